@@ -1,6 +1,8 @@
 ﻿
 #pragma once
 
+#include <cstring>
+
 #include "base/array.hpp"
 
 #include "glog/logging.h"
@@ -1,12 +1,15 @@
 ﻿
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <experimental/optional>
 #include <functional>
 #include <queue>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <vector>
 
 #include "base/macros.hpp"
@@ -0,0 +1,34 @@
+﻿
+#pragma once
+
+#include <cstdint>
+
+#include "base/array.hpp"
+
+namespace principia {
+namespace base {
+
+// An implementation of the LZ4 block format, see
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md.  It favours
+// speed over compression ratio and is used to reduce the size of the
+// serialized plugin.
+
+// An upper bound on the size of the compressed form of |input_size| bytes.
+inline std::int64_t LZ4MaxCompressedSize(std::int64_t input_size);
+
+// Compresses |input| into |output| and returns the number of bytes written.
+// |output.size| must be at least |LZ4MaxCompressedSize(input.size)|.  |input|
+// and |output| must not overlap.
+inline std::int64_t LZ4Compress(Array<std::uint8_t const> input,
+                                Array<std::uint8_t> output);
+
+// Decompresses |input| into |output| and returns the number of bytes written.
+// Fails if |input| is malformed or if |output| is too small.  |input| and
+// |output| must not overlap.
+inline std::int64_t LZ4Decompress(Array<std::uint8_t const> input,
+                                  Array<std::uint8_t> output);
+
+}  // namespace base
+}  // namespace principia
+
+#include "base/lz4_body.hpp"
@@ -0,0 +1,188 @@
+﻿
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "base/lz4.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace internal_lz4 {
+
+// Constraints imposed by the format on the end of a block.
+constexpr std::int64_t last_literals = 5;
+constexpr std::int64_t match_safe_distance = 12;
+constexpr std::int64_t min_match = 4;
+constexpr std::int64_t max_offset = 0xFFFF;
+constexpr int hash_bits = 12;
+
+inline std::uint32_t Read32(std::uint8_t const* const p) {
+  std::uint32_t result;
+  std::memcpy(&result, p, sizeof(result));
+  return result;
+}
+
+inline int Hash(std::uint32_t const sequence) {
+  return static_cast<int>((sequence * 2654435761U) >> (32 - hash_bits));
+}
+
+// Writes the remainder of a length which did not fit in a nibble.
+inline std::uint8_t* WriteLength(std::int64_t length, std::uint8_t* output) {
+  for (; length >= 0xFF; length -= 0xFF) {
+    *output++ = 0xFF;
+  }
+  *output++ = static_cast<std::uint8_t>(length);
+  return output;
+}
+
+// Reads the remainder of a length whose nibble was 15.
+inline std::int64_t ReadLength(std::uint8_t const*& input,
+                               std::uint8_t const* const input_end) {
+  std::int64_t length = 0;
+  std::uint8_t byte;
+  do {
+    CHECK_LT(input, input_end) << "Truncated length";
+    byte = *input++;
+    length += byte;
+  } while (byte == 0xFF);
+  return length;
+}
+
+// Writes a sequence made of the literals [literals, literals + literal_length[
+// followed, unless |match_length| is 0, by a match.
+inline std::uint8_t* WriteSequence(std::uint8_t const* const literals,
+                                   std::int64_t const literal_length,
+                                   std::int64_t const offset,
+                                   std::int64_t const match_length,
+                                   std::uint8_t* output) {
+  std::uint8_t* const token = output++;
+  std::int64_t const match_code =
+      match_length == 0 ? 0 : match_length - min_match;
+  *token = static_cast<std::uint8_t>((std::min<std::int64_t>(literal_length,
+                                                             15) << 4) |
+                                     std::min<std::int64_t>(match_code, 15));
+  if (literal_length >= 15) {
+    output = WriteLength(literal_length - 15, output);
+  }
+  std::memcpy(output, literals, literal_length);
+  output += literal_length;
+  if (match_length > 0) {
+    *output++ = static_cast<std::uint8_t>(offset);
+    *output++ = static_cast<std::uint8_t>(offset >> 8);
+    if (match_code >= 15) {
+      output = WriteLength(match_code - 15, output);
+    }
+  }
+  return output;
+}
+
+}  // namespace internal_lz4
+
+inline std::int64_t LZ4MaxCompressedSize(std::int64_t const input_size) {
+  return input_size + input_size / 0xFF + 16;
+}
+
+inline std::int64_t LZ4Compress(Array<std::uint8_t const> const input,
+                                Array<std::uint8_t> const output) {
+  using namespace internal_lz4;
+  CHECK_GE(output.size, LZ4MaxCompressedSize(input.size));
+  std::uint8_t const* const begin = input.data;
+  std::uint8_t const* const end = input.data + input.size;
+  std::uint8_t* out = output.data;
+  std::uint8_t const* anchor = begin;
+
+  if (input.size > match_safe_distance) {
+    // Positions (relative to |begin|) of the last occurrences of 4-byte
+    // sequences, indexed by their hash.  -1 if there is none.
+    std::vector<std::int32_t> last_positions(1 << hash_bits, -1);
+    std::uint8_t const* const match_start_limit = end - match_safe_distance;
+    std::uint8_t const* const match_end_limit = end - last_literals;
+    std::uint8_t const* p = begin;
+    while (p < match_start_limit) {
+      std::uint32_t const sequence = Read32(p);
+      std::int32_t& last_position = last_positions[Hash(sequence)];
+      std::int64_t const previous_position = last_position;
+      last_position = static_cast<std::int32_t>(p - begin);
+      // Don't form a pointer from -1, it would be before the start of |input|.
+      if (previous_position < 0 ||
+          (p - begin) - previous_position > max_offset ||
+          Read32(begin + previous_position) != sequence) {
+        ++p;
+        continue;
+      }
+      std::uint8_t const* match = begin + previous_position;
+      // Extend the match backwards into the pending literals and forwards as
+      // far as the format permits.
+      while (p > anchor && match > begin && p[-1] == match[-1]) {
+        --p;
+        --match;
+      }
+      std::int64_t match_length = min_match;
+      while (p + match_length < match_end_limit &&
+             p[match_length] == match[match_length]) {
+        ++match_length;
+      }
+      out = WriteSequence(anchor, p - anchor, p - match, match_length, out);
+      p += match_length;
+      anchor = p;
+    }
+  }
+
+  // The last sequence only has literals.
+  out = WriteSequence(anchor, end - anchor, /*offset=*/0, /*match_length=*/0,
+                      out);
+  return out - output.data;
+}
+
+inline std::int64_t LZ4Decompress(Array<std::uint8_t const> const input,
+                                  Array<std::uint8_t> const output) {
+  using namespace internal_lz4;
+  std::uint8_t const* in = input.data;
+  std::uint8_t const* const in_end = input.data + input.size;
+  std::uint8_t* out = output.data;
+  std::uint8_t* const out_end = output.data + output.size;
+  for (;;) {
+    CHECK_LT(in, in_end) << "Truncated sequence";
+    std::uint8_t const token = *in++;
+
+    std::int64_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      literal_length += ReadLength(in, in_end);
+    }
+    CHECK_LE(literal_length, in_end - in) << "Truncated literals";
+    CHECK_LE(literal_length, out_end - out) << "Output too small";
+    std::memcpy(out, in, literal_length);
+    in += literal_length;
+    out += literal_length;
+
+    // The last sequence has no match.
+    if (in == in_end) {
+      break;
+    }
+
+    CHECK_LE(2, in_end - in) << "Truncated offset";
+    std::int64_t const offset = in[0] | (in[1] << 8);
+    in += 2;
+    CHECK_LT(0, offset) << "Invalid offset";
+    CHECK_LE(offset, out - output.data) << "Invalid offset";
+    std::int64_t match_length = token & 0xF;
+    if (match_length == 15) {
+      match_length += ReadLength(in, in_end);
+    }
+    match_length += min_match;
+    CHECK_LE(match_length, out_end - out) << "Output too small";
+    // The match may overlap the output, so copy byte by byte.
+    std::uint8_t const* match = out - offset;
+    for (std::int64_t i = 0; i < match_length; ++i) {
+      *out++ = *match++;
+    }
+  }
+  return out - output.data;
+}
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,146 @@
+﻿
+#include "base/lz4.hpp"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/array.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+class LZ4Test : public testing::Test {
+ protected:
+  // Compresses and decompresses |input|, checks that the round trip is the
+  // identity and returns the compressed size.
+  std::int64_t RoundTrip(Array<std::uint8_t const> const input) {
+    UniqueBytes compressed(LZ4MaxCompressedSize(input.size));
+    std::int64_t const compressed_size =
+        LZ4Compress(input, compressed.get());
+    EXPECT_LE(compressed_size, compressed.size);
+    UniqueBytes decompressed(input.size);
+    EXPECT_EQ(input.size,
+              LZ4Decompress(Bytes(compressed.data.get(), compressed_size),
+                            decompressed.get()));
+    EXPECT_EQ(input, Array<std::uint8_t const>(decompressed.get()));
+    return compressed_size;
+  }
+
+  // Decompresses |compressed|, checks that it has |size| bytes and returns
+  // them as a string.
+  std::string Decompress(Array<std::uint8_t const> const compressed,
+                         std::int64_t const size) {
+    UniqueBytes decompressed(size);
+    EXPECT_EQ(size, LZ4Decompress(compressed, decompressed.get()));
+    return std::string(reinterpret_cast<char const*>(decompressed.data.get()),
+                       decompressed.size);
+  }
+};
+
+using LZ4DeathTest = LZ4Test;
+
+TEST_F(LZ4Test, Empty) {
+  EXPECT_EQ(1, RoundTrip(Bytes()));
+}
+
+TEST_F(LZ4Test, Short) {
+  std::string const text = "Ceci n'est pas une pipe.";
+  std::int64_t const compressed_size =
+      RoundTrip({reinterpret_cast<std::uint8_t const*>(text.data()),
+                 text.size()});
+  EXPECT_EQ(text.size() + 2, compressed_size);
+}
+
+TEST_F(LZ4Test, Repetitive) {
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += "All work and no play makes Jack a dull boy.  ";
+  }
+  std::int64_t const compressed_size =
+      RoundTrip({reinterpret_cast<std::uint8_t const*>(text.data()),
+                 text.size()});
+  EXPECT_GT(text.size() / 100, compressed_size);
+
+  UniqueBytes zeroes(100'000);
+  std::memset(zeroes.data.get(), 0, zeroes.size);
+  EXPECT_GT(zeroes.size / 200, RoundTrip(zeroes.get()));
+}
+
+TEST_F(LZ4Test, Random) {
+  std::mt19937_64 random(42);
+  for (std::int64_t const size : {13, 255, 256, 270, 65'536, 200'000}) {
+    UniqueBytes bytes(size);
+    // Bytes from a small alphabet, so that we get a mix of literals and
+    // matches of varying lengths and offsets.
+    for (std::int64_t i = 0; i < size; ++i) {
+      bytes.data[i] = static_cast<std::uint8_t>('a' + random() % 4);
+    }
+    RoundTrip(bytes.get());
+    for (std::int64_t i = 0; i < size; ++i) {
+      bytes.data[i] = static_cast<std::uint8_t>(random());
+    }
+    EXPECT_GE(LZ4MaxCompressedSize(size), RoundTrip(bytes.get()));
+  }
+}
+
+// The inputs below were compressed by the reference implementation (liblz4
+// 1.9.4, |LZ4_compress_default|), to check that we decode what it produces.
+TEST_F(LZ4Test, ReferenceBlocks) {
+  {
+    std::string const text = "Ceci n'est pas une pipe.";
+    std::vector<std::uint8_t> compressed = {0xF0, 0x09};
+    compressed.insert(compressed.end(), text.begin(), text.end());
+    EXPECT_EQ(text,
+              Decompress({compressed.data(), compressed.size()}, text.size()));
+  }
+  {
+    // An overlapping match.
+    std::string const text = "abcabcabcabcabcabcabcabcabcabcabcabcabc";
+    std::uint8_t const compressed[] = {0x3F, 'a', 'b', 'c', 0x03, 0x00, 0x0C,
+                                       0x50, 'b', 'c', 'a', 'b', 'c'};
+    EXPECT_EQ(text, Decompress({compressed, sizeof(compressed)}, text.size()));
+  }
+  {
+    // Literal and match lengths that need extra bytes: 280 pseudo-random bytes
+    // followed by 1000 zeroes.
+    std::string text;
+    std::uint64_t state = 0;
+    for (int i = 0; i < 280; ++i) {
+      state = state * 6364136223846793005 + 1442695040888963407;
+      text.push_back(static_cast<char>(state >> 56));
+    }
+    text.resize(1280, '\0');
+    std::vector<std::uint8_t> compressed = {0xFF, 0xFF, 0x0D};
+    compressed.insert(compressed.end(), text.begin(), text.begin() + 283);
+    for (std::uint8_t const byte : {0x01, 0x00, 0xFF, 0xFF, 0xFF, 0xD0,
+                                    0x50, 0x00, 0x00, 0x00, 0x00, 0x00}) {
+      compressed.push_back(byte);
+    }
+    ASSERT_EQ(298, compressed.size());
+    EXPECT_EQ(text,
+              Decompress({compressed.data(), compressed.size()}, text.size()));
+  }
+}
+
+TEST_F(LZ4DeathTest, Malformed) {
+  UniqueBytes output(100);
+  std::uint8_t const truncated_literals[] = {0x10};
+  std::uint8_t const invalid_offset[] = {0x10, 'a', 0x05, 0x00};
+  std::uint8_t const overflow[] = {0x1F, 'a', 0x01, 0x00, 0xFF, 0x00};
+  EXPECT_DEATH({
+    LZ4Decompress({truncated_literals, 1}, output.get());
+  }, "Truncated literals");
+  EXPECT_DEATH({
+    LZ4Decompress({invalid_offset, 4}, output.get());
+  }, "Invalid offset");
+  EXPECT_DEATH({
+    LZ4Decompress({overflow, 6}, output.get());
+  }, "Output too small");
+}
+
+}  // namespace base
+}  // namespace principia
@@ -144,6 +144,17 @@ inline void noreturn() { std::exit(0); }
 #  error "What compiler is this?"
 #endif
 
+// The vector instruction sets that explicitly vectorized code may use.  SSE2 is
+// part of x86-64 and is enabled by default by MSVC on x86; AVX must be
+// requested from the compiler.
+#if ARCH_CPU_X86_64 || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define PRINCIPIA_USE_SSE2 1
+#endif
+#if defined(__AVX__)
+#  define PRINCIPIA_USE_AVX 1
+#endif
+
 // Thread-safety analysis.
 #if PRINCIPIA_COMPILER_CLANG || PRINCIPIA_COMPILER_CLANG_CL
 #  define THREAD_ANNOTATION_ATTRIBUTE__(x) __attribute__((x))
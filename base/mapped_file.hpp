@@ -0,0 +1,50 @@
+﻿
+#pragma once
+
+#include <cstdint>
+#include <experimental/filesystem>
+
+#include "base/macros.hpp"
+
+namespace principia {
+namespace base {
+namespace internal_mapped_file {
+
+// A read-only view of the contents of a file, mapped in memory.  The pages are
+// loaded lazily by the operating system and shared with its file cache, so
+// mapping a large file is fast and doesn't increase the private memory of the
+// process.  The mapping starts at a page boundary, so its alignment is
+// suitable for any type.  Thread-safe.
+class MappedFile final {
+ public:
+  explicit MappedFile(std::experimental::filesystem::path const& path);
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  // Null if the file is empty.
+  char const* data() const;
+  std::int64_t size() const;
+
+ private:
+  char const* data_ = nullptr;
+  std::int64_t size_ = 0;
+#if OS_WIN
+  void* file_;
+  void* mapping_ = nullptr;
+#else
+  int file_descriptor_;
+#endif
+};
+
+}  // namespace internal_mapped_file
+
+using internal_mapped_file::MappedFile;
+
+}  // namespace base
+}  // namespace principia
+
+#include "base/mapped_file_body.hpp"
@@ -0,0 +1,104 @@
+﻿
+#pragma once
+
+#include "base/mapped_file.hpp"
+
+#if OS_WIN
+#define NOGDI
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace internal_mapped_file {
+
+#if OS_WIN
+
+inline MappedFile::MappedFile(
+    std::experimental::filesystem::path const& path) {
+  file_ = CreateFileW(path.c_str(),
+                      GENERIC_READ,
+                      FILE_SHARE_READ,
+                      /*lpSecurityAttributes=*/nullptr,
+                      OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL,
+                      /*hTemplateFile=*/nullptr);
+  CHECK(file_ != INVALID_HANDLE_VALUE) << path << " " << GetLastError();
+  LARGE_INTEGER size;
+  CHECK(GetFileSizeEx(file_, &size)) << path << " " << GetLastError();
+  size_ = size.QuadPart;
+  if (size_ > 0) {
+    mapping_ = CreateFileMappingW(file_,
+                                  /*lpFileMappingAttributes=*/nullptr,
+                                  PAGE_READONLY,
+                                  /*dwMaximumSizeHigh=*/0,
+                                  /*dwMaximumSizeLow=*/0,
+                                  /*lpName=*/nullptr);
+    CHECK_NOTNULL(mapping_);
+    data_ = static_cast<char const*>(MapViewOfFile(mapping_,
+                                                   FILE_MAP_READ,
+                                                   /*dwFileOffsetHigh=*/0,
+                                                   /*dwFileOffsetLow=*/0,
+                                                   /*dwNumberOfBytesToMap=*/0));
+    CHECK_NOTNULL(data_);
+  }
+}
+
+inline MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_ != nullptr) {
+    CloseHandle(mapping_);
+  }
+  CloseHandle(file_);
+}
+
+#else
+
+inline MappedFile::MappedFile(
+    std::experimental::filesystem::path const& path) {
+  file_descriptor_ = open(path.c_str(), O_RDONLY);
+  PCHECK(file_descriptor_ >= 0) << path;
+  struct stat status;
+  PCHECK(fstat(file_descriptor_, &status) == 0) << path;
+  size_ = status.st_size;
+  if (size_ > 0) {
+    void* const data = mmap(/*addr=*/nullptr,
+                            size_,
+                            PROT_READ,
+                            MAP_SHARED,
+                            file_descriptor_,
+                            /*offset=*/0);
+    PCHECK(data != MAP_FAILED) << path;
+    data_ = static_cast<char const*>(data);
+  }
+}
+
+inline MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  close(file_descriptor_);
+}
+
+#endif
+
+inline char const* MappedFile::data() const {
+  return data_;
+}
+
+inline std::int64_t MappedFile::size() const {
+  return size_;
+}
+
+}  // namespace internal_mapped_file
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,51 @@
+﻿
+#include "base/mapped_file.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+class MappedFileTest : public testing::Test {
+ protected:
+  static void WriteFile(std::experimental::filesystem::path const& path,
+                        std::string const& contents) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+  }
+};
+
+TEST_F(MappedFileTest, Contents) {
+  auto const path = TEMP_DIR / "mapped_file_test_contents.bin";
+  std::string const contents("Чебышёв\0Newhall", 22);
+  WriteFile(path, contents);
+  {
+    MappedFile const mapped_file(path);
+    EXPECT_EQ(contents.size(), mapped_file.size());
+    EXPECT_EQ(0, std::memcmp(contents.data(),
+                             mapped_file.data(),
+                             contents.size()));
+    EXPECT_EQ(0,
+              reinterpret_cast<std::uintptr_t>(mapped_file.data()) % 64);
+  }
+  std::experimental::filesystem::remove(path);
+}
+
+TEST_F(MappedFileTest, Empty) {
+  auto const path = TEMP_DIR / "mapped_file_test_empty.bin";
+  WriteFile(path, "");
+  {
+    MappedFile const mapped_file(path);
+    EXPECT_EQ(0, mapped_file.size());
+    EXPECT_EQ(nullptr, mapped_file.data());
+  }
+  std::experimental::filesystem::remove(path);
+}
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,76 @@
+﻿
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "base/macros.hpp"
+
+namespace principia {
+namespace base {
+namespace internal_thread_pool {
+
+// A pool of threads that persist for the lifetime of the pool, for running
+// many short batches of tasks without paying for the creation of threads.
+// Unlike |Bundle|, it has no cooperative aborting and is available with all
+// compilers.
+class ThreadPool final {
+ public:
+  // Creates |workers - 1| threads; the calling thread of |ParallelFor| is the
+  // remaining worker.
+  explicit ThreadPool(int workers);
+  // Joins the threads.
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  int workers() const;
+
+  // Calls |task| for each index in [0, tasks[, on the threads of the pool and
+  // on the calling thread, and returns once all the calls have completed.  The
+  // order of the calls is unspecified.  Must not be called concurrently with
+  // itself.
+  void ParallelFor(int tasks, std::function<void(int task)> const& task);
+
+ private:
+  // The body of the |threads_|, which run the tasks of successive calls to
+  // |ParallelFor| until the destruction of the pool.
+  void Toil();
+
+  // Runs the remaining tasks of the current |ParallelFor|, if any.  |lock|
+  // must hold |lock_|, and holds it on return.
+  void RunTasks(std::unique_lock<std::mutex>& lock);
+
+  std::mutex lock_;
+  // Notified to all when tasks are available or when the pool is destroyed.
+  std::condition_variable tasks_available_or_terminate_;
+  // Notified when the last task of the current |ParallelFor| completes.
+  std::condition_variable tasks_completed_;
+
+  std::function<void(int task)> const* task_ GUARDED_BY(lock_) = nullptr;
+  int tasks_ GUARDED_BY(lock_) = 0;
+  // The index of the next task to start.
+  int next_task_ GUARDED_BY(lock_) = 0;
+  // The number of tasks that have not completed.
+  int pending_tasks_ GUARDED_BY(lock_) = 0;
+  bool terminate_ GUARDED_BY(lock_) = false;
+
+  int const workers_;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace internal_thread_pool
+
+using internal_thread_pool::ThreadPool;
+
+}  // namespace base
+}  // namespace principia
+
+#include "base/thread_pool_body.hpp"
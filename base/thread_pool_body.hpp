@@ -0,0 +1,82 @@
+﻿
+#pragma once
+
+#include "base/thread_pool.hpp"
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace internal_thread_pool {
+
+inline ThreadPool::ThreadPool(int const workers) : workers_(workers) {
+  CHECK_LE(1, workers_);
+  threads_.reserve(workers_ - 1);
+  for (int i = 0; i < workers_ - 1; ++i) {
+    threads_.emplace_back(&ThreadPool::Toil, this);
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    terminate_ = true;
+  }
+  tasks_available_or_terminate_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+inline int ThreadPool::workers() const {
+  return workers_;
+}
+
+inline void ThreadPool::ParallelFor(
+    int const tasks,
+    std::function<void(int task)> const& task) {
+  std::unique_lock<std::mutex> lock(lock_);
+  CHECK(task_ == nullptr);
+  task_ = &task;
+  tasks_ = tasks;
+  next_task_ = 0;
+  pending_tasks_ = tasks;
+  if (tasks > 1) {
+    tasks_available_or_terminate_.notify_all();
+  }
+  RunTasks(lock);
+  tasks_completed_.wait(lock, [this] { return pending_tasks_ == 0; });
+  task_ = nullptr;
+  tasks_ = 0;
+  next_task_ = 0;
+}
+
+inline void ThreadPool::Toil() {
+  std::unique_lock<std::mutex> lock(lock_);
+  for (;;) {
+    tasks_available_or_terminate_.wait(
+        lock,
+        [this] { return terminate_ || next_task_ < tasks_; });
+    if (terminate_) {
+      return;
+    }
+    RunTasks(lock);
+  }
+}
+
+inline void ThreadPool::RunTasks(std::unique_lock<std::mutex>& lock) {
+  while (next_task_ < tasks_) {
+    int const i = next_task_++;
+    auto const& task = *task_;
+    lock.unlock();
+    task(i);
+    lock.lock();
+    if (--pending_tasks_ == 0) {
+      tasks_completed_.notify_one();
+    }
+  }
+}
+
+}  // namespace internal_thread_pool
+}  // namespace base
+}  // namespace principia
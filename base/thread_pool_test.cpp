@@ -0,0 +1,68 @@
+﻿
+#include "base/thread_pool.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+class ThreadPoolTest : public testing::Test {
+ protected:
+  ThreadPoolTest() : pool_(4) {}
+
+  ThreadPool pool_;
+};
+
+// Each task is run exactly once, and the pool may be reused.
+TEST_F(ThreadPoolTest, ParallelFor) {
+  for (int tasks : {0, 1, 3, 4, 100}) {
+    std::vector<std::atomic<int>> calls(tasks);
+    pool_.ParallelFor(tasks, [&calls](int const task) { ++calls[task]; });
+    for (int i = 0; i < tasks; ++i) {
+      EXPECT_EQ(1, calls[i]) << tasks << " " << i;
+    }
+  }
+}
+
+// The tasks run on several threads, including the calling one.
+TEST_F(ThreadPoolTest, Threads) {
+  std::mutex lock;
+  std::set<std::thread::id> thread_ids;
+  std::atomic<int> running(0);
+  pool_.ParallelFor(
+      pool_.workers(),
+      [&lock, &running, &thread_ids](int const task) {
+        {
+          std::lock_guard<std::mutex> l(lock);
+          thread_ids.insert(std::this_thread::get_id());
+        }
+        // Wait until all the tasks have started, which can only happen if
+        // they run on distinct threads.
+        ++running;
+        while (running < 4) {
+          std::this_thread::yield();
+        }
+      });
+  EXPECT_THAT(thread_ids, SizeIs(4));
+  EXPECT_EQ(1, thread_ids.count(std::this_thread::get_id()));
+}
+
+TEST_F(ThreadPoolTest, SingleWorker) {
+  ThreadPool pool(1);
+  std::vector<int> order;
+  pool.ParallelFor(3, [&order](int const task) { order.push_back(task); });
+  EXPECT_THAT(order, ElementsAre(0, 1, 2));
+}
+
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,157 @@
+﻿
+// .\Release\x64\benchmarks.exe --benchmark_filter=ContinuousTrajectory --benchmark_repetitions=5  // NOLINT(whitespace/line_length)
+
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/mapped_file.hpp"
+#include "base/not_null.hpp"
+#include "geometry/frame.hpp"
+#include "geometry/named_quantities.hpp"
+#include "physics/continuous_trajectory.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "serialization/physics.pb.h"
+
+// Must come last to avoid conflicts when defining the CHECK macros.
+#include "benchmark/benchmark.h"
+
+namespace principia {
+
+using base::make_not_null_unique;
+using base::MappedFile;
+using base::not_null;
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::Instant;
+using geometry::Position;
+using geometry::Velocity;
+using numerics::ЧебышёвSeriesBlock;
+using quantities::Angle;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Time;
+using quantities::si::Kilo;
+using quantities::si::Metre;
+using quantities::si::Milli;
+using quantities::si::Minute;
+using quantities::si::Radian;
+using quantities::si::Second;
+
+namespace physics {
+
+namespace {
+
+using World = Frame<serialization::Frame::TestTag,
+                    serialization::Frame::TEST, true>;
+
+int const evaluations_per_iteration = 1000;
+Time const step = 10 * Minute;
+
+// Returns a trajectory for a circular orbit made of |number_of_series|
+// Чебышёв series.
+not_null<std::unique_ptr<ContinuousTrajectory<World>>> MakeTrajectory(
+    int const number_of_series) {
+  Length const distance = 7000 * Kilo(Metre);
+  AngularFrequency const ω = 2 * π * Radian / (100 * Minute);
+  auto trajectory = make_not_null_unique<ContinuousTrajectory<World>>(
+                        step,
+                        /*tolerance=*/1 * Milli(Metre));
+  Instant const t0;
+  for (int i = 0; i <= 8 * number_of_series; ++i) {
+    Instant const t = t0 + i * step;
+    Angle const angle = ω * (t - t0);
+    trajectory->Append(
+        t,
+        DegreesOfFreedom<World>(
+            World::origin + Displacement<World>({distance * Cos(angle),
+                                                 distance * Sin(angle),
+                                                 0 * Metre}),
+            Velocity<World>({-ω * distance * Sin(angle) / Radian,
+                             ω * distance * Cos(angle) / Radian,
+                             0 * Metre / Second})));
+  }
+  return trajectory;
+}
+
+}  // namespace
+
+// Evaluates the trajectory at random times over its entire span.  The cost of
+// finding the series for a given time should not depend on the length of the
+// trajectory.
+void BM_ContinuousTrajectoryEvaluatePosition(benchmark::State& state) {
+  auto const trajectory = MakeTrajectory(state.range_x());
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(0.0, 1.0);
+  std::vector<Instant> times;
+  Time const duration = trajectory->t_max() - trajectory->t_min();
+  for (int i = 0; i < evaluations_per_iteration; ++i) {
+    times.push_back(trajectory->t_min() + distribution(random) * duration);
+  }
+
+  Displacement<World> result{};
+  while (state.KeepRunning()) {
+    for (Instant const& t : times) {
+      result += trajectory->EvaluatePosition(t) - World::origin;
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
+// Reads a trajectory made of 2¹⁶ series, i.e., about 7 years with the step of
+// the ephemeris.  The argument is 0 to read the series from the message, 1 to
+// map them from a series file.
+void BM_ContinuousTrajectoryReadFromMessage(benchmark::State& state) {
+  bool const use_series_file = state.range_x() != 0;
+  auto const trajectory = MakeTrajectory(1 << 16);
+  auto const path = TEMP_DIR / "continuous_trajectory_benchmark_series.bin";
+  serialization::ContinuousTrajectory message;
+  if (use_series_file) {
+    std::ofstream blocks(path, std::ios::binary | std::ios::trunc);
+    trajectory->WriteToMessage(&message,
+                               trajectory->GetCheckpoint(),
+                               /*first_block=*/0,
+                               &blocks);
+  } else {
+    trajectory->WriteToMessage(&message);
+  }
+
+  Instant t_max;
+  while (state.KeepRunning()) {
+    if (use_series_file) {
+      auto const series_file = std::make_shared<MappedFile const>(path);
+      t_max = ContinuousTrajectory<World>::ReadFromMessage(
+                  message,
+                  series_file,
+                  reinterpret_cast<ЧебышёвSeriesBlock const*>(
+                      series_file->data()),
+                  series_file->size() / sizeof(ЧебышёвSeriesBlock))->t_max();
+    } else {
+      t_max = ContinuousTrajectory<World>::ReadFromMessage(message)->t_max();
+    }
+  }
+  // The call to |DebugString| prevents the loop from being optimized away.
+  state.SetLabel(std::to_string(message.ByteSize()) + " bytes" +
+                 quantities::DebugString(t_max - Instant()).substr(0, 0));
+}
+
+BENCHMARK(BM_ContinuousTrajectoryEvaluatePosition)->
+    Arg(1 << 4)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 16);
+BENCHMARK(BM_ContinuousTrajectoryReadFromMessage)->Arg(0)->Arg(1);
+
+}  // namespace physics
+}  // namespace principia
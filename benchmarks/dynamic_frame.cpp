@@ -221,10 +221,50 @@ void BM_BarycentricRotatingDynamicFrame(benchmark::State& state) {
   }
 }
 
+// Evaluates the frame repeatedly at the same instants, the way rendering,
+// apsides, nodes and the navball do.  The motions are memoized for the most
+// recent instants, so this is fast as long as there are few distinct instants.
+void BM_DynamicFrameMemoization(benchmark::State& state) {
+  Time const Δt = 5 * Minute;
+  int const distinct_instants = state.range_x();
+  int const evaluations_per_instant = 10;
+
+  SolarSystem<ICRFJ2000Equator> solar_system;
+  solar_system.Initialize(
+      SOLUTION_DIR / "astronomy" / "gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" /
+          "initial_state_jd_2433282_500000000.proto.txt");
+  auto const ephemeris = solar_system.MakeEphemeris(
+      /*fitting_tolerance=*/5 * Milli(Metre),
+      Ephemeris<ICRFJ2000Equator>::FixedStepParameters(
+          McLachlanAtela1992Order5Optimal<Position<ICRFJ2000Equator>>(),
+          /*step=*/45 * Minute));
+  ephemeris->Prolong(solar_system.epoch() + distinct_instants * Δt);
+
+  not_null<MassiveBody const*> const earth =
+      solar_system.massive_body(*ephemeris, "Earth");
+  not_null<MassiveBody const*> const venus =
+      solar_system.massive_body(*ephemeris, "Venus");
+
+  std::vector<Instant> times;
+  for (int i = 0; i < distinct_instants; ++i) {
+    times.push_back(solar_system.epoch() + i * Δt);
+  }
+
+  BarycentricRotatingDynamicFrame<ICRFJ2000Equator, Rendering>
+      dynamic_frame(ephemeris.get(), earth, venus);
+  while (state.KeepRunning()) {
+    for (int i = 0; i < evaluations_per_instant; ++i) {
+      auto v = dynamic_frame.ToThisFrameAtTimes(times);
+    }
+  }
+}
+
 int const iterations = (1000 << 10) + 1;
 
 BENCHMARK(BM_BodyCentredNonRotatingDynamicFrame)->Arg(iterations);
 BENCHMARK(BM_BarycentricRotatingDynamicFrame)->Arg(iterations);
+BENCHMARK(BM_DynamicFrameMemoization)->Arg(16)->Arg(64)->Arg(1024);
 
 }  // namespace physics
 }  // namespace principia
@@ -4,6 +4,7 @@
 #define GLOG_NO_ABBREVIATED_SEVERITIES
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <type_traits>
 #include <vector>
@@ -58,8 +59,12 @@ using World = Frame<serialization::Frame::TestTag,
 void ComputeHarmonicOscillatorAcceleration1D(
     Instant const& t,
     std::vector<Length> const& q,
-    std::vector<Acceleration>& result) {
+    std::vector<Acceleration>& result,
+    int* const evaluations) {
   result[0] = -q[0] * (SIUnit<Stiffness>() / SIUnit<Mass>());
+  if (evaluations != nullptr) {
+    ++*evaluations;
+  }
 }
 
 void ComputeHarmonicOscillatorAcceleration3D(
@@ -91,24 +96,31 @@ double HarmonicOscillatorToleranceRatio3D(
 
 }  // namespace
 
+// |tolerance| is the integration tolerance in metres and metres per second.
+// If |evaluations| is not null, it is incremented by the number of evaluations
+// of the right-hand side.
 template<typename Integrator>
-void SolveHarmonicOscillatorAndComputeError1D(benchmark::State& state,
-                                              Length& q_error,
-                                              Speed& v_error,
-                                              Integrator const& integrator) {
+void SolveHarmonicOscillatorAndComputeError1D(
+    benchmark::State& state,
+    Length& q_error,
+    Speed& v_error,
+    Integrator const& integrator,
+    double const tolerance = 1e-6,
+    int* const evaluations = nullptr) {
   using ODE = SpecialSecondOrderDifferentialEquation<Length>;
 
   Length const q_initial = 1 * Metre;
   Speed const v_initial;
   Instant const t_initial;
   Instant const t_final = t_initial + 1000 * Second;
-  Length const length_tolerance = 1e-6 * Metre;
-  Speed const speed_tolerance = 1e-6 * Metre / Second;
+  Length const length_tolerance = tolerance * Metre;
+  Speed const speed_tolerance = tolerance * Metre / Second;
 
   std::vector<ODE::SystemState> solution;
   ODE harmonic_oscillator;
   harmonic_oscillator.compute_acceleration =
-      std::bind(ComputeHarmonicOscillatorAcceleration1D, _1, _2, _3);
+      std::bind(ComputeHarmonicOscillatorAcceleration1D,
+                _1, _2, _3, evaluations);
   IntegrationProblem<ODE> problem;
   problem.equation = harmonic_oscillator;
   problem.initial_state = {{q_initial}, {v_initial}, t_initial};
@@ -233,6 +245,28 @@ void BM_EmbeddedExplicitRungeKuttaNyströmIntegratorSolveHarmonicOscillator3D(
   state.SetLabel(ss.str());
 }
 
+// Reports the number of evaluations of the right-hand side needed to reach
+// a given accuracy.  |state.range_x()| is the opposite of the decimal logarithm
+// of the tolerance.
+template<typename Integrator, Integrator const& (*integrator)()>
+void BM_EmbeddedExplicitRungeKuttaNyströmIntegratorEvaluationsHarmonicOscillator1D(  // NOLINT(whitespace/line_length)
+    benchmark::State& state) {
+  double const tolerance = std::pow(10.0, -state.range_x());
+  Length q_error;
+  Speed v_error;
+  int evaluations = 0;
+  while (state.KeepRunning()) {
+    evaluations = 0;
+    SolveHarmonicOscillatorAndComputeError1D(state, q_error, v_error,
+                                             integrator(),
+                                             tolerance,
+                                             &evaluations);
+  }
+  std::stringstream ss;
+  ss << evaluations << " evaluations, " << q_error << ", " << v_error;
+  state.SetLabel(ss.str());
+}
+
 // Keep each argument on a single line below, lest it breaks benchmark parsing.
 
 BENCHMARK_TEMPLATE2(
@@ -245,5 +279,27 @@ BENCHMARK_TEMPLATE2(
     decltype(DormandElMikkawyPrince1986RKN434FM<Position<World>>()),
     &DormandElMikkawyPrince1986RKN434FM<Position<World>>);
 
+BENCHMARK_TEMPLATE2(
+    BM_EmbeddedExplicitRungeKuttaNyströmIntegratorSolveHarmonicOscillator1D,
+    decltype(DormandElMikkawyPrince1986RKN646FM<Length>()),
+    &DormandElMikkawyPrince1986RKN646FM<Length>);
+
+BENCHMARK_TEMPLATE2(
+    BM_EmbeddedExplicitRungeKuttaNyströmIntegratorSolveHarmonicOscillator3D,
+    decltype(DormandElMikkawyPrince1986RKN646FM<Position<World>>()),
+    &DormandElMikkawyPrince1986RKN646FM<Position<World>>);
+
+BENCHMARK_TEMPLATE2(
+    BM_EmbeddedExplicitRungeKuttaNyströmIntegratorEvaluationsHarmonicOscillator1D,  // NOLINT(whitespace/line_length)
+    decltype(DormandElMikkawyPrince1986RKN434FM<Length>()),
+    &DormandElMikkawyPrince1986RKN434FM<Length>)
+    ->Arg(3)->Arg(6)->Arg(9)->Arg(12);
+
+BENCHMARK_TEMPLATE2(
+    BM_EmbeddedExplicitRungeKuttaNyströmIntegratorEvaluationsHarmonicOscillator1D,  // NOLINT(whitespace/line_length)
+    decltype(DormandElMikkawyPrince1986RKN646FM<Length>()),
+    &DormandElMikkawyPrince1986RKN646FM<Length>)
+    ->Arg(3)->Arg(6)->Arg(9)->Arg(12);
+
 }  // namespace integrators
 }  // namespace principia
@@ -1,6 +1,7 @@
 ﻿
 // .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=Ephemeris                                                                     // NOLINT(whitespace/line_length)
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <memory>
@@ -41,11 +42,15 @@ using geometry::Instant;
 using geometry::Position;
 using geometry::Quaternion;
 using geometry::Rotation;
+using geometry::Vector;
 using geometry::Velocity;
+using integrators::AdaptiveStepSizeIntegrator;
 using integrators::DormandElMikkawyPrince1986RKN434FM;
+using integrators::IntegrationProblem;
 using integrators::McLachlanAtela1992Order5Optimal;
 using integrators::Quinlan1999Order8A;
 using integrators::QuinlanTremaine1990Order12;
+using quantities::Acceleration;
 using quantities::DebugString;
 using quantities::Length;
 using quantities::Speed;
@@ -81,6 +86,7 @@ Ephemeris<ICRFJ2000Equator>::FixedStepParameters EphemerisParameters() {
 }
 
 void EphemerisSolarSystemBenchmark(SolarSystemFactory::Accuracy const accuracy,
+                                   bool const vectorized_gravity,
                                    benchmark::State& state) {
   Length error;
   while (state.KeepRunning()) {
@@ -92,6 +98,7 @@ void EphemerisSolarSystemBenchmark(SolarSystemFactory::Accuracy const accuracy,
     auto const ephemeris =
         at_спутник_1_launch->MakeEphemeris(FittingTolerance(state.range_x()),
                                            EphemerisParameters());
+    ephemeris->set_vectorized_gravity(vectorized_gravity);
 
     state.ResumeTiming();
     ephemeris->Prolong(final_time);
@@ -270,18 +277,29 @@ void EphemerisLEOProbeBenchmark(SolarSystemFactory::Accuracy const accuracy,
 
 void BM_EphemerisSolarSystemMajorBodiesOnly(benchmark::State& state) {
   EphemerisSolarSystemBenchmark(SolarSystemFactory::Accuracy::MajorBodiesOnly,
+                                /*vectorized_gravity=*/true,
                                 state);
 }
 
 void BM_EphemerisSolarSystemMinorAndMajorBodies(benchmark::State& state) {
   EphemerisSolarSystemBenchmark(
       SolarSystemFactory::Accuracy::MinorAndMajorBodies,
+      /*vectorized_gravity=*/true,
+      state);
+}
+
+void BM_EphemerisSolarSystemMinorAndMajorBodiesScalar(
+    benchmark::State& state) {
+  EphemerisSolarSystemBenchmark(
+      SolarSystemFactory::Accuracy::MinorAndMajorBodies,
+      /*vectorized_gravity=*/false,
       state);
 }
 
 void BM_EphemerisSolarSystemAllBodiesAndOblateness(benchmark::State& state) {
   EphemerisSolarSystemBenchmark(
       SolarSystemFactory::Accuracy::AllBodiesAndOblateness,
+      /*vectorized_gravity=*/true,
       state);
 }
 
@@ -357,6 +375,76 @@ void FlowEphemerisWithAdaptiveStep(
       /*last_point_only=*/false));
 }
 
+// Integrates the trajectory with an adaptive-step integrator whose right-hand
+// side calls the ephemeris, either through a |std::function| or through a
+// functor known at compile time, to measure the cost of the type erasure.
+void FlowEphemerisRightHandSide(
+    bool const specialized,
+    not_null<DiscreteTrajectory<ICRFJ2000Equator>*> const trajectory,
+    Instant const& t,
+    Ephemeris<ICRFJ2000Equator>& ephemeris) {
+  using ODE = Ephemeris<ICRFJ2000Equator>::NewtonianMotionEquation;
+  auto const& integrator =
+      DormandElMikkawyPrince1986RKN434FM<Position<ICRFJ2000Equator>>();
+
+  auto const compute_acceleration =
+      [&ephemeris](
+          Instant const& time,
+          std::vector<Position<ICRFJ2000Equator>> const& positions,
+          std::vector<Vector<Acceleration, ICRFJ2000Equator>>& accelerations) {
+        ephemeris.ComputeGravitationalAccelerationsOnMasslessBodies(
+            positions, time, accelerations);
+      };
+  auto const append_state = [trajectory](ODE::SystemState const& state) {
+    trajectory->Append(
+        state.time.value,
+        DegreesOfFreedom<ICRFJ2000Equator>(state.positions[0].value,
+                                           state.velocities[0].value));
+  };
+  auto const tolerance_to_error_ratio =
+      [](Time const& current_step_size, ODE::SystemStateError const& error) {
+        return std::min(1 * Metre / error.position_error[0].Norm(),
+                        1 * Metre / Second / error.velocity_error[0].Norm());
+      };
+
+  auto const last = trajectory->last();
+  ODE::SystemState const initial_state({last.degrees_of_freedom().position()},
+                                       {last.degrees_of_freedom().velocity()},
+                                       last.time());
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t - last.time(),
+      /*safety_factor=*/0.9);
+  auto const instance =
+      specialized
+          ? integrator.NewSpecializedInstance(initial_state,
+                                              compute_acceleration,
+                                              append_state,
+                                              tolerance_to_error_ratio,
+                                              parameters,
+                                              /*dense_output=*/nullptr)
+          : integrator.NewInstance(
+                IntegrationProblem<ODE>{ODE{compute_acceleration},
+                                        initial_state},
+                append_state,
+                tolerance_to_error_ratio,
+                parameters);
+  CHECK(instance->Solve(t).ok());
+}
+
+void FlowEphemerisRightHandSideTypeErased(
+    not_null<DiscreteTrajectory<ICRFJ2000Equator>*> const trajectory,
+    Instant const& t,
+    Ephemeris<ICRFJ2000Equator>& ephemeris) {
+  FlowEphemerisRightHandSide(/*specialized=*/false, trajectory, t, ephemeris);
+}
+
+void FlowEphemerisRightHandSideSpecialized(
+    not_null<DiscreteTrajectory<ICRFJ2000Equator>*> const trajectory,
+    Instant const& t,
+    Ephemeris<ICRFJ2000Equator>& ephemeris) {
+  FlowEphemerisRightHandSide(/*specialized=*/true, trajectory, t, ephemeris);
+}
+
 void FlowEphemerisWithFixedStepSLMS(
     not_null<DiscreteTrajectory<ICRFJ2000Equator>*> const trajectory,
     Instant const& t,
@@ -385,6 +473,7 @@ void FlowEphemerisWithFixedStepSRKN(
 
 BENCHMARK(BM_EphemerisSolarSystemMajorBodiesOnly)->Arg(-3);
 BENCHMARK(BM_EphemerisSolarSystemMinorAndMajorBodies)->Arg(-3);
+BENCHMARK(BM_EphemerisSolarSystemMinorAndMajorBodiesScalar)->Arg(-3);
 BENCHMARK(BM_EphemerisSolarSystemAllBodiesAndOblateness)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisL4ProbeMajorBodiesOnly,
                     &FlowEphemerisWithAdaptiveStep)->Arg(-3);
@@ -398,18 +487,30 @@ BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMajorBodiesOnly,
                     &FlowEphemerisWithFixedStepSLMS)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMajorBodiesOnly,
                     &FlowEphemerisWithFixedStepSRKN)->Arg(-3);
+BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMajorBodiesOnly,
+                    &FlowEphemerisRightHandSideTypeErased)->Arg(-3);
+BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMajorBodiesOnly,
+                    &FlowEphemerisRightHandSideSpecialized)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMinorAndMajorBodies,
                     &FlowEphemerisWithAdaptiveStep)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMinorAndMajorBodies,
                     &FlowEphemerisWithFixedStepSLMS)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMinorAndMajorBodies,
                     &FlowEphemerisWithFixedStepSRKN)->Arg(-3);
+BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMinorAndMajorBodies,
+                    &FlowEphemerisRightHandSideTypeErased)->Arg(-3);
+BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeMinorAndMajorBodies,
+                    &FlowEphemerisRightHandSideSpecialized)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeAllBodiesAndOblateness,
                     &FlowEphemerisWithAdaptiveStep)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeAllBodiesAndOblateness,
                     &FlowEphemerisWithFixedStepSLMS)->Arg(-3);
 BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeAllBodiesAndOblateness,
                     &FlowEphemerisWithFixedStepSRKN)->Arg(-3);
+BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeAllBodiesAndOblateness,
+                    &FlowEphemerisRightHandSideTypeErased)->Arg(-3);
+BENCHMARK_TEMPLATE1(BM_EphemerisLEOProbeAllBodiesAndOblateness,
+                    &FlowEphemerisRightHandSideSpecialized)->Arg(-3);
 
 BENCHMARK_TEMPLATE1(BM_EphemerisFittingTolerance,
                     &FlowEphemerisWithAdaptiveStep)->DenseRange(-4, 4);
@@ -46,6 +46,7 @@ using geometry::Displacement;
 using geometry::Instant;
 using geometry::Multivector;
 using geometry::R3Element;
+using geometry::Velocity;
 using quantities::Length;
 using quantities::Time;
 using quantities::Variation;
@@ -218,6 +219,83 @@ void BM_EvaluateDisplacement(benchmark::State& state) {
   state.SetLabel(ss.str().substr(0, 0));
 }
 
+void BM_EvaluateDisplacementAndVelocity(benchmark::State& state) {
+  int const degree = state.range_x();
+  std::mt19937_64 random(42);
+  std::vector<Displacement<ICRFJ2000Ecliptic>> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(
+        Displacement<ICRFJ2000Ecliptic>(
+            {static_cast<double>(random()) * Metre,
+             static_cast<double>(random()) * Metre,
+             static_cast<double>(random()) * Metre}));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Displacement<ICRFJ2000Ecliptic>> const series(
+    coefficients, t_min, t_max);
+
+  Instant t = t_min;
+  Time const Δt = (t_max - t_min) * 1e-9;
+  Displacement<ICRFJ2000Ecliptic> result{};
+  Velocity<ICRFJ2000Ecliptic> derivative_result{};
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < evaluations_per_iteration; ++i) {
+      result += series.Evaluate(t);
+      derivative_result += series.EvaluateDerivative(t);
+      t += Δt;
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result << derivative_result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
+void BM_EvaluateDisplacementWithVelocity(benchmark::State& state) {
+  int const degree = state.range_x();
+  std::mt19937_64 random(42);
+  std::vector<Displacement<ICRFJ2000Ecliptic>> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(
+        Displacement<ICRFJ2000Ecliptic>(
+            {static_cast<double>(random()) * Metre,
+             static_cast<double>(random()) * Metre,
+             static_cast<double>(random()) * Metre}));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Displacement<ICRFJ2000Ecliptic>> const series(
+    coefficients, t_min, t_max);
+
+  Instant t = t_min;
+  Time const Δt = (t_max - t_min) * 1e-9;
+  Displacement<ICRFJ2000Ecliptic> result{};
+  Velocity<ICRFJ2000Ecliptic> derivative_result{};
+  Displacement<ICRFJ2000Ecliptic> value;
+  Velocity<ICRFJ2000Ecliptic> derivative;
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < evaluations_per_iteration; ++i) {
+      series.EvaluateWithDerivative(t, value, derivative);
+      result += value;
+      derivative_result += derivative;
+      t += Δt;
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result << derivative_result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
 void BM_NewhallApproximation(benchmark::State& state) {
   int const degree = state.range_x();
   std::mt19937_64 random(42);
@@ -251,6 +329,10 @@ BENCHMARK(BM_EvaluateVectorDouble)->
     Arg(4)->Arg(8)->Arg(15)->Arg(16)->Arg(17)->Arg(18)->Arg(19);
 BENCHMARK(BM_EvaluateDisplacement)->
     Arg(4)->Arg(8)->Arg(15)->Arg(16)->Arg(17)->Arg(18)->Arg(19);
+BENCHMARK(BM_EvaluateDisplacementAndVelocity)->
+    Arg(3)->Arg(4)->Arg(8)->Arg(12)->Arg(15)->Arg(16)->Arg(17)->Arg(18);
+BENCHMARK(BM_EvaluateDisplacementWithVelocity)->
+    Arg(3)->Arg(4)->Arg(8)->Arg(12)->Arg(15)->Arg(16)->Arg(17)->Arg(18);
 BENCHMARK(BM_NewhallApproximation)->
     Arg(4)->Arg(8)->Arg(16);
 
@@ -15,6 +15,7 @@
 #include "base/not_null.hpp"
 #include "base/status.hpp"
 #include "numerics/fixed_arrays.hpp"
+#include "numerics/hermite5.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "quantities/named_quantities.hpp"
 #include "serialization/integrators.pb.h"
@@ -28,6 +29,7 @@ using base::Status;
 using geometry::Instant;
 using numerics::FixedStrictlyLowerTriangularMatrix;
 using numerics::FixedVector;
+using numerics::Hermite5;
 using quantities::Time;
 using quantities::Variation;
 
@@ -93,14 +95,65 @@ class EmbeddedExplicitRungeKuttaNyströmIntegrator
     void WriteToMessage(
         not_null<serialization::IntegratorInstance*> message) const override;
 
-   private:
+   protected:
     Instance(IntegrationProblem<ODE> const& problem,
              AppendState const& append_state,
              ToleranceToErrorRatio const& tolerance_to_error_ratio,
              Parameters const& adaptive_step_size,
              EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator);
 
+    // Same as |Solve| above, but the right-hand side is |compute_acceleration|
+    // rather than |equation_.compute_acceleration|.  When |RightHandSide| is
+    // not a |std::function| its calls may be inlined in the integration loop.
+    template<typename RightHandSide>
+    Status Solve(Instant const& t_final,
+                 RightHandSide const& compute_acceleration);
+
+   private:
     EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator_;
+
+    // Working storage for |Solve|, kept across calls to avoid reallocating it
+    // at every call.  The contents are meaningless between calls.
+    std::vector<typename ODE::Displacement> Δq_hat_;
+    std::vector<typename ODE::Velocity> Δv_hat_;
+    typename ODE::SystemStateError error_estimate_;
+    std::vector<Position> q_stage_;
+    // The accelerations at each stage, in a single buffer indexed by
+    // |k * stages + i| for dimension |k| and stage |i|, so that the sums over
+    // the stages read contiguous memory.
+    std::vector<typename ODE::Acceleration> g_;
+    // The accelerations computed by the right-hand side for the current
+    // stage, which are then copied to |g_|.
+    std::vector<typename ODE::Acceleration> g_stage_;
+    std::vector<Hermite5<Instant, Position>> interpolants_;
+
+    friend class EmbeddedExplicitRungeKuttaNyströmIntegrator;
+  };
+
+  // An instance whose right-hand side is a functor of type |RightHandSide|,
+  // known at compile time.  It is serialized like an |Instance|: the
+  // right-hand side is not part of the serialized state, so it is deserialized
+  // with the type-erased right-hand side given to |ReadFromMessage|.
+  template<typename RightHandSide>
+  class SpecializedInstance final : public Instance {
+   public:
+    Status Solve(Instant const& t_final) override;
+    not_null<std::unique_ptr<typename Integrator<ODE>::Instance>> Clone()
+        const override;
+
+   private:
+    SpecializedInstance(
+        typename ODE::SystemState const& initial_state,
+        RightHandSide const& compute_acceleration,
+        AppendState const& append_state,
+        ToleranceToErrorRatio const& tolerance_to_error_ratio,
+        Parameters const& adaptive_step_size,
+        typename AdaptiveStepSizeIntegrator<ODE>::DenseOutput const&
+            dense_output,
+        EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator);
+
+    RightHandSide const compute_acceleration_;
+
     friend class EmbeddedExplicitRungeKuttaNyströmIntegrator;
   };
 
@@ -110,6 +163,19 @@ class EmbeddedExplicitRungeKuttaNyströmIntegrator
       ToleranceToErrorRatio const& tolerance_to_error_ratio,
       Parameters const& parameters) const override;
 
+  // The factory function for |SpecializedInstance|.  |dense_output| may be
+  // empty.
+  template<typename RightHandSide>
+  not_null<std::unique_ptr<typename Integrator<ODE>::Instance>>
+  NewSpecializedInstance(
+      typename ODE::SystemState const& initial_state,
+      RightHandSide const& compute_acceleration,
+      AppendState const& append_state,
+      ToleranceToErrorRatio const& tolerance_to_error_ratio,
+      Parameters const& parameters,
+      typename AdaptiveStepSizeIntegrator<ODE>::DenseOutput const&
+          dense_output) const;
+
  private:
   not_null<std::unique_ptr<typename Integrator<ODE>::Instance>>
   ReadFromMessage(
@@ -138,10 +204,27 @@ EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
                                             /*first_same_as_last=*/true> const&
 DormandElMikkawyPrince1986RKN434FM();
 
+// The high-order method is the RKN6(4)6FM from Dormand, El-Mikkawy and Prince
+// (1986), Families of Runge-Kutta-Nyström formulae.  It costs 5 evaluations
+// per step instead of 3 for the RK4(3)4FM, but at the tolerances used for
+// predictions and flight plans its steps are much longer.  The embedded
+// 4th-order method is the one of the family compatible with these nodes for
+// which the velocity weight of the fifth stage vanishes and bᵢ = b′ᵢ(1 - cᵢ),
+// the latter relation being also satisfied by the high-order method.
+template<typename Position>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
+                                            /*higher_order=*/6,
+                                            /*lower_order=*/4,
+                                            /*stages=*/6,
+                                            /*first_same_as_last=*/true> const&
+DormandElMikkawyPrince1986RKN646FM();
+
 }  // namespace internal_embedded_explicit_runge_kutta_nyström_integrator
 
 using internal_embedded_explicit_runge_kutta_nyström_integrator::
     DormandElMikkawyPrince1986RKN434FM;
+using internal_embedded_explicit_runge_kutta_nyström_integrator::
+    DormandElMikkawyPrince1986RKN646FM;
 using internal_embedded_explicit_runge_kutta_nyström_integrator::
     EmbeddedExplicitRungeKuttaNyströmIntegrator;
 
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <ctime>
 #include <experimental/optional>
+#include <utility>
 #include <vector>
 
 #include "geometry/sign.hpp"
@@ -49,6 +50,40 @@ DormandElMikkawyPrince1986RKN434FM() {
   return integrator;
 }
 
+template<typename Position>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Position, 6, 4, 6, true> const&
+DormandElMikkawyPrince1986RKN646FM() {
+  static EmbeddedExplicitRungeKuttaNyströmIntegrator<
+             Position, 6, 4, 6, true> const integrator(
+      serialization::AdaptiveStepSizeIntegrator::
+          DORMAND_ELMIKKAWY_PRINCE_1986_RKN_646FM,
+      // c
+      {     0.0            ,      1.0 /     10.0,      3.0 /     10.0,
+            7.0 /     10.0,     17.0 /     25.0,      1.0},
+      // a
+      {
+            1.0 /    200.0,
+           -1.0 /   2200.0,      1.0 /     22.0,
+          637.0 /   6600.0,     -7.0 /    110.0,      7.0 /     33.0,
+       225437.0 / 1968750.0, -30073.0 / 281250.0,  65569.0 / 281250.0,
+        -9367.0 /  984375.0,
+          151.0 /   2142.0,      5.0 /    116.0,    385.0 /   1368.0,
+           55.0 /    168.0,  -6250.0 /  28101.0},
+      // b̂
+      {   151.0 /   2142.0,      5.0 /    116.0,    385.0 /   1368.0,
+           55.0 /    168.0,  -6250.0 /  28101.0,      0.0},
+      // b̂′
+      {   151.0 /   2142.0,     25.0 /    522.0,    275.0 /    684.0,
+          275.0 /    252.0, -78125.0 / 112404.0,      1.0 /     12.0},
+      // b
+      {   -19.0 /    252.0,      5.0 /     16.0,     35.0 /    288.0,
+           95.0 /    672.0,      0.0,                 0.0},
+      // b′
+      {   -19.0 /    252.0,     25.0 /     72.0,     25.0 /    144.0,
+          475.0 /   1008.0,      0.0,                 1.0 /     12.0});
+  return integrator;
+}
+
 template<typename Position, int higher_order, int lower_order, int stages,
          bool first_same_as_last>
 EmbeddedExplicitRungeKuttaNyströmIntegrator<Position, higher_order, lower_order,
@@ -91,6 +126,19 @@ Status EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
                                                    stages,
                                                    first_same_as_last>::
 Instance::Solve(Instant const& t_final) {
+  return Solve(t_final, this->equation_.compute_acceleration);
+}
+
+template<typename Position, int higher_order, int lower_order, int stages,
+         bool first_same_as_last>
+template<typename RightHandSide>
+Status EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
+                                                   higher_order,
+                                                   lower_order,
+                                                   stages,
+                                                   first_same_as_last>::
+Instance::Solve(Instant const& t_final,
+                RightHandSide const& compute_acceleration) {
   using Displacement = typename ODE::Displacement;
   using Velocity = typename ODE::Velocity;
   using Acceleration = typename ODE::Acceleration;
@@ -106,7 +154,7 @@ Instance::Solve(Instant const& t_final) {
   auto& current_state = this->current_state_;
   auto& first_use = this->first_use_;
   auto& parameters = this->parameters_;
-  auto const& equation = this->equation_;
+  auto const& dense_output = this->dense_output_;
 
   // |current_state| gets updated as the integration progresses to allow
   // restartability.
@@ -126,6 +174,10 @@ Instance::Solve(Instant const& t_final) {
   }
   CHECK(first_use || !parameters.last_step_is_exact)
       << "Cannot reuse an instance where the last step is exact";
+  // Without the FSAL property we would need an extra evaluation per step to
+  // get the accelerations at the end of the step.
+  CHECK(!dense_output || first_same_as_last)
+      << "Dense output requires the first-same-as-last property";
   first_use = false;
 
   // Time step.  Updated as the integration progresses to allow restartability.
@@ -134,10 +186,16 @@ Instance::Solve(Instant const& t_final) {
   // equations more readable.
   DoublePrecision<Instant>& t = current_state.time;
 
+  // The working storage below is held by the instance so that the integration
+  // does not allocate once the dimension is known; |resize| is a no-op when
+  // the dimension doesn't change between calls to |Solve|.
+
   // Position increment (high-order).
-  std::vector<Displacement> Δq_hat(dimension);
+  std::vector<Displacement>& Δq_hat = Δq_hat_;
+  Δq_hat.resize(dimension);
   // Velocity increment (high-order).
-  std::vector<Velocity> Δv_hat(dimension);
+  std::vector<Velocity>& Δv_hat = Δv_hat_;
+  Δv_hat.resize(dimension);
   // Current position.  This is a non-const reference whose purpose is to make
   // the equations more readable.
   std::vector<DoublePrecision<Position>>& q_hat = current_state.positions;
@@ -146,17 +204,25 @@ Instance::Solve(Instant const& t_final) {
   std::vector<DoublePrecision<Velocity>>& v_hat = current_state.velocities;
 
   // Difference between the low- and high-order approximations.
-  typename ODE::SystemStateError error_estimate;
+  typename ODE::SystemStateError& error_estimate = error_estimate_;
   error_estimate.position_error.resize(dimension);
   error_estimate.velocity_error.resize(dimension);
 
   // Current Runge-Kutta-Nyström stage.
-  std::vector<Position> q_stage(dimension);
-  // Accelerations at each stage.
-  // TODO(egg): this is a rectangular container, use something more appropriate.
-  std::vector<std::vector<Acceleration>> g(stages);
-  for (auto& g_stage : g) {
-    g_stage.resize(dimension);
+  std::vector<Position>& q_stage = q_stage_;
+  q_stage.resize(dimension);
+  // Accelerations at each stage, |g[k * stages + i]| being the acceleration
+  // for dimension |k| at stage |i|.
+  std::vector<Acceleration>& g = g_;
+  g.resize(dimension * stages);
+  // Accelerations at the current stage, as computed by the right-hand side.
+  std::vector<Acceleration>& g_stage = g_stage_;
+  g_stage.resize(dimension);
+
+  // The interpolants passed to |dense_output|.
+  std::vector<Hermite5<Instant, Position>>& interpolants = interpolants_;
+  if (dense_output) {
+    interpolants.reserve(dimension);
   }
 
   bool at_end = false;
@@ -213,18 +279,23 @@ Instance::Solve(Instant const& t_final) {
       for (int i = first_stage; i < stages; ++i) {
         Instant const t_stage = t.value + c[i] * h;
         for (int k = 0; k < dimension; ++k) {
+          Acceleration const* const g_k = &g[k * stages];
           Acceleration Σj_a_ij_g_jk{};
           for (int j = 0; j < i; ++j) {
-            Σj_a_ij_g_jk += a[i][j] * g[j][k];
+            Σj_a_ij_g_jk += a[i][j] * g_k[j];
           }
           q_stage[k] = q_hat[k].value +
                            h * (c[i] * v_hat[k].value + h * Σj_a_ij_g_jk);
         }
-        equation.compute_acceleration(t_stage, q_stage, g[i]);
+        compute_acceleration(t_stage, q_stage, g_stage);
+        for (int k = 0; k < dimension; ++k) {
+          g[k * stages + i] = g_stage[k];
+        }
       }
 
       // Increment computation and step size control.
       for (int k = 0; k < dimension; ++k) {
+        Acceleration const* const g_k = &g[k * stages];
         Acceleration Σi_b_hat_i_g_ik{};
         Acceleration Σi_b_i_g_ik{};
         Acceleration Σi_b_prime_hat_i_g_ik{};
@@ -232,10 +303,10 @@ Instance::Solve(Instant const& t_final) {
         // Please keep the eight assigments below aligned, they become illegible
         // otherwise.
         for (int i = 0; i < stages; ++i) {
-          Σi_b_hat_i_g_ik       += b_hat[i] * g[i][k];
-          Σi_b_i_g_ik           += b[i] * g[i][k];
-          Σi_b_prime_hat_i_g_ik += b_prime_hat[i] * g[i][k];
-          Σi_b_prime_i_g_ik     += b_prime[i] * g[i][k];
+          Σi_b_hat_i_g_ik       += b_hat[i] * g_k[i];
+          Σi_b_i_g_ik           += b[i] * g_k[i];
+          Σi_b_prime_hat_i_g_ik += b_prime_hat[i] * g_k[i];
+          Σi_b_prime_i_g_ik     += b_prime[i] * g_k[i];
         }
         // The hat-less Δq and Δv are the low-order increments.
         Δq_hat[k]               = h * (h * (Σi_b_hat_i_g_ik) + v_hat[k].value);
@@ -256,9 +327,24 @@ Instance::Solve(Instant const& t_final) {
       break;
     }
 
+    if (dense_output) {
+      // Because of the FSAL property, the last stage holds the accelerations
+      // at the end of the step.
+      interpolants.clear();
+      Instant const t_next = t.value + (t.error + h);
+      for (int k = 0; k < dimension; ++k) {
+        interpolants.emplace_back(
+            std::make_pair(t.value, t_next),
+            std::make_pair(q_hat[k].value, q_hat[k].value + Δq_hat[k]),
+            std::make_pair(v_hat[k].value, v_hat[k].value + Δv_hat[k]),
+            std::make_pair(g[k * stages], g[k * stages + stages - 1]));
+      }
+    }
+
     if (first_same_as_last) {
-      using std::swap;
-      swap(g.front(), g.back());
+      for (int k = 0; k < dimension; ++k) {
+        g[k * stages] = g[k * stages + stages - 1];
+      }
       first_stage = 1;
     }
 
@@ -269,6 +355,9 @@ Instance::Solve(Instant const& t_final) {
       v_hat[k].Increment(Δv_hat[k]);
     }
     append_state(current_state);
+    if (dense_output) {
+      dense_output(interpolants);
+    }
     ++step_count;
     if (step_count == parameters.max_steps && !at_end) {
       return Status(termination_condition::ReachedMaximalStepCount,
@@ -351,6 +440,58 @@ Instance::Instance(
           problem, append_state, tolerance_to_error_ratio, parameters),
       integrator_(integrator) {}
 
+template<typename Position, int higher_order, int lower_order, int stages,
+         bool first_same_as_last>
+template<typename RightHandSide>
+Status EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
+                                                   higher_order,
+                                                   lower_order,
+                                                   stages,
+                                                   first_same_as_last>::
+SpecializedInstance<RightHandSide>::Solve(Instant const& t_final) {
+  return Instance::Solve(t_final, compute_acceleration_);
+}
+
+template<typename Position, int higher_order, int lower_order, int stages,
+         bool first_same_as_last>
+template<typename RightHandSide>
+not_null<std::unique_ptr<typename Integrator<
+    SpecialSecondOrderDifferentialEquation<Position>>::Instance>>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
+                                            higher_order,
+                                            lower_order,
+                                            stages,
+                                            first_same_as_last>::
+SpecializedInstance<RightHandSide>::Clone() const {
+  return std::unique_ptr<SpecializedInstance>(new SpecializedInstance(*this));
+}
+
+template<typename Position, int higher_order, int lower_order, int stages,
+         bool first_same_as_last>
+template<typename RightHandSide>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
+                                            higher_order,
+                                            lower_order,
+                                            stages,
+                                            first_same_as_last>::
+SpecializedInstance<RightHandSide>::SpecializedInstance(
+    typename ODE::SystemState const& initial_state,
+    RightHandSide const& compute_acceleration,
+    AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters,
+    typename AdaptiveStepSizeIntegrator<ODE>::DenseOutput const& dense_output,
+    EmbeddedExplicitRungeKuttaNyströmIntegrator const& integrator)
+    : Instance(IntegrationProblem<ODE>{ODE{compute_acceleration},
+                                       initial_state},
+               append_state,
+               tolerance_to_error_ratio,
+               parameters,
+               integrator),
+      compute_acceleration_(compute_acceleration) {
+  this->dense_output_ = dense_output;
+}
+
 template<typename Position, int higher_order, int lower_order, int stages,
          bool first_same_as_last>
 not_null<std::unique_ptr<typename Integrator<
@@ -373,6 +514,36 @@ NewInstance(IntegrationProblem<ODE> const& problem,
                                                 *this));
 }
 
+template<typename Position, int higher_order, int lower_order, int stages,
+         bool first_same_as_last>
+template<typename RightHandSide>
+not_null<std::unique_ptr<typename Integrator<
+    SpecialSecondOrderDifferentialEquation<Position>>::Instance>>
+EmbeddedExplicitRungeKuttaNyströmIntegrator<Position,
+                                            higher_order,
+                                            lower_order,
+                                            stages,
+                                            first_same_as_last>::
+NewSpecializedInstance(
+    typename ODE::SystemState const& initial_state,
+    RightHandSide const& compute_acceleration,
+    AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters,
+    typename AdaptiveStepSizeIntegrator<ODE>::DenseOutput const&
+        dense_output) const {
+  // Cannot use |make_not_null_unique| because the constructor of
+  // |SpecializedInstance| is private.
+  return std::unique_ptr<SpecializedInstance<RightHandSide>>(
+      new SpecializedInstance<RightHandSide>(initial_state,
+                                             compute_acceleration,
+                                             append_state,
+                                             tolerance_to_error_ratio,
+                                             parameters,
+                                             dense_output,
+                                             *this));
+}
+
 template<typename Position, int higher_order, int lower_order, int stages,
          bool first_same_as_last>
 not_null<std::unique_ptr<typename Integrator<
@@ -29,10 +29,13 @@ using quantities::Time;
 using quantities::si::Centi;
 using quantities::si::Kilogram;
 using quantities::si::Metre;
+using quantities::si::Micro;
 using quantities::si::Milli;
+using quantities::si::Nano;
 using quantities::si::Newton;
 using quantities::si::Radian;
 using quantities::si::Second;
+using numerics::Hermite5;
 using testing_utilities::AbsoluteError;
 using testing_utilities::AlmostEquals;
 using testing_utilities::ComputeHarmonicOscillatorAcceleration;
@@ -172,6 +175,71 @@ TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest,
   EXPECT_EQ(11, subsequent_rejections);
 }
 
+// At a tight tolerance the high-order method needs far fewer evaluations to
+// reach the same accuracy.
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, HighOrder) {
+  Length const x_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  Time const period = 2 * π * Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 10 * period;
+  Length const length_tolerance = 1 * Nano(Metre);
+  Speed const speed_tolerance = 1 * Nano(Metre) / Second;
+
+  ODE harmonic_oscillator;
+  IntegrationProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {{x_initial}, {v_initial}, t_initial};
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final - t_initial,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2,
+                length_tolerance,
+                speed_tolerance,
+                /*callback=*/[](bool tolerable) {});
+
+  auto const solve = [&](AdaptiveStepSizeIntegrator<ODE> const& integrator,
+                         int& evaluations,
+                         ODE::SystemState& final_state) {
+    evaluations = 0;
+    problem.equation.compute_acceleration =
+        std::bind(ComputeHarmonicOscillatorAcceleration,
+                  _1, _2, _3, &evaluations);
+    auto const instance = integrator.NewInstance(
+        problem,
+        /*append_state=*/[&final_state](ODE::SystemState const& state) {
+          final_state = state;
+        },
+        tolerance_to_error_ratio,
+        parameters);
+    EXPECT_EQ(termination_condition::Done, instance->Solve(t_final).error());
+    EXPECT_EQ(t_final, final_state.time.value);
+  };
+
+  int evaluations_434;
+  ODE::SystemState final_state_434;
+  solve(DormandElMikkawyPrince1986RKN434FM<Length>(),
+        evaluations_434,
+        final_state_434);
+  int evaluations_646;
+  ODE::SystemState final_state_646;
+  solve(DormandElMikkawyPrince1986RKN646FM<Length>(),
+        evaluations_646,
+        final_state_646);
+  EXPECT_EQ(12347, evaluations_434);
+  EXPECT_EQ(4517, evaluations_646);
+  EXPECT_THAT(AbsoluteError(x_initial, final_state_434.positions[0].value),
+              AllOf(Ge(9e-12 * Metre), Le(1e-11 * Metre)));
+  EXPECT_THAT(AbsoluteError(x_initial, final_state_646.positions[0].value),
+              AllOf(Ge(4e-13 * Metre), Le(5e-13 * Metre)));
+  EXPECT_THAT(AbsoluteError(v_initial, final_state_434.velocities[0].value),
+              AllOf(Ge(2e-9 * Metre / Second), Le(3e-9 * Metre / Second)));
+  EXPECT_THAT(AbsoluteError(v_initial, final_state_646.velocities[0].value),
+              AllOf(Ge(6e-12 * Metre / Second), Le(7e-12 * Metre / Second)));
+}
+
 TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, MaxSteps) {
   AdaptiveStepSizeIntegrator<ODE> const& integrator =
       DormandElMikkawyPrince1986RKN434FM<Length>();
@@ -256,6 +324,170 @@ TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, MaxSteps) {
   }
 }
 
+// The dense output approximates the solution within the steps as well as the
+// integrator does at the bounds of the steps.
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, DenseOutput) {
+  AdaptiveStepSizeIntegrator<ODE> const& integrator =
+      DormandElMikkawyPrince1986RKN646FM<Length>();
+  Length const x_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  AngularFrequency const ω = 1 * Radian / Second;
+  Time const period = 2 * π * Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 10 * period;
+  Length const length_tolerance = 1 * Micro(Metre);
+  Speed const speed_tolerance = 1 * Micro(Metre) / Second;
+
+  std::vector<ODE::SystemState> solution;
+  std::vector<Hermite5<Instant, Length>> interpolants;
+  ODE harmonic_oscillator;
+  harmonic_oscillator.compute_acceleration =
+      std::bind(ComputeHarmonicOscillatorAcceleration,
+                _1, _2, _3, /*evaluations=*/nullptr);
+  IntegrationProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {{x_initial}, {v_initial}, t_initial};
+  auto const append_state = [&solution](ODE::SystemState const& state) {
+    solution.push_back(state);
+  };
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final - t_initial,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2,
+                length_tolerance,
+                speed_tolerance,
+                /*callback=*/[](bool tolerable) {});
+
+  auto const dense_output =
+      [&interpolants](
+          std::vector<Hermite5<Instant, Length>> const& step_interpolants) {
+        EXPECT_EQ(1, step_interpolants.size());
+        interpolants.push_back(step_interpolants[0]);
+      };
+  auto const instance = integrator.NewInstance(problem,
+                                               append_state,
+                                               tolerance_to_error_ratio,
+                                               parameters,
+                                               dense_output);
+  EXPECT_EQ(termination_condition::Done, instance->Solve(t_final).error());
+
+  // One interpolant per step, joining the successive states.
+  ASSERT_EQ(solution.size(), interpolants.size());
+  Instant lower_bound = t_initial;
+  Length max_state_error;
+  Length max_interpolation_error;
+  for (int i = 0; i < interpolants.size(); ++i) {
+    auto const& interpolant = interpolants[i];
+    EXPECT_EQ(lower_bound, interpolant.lower_bound());
+    EXPECT_EQ(solution[i].time.value, interpolant.upper_bound());
+    EXPECT_THAT(AbsoluteError(solution[i].positions[0].value,
+                              interpolant.Evaluate(interpolant.upper_bound())),
+                Le(1e-15 * Metre));
+    EXPECT_THAT(
+        AbsoluteError(solution[i].velocities[0].value,
+                      interpolant.EvaluateDerivative(interpolant.upper_bound())),
+        Le(1e-15 * Metre / Second));
+    max_state_error = std::max(
+        max_state_error,
+        AbsoluteError(x_initial * Cos(ω * (solution[i].time.value - t_initial)),
+                      solution[i].positions[0].value));
+    Instant const midpoint =
+        lower_bound + (interpolant.upper_bound() - lower_bound) / 2;
+    max_interpolation_error = std::max(
+        max_interpolation_error,
+        AbsoluteError(x_initial * Cos(ω * (midpoint - t_initial)),
+                      interpolant.Evaluate(midpoint)));
+    lower_bound = interpolant.upper_bound();
+  }
+  EXPECT_EQ(228, interpolants.size());
+  EXPECT_THAT(max_state_error, AllOf(Ge(2e-8 * Metre), Le(3e-8 * Metre)));
+  EXPECT_THAT(max_interpolation_error,
+              AllOf(Ge(3e-8 * Metre), Le(4e-8 * Metre)));
+}
+
+TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, SpecializedInstance) {
+  AdaptiveStepSizeIntegrator<ODE> const& integrator =
+      DormandElMikkawyPrince1986RKN434FM<Length>();
+  Length const x_initial = 1 * Metre;
+  Speed const v_initial = 0 * Metre / Second;
+  Time const period = 2 * π * Second;
+  Instant const t_initial;
+  Instant const t_final = t_initial + 10 * period;
+  Length const length_tolerance = 1 * Milli(Metre);
+  Speed const speed_tolerance = 1 * Milli(Metre) / Second;
+
+  std::vector<ODE::SystemState> type_erased_solution;
+  std::vector<ODE::SystemState> specialized_solution;
+  ODE harmonic_oscillator;
+  harmonic_oscillator.compute_acceleration =
+      std::bind(ComputeHarmonicOscillatorAcceleration,
+                _1, _2, _3, /*evaluations=*/nullptr);
+  IntegrationProblem<ODE> problem;
+  problem.equation = harmonic_oscillator;
+  problem.initial_state = {{x_initial}, {v_initial}, t_initial};
+  AdaptiveStepSizeIntegrator<ODE>::Parameters const parameters(
+      /*first_time_step=*/t_final - t_initial,
+      /*safety_factor=*/0.9);
+  auto const tolerance_to_error_ratio =
+      std::bind(HarmonicOscillatorToleranceRatio,
+                _1, _2,
+                length_tolerance,
+                speed_tolerance,
+                /*callback=*/[](bool tolerable) {});
+
+  auto const type_erased_instance = integrator.NewInstance(
+      problem,
+      /*append_state=*/[&type_erased_solution](ODE::SystemState const& state) {
+        type_erased_solution.push_back(state);
+      },
+      tolerance_to_error_ratio,
+      parameters);
+  EXPECT_EQ(termination_condition::Done,
+            type_erased_instance->Solve(t_final).error());
+
+  auto const compute_acceleration =
+      [](Instant const& t,
+         std::vector<Length> const& q,
+         std::vector<Acceleration>& result) {
+        ComputeHarmonicOscillatorAcceleration(t, q, result,
+                                              /*evaluations=*/nullptr);
+      };
+  auto const specialized_instance = integrator.NewSpecializedInstance(
+      problem.initial_state,
+      compute_acceleration,
+      /*append_state=*/[&specialized_solution](ODE::SystemState const& state) {
+        specialized_solution.push_back(state);
+      },
+      tolerance_to_error_ratio,
+      parameters,
+      /*dense_output=*/nullptr);
+  auto const cloned_instance = specialized_instance->Clone();
+  EXPECT_EQ(termination_condition::Done,
+            specialized_instance->Solve(t_final).error());
+
+  // The specialized instance computes exactly the same solution as the
+  // type-erased one.
+  EXPECT_EQ(type_erased_solution, specialized_solution);
+  EXPECT_EQ(type_erased_instance->state(), specialized_instance->state());
+
+  // So does its clone, which shares its |append_state|.
+  specialized_solution.clear();
+  EXPECT_EQ(termination_condition::Done,
+            cloned_instance->Solve(t_final).error());
+  EXPECT_EQ(type_erased_solution, specialized_solution);
+  EXPECT_EQ(type_erased_instance->state(), cloned_instance->state());
+
+  // And it is serialized identically.
+  serialization::IntegratorInstance type_erased_message;
+  serialization::IntegratorInstance specialized_message;
+  type_erased_instance->WriteToMessage(&type_erased_message);
+  specialized_instance->WriteToMessage(&specialized_message);
+  EXPECT_EQ(type_erased_message.SerializeAsString(),
+            specialized_message.SerializeAsString());
+}
+
 TEST_F(EmbeddedExplicitRungeKuttaNyströmIntegratorTest, Singularity) {
   // Integrating the position of an ideal rocket,
   //   x"(t) = m' I_sp / m(t),
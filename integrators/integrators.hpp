@@ -3,12 +3,14 @@
 
 #include <experimental/optional>
 #include <functional>
+#include <vector>
 
 #include "base/not_null.hpp"
 #include "base/status.hpp"
 #include "geometry/named_quantities.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "numerics/double_precision.hpp"
+#include "numerics/hermite5.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/integrators.pb.h"
 
@@ -21,6 +23,7 @@ using base::not_null;
 using base::Status;
 using geometry::Instant;
 using numerics::DoublePrecision;
+using numerics::Hermite5;
 using quantities::Time;
 
 // A base class for integrators.
@@ -150,6 +153,14 @@ class AdaptiveStepSizeIntegrator : public Integrator<ODE_> {
           double(Time const& current_step_size,
                   typename ODE::SystemStateError const& error)>;
 
+  // This functor is called after each accepted step with an interpolant of each
+  // of the positions of the system over that step, which approximates the
+  // solution at all the instants of the step, not just at its bounds.
+  using DenseOutput =
+      std::function<void(std::vector<Hermite5<Instant,
+                                              typename ODE::Position>> const&
+                             interpolants)>;
+
   struct Parameters final {
     Parameters(Time first_time_step,
                double safety_factor,
@@ -206,6 +217,10 @@ class AdaptiveStepSizeIntegrator : public Integrator<ODE_> {
     Parameters const parameters_;
     Time time_step_;
     bool first_use_ = true;
+    // May be empty.  Not serialized.
+    DenseOutput dense_output_;
+
+    friend class AdaptiveStepSizeIntegrator;
   };
 
   // The factory function for |Instance|, above.  It ensures that the instance
@@ -216,6 +231,30 @@ class AdaptiveStepSizeIntegrator : public Integrator<ODE_> {
               ToleranceToErrorRatio const& tolerance_to_error_ratio,
               Parameters const& parameters) const = 0;
 
+  // Same as above, but |dense_output| is called after each accepted step.  The
+  // integrator must have the first-same-as-last property.
+  not_null<std::unique_ptr<typename Integrator<ODE>::Instance>>
+  NewInstance(IntegrationProblem<ODE> const& problem,
+              typename Integrator<ODE>::AppendState const& append_state,
+              ToleranceToErrorRatio const& tolerance_to_error_ratio,
+              Parameters const& parameters,
+              DenseOutput const& dense_output) const;
+
+  // Same as above, but the right-hand side of the equation is the functor
+  // |compute_acceleration|, whose type is known at compile time, so that the
+  // integrator may inline it in its integration loop.  The resulting instance
+  // is serialized like one created with a type-erased right-hand side.
+  // |dense_output| may be empty.
+  template<typename RightHandSide>
+  not_null<std::unique_ptr<typename Integrator<ODE>::Instance>>
+  NewSpecializedInstance(
+      typename ODE::SystemState const& initial_state,
+      RightHandSide const& compute_acceleration,
+      typename Integrator<ODE>::AppendState const& append_state,
+      ToleranceToErrorRatio const& tolerance_to_error_ratio,
+      Parameters const& parameters,
+      DenseOutput const& dense_output) const;
+
   void WriteToMessage(
       not_null<serialization::AdaptiveStepSizeIntegrator*> message) const;
   static AdaptiveStepSizeIntegrator const& ReadFromMessage(
@@ -249,6 +249,64 @@ AdaptiveStepSizeIntegrator<ODE_>::Instance::Instance(
   CHECK_LT(parameters.safety_factor, 1);
 }
 
+template<typename ODE_>
+not_null<std::unique_ptr<typename Integrator<ODE_>::Instance>>
+AdaptiveStepSizeIntegrator<ODE_>::NewInstance(
+    IntegrationProblem<ODE> const& problem,
+    typename Integrator<ODE>::AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters,
+    DenseOutput const& dense_output) const {
+  auto instance = NewInstance(problem,
+                              append_state,
+                              tolerance_to_error_ratio,
+                              parameters);
+  // The instances of adaptive step size integrators are always derived from
+  // |Instance|.
+  static_cast<Instance&>(*instance).dense_output_ = dense_output;
+  return instance;
+}
+
+template<typename ODE_>
+template<typename RightHandSide>
+not_null<std::unique_ptr<typename Integrator<ODE_>::Instance>>
+AdaptiveStepSizeIntegrator<ODE_>::NewSpecializedInstance(
+    typename ODE::SystemState const& initial_state,
+    RightHandSide const& compute_acceleration,
+    typename Integrator<ODE>::AppendState const& append_state,
+    ToleranceToErrorRatio const& tolerance_to_error_ratio,
+    Parameters const& parameters,
+    DenseOutput const& dense_output) const {
+  // The integrators are singletons, so their kind determines their type.
+  using ASSI = serialization::AdaptiveStepSizeIntegrator;
+  switch (kind_) {
+    case ASSI::DORMAND_ELMIKKAWY_PRINCE_1986_RKN_434FM:
+      return DormandElMikkawyPrince1986RKN434FM<typename ODE::Position>()
+          .NewSpecializedInstance(initial_state,
+                                  compute_acceleration,
+                                  append_state,
+                                  tolerance_to_error_ratio,
+                                  parameters,
+                                  dense_output);
+    case ASSI::DORMAND_ELMIKKAWY_PRINCE_1986_RKN_646FM:
+      return DormandElMikkawyPrince1986RKN646FM<typename ODE::Position>()
+          .NewSpecializedInstance(initial_state,
+                                  compute_acceleration,
+                                  append_state,
+                                  tolerance_to_error_ratio,
+                                  parameters,
+                                  dense_output);
+    default:
+      // An integrator without specialized instances: fall back to the
+      // type-erased right-hand side.
+      return NewInstance({ODE{compute_acceleration}, initial_state},
+                         append_state,
+                         tolerance_to_error_ratio,
+                         parameters,
+                         dense_output);
+  }
+}
+
 template<typename ODE_>
 void AdaptiveStepSizeIntegrator<ODE_>::WriteToMessage(
     not_null<serialization::AdaptiveStepSizeIntegrator*> const message) const {
@@ -263,6 +321,8 @@ AdaptiveStepSizeIntegrator<ODE_>::ReadFromMessage(
   switch (message.kind()) {
     case ASSI::DORMAND_ELMIKKAWY_PRINCE_1986_RKN_434FM:
       return DormandElMikkawyPrince1986RKN434FM<typename ODE::Position>();
+    case ASSI::DORMAND_ELMIKKAWY_PRINCE_1986_RKN_646FM:
+      return DormandElMikkawyPrince1986RKN646FM<typename ODE::Position>();
     default:
       LOG(FATAL) << message.kind();
       base::noreturn();
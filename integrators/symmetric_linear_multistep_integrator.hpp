@@ -101,6 +101,13 @@ class SymmetricLinearMultistepIntegrator
     int startup_step_index_ = 0;
     std::list<Step> previous_steps_;  // At most |order_ - 1| elements.
     SymmetricLinearMultistepIntegrator const& integrator_;
+
+    // Working storage for |Solve|, kept across calls to avoid reallocating it
+    // at every call.  The contents are meaningless between calls.
+    std::vector<typename ODE::Position> positions_;
+    std::vector<DoublePrecision<typename ODE::Displacement>> Σj_minus_ɑj_qj_;
+    std::vector<typename ODE::Acceleration> Σj_βj_numerator_aj_;
+
     friend class SymmetricLinearMultistepIntegrator;
   };
 
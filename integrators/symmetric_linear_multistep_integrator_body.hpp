@@ -59,10 +59,15 @@ Status SymmetricLinearMultistepIntegrator<Position, order_>::Instance::Solve(
   // Order.
   int const k = order_;
 
-  std::vector<Position> positions(dimension);
-
-  DoubleDisplacements Σj_minus_ɑj_qj(dimension);
-  std::vector<Acceleration> Σj_βj_numerator_aj(dimension);
+  // The working storage below is held by the instance so that the integration
+  // does not allocate once the dimension is known.
+  std::vector<Position>& positions = positions_;
+  positions.resize(dimension);
+
+  DoubleDisplacements& Σj_minus_ɑj_qj = Σj_minus_ɑj_qj_;
+  Σj_minus_ɑj_qj.resize(dimension);
+  std::vector<Acceleration>& Σj_βj_numerator_aj = Σj_βj_numerator_aj_;
+  Σj_βj_numerator_aj.resize(dimension);
   while (h <= (t_final - t.value) - t.error) {
     // We take advantage of the symmetry to iterate on the list of previous
     // steps from both ends.
@@ -109,12 +114,15 @@ Status SymmetricLinearMultistepIntegrator<Position, order_>::Instance::Solve(
       }
     }
 
-    // Create a new step in the instance.
+    // Create a new step in the instance.  The oldest step is no longer needed,
+    // so we recycle its node and its vectors instead of allocating new ones.
     t.Increment(h);
-    previous_steps_.pop_front();
-    previous_steps_.emplace_back();
+    previous_steps_.splice(previous_steps_.end(),
+                           previous_steps_,
+                           previous_steps_.begin());
     Step& current_step = previous_steps_.back();
     current_step.time = t;
+    current_step.displacements.clear();
     current_step.accelerations.resize(dimension);
 
     // Fill the new step.  We skip the division by ɑk as it is equal to 1.0.
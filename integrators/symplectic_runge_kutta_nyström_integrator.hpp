@@ -105,6 +105,14 @@ class SymplecticRungeKuttaNyströmIntegrator
              SymplecticRungeKuttaNyströmIntegrator const& integrator);
 
     SymplecticRungeKuttaNyströmIntegrator const& integrator_;
+
+    // Working storage for |Solve|, kept across calls to avoid reallocating it
+    // at every call.  The contents are meaningless between calls.
+    std::vector<typename ODE::Displacement> Δq_;
+    std::vector<typename ODE::Velocity> Δv_;
+    std::vector<Position> q_stage_;
+    std::vector<typename ODE::Acceleration> g_;
+
     friend class SymplecticRungeKuttaNyströmIntegrator;
   };
 
@@ -59,10 +59,15 @@ Instance::Solve(Instant const& t_final) {
   // equations more readable.
   DoublePrecision<Instant>& t = current_state.time;
 
+  // The working storage below is held by the instance so that the integration
+  // does not allocate once the dimension is known.
+
   // Position increment.
-  std::vector<Displacement> Δq(dimension);
+  std::vector<Displacement>& Δq = Δq_;
+  Δq.resize(dimension);
   // Velocity increment.
-  std::vector<Velocity> Δv(dimension);
+  std::vector<Velocity>& Δv = Δv_;
+  Δv.resize(dimension);
   // Current position.  This is a non-const reference whose purpose is to make
   // the equations more readable.
   std::vector<DoublePrecision<Position>>& q = current_state.positions;
@@ -71,9 +76,11 @@ Instance::Solve(Instant const& t_final) {
   std::vector<DoublePrecision<Velocity>>& v = current_state.velocities;
 
   // Current Runge-Kutta-Nyström stage.
-  std::vector<Position> q_stage(dimension);
+  std::vector<Position>& q_stage = q_stage_;
+  q_stage.resize(dimension);
   // Accelerations at the current stage.
-  std::vector<Acceleration> g(dimension);
+  std::vector<Acceleration>& g = g_;
+  g.resize(dimension);
 
   // The first full stage of the step, i.e. the first stage where
   // exp(bᵢ h B) exp(aᵢ h A) must be entirely computed.
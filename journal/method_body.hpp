@@ -71,12 +71,14 @@ Method<Profile>::~Method() {
     serialization::Method method;
     auto* const extension =
         method.MutableExtension(Profile::Message::extension);
-    if (out_filler_ != nullptr) {
-      out_filler_(extension);
-    }
+    // The return value is filled first because the out filler may depend on
+    // it, e.g., to serialize only the elements of an array that were filled.
     if (return_filler_ != nullptr) {
       return_filler_(extension);
     }
+    if (out_filler_ != nullptr) {
+      out_filler_(extension);
+    }
     Recorder::active_recorder_->Write(method);
   }
 }
@@ -1,13 +1,18 @@
 ﻿
 #include "journal/player.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <utility>
 
 #include "base/array.hpp"
 #include "base/get_line.hpp"
 #include "base/hexadecimal.hpp"
 #include "journal/profiles.hpp"
+#include "journal/recorder.hpp"
 #include "glog/logging.h"
 
 namespace principia {
@@ -18,9 +23,34 @@ using base::UniqueBytes;
 
 namespace journal {
 
-Player::Player(std::experimental::filesystem::path const& path)
-    : stream_(path, std::ios::in) {
+namespace {
+
+// The number of messages parsed by a single task.
+constexpr int batch_size = 256;
+
+}  // namespace
+
+Player::Player(std::experimental::filesystem::path const& path,
+               int const decoding_threads)
+    : path_(path),
+      decoding_threads_(decoding_threads),
+      stream_(path, std::ios::in | std::ios::binary) {
   CHECK(!stream_.fail());
+  CHECK_LT(0, decoding_threads_);
+  char magic[Recorder::binary_magic_size];
+  stream_.read(magic, Recorder::binary_magic_size);
+  binary_ = stream_.gcount() == Recorder::binary_magic_size &&
+            std::memcmp(magic,
+                        Recorder::binary_magic,
+                        Recorder::binary_magic_size) == 0;
+  if (binary_) {
+    start_ = Recorder::binary_magic_size;
+  } else {
+    // Reopen in text mode to read the hexadecimal lines.
+    stream_.close();
+    stream_.open(path, std::ios::in);
+    CHECK(!stream_.fail());
+  }
 }
 
 bool Player::Play() {
@@ -37,7 +67,11 @@ bool Player::Play() {
 
   auto const before = std::chrono::system_clock::now();
 
-#include "journal/player.generated.cc"
+  auto const& runners = Runners();
+  auto const it = runners.find(Extension(*method_in));
+  CHECK(it != runners.end()) << method_in->DebugString() << "\n"
+                             << method_out_return->DebugString();
+  CHECK((this->*it->second)(*method_in, *method_out_return));
 
   auto const after = std::chrono::system_clock::now();
   if (after - before > std::chrono::milliseconds(100)) {
@@ -46,10 +80,40 @@ bool Player::Play() {
 
   last_method_in_.swap(method_in);
   last_method_out_return_.swap(method_out_return);
+  ++next_method_;
 
   return true;
 }
 
+std::int64_t Player::number_of_methods() {
+  BuildIndexIfNeeded();
+  return index_.size() / 2;
+}
+
+void Player::SeekToMethod(std::int64_t const index) {
+  BuildIndexIfNeeded();
+  CHECK_LE(next_method_, index)
+      << "Cannot seek backwards, the methods already replayed cannot be undone";
+  CHECK_LE(index, number_of_methods());
+  while (next_method_ < index) {
+    CHECK(Play()) << next_method_;
+  }
+}
+
+std::int64_t Player::SeekToTime(double const t) {
+  BuildIndexIfNeeded();
+  int const advance_time = serialization::AdvanceTime::extension.number();
+  std::int64_t index = next_method_;
+  for (; index < number_of_methods(); ++index) {
+    IndexEntry const& entry = index_[2 * index];
+    if (entry.extension == advance_time && entry.time >= t) {
+      break;
+    }
+  }
+  SeekToMethod(index);
+  return index;
+}
+
 serialization::Method const& Player::last_method_in() const {
   return *last_method_in_;
 }
@@ -59,23 +123,150 @@ serialization::Method const& Player::last_method_out_return() const {
 }
 
 std::unique_ptr<serialization::Method> Player::Read() {
-  std::string const line = GetLine(stream_);
-  if (line.empty()) {
-    return nullptr;
+  while (next_parsed_ == parsed_.size()) {
+    // Read batches of frames and start parsing them until there are enough
+    // batches in flight.
+    while (!end_of_stream_ && parsing_.size() < decoding_threads_) {
+      std::vector<std::string> frames(batch_size);
+      int size = 0;
+      while (size < batch_size && ReadFrame(stream_, frames[size])) {
+        ++size;
+      }
+      if (size < batch_size) {
+        end_of_stream_ = true;
+        frames.resize(size);
+      }
+      if (!frames.empty()) {
+        parsing_.push_back(std::async(
+            std::launch::async,
+            [frames = std::move(frames), binary = binary_]() {
+              Methods methods;
+              methods.reserve(frames.size());
+              for (auto const& frame : frames) {
+                methods.push_back(Decode(frame, binary));
+              }
+              return methods;
+            }));
+      }
+    }
+    if (parsing_.empty()) {
+      return nullptr;
+    }
+    parsed_ = parsing_.front().get();
+    parsing_.pop_front();
+    next_parsed_ = 0;
   }
+  return std::move(parsed_[next_parsed_++]);
+}
 
-  std::uint8_t const* const hexadecimal =
-      reinterpret_cast<std::uint8_t const*>(line.c_str());
-  int const hexadecimal_size = strlen(line.c_str());
-  UniqueBytes bytes(hexadecimal_size >> 1);
-  HexadecimalDecode({hexadecimal, hexadecimal_size},
-                    {bytes.data.get(), bytes.size});
-  auto method = std::make_unique<serialization::Method>();
-  CHECK(method->ParseFromArray(bytes.data.get(),
-                               static_cast<int>(bytes.size)));
+bool Player::ReadFrame(std::ifstream& stream, std::string& frame) const {
+  if (binary_) {
+    char size_bytes[Recorder::binary_size_size];
+    stream.read(size_bytes, Recorder::binary_size_size);
+    if (stream.gcount() == 0) {
+      return false;
+    }
+    CHECK_EQ(Recorder::binary_size_size, stream.gcount()) << "Truncated size";
+    std::int64_t size = 0;
+    for (int i = 0; i < Recorder::binary_size_size; ++i) {
+      size |= static_cast<std::int64_t>(
+                  static_cast<std::uint8_t>(size_bytes[i])) << (8 * i);
+    }
+    frame.resize(size);
+    stream.read(&frame[0], size);
+    CHECK_EQ(size, stream.gcount()) << "Truncated method";
+    return true;
+  } else {
+    frame = GetLine(stream);
+    return !frame.empty();
+  }
+}
 
+std::unique_ptr<serialization::Method> Player::Decode(std::string const& frame,
+                                                      bool const binary) {
+  auto method = std::make_unique<serialization::Method>();
+  if (binary) {
+    CHECK(method->ParseFromString(frame));
+  } else {
+    std::uint8_t const* const hexadecimal =
+        reinterpret_cast<std::uint8_t const*>(frame.c_str());
+    int const hexadecimal_size = strlen(frame.c_str());
+    UniqueBytes bytes(hexadecimal_size >> 1);
+    HexadecimalDecode({hexadecimal, hexadecimal_size},
+                      {bytes.data.get(), bytes.size});
+    CHECK(method->ParseFromArray(bytes.data.get(),
+                                 static_cast<int>(bytes.size)));
+  }
   return method;
 }
 
+int Player::DecodeExtension(std::string const& frame, bool const binary) {
+  // The message starts with the key of its only extension, a varint of at most
+  // 5 bytes.
+  constexpr int max_key_size = 5;
+  std::uint8_t key_bytes[max_key_size];
+  int key_size;
+  if (binary) {
+    key_size = std::min<int>(max_key_size, frame.size());
+    std::memcpy(key_bytes, frame.data(), key_size);
+  } else {
+    key_size = std::min<int>(max_key_size, frame.size() >> 1);
+    HexadecimalDecode(
+        {reinterpret_cast<std::uint8_t const*>(frame.data()), key_size << 1},
+        {key_bytes, key_size});
+  }
+  std::uint32_t key = 0;
+  for (int i = 0; i < key_size; ++i) {
+    key |= static_cast<std::uint32_t>(key_bytes[i] & 0x7F) << (7 * i);
+    if ((key_bytes[i] & 0x80) == 0) {
+      return key >> 3;
+    }
+  }
+  LOG(FATAL) << "Malformed key";
+  base::noreturn();
+}
+
+int Player::Extension(serialization::Method const& method) {
+  std::vector<google::protobuf::FieldDescriptor const*> fields;
+  method.GetReflection()->ListFields(method, &fields);
+  CHECK_EQ(1, fields.size()) << method.DebugString();
+  return fields.front()->number();
+}
+
+void Player::BuildIndexIfNeeded() {
+  if (indexed_) {
+    return;
+  }
+  std::ifstream stream(path_,
+                       binary_ ? std::ios::in | std::ios::binary
+                               : std::ios::in);
+  CHECK(!stream.fail());
+  stream.seekg(start_);
+  int const advance_time = serialization::AdvanceTime::extension.number();
+  std::string frame;
+  while (ReadFrame(stream, frame)) {
+    IndexEntry entry{DecodeExtension(frame, binary_),
+                     std::numeric_limits<double>::quiet_NaN()};
+    // Only the in messages of |AdvanceTime|, which are at even positions, have
+    // a time.  They are short, so parsing them fully is cheap.
+    if (entry.extension == advance_time && index_.size() % 2 == 0) {
+      entry.time = Decode(frame, binary_)
+                       ->GetExtension(serialization::AdvanceTime::extension)
+                       .in()
+                       .t();
+    }
+    index_.push_back(entry);
+  }
+  indexed_ = true;
+}
+
+std::unordered_map<int, Player::Runner> const& Player::Runners() {
+  static auto const* const runners =
+      new std::unordered_map<int, Runner>{
+#include "journal/player.generated.cc"
+      };
+  return *runners;
+}
+
 }  // namespace journal
 }  // namespace principia
@@ -1,10 +1,15 @@
 ﻿
 #pragma once
 
+#include <deque>
 #include <experimental/filesystem>
 #include <fstream>
+#include <future>
 #include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "serialization/journal.pb.h"
 
@@ -15,25 +20,100 @@ class Player final {
  public:
   using PointerMap = std::map<std::uint64_t, void*>;
 
-  explicit Player(std::experimental::filesystem::path const& path);
+  // The format of the journal (hexadecimal or binary) is detected
+  // automatically.  The messages are parsed ahead of |Play| in batches, with up
+  // to |decoding_threads| batches being parsed concurrently.
+  explicit Player(std::experimental::filesystem::path const& path,
+                  int decoding_threads = 4);
 
   // Replays the next message in the journal.  Returns false at end of journal.
   bool Play();
 
+  // The number of methods, i.e., of pairs of in and out/return messages, in
+  // the journal.  Builds the index of the journal if needed.
+  std::int64_t number_of_methods();
+
+  // Positions the journal so that the next call to |Play| replays the method
+  // at |index|.  The methods up to |index| are replayed, since the objects
+  // that they create and the pointers that they produce are needed by the
+  // methods that follow.  For the same reason, |index| may not be before the
+  // method that |Play| would replay next.  Builds the index of the journal if
+  // needed.
+  void SeekToMethod(std::int64_t index);
+
+  // Positions the journal, as |SeekToMethod| does, at the first |AdvanceTime|
+  // method whose time is at least |t| and that is not before the method that
+  // |Play| would replay next, and returns its index.  If there is no such
+  // method, positions the journal at its end and returns
+  // |number_of_methods()|.  Builds the index of the journal if needed.
+  std::int64_t SeekToTime(double t);
+
   // Return the last replayed messages.
   serialization::Method const& last_method_in() const;
   serialization::Method const& last_method_out_return() const;
 
  private:
+  using Methods = std::vector<std::unique_ptr<serialization::Method>>;
+  using Runner =
+      bool (Player::*)(serialization::Method const& method_in,
+                       serialization::Method const& method_out_return);
+
+  // The number of the extension of |serialization::Method| that a message
+  // contains and, for the in message of |AdvanceTime|, the time to which it
+  // advances.
+  struct IndexEntry final {
+    int extension;
+    double time;
+  };
+
   // Reads one message from the stream.  Returns a |nullptr| at end of stream.
   std::unique_ptr<serialization::Method> Read();
 
+  // Reads the undecoded representation of one message from |stream|.  Returns
+  // false at end of stream.
+  bool ReadFrame(std::ifstream& stream, std::string& frame) const;
+
+  // Decodes and parses the representation of one message.
+  static std::unique_ptr<serialization::Method> Decode(std::string const& frame,
+                                                       bool binary);
+
+  // Parses only the tag of the extension at the beginning of |frame|.
+  static int DecodeExtension(std::string const& frame, bool binary);
+
+  // Returns the number of the unique extension of |method|.
+  static int Extension(serialization::Method const& method);
+
+  void BuildIndexIfNeeded();
+
+  // Maps the extension numbers to the corresponding instance of
+  // |RunIfAppropriate|.
+  static std::unordered_map<int, Runner> const& Runners();
+
   template<typename Profile>
   bool RunIfAppropriate(serialization::Method const& method_in,
                         serialization::Method const& method_out_return);
 
+  std::experimental::filesystem::path const path_;
+  int const decoding_threads_;
+
   PointerMap pointer_map_;
   std::ifstream stream_;
+  bool binary_ = false;
+  // The offset of the first message.
+  std::streamoff start_ = 0;
+
+  // Batches of messages being parsed, in the order of the stream.
+  std::deque<std::future<Methods>> parsing_;
+  // The last batch parsed and the index of the next message to return from it.
+  Methods parsed_;
+  std::int64_t next_parsed_ = 0;
+  bool end_of_stream_ = false;
+  // The index of the method that the next call to |Play| replays.
+  std::int64_t next_method_ = 0;
+
+  // One entry per message, empty until the index is built.
+  std::vector<IndexEntry> index_;
+  bool indexed_ = false;
 
   std::unique_ptr<serialization::Method> last_method_in_;
   std::unique_ptr<serialization::Method> last_method_out_return_;
@@ -84,6 +84,144 @@ TEST_F(PlayerTest, PlayTiny) {
   EXPECT_EQ(2, count);
 }
 
+TEST_F(PlayerTest, PlayTinyBinaryAsynchronous) {
+  std::thread recorder([this]() {
+    Recorder* const r(new Recorder(test_name_ + ".journal.bin",
+                                   Recorder::Format::binary,
+                                   /*asynchronous=*/true));
+    Recorder::Activate(r);
+
+    {
+      Method<NewPlugin> m({"1 s", "2 s", 3});
+      m.Return(plugin_.get());
+    }
+    {
+      const ksp_plugin::Plugin* plugin = plugin_.get();
+      Method<DeletePlugin> m({&plugin}, {&plugin});
+      m.Return();
+    }
+    // Waits for the pending methods to be written.
+    Recorder::Deactivate();
+  });
+  recorder.join();
+
+  Player player(test_name_ + ".journal.bin");
+
+  int count = 0;
+  while (player.Play()) {
+    ++count;
+  }
+  EXPECT_EQ(2, count);
+}
+
+TEST_F(PlayerTest, Seek) {
+  std::thread recorder([this]() {
+    Recorder* const r(new Recorder(test_name_ + ".journal.hex"));
+    Recorder::Activate(r);
+
+    {
+      Method<NewPlugin> m({"1 s", "2 s", 3});
+      m.Return(plugin_.get());
+    }
+    for (double const t : {1, 2}) {
+      Method<SetPredictionLength> m({plugin_.get(), t});
+      m.Return();
+    }
+    {
+      const ksp_plugin::Plugin* plugin = plugin_.get();
+      Method<DeletePlugin> m({&plugin}, {&plugin});
+      m.Return();
+    }
+    {
+      // Never replayed, the plugin doesn't exist anymore.
+      Method<AdvanceTime> m({plugin_.get(), 10, 0});
+      m.Return();
+    }
+    Recorder::Deactivate();
+  });
+  recorder.join();
+
+  Player player(test_name_ + ".journal.hex");
+  EXPECT_EQ(5, player.number_of_methods());
+
+  // Seek to the middle of the journal and play from there: the plugin created
+  // by the first method must be known to the player.
+  player.SeekToMethod(2);
+  EXPECT_TRUE(player.Play());
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      SetPredictionLength::Message::extension));
+  EXPECT_EQ(2,
+            player.last_method_in()
+                .GetExtension(SetPredictionLength::Message::extension)
+                .in()
+                .t());
+  EXPECT_TRUE(player.Play());
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      DeletePlugin::Message::extension));
+
+  EXPECT_EQ(4, player.SeekToTime(5));
+  EXPECT_EQ(4, player.SeekToTime(10));
+  player.SeekToMethod(4);
+}
+
+TEST_F(PlayerTest, SeekToTimeAtEnd) {
+  std::thread recorder([this]() {
+    Recorder* const r(new Recorder(test_name_ + ".journal.bin",
+                                   Recorder::Format::binary));
+    Recorder::Activate(r);
+
+    {
+      Method<NewPlugin> m({"1 s", "2 s", 3});
+      m.Return(plugin_.get());
+    }
+    {
+      const ksp_plugin::Plugin* plugin = plugin_.get();
+      Method<DeletePlugin> m({&plugin}, {&plugin});
+      m.Return();
+    }
+    Recorder::Deactivate();
+  });
+  recorder.join();
+
+  // There is no |AdvanceTime| in this journal, so seeking replays all of it.
+  Player player(test_name_ + ".journal.bin");
+  EXPECT_EQ(2, player.SeekToTime(0));
+  EXPECT_TRUE(player.last_method_in().HasExtension(
+      DeletePlugin::Message::extension));
+  EXPECT_FALSE(player.Play());
+}
+
+using PlayerDeathTest = PlayerTest;
+
+TEST_F(PlayerDeathTest, SeekError) {
+  std::thread recorder([this]() {
+    Recorder* const r(new Recorder(test_name_ + ".journal.hex"));
+    Recorder::Activate(r);
+
+    {
+      Method<NewPlugin> m({"1 s", "2 s", 3});
+      m.Return(plugin_.get());
+    }
+    {
+      const ksp_plugin::Plugin* plugin = plugin_.get();
+      Method<DeletePlugin> m({&plugin}, {&plugin});
+      m.Return();
+    }
+    Recorder::Deactivate();
+  });
+  recorder.join();
+
+  EXPECT_DEATH({
+    Player player(test_name_ + ".journal.hex");
+    player.SeekToMethod(1);
+    player.SeekToMethod(0);
+  }, "Cannot seek backwards");
+  EXPECT_DEATH({
+    Player player(test_name_ + ".journal.hex");
+    player.SeekToMethod(3);
+  }, "number_of_methods");
+}
+
 TEST_F(PlayerTest, DISABLED_Benchmarks) {
   benchmark::RunSpecifiedBenchmarks();
 }
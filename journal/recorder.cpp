@@ -7,32 +7,57 @@
 
 namespace principia {
 
+using base::Bytes;
 using base::HexadecimalEncode;
-using base::UniqueBytes;
 
 namespace journal {
 
-Recorder::Recorder(std::experimental::filesystem::path const& path)
-    : stream_(path, std::ios::out) {
+constexpr char Recorder::binary_magic[];
+constexpr int Recorder::binary_magic_size;
+constexpr int Recorder::binary_size_size;
+
+Recorder::Recorder(std::experimental::filesystem::path const& path,
+                   Format const format,
+                   bool const asynchronous)
+    : format_(format),
+      stream_(path,
+              format == Format::binary ? std::ios::out | std::ios::binary
+                                       : std::ios::out) {
   CHECK(!stream_.fail()) << path;
+  if (format_ == Format::binary) {
+    stream_.write(binary_magic, binary_magic_size);
+    stream_.flush();
+  }
+  if (asynchronous) {
+    writer_ = std::make_unique<std::thread>([this]() { WriteBatches(); });
+  }
 }
 
 Recorder::~Recorder() {
+  if (writer_ != nullptr) {
+    {
+      std::lock_guard<std::mutex> l(lock_);
+      done_ = true;
+    }
+    has_pending_or_done_.notify_one();
+    writer_->join();
+  }
   stream_.close();
 }
 
 void Recorder::Write(serialization::Method const& method) {
   CHECK_LT(0, method.ByteSize()) << method.DebugString();
-  UniqueBytes bytes(method.ByteSize());
-  method.SerializeToArray(bytes.data.get(), static_cast<int>(bytes.size));
-
-  std::int64_t const hexadecimal_size = (bytes.size << 1) + 2;
-  UniqueBytes hexadecimal(hexadecimal_size);
-  HexadecimalEncode({bytes.data.get(), bytes.size}, hexadecimal.get());
-  hexadecimal.data.get()[hexadecimal_size - 2] = '\n';
-  hexadecimal.data.get()[hexadecimal_size - 1] = '\0';
-  stream_ << hexadecimal.data.get();
-  stream_.flush();
+  Encode(method);
+  if (writer_ == nullptr) {
+    stream_.write(frame_.data(), frame_.size());
+    stream_.flush();
+  } else {
+    {
+      std::lock_guard<std::mutex> l(lock_);
+      pending_.append(frame_);
+    }
+    has_pending_or_done_.notify_one();
+  }
 }
 
 void Recorder::Activate(base::not_null<Recorder*> const journal) {
@@ -50,6 +75,52 @@ bool Recorder::IsActivated() {
   return active_recorder_ != nullptr;
 }
 
+void Recorder::Encode(serialization::Method const& method) {
+  std::int64_t const size = method.ByteSize();
+  switch (format_) {
+    case Format::hexadecimal: {
+      // Serialize at the beginning of the buffer and encode in place.
+      std::int64_t const hexadecimal_size = size << 1;
+      frame_.resize(hexadecimal_size + 1);
+      auto* const hexadecimal = reinterpret_cast<std::uint8_t*>(&frame_[0]);
+      method.SerializeWithCachedSizesToArray(hexadecimal);
+      HexadecimalEncode(Bytes(hexadecimal, size),
+                        Bytes(hexadecimal, hexadecimal_size));
+      frame_[hexadecimal_size] = '\n';
+      break;
+    }
+    case Format::binary: {
+      frame_.resize(binary_size_size + size);
+      for (int i = 0; i < binary_size_size; ++i) {
+        frame_[i] = static_cast<char>(size >> (8 * i));
+      }
+      method.SerializeWithCachedSizesToArray(
+          reinterpret_cast<std::uint8_t*>(&frame_[binary_size_size]));
+      break;
+    }
+  }
+}
+
+void Recorder::WriteBatches() {
+  std::string batch;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> l(lock_);
+      has_pending_or_done_.wait(l, [this]() {
+        return !pending_.empty() || done_;
+      });
+      if (pending_.empty()) {
+        // |done_| is true and everything has been written.
+        return;
+      }
+      batch.swap(pending_);
+    }
+    stream_.write(batch.data(), batch.size());
+    stream_.flush();
+    batch.clear();
+  }
+}
+
 thread_local Recorder* Recorder::active_recorder_ = nullptr;
 
 }  // namespace journal
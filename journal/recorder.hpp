@@ -1,9 +1,15 @@
 ﻿
 #pragma once
 
+#include <condition_variable>
 #include <experimental/filesystem>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
+#include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "serialization/journal.pb.h"
 
@@ -14,7 +20,28 @@ FORWARD_DECLARE_FROM(method, template<typename Profile> class, Method);
 
 class Recorder final {
  public:
-  explicit Recorder(std::experimental::filesystem::path const& path);
+  enum class Format {
+    // One line of hexadecimal digits per method.
+    hexadecimal,
+    // The |binary_magic| followed, for each method, by its 4-byte
+    // little-endian size and its serialized bytes.
+    binary,
+  };
+
+  // The first bytes of a binary journal.  They are not hexadecimal digits, so
+  // they distinguish the two formats.
+  static constexpr char binary_magic[] = "PrincipiaJournal";
+  static constexpr int binary_magic_size = sizeof(binary_magic) - 1;
+  static constexpr int binary_size_size = 4;
+
+  // If |asynchronous| is false, each call to |Write| writes and flushes the
+  // method before returning.  Otherwise, |Write| only serializes the method
+  // and a background thread writes the pending methods in batches; the
+  // methods not yet written are lost if the process crashes, but all of them
+  // are written by the time the destructor returns.
+  explicit Recorder(std::experimental::filesystem::path const& path,
+                    Format format = Format::hexadecimal,
+                    bool asynchronous = false);
   ~Recorder();
 
   void Write(serialization::Method const& method);
@@ -24,8 +51,28 @@ class Recorder final {
   static bool IsActivated();
 
  private:
+  // Sets |frame_| to the representation of |method| in |format_|.
+  void Encode(serialization::Method const& method);
+
+  // The body of |writer_|.
+  void WriteBatches();
+
+  Format const format_;
   std::ofstream stream_;
 
+  // Reused across calls to |Write| to avoid allocations.
+  std::string frame_;
+
+  // The thread writing the pending methods in asynchronous mode, null in
+  // synchronous mode.
+  std::unique_ptr<std::thread> writer_;
+
+  std::mutex lock_;
+  std::condition_variable has_pending_or_done_;
+  // The methods encoded by |Write| and not yet picked up by |writer_|.
+  std::string pending_ GUARDED_BY(lock_);
+  bool done_ GUARDED_BY(lock_) = false;
+
   static thread_local Recorder* active_recorder_;
 
   template<typename>
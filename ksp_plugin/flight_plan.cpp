@@ -238,6 +238,10 @@ std::unique_ptr<FlightPlan> FlightPlan::ReadFromMessage(
           DegreesOfFreedom<Barycentric>::ReadFromMessage(
               message.initial_degrees_of_freedom()));
 
+  // The flight plan is recomputed from its initial time, which the series of
+  // an ephemeris read from a compact message may not cover yet.
+  ephemeris->Reanimate(initial_time);
+
   auto flight_plan = std::make_unique<FlightPlan>(
       Mass::ReadFromMessage(message.initial_mass()),
       initial_time,
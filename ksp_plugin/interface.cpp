@@ -3,6 +3,7 @@
 
 #include <cctype>
 #include <cstring>
+#include <experimental/filesystem>
 #include <iomanip>
 #include <string>
 #include <utility>
@@ -16,6 +17,7 @@
 #include "astronomy/epoch.hpp"
 #include "base/array.hpp"
 #include "base/hexadecimal.hpp"
+#include "base/lz4.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "base/optional_logging.hpp"
@@ -40,6 +42,9 @@ using base::Bytes;
 using base::check_not_null;
 using base::HexadecimalDecode;
 using base::HexadecimalEncode;
+using base::LZ4Compress;
+using base::LZ4Decompress;
+using base::LZ4MaxCompressedSize;
 using base::make_not_null_unique;
 using base::PullSerializer;
 using base::PushDeserializer;
@@ -80,6 +85,91 @@ namespace {
 int const chunk_size = 64 << 10;
 int const number_of_chunks = 8;
 
+// The binary serialization of the plugin is a sequence of frames, each made of
+// a 4-byte little-endian length followed by that many bytes of payload.  When
+// the frames are compressed, the payload is the 4-byte little-endian length of
+// the uncompressed chunk followed by its LZ4 block.
+int const frame_header_size = 4;
+
+void WriteLittleEndian32(std::uint32_t const value, std::uint8_t* const bytes) {
+  for (int i = 0; i < frame_header_size; ++i) {
+    bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+std::uint32_t ReadLittleEndian32(std::uint8_t const* const bytes) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < frame_header_size; ++i) {
+    value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+  return value;
+}
+
+// Returns true if |compressor| designates LZ4, false if it is empty.
+bool IsLZ4Compressor(char const* const compressor) {
+  std::string const name = compressor;
+  if (name.empty()) {
+    return false;
+  }
+  CHECK_EQ("lz4", name) << "Unknown compressor";
+  return true;
+}
+
+// Pulls the next chunk of the serialization of |plugin|, creating and starting
+// a serializer if |*serializer| is null.  At the end of the stream, deletes the
+// serializer and returns an empty chunk.
+Bytes PullPluginChunk(Plugin const& plugin,
+                      PullSerializer** const serializer) {
+  if (*serializer == nullptr) {
+    LOG(INFO) << "Begin plugin serialization";
+    *serializer = new PullSerializer(chunk_size, number_of_chunks);
+    auto message = make_not_null_unique<serialization::Plugin>();
+    plugin.WriteToMessage(message.get());
+    (*serializer)->Start(std::move(message));
+  }
+
+  Bytes const bytes = (*serializer)->Pull();
+
+  if (bytes.size == 0) {
+    LOG(INFO) << "End plugin serialization";
+    TakeOwnership(serializer);
+  }
+  return bytes;
+}
+
+// Pushes |bytes| to the deserializer, creating and starting one if
+// |*deserializer| is null.  |done| is called when |bytes| may be reclaimed.
+// When |bytes| is empty, deletes the deserializer, which ensures that |*plugin|
+// is filled.  |ephemeris_series_directory| is passed to
+// |Plugin::ReadFromMessage|.
+void PushPluginChunk(
+    Bytes const bytes,
+    std::function<void()> done,
+    std::experimental::filesystem::path const& ephemeris_series_directory,
+    PushDeserializer** const deserializer,
+    Plugin const** const plugin) {
+  if (*deserializer == nullptr) {
+    LOG(INFO) << "Begin plugin deserialization";
+    *deserializer = new PushDeserializer(chunk_size, number_of_chunks);
+    auto message = make_not_null_unique<serialization::Plugin>();
+    (*deserializer)->Start(
+        std::move(message),
+        [ephemeris_series_directory,
+         plugin](google::protobuf::Message const& message) {
+          *plugin = Plugin::ReadFromMessage(
+              static_cast<serialization::Plugin const&>(message),
+              ephemeris_series_directory).release();
+        });
+  }
+
+  (*deserializer)->Push(bytes, std::move(done));
+
+  if (bytes.size == 0) {
+    LOG(INFO) << "End plugin deserialization";
+    TakeOwnership(deserializer);
+  }
+}
+
 base::not_null<std::unique_ptr<RotatingBody<Barycentric>>> MakeRotatingBody(
     BodyParameters const& body_parameters) {
   // Logging operators would dereference a null C string.
@@ -139,9 +229,12 @@ base::not_null<std::unique_ptr<RotatingBody<Barycentric>>> MakeRotatingBody(
 // If |activate| is true and there is no active journal, create one and
 // activate it.  If |activate| is false and there is an active journal,
 // deactivate it.  Does nothing if there is already a journal in the desired
-// state.  |verbose| causes methods to be output in the INFO log before being
-// executed.
-void principia__ActivateRecorder(bool const activate) {
+// state.  If |asynchronous| is true, the journal is written by a background
+// thread, which makes recording much cheaper for the game; however, the last
+// methods before a crash are then lost, so a synchronous journal is needed to
+// replay a crash.  |asynchronous| is ignored when deactivating.
+void principia__ActivateRecorder(bool const activate,
+                                 bool const asynchronous) {
   // NOTE: Do not journal!  You'd end up with half a message in the journal and
   // that would cause trouble.
   if (activate && !journal::Recorder::IsActivated()) {
@@ -153,7 +246,9 @@ void principia__ActivateRecorder(bool const activate) {
     name << std::put_time(localtime, "JOURNAL.%Y%m%d-%H%M%S");
     journal::Recorder* const recorder =
         new journal::Recorder(std::experimental::filesystem::path("glog") /
-                                  "Principia" / name.str());
+                                  "Principia" / name.str(),
+                              journal::Recorder::Format::binary,
+                              asynchronous);
     journal::Recorder::Activate(recorder);
   } else if (!activate && journal::Recorder::IsActivated()) {
     journal::Recorder::Deactivate();
@@ -237,6 +332,15 @@ double principia__CurrentTime(Plugin const* const plugin) {
   return m.Return(ToGameTime(*plugin, plugin->CurrentTime()));
 }
 
+// Deletes and nulls |*native_bytes|.  |native_bytes| must not be null.  No
+// transfer of ownership of |*native_bytes|, takes ownership of
+// |**native_bytes|.
+void principia__DeleteBytes(std::uint8_t const** const native_bytes) {
+  journal::Method<journal::DeleteBytes> m({native_bytes}, {native_bytes});
+  TakeOwnershipArray(native_bytes);
+  return m.Return();
+}
+
 // Deletes and nulls |*plugin|.
 // |plugin| must not be null.  No transfer of ownership of |*plugin|, takes
 // ownership of |**plugin|.
@@ -285,19 +389,6 @@ void principia__DeserializePlugin(char const* const serialization,
   CHECK_NOTNULL(deserializer);
   CHECK_NOTNULL(plugin);
 
-  // Create and start a deserializer if the caller didn't provide one.
-  if (*deserializer == nullptr) {
-    LOG(INFO) << "Begin plugin deserialization";
-    *deserializer = new PushDeserializer(chunk_size, number_of_chunks);
-    auto message = make_not_null_unique<serialization::Plugin>();
-    (*deserializer)->Start(
-        std::move(message),
-        [plugin](google::protobuf::Message const& message) {
-          *plugin = Plugin::ReadFromMessage(
-              static_cast<serialization::Plugin const&>(message)).release();
-        });
-  }
-
   // Decode the hexadecimal representation.
   std::uint8_t const* const hexadecimal =
       reinterpret_cast<std::uint8_t const*>(serialization);
@@ -309,15 +400,74 @@ void principia__DeserializePlugin(char const* const serialization,
   HexadecimalDecode({hexadecimal, hexadecimal_size}, {bytes, byte_size});
 
   // Push the data, taking ownership of it.
-  (*deserializer)->Push(Bytes(&bytes[0], byte_size),
-                        [bytes]() { delete[] bytes; });
+  PushPluginChunk(Bytes(&bytes[0], byte_size),
+                  [bytes]() { delete[] bytes; },
+                  /*ephemeris_series_directory=*/
+                  std::experimental::filesystem::path(),
+                  deserializer,
+                  plugin);
+  return m.Return();
+}
 
-  // If the data was empty, delete the deserializer.  This ensures that
-  // |*plugin| is filled.
-  if (byte_size == 0) {
-    LOG(INFO) << "End plugin deserialization";
-    TakeOwnership(deserializer);
+// Same as |principia__DeserializePlugin|, but |serialization| must be a frame
+// returned by |principia__SerializePluginBinary| (with its length prefix), and
+// |compressor| must be the one that was used to produce it.  The caller must
+// perform an extra call with |serialization_size| set to 0 to indicate the end
+// of the input stream; |serialization| may then be null.
+// |ephemeris_series_directory| is the directory that was given to
+// |principia__SetEphemerisSeriesDirectory| when the plugin was serialized, or
+// the empty string.
+void principia__DeserializePluginBinary(
+    std::uint8_t const* const serialization,
+    int const serialization_size,
+    PushDeserializer** const deserializer,
+    Plugin const** const plugin,
+    char const* const compressor,
+    char const* const ephemeris_series_directory) {
+  journal::Method<journal::DeserializePluginBinary> m(
+      {serialization,
+       serialization_size,
+       deserializer,
+       plugin,
+       compressor,
+       ephemeris_series_directory},
+      {deserializer, plugin});
+  CHECK(serialization != nullptr || serialization_size == 0);
+  CHECK_NOTNULL(deserializer);
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(compressor);
+  CHECK_NOTNULL(ephemeris_series_directory);
+
+  // Extract the payload of the frame and decompress it if needed.  Ownership
+  // of |bytes| is transfered to the deserializer using the callback to |Push|.
+  std::uint8_t* bytes = nullptr;
+  std::int64_t byte_size = 0;
+  if (serialization_size > 0) {
+    CHECK_LE(frame_header_size, serialization_size);
+    std::int64_t const payload_size = ReadLittleEndian32(serialization);
+    CHECK_EQ(frame_header_size + payload_size, serialization_size);
+    std::uint8_t const* const payload = &serialization[frame_header_size];
+    if (IsLZ4Compressor(compressor)) {
+      CHECK_LE(frame_header_size, payload_size);
+      byte_size = ReadLittleEndian32(payload);
+      bytes = new std::uint8_t[byte_size];
+      CHECK_EQ(byte_size,
+               LZ4Decompress({&payload[frame_header_size],
+                              payload_size - frame_header_size},
+                             {bytes, byte_size}));
+    } else {
+      byte_size = payload_size;
+      bytes = new std::uint8_t[byte_size];
+      std::memcpy(bytes, payload, byte_size);
+    }
   }
+
+  PushPluginChunk(Bytes(bytes, byte_size),
+                  [bytes]() { delete[] bytes; },
+                  std::experimental::filesystem::u8path(
+                      ephemeris_series_directory),
+                  deserializer,
+                  plugin);
   return m.Return();
 }
 
@@ -825,24 +975,10 @@ char const* principia__SerializePlugin(Plugin const* const plugin,
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(serializer);
 
-  // Create and start a serializer if the caller didn't provide one.
-  if (*serializer == nullptr) {
-    LOG(INFO) << "Begin plugin serialization";
-    *serializer = new PullSerializer(chunk_size, number_of_chunks);
-    auto message = make_not_null_unique<serialization::Plugin>();
-    plugin->WriteToMessage(message.get());
-    (*serializer)->Start(std::move(message));
-  }
-
-  // Pull a chunk.
-  Bytes bytes;
-  bytes = (*serializer)->Pull();
+  Bytes const bytes = PullPluginChunk(*plugin, serializer);
 
-  // If this is the end of the serialization, delete the serializer and return a
-  // nullptr.
+  // If this is the end of the serialization, return a nullptr.
   if (bytes.size == 0) {
-    LOG(INFO) << "End plugin serialization";
-    TakeOwnership(serializer);
     return m.Return(nullptr);
   }
 
@@ -854,6 +990,56 @@ char const* principia__SerializePlugin(Plugin const* const plugin,
   return m.Return(reinterpret_cast<char const*>(hexadecimal.data.release()));
 }
 
+// Same as |principia__SerializePlugin|, but the result is a frame made of a
+// 4-byte little-endian length followed by that many bytes of binary payload.
+// The frame is deleted using |principia__DeleteBytes| and its total size is
+// returned in |*serialization_size|, which is set to 0 at the end of the
+// serialization.  |compressor| is either empty or "lz4", in which case the
+// payload is compressed.
+std::uint8_t const* principia__SerializePluginBinary(
+    Plugin const* const plugin,
+    PullSerializer** const serializer,
+    char const* const compressor,
+    int* const serialization_size) {
+  journal::Method<journal::SerializePluginBinary> m(
+      {plugin, serializer, compressor},
+      {serializer, serialization_size});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(serializer);
+  CHECK_NOTNULL(compressor);
+  CHECK_NOTNULL(serialization_size);
+  bool const compress = IsLZ4Compressor(compressor);
+
+  Bytes const bytes = PullPluginChunk(*plugin, serializer);
+
+  // If this is the end of the serialization, return a nullptr.
+  if (bytes.size == 0) {
+    *serialization_size = 0;
+    return m.Return(nullptr);
+  }
+
+  UniqueBytes frame;
+  std::int64_t payload_size;
+  if (compress) {
+    frame = UniqueBytes(2 * frame_header_size +
+                        LZ4MaxCompressedSize(bytes.size));
+    std::uint8_t* const payload = &frame.data[frame_header_size];
+    WriteLittleEndian32(bytes.size, payload);
+    payload_size =
+        frame_header_size +
+        LZ4Compress(bytes,
+                    {&payload[frame_header_size],
+                     frame.size - 2 * frame_header_size});
+  } else {
+    frame = UniqueBytes(frame_header_size + bytes.size);
+    std::memcpy(&frame.data[frame_header_size], bytes.data, bytes.size);
+    payload_size = bytes.size;
+  }
+  WriteLittleEndian32(payload_size, frame.data.get());
+  *serialization_size = frame_header_size + payload_size;
+  return m.Return(frame.data.release());
+}
+
 // Sets the maximum number of seconds which logs may be buffered for.
 void principia__SetBufferDuration(int const seconds) {
   journal::Method<journal::SetBufferDuration> m({seconds});
@@ -869,6 +1055,38 @@ void principia__SetBufferedLogging(int const max_severity) {
   return m.Return();
 }
 
+void principia__SetCompactEphemerisSerialization(Plugin* const plugin,
+                                                 bool const compact) {
+  journal::Method<journal::SetCompactEphemerisSerialization> m(
+      {plugin, compact});
+  CHECK_NOTNULL(plugin);
+  plugin->SetCompactEphemerisSerialization(compact);
+  return m.Return();
+}
+
+void principia__SetEphemerisProlongationHorizon(Plugin* const plugin,
+                                                double const horizon) {
+  journal::Method<journal::SetEphemerisProlongationHorizon> m(
+      {plugin, horizon});
+  CHECK_NOTNULL(plugin);
+  plugin->SetEphemerisProlongationHorizon(horizon * Second);
+  return m.Return();
+}
+
+// If |directory| is not empty, the Чебышёв series of the ephemeris are saved
+// to a file in |directory| instead of being part of the serialization of the
+// plugin, which makes loading faster.  Such a serialization must then be read
+// by |principia__DeserializePluginBinary| with the same |directory|.
+void principia__SetEphemerisSeriesDirectory(Plugin* const plugin,
+                                            char const* const directory) {
+  journal::Method<journal::SetEphemerisSeriesDirectory> m({plugin, directory});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(directory);
+  plugin->SetEphemerisSeriesDirectory(
+      std::experimental::filesystem::u8path(directory));
+  return m.Return();
+}
+
 void principia__SetMainBody(Plugin* const plugin, int const index) {
   journal::Method<journal::SetMainBody> m({plugin, index});
   CHECK_NOTNULL(plugin);
@@ -876,6 +1094,13 @@ void principia__SetMainBody(Plugin* const plugin, int const index) {
   return m.Return();
 }
 
+void principia__SetMaxWorkers(Plugin* const plugin, int const max_workers) {
+  journal::Method<journal::SetMaxWorkers> m({plugin, max_workers});
+  CHECK_NOTNULL(plugin);
+  plugin->SetMaxWorkers(max_workers);
+  return m.Return();
+}
+
 void principia__SetPartApparentDegreesOfFreedom(Plugin* const plugin,
                                                 PartId const part_id,
                                                 QP const degrees_of_freedom) {
@@ -964,5 +1189,20 @@ void principia__UpdatePrediction(Plugin const* const plugin,
   return m.Return();
 }
 
+// Updates the predictions of the |vessel_guids_size| vessels whose guids are
+// in |vessel_guids|, possibly concurrently, see |principia__SetMaxWorkers|.
+void principia__UpdatePredictions(Plugin const* const plugin,
+                                  char const* const* const vessel_guids,
+                                  int const vessel_guids_size) {
+  journal::Method<journal::UpdatePredictions> m({plugin,
+                                                 vessel_guids,
+                                                 vessel_guids_size});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(vessel_guids);
+  plugin->UpdatePredictions(std::vector<GUID>(vessel_guids,
+                                              vessel_guids + vessel_guids_size));
+  return m.Return();
+}
+
 }  // namespace interface
 }  // namespace principia
@@ -55,6 +55,9 @@ class Iterator {
 
   virtual bool AtEnd() const = 0;
   virtual void Increment() = 0;
+  // Moves this iterator to the element at |index|, which must be in
+  // [0, Size()].
+  virtual void Reset(int index) = 0;
   virtual int Size() const = 0;
 };
 
@@ -73,6 +76,7 @@ class TypedIterator : public Iterator {
 
   bool AtEnd() const override;
   void Increment() override;
+  void Reset(int index) override;
   int Size() const override;
 
  private:
@@ -94,8 +98,17 @@ class TypedIterator<DiscreteTrajectory<World>> : public Iterator {
       std::function<Interchange(
           DiscreteTrajectory<World>::Iterator const&)> const& convert) const;
 
+  // Converts the elements starting at the one denoted by this iterator using
+  // |convert|, stores them in |interchanges|, and advances this iterator past
+  // them.  At most |size| elements are converted.  Returns the number of
+  // elements that were converted, which is less than |size| only if the end
+  // was reached.
+  template<typename Interchange, typename Converter>
+  int Fill(Converter const& convert, Interchange* interchanges, int size);
+
   bool AtEnd() const override;
   void Increment() override;
+  void Reset(int index) override;
   int Size() const override;
 
   not_null<Plugin const*> plugin() const;
@@ -117,7 +130,7 @@ std::unique_ptr<T[]> TakeOwnershipArray(T** pointer);
 #include "ksp_plugin/interface.generated.h"
 
 extern "C" PRINCIPIA_DLL
-void CDECL principia__ActivateRecorder(bool activate);
+void CDECL principia__ActivateRecorder(bool activate, bool asynchronous);
 
 extern "C" PRINCIPIA_DLL
 void CDECL principia__InitGoogleLogging();
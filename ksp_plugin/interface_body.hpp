@@ -111,6 +111,13 @@ void TypedIterator<Container>::Increment() {
   ++iterator_;
 }
 
+template<typename Container>
+void TypedIterator<Container>::Reset(int const index) {
+  CHECK_LE(0, index);
+  CHECK_LE(index, Size());
+  iterator_ = std::next(container_.begin(), index);
+}
+
 template<typename Container>
 int TypedIterator<Container>::Size() const {
   return container_.size();
@@ -133,6 +140,20 @@ Interchange TypedIterator<DiscreteTrajectory<World>>::Get(
   return convert(iterator_);
 }
 
+template<typename Interchange, typename Converter>
+int TypedIterator<DiscreteTrajectory<World>>::Fill(
+    Converter const& convert,
+    Interchange* const interchanges,
+    int const size) {
+  CHECK_LE(0, size);
+  auto const end = trajectory_->End();
+  int filled = 0;
+  for (; filled < size && iterator_ != end; ++filled, ++iterator_) {
+    interchanges[filled] = convert(iterator_);
+  }
+  return filled;
+}
+
 inline bool TypedIterator<DiscreteTrajectory<World>>::AtEnd() const {
   return iterator_ == trajectory_->End();
 }
@@ -141,6 +162,10 @@ inline void TypedIterator<DiscreteTrajectory<World>>::Increment() {
   ++iterator_;
 }
 
+inline void TypedIterator<DiscreteTrajectory<World>>::Reset(int const index) {
+  iterator_ = trajectory_->At(index);
+}
+
 inline int TypedIterator<DiscreteTrajectory<World>>::Size() const {
   return trajectory_->Size();
 }
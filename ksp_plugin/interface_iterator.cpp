@@ -25,6 +25,56 @@ void principia__IteratorDelete(Iterator** const iterator) {
   return m.Return();
 }
 
+int principia__IteratorFillQPs(Iterator* const iterator,
+                               QP* const qps,
+                               int const qps_size) {
+  journal::Method<journal::IteratorFillQPs> m({iterator}, {qps, qps_size});
+  CHECK_NOTNULL(iterator);
+  CHECK_NOTNULL(qps);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  return m.Return(typed_iterator->Fill(
+      [](DiscreteTrajectory<World>::Iterator const& iterator) -> QP {
+        return ToQP(iterator.degrees_of_freedom());
+      },
+      qps,
+      qps_size));
+}
+
+int principia__IteratorFillTimes(Iterator* const iterator,
+                                 double* const times,
+                                 int const times_size) {
+  journal::Method<journal::IteratorFillTimes> m({iterator},
+                                                {times, times_size});
+  CHECK_NOTNULL(iterator);
+  CHECK_NOTNULL(times);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  auto const plugin = typed_iterator->plugin();
+  return m.Return(typed_iterator->Fill(
+      [plugin](DiscreteTrajectory<World>::Iterator const& iterator) -> double {
+        return ToGameTime(*plugin, iterator.time());
+      },
+      times,
+      times_size));
+}
+
+int principia__IteratorFillXYZs(Iterator* const iterator,
+                                XYZ* const xyzs,
+                                int const xyzs_size) {
+  journal::Method<journal::IteratorFillXYZs> m({iterator}, {xyzs, xyzs_size});
+  CHECK_NOTNULL(iterator);
+  CHECK_NOTNULL(xyzs);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  return m.Return(typed_iterator->Fill(
+      [](DiscreteTrajectory<World>::Iterator const& iterator) -> XYZ {
+        return ToXYZ(iterator.degrees_of_freedom().position());
+      },
+      xyzs,
+      xyzs_size));
+}
+
 QP principia__IteratorGetQP(Iterator const* const iterator) {
   journal::Method<journal::IteratorGetQP> m({iterator});
   CHECK_NOTNULL(iterator);
@@ -65,6 +115,12 @@ void principia__IteratorIncrement(Iterator* const iterator) {
   return m.Return();
 }
 
+void principia__IteratorReset(Iterator* const iterator, int const index) {
+  journal::Method<journal::IteratorReset> m({iterator, index});
+  CHECK_NOTNULL(iterator)->Reset(index);
+  return m.Return();
+}
+
 int principia__IteratorSize(Iterator const* const iterator) {
   journal::Method<journal::IteratorSize> m({iterator});
   return m.Return(CHECK_NOTNULL(iterator)->Size());
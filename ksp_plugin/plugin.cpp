@@ -5,11 +5,15 @@
 #include <cmath>
 #include <experimental/filesystem>
 #include <fstream>
+#include <iomanip>
 #include <ios>
 #include <limits>
 #include <list>
 #include <map>
+#include <sstream>
 #include <string>
+#include <system_error>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <set>
@@ -38,6 +42,7 @@
 #include "physics/dynamic_frame.hpp"
 #include "physics/frame_field.hpp"
 #include "physics/massive_body.hpp"
+#include "physics/trajectory_decimator.hpp"
 
 namespace principia {
 namespace ksp_plugin {
@@ -50,6 +55,7 @@ using base::Fingerprint2011;
 using base::FingerprintCat2011;
 using base::make_not_null_unique;
 using base::OFStream;
+using base::Status;
 using base::not_null;
 using geometry::AffineMap;
 using geometry::AngularVelocity;
@@ -76,7 +82,9 @@ using physics::MassiveBody;
 using physics::RigidMotion;
 using physics::RigidTransformation;
 using quantities::Force;
+using quantities::IsFinite;
 using quantities::Length;
+using quantities::si::Degree;
 using quantities::si::Kilogram;
 using quantities::si::Milli;
 using quantities::si::Minute;
@@ -87,6 +95,9 @@ namespace {
 
 Length const fitting_tolerance = 1 * Milli(Metre);
 
+// The angular error allowed when decimating rendered trajectories.
+Angle const rendering_tolerance = 0.1 * Degree;
+
 std::uint64_t const ksp_stock_system_fingerprint = 0x025779971BA2BFD7u;
 std::uint64_t const ksp_fixed_system_fingerprint = 0x1248ADFCBD8BCE64u;
 
@@ -511,6 +522,7 @@ void Plugin::FreeVesselsAndPartsAndCollectPileUps() {
       if (target_ && target_->vessel == vessel) {
         target_ = std::experimental::nullopt;
       }
+      rendering_caches_.erase(&vessel->psychohistory());
       it = vessels_.erase(it);
     }
   }
@@ -643,6 +655,7 @@ void Plugin::AdvanceTime(Instant const& t, Angle const& planetarium_rotation) {
   planetarium_rotation_ = planetarium_rotation;
   UpdatePlanetariumRotation();
   loaded_vessels_.clear();
+  RequestEphemerisProlongation();
 }
 
 void Plugin::ForgetAllHistoriesBefore(Instant const& t) const {
@@ -652,6 +665,13 @@ void Plugin::ForgetAllHistoriesBefore(Instant const& t) const {
   for (auto const& pair : vessels_) {
     not_null<std::unique_ptr<Vessel>> const& vessel = pair.second;
     vessel->ForgetBefore(t);
+    // Trim the rendering cache of the psychohistory rather than dropping it,
+    // so that its next update only has to render the points appended since.
+    auto const it = rendering_caches_.find(&vessel->psychohistory());
+    if (it != rendering_caches_.end()) {
+      it->second.decimator.ForgetBefore(
+          vessel->psychohistory().Begin().time());
+    }
   }
 }
 
@@ -701,6 +721,41 @@ void Plugin::UpdatePrediction(GUID const& vessel_guid) const {
       current_time_ + prediction_length_);
 }
 
+void Plugin::UpdatePredictions(std::vector<GUID> const& vessel_guids) const {
+  CHECK(!initializing_);
+  std::vector<not_null<Vessel*>> vessels;
+  for (GUID const& vessel_guid : vessel_guids) {
+    vessels.push_back(find_vessel_by_guid_or_die(vessel_guid).get());
+  }
+
+  // The flows only read the ephemeris as long as it covers the time to which
+  // they integrate, so we prolong it once here, which lets us flow the
+  // predictions concurrently.  For an infinite prediction length we prolong it
+  // by |max_ephemeris_steps_per_frame| steps, as a single vessel would, and
+  // all the predictions end at the new |t_max|.  The same time is used on the
+  // serial path so that the results don't depend on the number of workers.
+  Instant last_time = current_time_ + prediction_length_;
+  if (IsFinite(prediction_length_)) {
+    ephemeris_->Prolong(last_time);
+  } else {
+    ephemeris_->Prolong(ephemeris_->t_max() +
+                        FlightPlan::max_ephemeris_steps_per_frame *
+                            history_parameters_.step());
+    last_time = ephemeris_->t_max();
+  }
+
+  if (thread_pool_ != nullptr) {
+    thread_pool_->ParallelFor(vessels.size(),
+                              [&vessels, last_time](int const i) {
+                                vessels[i]->UpdatePrediction(last_time);
+                              });
+  } else {
+    for (not_null<Vessel*> const vessel : vessels) {
+      vessel->UpdatePrediction(last_time);
+    }
+  }
+}
+
 void Plugin::CreateFlightPlan(GUID const& vessel_guid,
                               Instant const& final_time,
                               Mass const& initial_mass) const {
@@ -716,12 +771,66 @@ Plugin::RenderBarycentricTrajectoryInWorld(
     DiscreteTrajectory<Barycentric>::Iterator const& begin,
     DiscreteTrajectory<Barycentric>::Iterator const& end,
     Position<World> const& sun_world_position) const {
-  auto const trajectory_in_navigation =
-      RenderBarycentricTrajectoryInNavigation(begin, end);
-  auto trajectory_in_world =
-      RenderNavigationTrajectoryInWorld(trajectory_in_navigation->Begin(),
-                                        trajectory_in_navigation->End(),
-                                        sun_world_position);
+  // If the ephemeris was read from a compact message, the series covering the
+  // beginning of the psychohistories are recomputed in the background.  We
+  // don't wait for them: until they are spliced into the ephemeris, we only
+  // render the part of the trajectory that it covers.
+  auto first = begin;
+  if (begin != end) {
+    ephemeris_->PollReanimation(begin.time());
+    Instant const t_min = ephemeris_->t_min();
+    while (first != end && first.time() < t_min) {
+      ++first;
+    }
+  }
+  DiscreteTrajectory<Barycentric> const& trajectory = *begin.trajectory();
+  DiscreteTrajectory<Navigation> decimated_trajectory_in_navigation;
+  // The target frame depends on the prediction of the target vessel, so we
+  // don't cache renderings in it.  The predictions are rebuilt from scratch
+  // when they are updated, so we only cache the psychohistories, which are
+  // extended incrementally and whose caches are dropped with their vessels.
+  bool const is_psychohistory =
+      std::any_of(vessels_.begin(),
+                  vessels_.end(),
+                  [&trajectory](auto const& pair) {
+                    return &pair.second->psychohistory() == &trajectory;
+                  });
+  if (!target_ && is_psychohistory && !trajectory.Empty() &&
+      first == trajectory.Begin() && end == trajectory.End()) {
+    NavigationFrame const& plotting_frame = *GetPlottingFrame();
+    TrajectoryDecimator<Navigation> const& decimator =
+        UpdatedRenderingCache(trajectory).decimator;
+    // If the cache was trimmed by |ForgetAllHistoriesBefore|, it may start
+    // after the first point of the trajectory.  It is empty if the trajectory
+    // has a single point.
+    if (!decimator.empty() &&
+        first.time() < decimator.retained().Begin().time()) {
+      decimated_trajectory_in_navigation.Append(
+          first.time(),
+          plotting_frame.ToThisFrameAtTime(first.time())(
+              first.degrees_of_freedom()));
+    }
+    decimator.WriteTo(decimated_trajectory_in_navigation);
+    auto const last = trajectory.last();
+    decimated_trajectory_in_navigation.Append(
+        last.time(),
+        plotting_frame.ToThisFrameAtTime(last.time())(
+            last.degrees_of_freedom()));
+  } else {
+    auto const trajectory_in_navigation =
+        RenderBarycentricTrajectoryInNavigation(first, end);
+    TrajectoryDecimator<Navigation> decimator(rendering_tolerance);
+    for (auto it = trajectory_in_navigation->Begin();
+         it != trajectory_in_navigation->End();
+         ++it) {
+      decimator.Append(it.time(), it.degrees_of_freedom());
+    }
+    decimator.WriteTo(decimated_trajectory_in_navigation);
+  }
+  auto trajectory_in_world = RenderNavigationTrajectoryInWorld(
+                                 decimated_trajectory_in_navigation.Begin(),
+                                 decimated_trajectory_in_navigation.End(),
+                                 sun_world_position);
   return trajectory_in_world;
 }
 
@@ -740,13 +849,13 @@ void Plugin::ComputeAndRenderApsides(
                  apoapsides_trajectory,
                  periapsides_trajectory);
   apoapsides =
-      RenderBarycentricTrajectoryInWorld(apoapsides_trajectory.Begin(),
-                                         apoapsides_trajectory.End(),
-                                         sun_world_position);
+      RenderBarycentricPointsInWorld(apoapsides_trajectory.Begin(),
+                                     apoapsides_trajectory.End(),
+                                     sun_world_position);
   periapsides =
-      RenderBarycentricTrajectoryInWorld(periapsides_trajectory.Begin(),
-                                         periapsides_trajectory.End(),
-                                         sun_world_position);
+      RenderBarycentricPointsInWorld(periapsides_trajectory.Begin(),
+                                     periapsides_trajectory.End(),
+                                     sun_world_position);
 }
 
 void Plugin::ComputeAndRenderClosestApproaches(
@@ -764,9 +873,9 @@ void Plugin::ComputeAndRenderClosestApproaches(
                  apoapsides_trajectory,
                  periapsides_trajectory);
   closest_approaches =
-      RenderBarycentricTrajectoryInWorld(periapsides_trajectory.Begin(),
-                                         periapsides_trajectory.End(),
-                                         sun_world_position);
+      RenderBarycentricPointsInWorld(periapsides_trajectory.Begin(),
+                                     periapsides_trajectory.End(),
+                                     sun_world_position);
 }
 
 void Plugin::ComputeAndRenderNodes(
@@ -798,6 +907,37 @@ void Plugin::SetPredictionLength(Time const& t) {
   prediction_length_ = t;
 }
 
+void Plugin::SetMaxWorkers(int const max_workers) {
+  CHECK_LE(1, max_workers);
+  if (max_workers > 1) {
+    thread_pool_ = std::make_unique<ThreadPool>(max_workers);
+  } else {
+    thread_pool_.reset();
+  }
+  if (!initializing_) {
+    ephemeris_->set_max_reanimation_workers(max_workers);
+  }
+}
+
+void Plugin::SetEphemerisProlongationHorizon(Time const& horizon) {
+  CHECK_LE(Time(), horizon);
+  ephemeris_prolongation_horizon_ = horizon;
+  if (horizon == Time()) {
+    ephemeris_prolonger_.reset();
+  } else if (!initializing_) {
+    RequestEphemerisProlongation();
+  }
+}
+
+void Plugin::SetCompactEphemerisSerialization(bool const compact) {
+  compact_ephemeris_serialization_ = compact;
+}
+
+void Plugin::SetEphemerisSeriesDirectory(
+    std::experimental::filesystem::path const& directory) {
+  ephemeris_series_directory_ = directory;
+}
+
 void Plugin::SetPredictionAdaptiveStepParameters(
     Ephemeris<Barycentric>::AdaptiveStepParameters const&
         prediction_adaptive_step_parameters) {
@@ -873,6 +1013,7 @@ Plugin::NewBodySurfaceNavigationFrame(
 void Plugin::SetPlottingFrame(
     not_null<std::unique_ptr<NavigationFrame>> plotting_frame) {
   plotting_frame_ = std::move(plotting_frame);
+  rendering_caches_.clear();
 }
 
 not_null<NavigationFrame const*> Plugin::GetPlottingFrame() const {
@@ -1104,7 +1245,33 @@ void Plugin::WriteToMessage(
     (*message->mutable_part_id_to_vessel())[part_id] = vessel_to_guid[vessel];
   }
 
-  ephemeris_->WriteToMessage(message->mutable_ephemeris());
+  if (compact_ephemeris_serialization_) {
+    // Only the part of the ephemeris covered by the psychohistories is
+    // recomputed when reading.
+    Instant desired_t_min = current_time_;
+    for (auto const& pair : vessels_) {
+      not_null<Vessel*> const vessel = pair.second.get();
+      desired_t_min =
+          std::min(desired_t_min, vessel->psychohistory().Begin().time());
+    }
+    ephemeris_->WriteCheckpointsToMessage(message->mutable_ephemeris(),
+                                          desired_t_min);
+  } else if (!ephemeris_series_directory_.empty()) {
+    // The name of the file depends on the identifier chosen by the ephemeris,
+    // so the file is written under a temporary name and renamed afterwards.
+    auto const temporary_file =
+        ephemeris_series_directory_ / "ephemeris_series.tmp";
+    ephemeris_->WriteToMessage(message->mutable_ephemeris(), temporary_file);
+    std::error_code error;
+    std::experimental::filesystem::rename(
+        temporary_file,
+        EphemerisSeriesFile(ephemeris_series_directory_,
+                            message->ephemeris().series_file_identifier()),
+        error);
+    CHECK(!error) << temporary_file << ": " << error.message();
+  } else {
+    ephemeris_->WriteToMessage(message->mutable_ephemeris());
+  }
 
   history_parameters_.WriteToMessage(message->mutable_history_parameters());
   prolongation_parameters_.WriteToMessage(
@@ -1129,6 +1296,14 @@ void Plugin::WriteToMessage(
 
 not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
     serialization::Plugin const& message) {
+  return ReadFromMessage(message,
+                         /*ephemeris_series_directory=*/
+                         std::experimental::filesystem::path());
+}
+
+not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
+    serialization::Plugin const& message,
+    std::experimental::filesystem::path const& ephemeris_series_directory) {
   LOG(INFO) << __FUNCTION__;
 
   auto const history_parameters =
@@ -1145,8 +1320,18 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
                                          prolongation_parameters,
                                          prediction_parameters));
 
-  plugin->ephemeris_ =
-      Ephemeris<Barycentric>::ReadFromMessage(message.ephemeris());
+  if (message.ephemeris().has_series_file_identifier()) {
+    CHECK(!ephemeris_series_directory.empty())
+        << "The series of the ephemeris are in a file but no directory was "
+        << "given";
+    plugin->ephemeris_ = Ephemeris<Barycentric>::ReadFromMessage(
+        message.ephemeris(),
+        EphemerisSeriesFile(ephemeris_series_directory,
+                            message.ephemeris().series_file_identifier()));
+  } else {
+    plugin->ephemeris_ =
+        Ephemeris<Barycentric>::ReadFromMessage(message.ephemeris());
+  }
   ReadCelestialsFromMessages(*plugin->ephemeris_,
                              message.celestial(),
                              plugin->celestials_);
@@ -1221,6 +1406,15 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
   return std::move(plugin);
 }
 
+std::experimental::filesystem::path Plugin::EphemerisSeriesFile(
+    std::experimental::filesystem::path const& directory,
+    std::uint64_t const series_file_identifier) {
+  std::ostringstream name;
+  name << "ephemeris_series_" << std::hex << std::setfill('0')
+       << std::setw(16) << series_file_identifier << ".bin";
+  return directory / name.str();
+}
+
 std::unique_ptr<Ephemeris<Barycentric>> Plugin::NewEphemeris(
     std::vector<
         not_null<std::unique_ptr<RotatingBody<Barycentric> const>>>&& bodies,
@@ -1318,6 +1512,24 @@ void Plugin::UpdatePlanetariumRotation() {
       to_planetarium;
 }
 
+void Plugin::RequestEphemerisProlongation() {
+  if (ephemeris_prolongation_horizon_ == Time()) {
+    return;
+  }
+  if (ephemeris_prolonger_ == nullptr) {
+    ephemeris_prolonger_ =
+        std::make_unique<EphemerisProlonger<Barycentric>>(ephemeris_.get());
+  }
+  Instant t = current_time_ + ephemeris_prolongation_horizon_;
+  for (auto const& pair : vessels_) {
+    Vessel const& vessel = *pair.second;
+    if (vessel.has_flight_plan()) {
+      t = std::max(t, vessel.flight_plan().desired_final_time());
+    }
+  }
+  ephemeris_prolonger_->RequestProlongation(t);
+}
+
 Vector<double, World> Plugin::FromVesselFrenetFrame(
     Vessel const& vessel,
     Vector<double, Frenet<Navigation>> const& vector) const {
@@ -1388,6 +1600,69 @@ std::uint64_t Plugin::FingerprintCelestialJacobiKeplerian(
   return Fingerprint2011(serialized.c_str(), serialized.size());
 }
 
+not_null<std::unique_ptr<DiscreteTrajectory<World>>>
+Plugin::RenderBarycentricPointsInWorld(
+    DiscreteTrajectory<Barycentric>::Iterator const& begin,
+    DiscreteTrajectory<Barycentric>::Iterator const& end,
+    Position<World> const& sun_world_position) const {
+  auto const trajectory_in_navigation =
+      RenderBarycentricTrajectoryInNavigation(begin, end);
+  auto trajectory_in_world =
+      RenderNavigationTrajectoryInWorld(trajectory_in_navigation->Begin(),
+                                        trajectory_in_navigation->End(),
+                                        sun_world_position);
+  return trajectory_in_world;
+}
+
+Plugin::RenderingCache& Plugin::UpdatedRenderingCache(
+    DiscreteTrajectory<Barycentric> const& trajectory) const {
+  NavigationFrame const& plotting_frame = *GetPlottingFrame();
+  auto const last = trajectory.last();
+  auto begin = trajectory.Begin();
+
+  // The cache may be extended if it doesn't start before the trajectory (it is
+  // trimmed when the beginning of the trajectory is forgotten) and if the
+  // trajectory still has, before its last point, the last point that was
+  // cached.
+  auto it = rendering_caches_.find(&trajectory);
+  if (it != rendering_caches_.end()) {
+    RenderingCache const& cache = it->second;
+    bool is_valid = false;
+    if (cache.last_degrees_of_freedom && !cache.decimator.empty() &&
+        begin.time() <= cache.decimator.retained().Begin().time()) {
+      auto const last_cached = trajectory.Find(cache.decimator.last_time());
+      if (last_cached != trajectory.End() && last_cached != last &&
+          last_cached.degrees_of_freedom() == *cache.last_degrees_of_freedom) {
+        begin = last_cached;
+        ++begin;
+        is_valid = true;
+      }
+    }
+    if (!is_valid) {
+      VLOG(1) << "Invalidating the rendering cache of a "
+              << trajectory.Size() << "-point trajectory";
+      rendering_caches_.erase(it);
+      it = rendering_caches_.end();
+    }
+  }
+  if (it == rendering_caches_.end()) {
+    it = rendering_caches_.emplace(std::piecewise_construct,
+                                   std::forward_as_tuple(&trajectory),
+                                   std::forward_as_tuple(rendering_tolerance))
+             .first;
+  }
+
+  RenderingCache& cache = it->second;
+  for (auto point = begin; point != last; ++point) {
+    cache.decimator.Append(
+        point.time(),
+        plotting_frame.ToThisFrameAtTime(point.time())(
+            point.degrees_of_freedom()));
+    cache.last_degrees_of_freedom = point.degrees_of_freedom();
+  }
+  return cache;
+}
+
 not_null<std::unique_ptr<DiscreteTrajectory<Navigation>>>
 Plugin::RenderBarycentricTrajectoryInNavigation(
     DiscreteTrajectory<Barycentric>::Iterator const& begin,
@@ -1475,6 +1750,9 @@ bool Plugin::is_loaded(not_null<Vessel*> vessel) const {
   return Contains(loaded_vessels_, vessel);
 }
 
+Plugin::RenderingCache::RenderingCache(Angle const& tolerance)
+    : decimator(tolerance) {}
+
 Plugin::Target::Target(not_null<Vessel*> vessel,
                        not_null<Ephemeris<Barycentric> const*> ephemeris,
                        not_null<Celestial const*> const celestial)
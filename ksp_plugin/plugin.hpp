@@ -1,6 +1,8 @@
 ﻿
 #pragma once
 
+#include <cstdint>
+#include <experimental/filesystem>
 #include <limits>
 #include <list>
 #include <map>
@@ -11,6 +13,7 @@
 #include <vector>
 
 #include "base/monostable.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/affine_map.hpp"
 #include "geometry/named_quantities.hpp"
 #include "geometry/point.hpp"
@@ -24,10 +27,12 @@
 #include "physics/discrete_trajectory.hpp"
 #include "physics/dynamic_frame.hpp"
 #include "physics/ephemeris.hpp"
+#include "physics/ephemeris_prolonger.hpp"
 #include "physics/frame_field.hpp"
 #include "physics/hierarchical_system.hpp"
 #include "physics/kepler_orbit.hpp"
 #include "physics/rotating_body.hpp"
+#include "physics/trajectory_decimator.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/si.hpp"
@@ -39,6 +44,7 @@ namespace internal_plugin {
 
 using base::not_null;
 using base::Subset;
+using base::ThreadPool;
 using geometry::AffineMap;
 using geometry::Displacement;
 using geometry::Instant;
@@ -55,11 +61,13 @@ using physics::DegreesOfFreedom;
 using physics::DiscreteTrajectory;
 using physics::DynamicFrame;
 using physics::Ephemeris;
+using physics::EphemerisProlonger;
 using physics::FrameField;
 using physics::Frenet;
 using physics::HierarchicalSystem;
 using physics::RelativeDegreesOfFreedom;
 using physics::RotatingBody;
+using physics::TrajectoryDecimator;
 using quantities::Angle;
 using quantities::Force;
 using quantities::Length;
@@ -265,12 +273,29 @@ class Plugin {
   // Updates the prediction for the vessel with guid |vessel_guid|.
   void UpdatePrediction(GUID const& vessel_guid) const;
 
+  // Updates the predictions for the vessels with guids |vessel_guids|.  The
+  // predictions are computed concurrently if |SetMaxWorkers| was called with
+  // more than one worker; the results do not depend on the number of workers.
+  // They may differ from those of calling |UpdatePrediction| for each vessel:
+  // the ephemeris is prolonged once, up front, without the limit on the number
+  // of steps per frame, and for an infinite prediction length all the
+  // predictions end at the same time, whereas successive calls to
+  // |UpdatePrediction| would each prolong the ephemeris.
+  virtual void UpdatePredictions(std::vector<GUID> const& vessel_guids) const;
+
   virtual void CreateFlightPlan(GUID const& vessel_guid,
                                 Instant const& final_time,
                                 Mass const& initial_mass) const;
 
   // Returns a |Trajectory| object corresponding to the trajectory defined by
-  // |begin| and |end|, as seen in the current |plotting_frame_|.
+  // |begin| and |end|, as seen in the current |plotting_frame_|.  The result is
+  // decimated to the points needed to draw the trajectory as a polyline with
+  // an angular error below |rendering_tolerance|, which only makes sense for
+  // a continuous trajectory.  When rendering an entire vessel psychohistory the
+  // decimated points are cached, so that only the points appended since the
+  // last call need to be transformed to the plotting frame.  Does not wait for
+  // the ephemeris to be reanimated: the points that it doesn't cover yet are
+  // omitted.
   virtual not_null<std::unique_ptr<DiscreteTrajectory<World>>>
   RenderBarycentricTrajectoryInWorld(
       DiscreteTrajectory<Barycentric>::Iterator const& begin,
@@ -306,6 +331,37 @@ class Plugin {
 
   virtual void SetPredictionLength(Time const& t);
 
+  // Sets the number of threads used by |UpdatePredictions|.  The default, 1,
+  // computes the predictions on the calling thread.  After initialization,
+  // also bounds the number of threads used to recompute the ephemeris after a
+  // compact save is read.
+  virtual void SetMaxWorkers(int max_workers);
+
+  // Sets how far ahead of the current time the ephemeris is prolonged on a
+  // background thread, so that |AdvanceTime|, the predictions and the flight
+  // plans rarely have to wait for the ephemeris to be prolonged.  The ephemeris
+  // is also prolonged until the end of the longest flight plan.  The default,
+  // 0, disables the background prolongation.
+  virtual void SetEphemerisProlongationHorizon(Time const& horizon);
+
+  // If |compact| is true, |WriteToMessage| only stores the checkpoints of the
+  // ephemeris.  When the plugin is read, the ephemeris is recomputed in the
+  // background from the beginning of the oldest psychohistory, and the
+  // recomputed part is only waited for when a trajectory that needs it is
+  // rendered.  The default, false, stores the ephemeris in full.
+  virtual void SetCompactEphemerisSerialization(bool compact);
+
+  // If |directory| is not empty, |WriteToMessage| writes the Чебышёв series of
+  // the ephemeris to a file in |directory| instead of storing them in the
+  // message.  The name of the file is derived from the message, so saves made
+  // at different times don't overwrite each other's files.  The message must
+  // then be read by passing the same |directory| to |ReadFromMessage|, which
+  // maps the file instead of deserializing the series.  Ignored if the
+  // serialization is compact.  The default, empty, stores the series in the
+  // message.
+  virtual void SetEphemerisSeriesDirectory(
+      std::experimental::filesystem::path const& directory);
+
   virtual void SetPredictionAdaptiveStepParameters(
       Ephemeris<Barycentric>::AdaptiveStepParameters const&
           prediction_adaptive_step_parameters);
@@ -364,6 +420,17 @@ class Plugin {
   virtual void WriteToMessage(not_null<serialization::Plugin*> message) const;
   static not_null<std::unique_ptr<Plugin>> ReadFromMessage(
       serialization::Plugin const& message);
+  // Same as above, but the Чебышёв series of the ephemeris may be in a file in
+  // |ephemeris_series_directory|, see |SetEphemerisSeriesDirectory|.
+  static not_null<std::unique_ptr<Plugin>> ReadFromMessage(
+      serialization::Plugin const& message,
+      std::experimental::filesystem::path const& ephemeris_series_directory);
+
+  // The file in |directory| that holds the Чебышёв series of an ephemeris
+  // written with the given |series_file_identifier|.
+  static std::experimental::filesystem::path EphemerisSeriesFile(
+      std::experimental::filesystem::path const& directory,
+      std::uint64_t series_file_identifier);
 
  protected:
   // May be overriden in tests to inject a mock.
@@ -388,6 +455,17 @@ class Plugin {
       std::map<Index, DegreesOfFreedom<Barycentric>>;
   using Trajectories = std::vector<not_null<DiscreteTrajectory<Barycentric>*>>;
 
+  // The decimated rendering in |Navigation| of a trajectory, excluding its last
+  // point which may not be authoritative.
+  struct RenderingCache final {
+    explicit RenderingCache(Angle const& tolerance);
+    TrajectoryDecimator<Navigation> decimator;
+    // The degrees of freedom of the last point appended to |decimator|, used to
+    // detect that the trajectory was changed before that point.
+    std::experimental::optional<DegreesOfFreedom<Barycentric>>
+        last_degrees_of_freedom;
+  };
+
   // This constructor should only be used during deserialization.
   Plugin(Ephemeris<Barycentric>::FixedStepParameters const& history_parameters,
          Ephemeris<Barycentric>::AdaptiveStepParameters const&
@@ -411,6 +489,11 @@ class Plugin {
   // whenever |main_body_| or |planetarium_rotation_| changes.
   void UpdatePlanetariumRotation();
 
+  // Requests the prolongation of |ephemeris_| by |ephemeris_prolonger_|,
+  // creating the latter if needed.  Has no effect if the background
+  // prolongation is disabled.
+  void RequestEphemerisProlongation();
+
   // Utilities for |AdvanceTime|.
 
   Vector<double, World> FromVesselFrenetFrame(
@@ -434,6 +517,21 @@ class Plugin {
           physics::KeplerianElements<Barycentric>> const& keplerian_elements,
       RotatingBody<Barycentric> const& body);
 
+  // Same as |RenderBarycentricTrajectoryInWorld|, but without decimation.  For
+  // use with isolated points such as apsides.
+  not_null<std::unique_ptr<DiscreteTrajectory<World>>>
+  RenderBarycentricPointsInWorld(
+      DiscreteTrajectory<Barycentric>::Iterator const& begin,
+      DiscreteTrajectory<Barycentric>::Iterator const& end,
+      Position<World> const& sun_world_position) const;
+
+  // Returns the rendering cache of |trajectory|, which must be a nonempty
+  // psychohistory, after extending it with the points appended to |trajectory|
+  // since the last call, or rebuilding it if |trajectory| was otherwise
+  // modified.
+  RenderingCache& UpdatedRenderingCache(
+      DiscreteTrajectory<Barycentric> const& trajectory) const;
+
   // Converts a trajectory from |Barycentric| to |Navigation|.
   not_null<std::unique_ptr<DiscreteTrajectory<Navigation>>>
   RenderBarycentricTrajectoryInNavigation(
@@ -487,12 +585,21 @@ class Plugin {
 
   // Null if and only if |initializing_|.
   std::unique_ptr<Ephemeris<Barycentric>> ephemeris_;
+  // Null if the background prolongation is disabled.  Declared after
+  // |ephemeris_| so that its thread is stopped before |ephemeris_| is
+  // destroyed.
+  std::unique_ptr<EphemerisProlonger<Barycentric>> ephemeris_prolonger_;
 
   // The parameters for computing the various trajectories.
   Ephemeris<Barycentric>::FixedStepParameters history_parameters_;
   Ephemeris<Barycentric>::AdaptiveStepParameters prolongation_parameters_;
   Ephemeris<Barycentric>::AdaptiveStepParameters prediction_parameters_;
   Time prediction_length_ = 1 * Hour;
+  // The threads used by |UpdatePredictions|.  Null if there is a single worker.
+  std::unique_ptr<ThreadPool> thread_pool_;
+  Time ephemeris_prolongation_horizon_;
+  bool compact_ephemeris_serialization_ = false;
+  std::experimental::filesystem::path ephemeris_series_directory_;
 
   // Whether initialization is ongoing.
   base::Monostable initializing_;
@@ -521,6 +628,12 @@ class Plugin {
   };
   std::experimental::optional<Target> target_;
 
+  // The rendering caches of the vessel psychohistories in the current plotting
+  // frame, keyed by psychohistory.  Cleared when the plotting frame changes,
+  // trimmed when histories are forgotten.
+  mutable std::map<not_null<DiscreteTrajectory<Barycentric> const*>,
+                   RenderingCache> rendering_caches_;
+
   // Used for detecting and patching the stock system.
   std::set<std::uint64_t> celestial_jacobi_keplerian_fingerprints_;
   bool is_ksp_stock_system_ = false;
@@ -22,6 +22,7 @@ using base::make_not_null_unique;
 using geometry::BarycentreCalculator;
 using geometry::Position;
 using quantities::IsFinite;
+using quantities::Length;
 using quantities::Time;
 
 Vessel::Vessel(GUID const& guid,
@@ -263,7 +264,21 @@ void Vessel::UpdatePrediction(Instant const& last_time) {
   CHECK(!psychohistory_->Empty());
   auto const last = psychohistory_->last();
   prediction_->Append(last.time(), last.degrees_of_freedom());
-  FlowPrediction(last_time);
+  // The merging of the pieces and the thinning of the steps each use a tenth
+  // of the integration tolerance, so that they don't noticeably degrade the
+  // accuracy of the prediction.
+  Length const tolerance =
+      0.1 * prediction_adaptive_step_parameters_.length_integration_tolerance();
+  DenseTrajectory<Barycentric> dense_prediction(tolerance);
+  FlowPrediction(last_time, &dense_prediction);
+  if (!dense_prediction.empty()) {
+    // Only keep the steps of the flow that are needed to interpolate the dense
+    // prediction.  They are exact states of the integrator.
+    auto const steps = std::move(prediction_);
+    prediction_ = make_not_null_unique<DiscreteTrajectory<Barycentric>>();
+    prediction_->Append(last.time(), last.degrees_of_freedom());
+    dense_prediction.Thin(*steps, tolerance, prediction_.get());
+  }
 }
 
 DiscreteTrajectory<Barycentric> const& Vessel::psychohistory() const {
@@ -375,14 +390,17 @@ void Vessel::AppendToPsychohistory(
   psychohistory_is_authoritative_ = authoritative;
 }
 
-void Vessel::FlowPrediction(Instant const& time) {
+void Vessel::FlowPrediction(
+    Instant const& time,
+    not_null<DenseTrajectory<Barycentric>*> const dense_prediction) {
   if (time > prediction_->last().time()) {
     bool const finite_time = IsFinite(time - prediction_->last().time());
     Instant const t = finite_time ? time : ephemeris_->t_max();
     // This will not prolong the ephemeris if |time| is infinite (but it may do
     // so if it is finite).
-    bool const reached_t = ephemeris_->FlowWithAdaptiveStep(
+    bool const reached_t = ephemeris_->FlowWithDenseOutput(
         prediction_.get(),
+        dense_prediction,
         Ephemeris<Barycentric>::NoIntrinsicAcceleration,
         t,
         prediction_adaptive_step_parameters_,
@@ -390,8 +408,9 @@ void Vessel::FlowPrediction(Instant const& time) {
         /*last_point_only=*/false);
     if (!finite_time && reached_t) {
       // This will prolong the ephemeris by |max_ephemeris_steps_per_frame|.
-      ephemeris_->FlowWithAdaptiveStep(
+      ephemeris_->FlowWithDenseOutput(
         prediction_.get(),
+        dense_prediction,
         Ephemeris<Barycentric>::NoIntrinsicAcceleration,
         time,
         prediction_adaptive_step_parameters_,
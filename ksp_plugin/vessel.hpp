@@ -12,6 +12,7 @@
 #include "ksp_plugin/flight_plan.hpp"
 #include "ksp_plugin/part.hpp"
 #include "ksp_plugin/pile_up.hpp"
+#include "physics/dense_trajectory.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/ephemeris.hpp"
 #include "physics/massless_body.hpp"
@@ -27,6 +28,7 @@ using base::not_null;
 using geometry::Instant;
 using geometry::Vector;
 using physics::DegreesOfFreedom;
+using physics::DenseTrajectory;
 using physics::DiscreteTrajectory;
 using physics::Ephemeris;
 using physics::MasslessBody;
@@ -136,6 +138,10 @@ class Vessel {
   // Deletes the |flight_plan_|.  Performs no action unless |has_flight_plan()|.
   virtual void DeleteFlightPlan();
 
+  // Recomputes the prediction from the end of the psychohistory to
+  // |last_time|.  The prediction is integrated with dense output and only
+  // keeps the steps that its cubic interpolation requires to stay within the
+  // length integration tolerance.
   virtual void UpdatePrediction(Instant const& last_time);
 
   virtual DiscreteTrajectory<Barycentric> const& psychohistory() const;
@@ -165,7 +171,11 @@ class Vessel {
       DegreesOfFreedom<Barycentric> const& degrees_of_freedom,
       bool authoritative);
 
-  void FlowPrediction(Instant const& time);
+  // Flows the prediction to |time|, appending the steps of the integration to
+  // |prediction_| and the corresponding pieces to |dense_prediction|, which
+  // must end at the last point of |prediction_|.
+  void FlowPrediction(Instant const& time,
+                      not_null<DenseTrajectory<Barycentric>*> dense_prediction);
 
   // Returns the last authoritative point of the psychohistory.
   DiscreteTrajectory<Barycentric>::Iterator last_authoritative() const;
@@ -95,34 +95,42 @@ public enum Style {
     }
   }
 
+  // Returns the positions from the current point of |trajectory_iterator| to
+  // its end, fetched with a single call to the plugin, and deletes the
+  // iterator.
+  public static XYZ[] FillAndDeleteXYZs(IntPtr trajectory_iterator) {
+    try {
+      var xyzs = new XYZ[trajectory_iterator.IteratorSize()];
+      int filled = trajectory_iterator.IteratorFillXYZs(xyzs, xyzs.Length);
+      Array.Resize(ref xyzs, filled);
+      return xyzs;
+    } finally {
+      Interface.IteratorDelete(ref trajectory_iterator);
+    }
+  }
+
   public static void RenderAndDeleteTrajectory(IntPtr trajectory_iterator,
                                                UnityEngine.Color colour,
                                                Style style) {
-    try {
-      Vector3d? previous_point = null;
-
-      UnityEngine.GL.Color(colour);
-      int size = trajectory_iterator.IteratorSize();
-
-      for (int i = 0;
-           !trajectory_iterator.IteratorAtEnd();
-           trajectory_iterator.IteratorIncrement(), ++i) {
-        Vector3d current_point = (Vector3d)trajectory_iterator.IteratorGetXYZ();
-        if (previous_point.HasValue) {
-          if (style == Style.FADED) {
-            colour.a = (float)(4 * i + size) / (float)(5 * size);
-            UnityEngine.GL.Color(colour);
-          }
-          if (style != Style.DASHED || i % 2 == 1) {
-            AddSegment(previous_point.Value,
-                       current_point,
-                       hide_behind_bodies : true);
-          }
-        }
-        previous_point = current_point;
+    RenderTrajectory(FillAndDeleteXYZs(trajectory_iterator), colour, style);
+  }
+
+  public static void RenderTrajectory(XYZ[] trajectory,
+                                      UnityEngine.Color colour,
+                                      Style style) {
+    UnityEngine.GL.Color(colour);
+    int size = trajectory.Length;
+
+    for (int i = 1; i < size; ++i) {
+      if (style == Style.FADED) {
+        colour.a = (float)(4 * i + size) / (float)(5 * size);
+        UnityEngine.GL.Color(colour);
+      }
+      if (style != Style.DASHED || i % 2 == 1) {
+        AddSegment((Vector3d)trajectory[i - 1],
+                   (Vector3d)trajectory[i],
+                   hide_behind_bodies : true);
       }
-    } finally {
-      Interface.IteratorDelete(ref trajectory_iterator);
     }
   }
 
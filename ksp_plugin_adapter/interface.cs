@@ -42,7 +42,8 @@ internal static partial class Interface {
   [DllImport(dllName           : Interface.dll_path,
              EntryPoint        = "principia__ActivateRecorder",
              CallingConvention = CallingConvention.Cdecl)]
-  internal static extern void ActivateRecorder(bool activate);
+  internal static extern void ActivateRecorder(bool activate,
+                                               bool asynchronous);
 
   [DllImport(dllName           : dll_path,
              EntryPoint        = "principia__InitGoogleLogging",
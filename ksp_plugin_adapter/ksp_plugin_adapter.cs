@@ -16,7 +16,14 @@ public partial class PrincipiaPluginAdapter
     : ScenarioModule,
       WindowRenderer.ManagerInterface {
 
+  // Saves made before the binary serialization have their plugin under this
+  // key, hexadecimal-encoded.
   private const String principia_key = "serialized_plugin";
+  // The plugin is saved as LZ4-compressed binary frames, encoded in base 64
+  // with an alphabet that doesn't interfere with the syntax of config nodes.
+  private const String principia_binary_key = "serialized_plugin_binary";
+  private const String principia_compressor_key = "serialization_compressor";
+  private const String principia_compressor = "lz4";
   private const String principia_initial_state_config_name =
       "principia_initial_state";
   private const String principia_gravity_model_config_name =
@@ -60,6 +67,16 @@ public partial class PrincipiaPluginAdapter
        1 << 26, 1 << 27, 1 << 28, 1 << 29, double.PositiveInfinity};
   [KSPField(isPersistant = true)]
   private int history_length_index_ = 10;
+  // How far ahead of the current time the plugin prolongs the ephemeris on a
+  // background thread.  0 disables the background prolongation.
+  private readonly double[] ephemeris_prolongation_horizons_ =
+      {0, 1 << 10, 1 << 12, 1 << 14, 1 << 16, 1 << 18, 1 << 20};
+  [KSPField(isPersistant = true)]
+  private int ephemeris_prolongation_horizon_index_ = 2;
+  // Whether the saves only contain the checkpoints of the ephemeris, which is
+  // then recomputed in the background when the save is loaded.
+  [KSPField(isPersistant = true)]
+  private bool compact_ephemeris_serialization_ = true;
 
   [KSPField(isPersistant = true)]
   private bool show_prediction_settings_ = true;
@@ -82,6 +99,11 @@ public partial class PrincipiaPluginAdapter
   // Whether a journal will be recorded when the plugin is next constructed.
   [KSPField(isPersistant = true)]
   private bool must_record_journal_ = false;
+  // Whether that journal is written on a background thread.  This slows the
+  // game down much less, but the last calls before a crash are then missing
+  // from the journal, so it cannot be used to replay the crash.
+  [KSPField(isPersistant = true)]
+  private bool record_journal_asynchronously_ = false;
 
   // Whether the plotting frame must be set to something convenient at the next
   // opportunity.
@@ -432,14 +454,28 @@ private enum PluginSource {
   public override void OnSave(ConfigNode node) {
     base.OnSave(node);
     if (PluginRunning()) {
-      String serialization;
+      // The series of the ephemeris are only written to a file if the
+      // serialization is not compact.
+      String ephemeris_series_directory = EphemerisSeriesDirectory();
+      if (!compact_ephemeris_serialization_) {
+        Directory.CreateDirectory(ephemeris_series_directory);
+      }
+      plugin_.SetEphemerisSeriesDirectory(ephemeris_series_directory);
+      node.AddValue(principia_compressor_key, principia_compressor);
       IntPtr serializer = IntPtr.Zero;
       for (;;) {
-        serialization = plugin_.SerializePlugin(ref serializer);
-        if (serialization == null) {
+        int serialization_size;
+        IntPtr serialization =
+            plugin_.SerializePluginBinary(ref serializer,
+                                          principia_compressor,
+                                          out serialization_size);
+        if (serialization == IntPtr.Zero) {
           break;
         }
-        node.AddValue(principia_key, serialization);
+        byte[] bytes = new byte[serialization_size];
+        Marshal.Copy(serialization, bytes, 0, serialization_size);
+        Interface.DeleteBytes(ref serialization);
+        node.AddValue(principia_binary_key, ToConfigNodeBase64(bytes));
       }
     }
   }
@@ -448,9 +484,10 @@ private enum PluginSource {
     base.OnLoad(node);
     if (must_record_journal_) {
       journaling_ = true;
-      Log.ActivateRecorder(true);
+      Log.ActivateRecorder(activate     : true,
+                           asynchronous : record_journal_asynchronously_);
     }
-    if (node.HasValue(principia_key)) {
+    if (node.HasValue(principia_binary_key) || node.HasValue(principia_key)) {
       Cleanup();
       SetRotatingFrameThresholds();
       RemoveBuggyTidalLocking();
@@ -460,15 +497,38 @@ private enum PluginSource {
       Log.SetVerboseLogging(verbose_logging_);
 
       IntPtr deserializer = IntPtr.Zero;
-      String[] serializations = node.GetValues(principia_key);
-      Log.Info("Serialization has " + serializations.Length + " chunks");
-      foreach (String serialization in serializations) {
-        Interface.DeserializePlugin(serialization,
-                                    serialization.Length,
-                                    ref deserializer,
-                                    ref plugin_);
+      if (node.HasValue(principia_binary_key)) {
+        String compressor = node.GetValue(principia_compressor_key) ?? "";
+        String ephemeris_series_directory = EphemerisSeriesDirectory();
+        String[] serializations = node.GetValues(principia_binary_key);
+        Log.Info("Serialization has " + serializations.Length + " chunks");
+        foreach (String serialization in serializations) {
+          byte[] bytes = FromConfigNodeBase64(serialization);
+          Interface.DeserializePluginBinary(bytes,
+                                            bytes.Length,
+                                            ref deserializer,
+                                            ref plugin_,
+                                            compressor,
+                                            ephemeris_series_directory);
+        }
+        Interface.DeserializePluginBinary(null,
+                                          0,
+                                          ref deserializer,
+                                          ref plugin_,
+                                          compressor,
+                                          ephemeris_series_directory);
+      } else {
+        String[] serializations = node.GetValues(principia_key);
+        Log.Info("Serialization has " + serializations.Length +
+                 " hexadecimal chunks");
+        foreach (String serialization in serializations) {
+          Interface.DeserializePlugin(serialization,
+                                      serialization.Length,
+                                      ref deserializer,
+                                      ref plugin_);
+        }
+        Interface.DeserializePlugin("", 0, ref deserializer, ref plugin_);
       }
-      Interface.DeserializePlugin("", 0, ref deserializer, ref plugin_);
 
       plotting_frame_selector_.reset(
           new ReferenceFrameSelector(this, 
@@ -477,6 +537,12 @@ private enum PluginSource {
                                      "Plotting frame"));
       must_set_plotting_frame_ = true;
       flight_planner_.reset(new FlightPlanner(this, plugin_));
+      plugin_.SetMaxWorkers(Math.Max(1, Environment.ProcessorCount - 1));
+      plugin_.SetEphemerisProlongationHorizon(
+          ephemeris_prolongation_horizons_[
+              ephemeris_prolongation_horizon_index_]);
+      plugin_.SetCompactEphemerisSerialization(
+          compact_ephemeris_serialization_);
 
       plugin_construction_ = DateTime.Now;
       plugin_source_ = PluginSource.SAVED_STATE;
@@ -801,7 +867,13 @@ private enum PluginSource {
       }
 
       if (ready_to_draw_active_vessel_trajectory) {
-        plugin_.UpdatePrediction(active_vessel.id.ToString());
+        var vessel_guids = new List<String>{active_vessel.id.ToString()};
+        var target_vessel = FlightGlobals.fetch.VesselTarget?.GetVessel();
+        if (target_vessel != null && target_vessel != active_vessel &&
+            plugin_.HasVessel(target_vessel.id.ToString())) {
+          vessel_guids.Add(target_vessel.id.ToString());
+        }
+        plugin_.UpdatePredictions(vessel_guids.ToArray(), vessel_guids.Count);
       }
       plugin_.ForgetAllHistoriesBefore(universal_time -
                                        history_lengths_[history_length_index_]);
@@ -1342,16 +1414,16 @@ private System.Collections.IEnumerator
               plugin_.FlightPlanNumberOfSegments(active_vessel_guid);
           for (int i = 0; i < number_of_segments; ++i) {
             bool is_burn = i % 2 == 1;
-            var rendered_segments = plugin_.FlightPlanRenderedSegment(
-                active_vessel_guid, sun_world_position, i);
-            if (rendered_segments.IteratorAtEnd()) {
+            XYZ[] rendered_segment = GLLines.FillAndDeleteXYZs(
+                plugin_.FlightPlanRenderedSegment(
+                    active_vessel_guid, sun_world_position, i));
+            if (rendered_segment.Length == 0) {
               Log.Info("Skipping segment " + i);
               continue;
             }
-            Vector3d position_at_start =
-                (Vector3d)rendered_segments.IteratorGetXYZ();
-            GLLines.RenderAndDeleteTrajectory(
-                rendered_segments,
+            Vector3d position_at_start = (Vector3d)rendered_segment[0];
+            GLLines.RenderTrajectory(
+                rendered_segment,
                 is_burn ? XKCDColors.OrangeRed : XKCDColors.BabyBlue,
                 is_burn ? GLLines.Style.SOLID : GLLines.Style.DASHED);
             if (is_burn) {
@@ -1569,6 +1641,17 @@ private System.Collections.IEnumerator
              "Max history length",
              ref changed_history_length,
              "{0:0.00e00} s");
+    bool compact_ephemeris_serialization = UnityEngine.GUILayout.Toggle(
+        value : compact_ephemeris_serialization_,
+        text  : "Save the ephemeris compactly (recomputed on load)");
+    if (compact_ephemeris_serialization !=
+        compact_ephemeris_serialization_) {
+      compact_ephemeris_serialization_ = compact_ephemeris_serialization;
+      if (PluginRunning()) {
+        plugin_.SetCompactEphemerisSerialization(
+            compact_ephemeris_serialization_);
+      }
+    }
     if (MapView.MapIsEnabled &&
         FlightGlobals.ActiveVessel?.orbitTargeter != null) {
       UnityEngine.GUILayout.BeginHorizontal();
@@ -1710,6 +1793,17 @@ private System.Collections.IEnumerator
              "Steps",
              ref changed_settings,
              "{0:0.00e0}");
+    bool changed_ephemeris_prolongation_horizon = false;
+    Selector(ephemeris_prolongation_horizons_,
+             ref ephemeris_prolongation_horizon_index_,
+             "Ephemeris lookahead",
+             ref changed_ephemeris_prolongation_horizon,
+             "{0:0.00e00} s");
+    if (changed_ephemeris_prolongation_horizon && PluginRunning()) {
+      plugin_.SetEphemerisProlongationHorizon(
+          ephemeris_prolongation_horizons_[
+              ephemeris_prolongation_horizon_index_]);
+    }
   }
 
   private void KSPFeatures() {
@@ -1819,11 +1913,15 @@ private System.Collections.IEnumerator
     must_record_journal_ = UnityEngine.GUILayout.Toggle(
         value   : must_record_journal_,
         text    : "Record journal (starts on load)");
+    record_journal_asynchronously_ = UnityEngine.GUILayout.Toggle(
+        value   : record_journal_asynchronously_,
+        text    : "Record asynchronously (faster, but misses a crash)");
     if (journaling_ && !must_record_journal_) {
       // We can deactivate a recorder at any time, but in order for replaying to
       // work, we should only activate one before creating a plugin.
       journaling_ = false;
-      Interface.ActivateRecorder(false);
+      Log.ActivateRecorder(activate     : false,
+                           asynchronous : record_journal_asynchronously_);
     }
   }
 
@@ -2016,6 +2114,35 @@ private System.Collections.IEnumerator
                                    "Plotting frame"));
     must_set_plotting_frame_ = true;
     flight_planner_.reset(new FlightPlanner(this, plugin_));
+    plugin_.SetMaxWorkers(Math.Max(1, Environment.ProcessorCount - 1));
+    plugin_.SetEphemerisProlongationHorizon(
+        ephemeris_prolongation_horizons_[
+            ephemeris_prolongation_horizon_index_]);
+    plugin_.SetCompactEphemerisSerialization(compact_ephemeris_serialization_);
+  }
+
+  // The directory, in the folder of the current save, where the Чебышёв series
+  // of the ephemeris are saved when the serialization is not compact.
+  private static String EphemerisSeriesDirectory() {
+    return Path.Combine(
+        Path.Combine(Path.Combine(KSPUtil.ApplicationRootPath, "saves"),
+                     HighLogic.SaveFolder),
+        "Principia");
+  }
+
+  // Base 64 with '-' and '_' instead of '+' and '/', and without padding: a
+  // "//" would start a comment in a config node, and a '=' separates the key
+  // from the value.
+  private static String ToConfigNodeBase64(byte[] bytes) {
+    return Convert.ToBase64String(bytes).TrimEnd('=')
+                                        .Replace('+', '-')
+                                        .Replace('/', '_');
+  }
+
+  private static byte[] FromConfigNodeBase64(String base64) {
+    String padded = base64.Replace('-', '+').Replace('_', '/');
+    padded = padded.PadRight(padded.Length + (4 - padded.Length % 4) % 4, '=');
+    return Convert.FromBase64String(padded);
   }
 
   private void SetRotatingFrameThresholds() {
@@ -46,23 +46,27 @@ public enum NodeSource {
                                      NodeSource source,
                                      Vessel vessel,
                                      CelestialBody celestial) {
-    for (; !apsis_iterator.IteratorAtEnd();
-         apsis_iterator.IteratorIncrement()) {
-      Vector3d apsis = (Vector3d)apsis_iterator.IteratorGetXYZ();
+    int size = apsis_iterator.IteratorSize();
+    var apsides = new XYZ[size];
+    var times = new double[size];
+    int filled = apsis_iterator.IteratorFillXYZs(apsides, size);
+    apsis_iterator.IteratorReset(0);
+    apsis_iterator.IteratorFillTimes(times, size);
+    Interface.IteratorDelete(ref apsis_iterator);
+    for (int i = 0; i < filled; ++i) {
       MapNodeProperties node_properties;
       node_properties.object_type = type;
       node_properties.vessel = vessel;
       node_properties.celestial = celestial;
-      node_properties.world_position = apsis;
+      node_properties.world_position = (Vector3d)apsides[i];
       node_properties.source = source;
-      node_properties.time = apsis_iterator.IteratorGetTime();
+      node_properties.time = times[i];
 
       if (pool_index_ == nodes_.Count) {
         AddMapNodeToPool();
       }
       properties_[nodes_[pool_index_++]] = node_properties;
     }
-    Interface.IteratorDelete(ref apsis_iterator);
   }
 
   private void AddMapNodeToPool() {
@@ -3,6 +3,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "astronomy/epoch.hpp"
 #include "base/not_null.hpp"
@@ -255,7 +256,7 @@ TEST_F(InterfaceDeathTest, ActivateRecorder) {
   EXPECT_DEATH({
     journal::Recorder::Deactivate();
     // Fails because the glog directory doesn't exist.
-    principia__ActivateRecorder(true);
+    principia__ActivateRecorder(/*activate=*/true, /*asynchronous=*/false);
   }, "glog.Principia.JOURNAL");
 }
 
@@ -599,6 +600,30 @@ TEST_F(InterfaceTest, RenderedPrediction) {
   }
   EXPECT_TRUE(principia__IteratorAtEnd(iterator));
 
+  // Random access.
+  principia__IteratorReset(iterator, 2);
+  EXPECT_EQ(21, principia__IteratorGetXYZ(iterator).x);
+  principia__IteratorReset(iterator, trajectory_size);
+  EXPECT_TRUE(principia__IteratorAtEnd(iterator));
+
+  // Bulk traversal.
+  principia__IteratorReset(iterator, 1);
+  std::vector<XYZ> xyzs(trajectory_size);
+  EXPECT_EQ(trajectory_size - 1,
+            principia__IteratorFillXYZs(iterator, xyzs.data(), xyzs.size()));
+  for (int i = 1; i < trajectory_size; ++i) {
+    EXPECT_EQ(1 + 10 * i, xyzs[i - 1].x);
+    EXPECT_EQ(2 + 20 * i, xyzs[i - 1].y);
+    EXPECT_EQ(3 + 30 * i, xyzs[i - 1].z);
+  }
+  EXPECT_TRUE(principia__IteratorAtEnd(iterator));
+  principia__IteratorReset(iterator, 0);
+  std::vector<QP> qps(2);
+  EXPECT_EQ(2, principia__IteratorFillQPs(iterator, qps.data(), qps.size()));
+  EXPECT_EQ(11, qps[1].q.x);
+  EXPECT_EQ(0, qps[1].p.x);
+  EXPECT_EQ(21, principia__IteratorGetXYZ(iterator).x);
+
   // Delete it.
   EXPECT_THAT(iterator, Not(IsNull()));
   principia__IteratorDelete(&iterator);
@@ -685,6 +710,19 @@ TEST_F(InterfaceTest, Iterator) {
 TEST_F(InterfaceTest, PredictionGettersAndSetters) {
   EXPECT_CALL(*plugin_, SetPredictionLength(42 * Second));
   principia__SetPredictionLength(plugin_.get(), 42);
+  EXPECT_CALL(*plugin_, SetMaxWorkers(4));
+  principia__SetMaxWorkers(plugin_.get(), 4);
+  char const* const vessel_guids[] = {"1", "2", "3"};
+  EXPECT_CALL(*plugin_, UpdatePredictions(ElementsAre("1", "2", "3")));
+  principia__UpdatePredictions(plugin_.get(), vessel_guids, 3);
+  EXPECT_CALL(*plugin_, SetEphemerisProlongationHorizon(3600 * Second));
+  principia__SetEphemerisProlongationHorizon(plugin_.get(), 3600);
+  EXPECT_CALL(*plugin_, SetCompactEphemerisSerialization(true));
+  principia__SetCompactEphemerisSerialization(plugin_.get(), true);
+  EXPECT_CALL(*plugin_,
+              SetEphemerisSeriesDirectory(
+                  std::experimental::filesystem::path("saves")));
+  principia__SetEphemerisSeriesDirectory(plugin_.get(), "saves");
 }
 
 TEST_F(InterfaceTest, NavballOrientation) {
@@ -836,6 +874,72 @@ TEST_F(InterfaceTest, DeserializePlugin) {
   principia__DeletePlugin(&plugin);
 }
 
+TEST_F(InterfaceTest, SerializePluginBinary) {
+  PullSerializer* serializer = nullptr;
+  principia::serialization::Plugin message;
+  message.ParseFromString(serialized_simple_plugin_);
+
+  EXPECT_CALL(*plugin_, WriteToMessage(_)).WillOnce(SetArgPointee<0>(message));
+  int serialization_size;
+  std::uint8_t const* serialization =
+      principia__SerializePluginBinary(plugin_.get(),
+                                       &serializer,
+                                       "",
+                                       &serialization_size);
+  std::int64_t const payload_size =
+      serialization[0] | (serialization[1] << 8) |
+      (serialization[2] << 16) | (serialization[3] << 24);
+  EXPECT_EQ(4 + payload_size, serialization_size);
+  EXPECT_EQ(serialized_simple_plugin_,
+            std::string(reinterpret_cast<char const*>(&serialization[4]),
+                        payload_size));
+  EXPECT_EQ(nullptr,
+            principia__SerializePluginBinary(plugin_.get(),
+                                             &serializer,
+                                             "",
+                                             &serialization_size));
+  EXPECT_EQ(0, serialization_size);
+  principia__DeleteBytes(&serialization);
+  EXPECT_THAT(serialization, IsNull());
+}
+
+TEST_F(InterfaceTest, DeserializePluginBinary) {
+  principia::serialization::Plugin message;
+  message.ParseFromString(serialized_simple_plugin_);
+  EXPECT_CALL(*plugin_, WriteToMessage(_))
+      .Times(2)
+      .WillRepeatedly(SetArgPointee<0>(message));
+
+  for (char const* const compressor : {"", "lz4"}) {
+    PullSerializer* serializer = nullptr;
+    PushDeserializer* deserializer = nullptr;
+    Plugin const* plugin = nullptr;
+    for (;;) {
+      int serialization_size;
+      std::uint8_t const* serialization =
+          principia__SerializePluginBinary(plugin_.get(),
+                                           &serializer,
+                                           compressor,
+                                           &serialization_size);
+      if (serialization == nullptr) {
+        break;
+      }
+      principia__DeserializePluginBinary(serialization,
+                                         serialization_size,
+                                         &deserializer,
+                                         &plugin,
+                                         compressor,
+                                         /*ephemeris_series_directory=*/"");
+      principia__DeleteBytes(&serialization);
+    }
+    principia__DeserializePluginBinary(nullptr, 0, &deserializer, &plugin,
+                                       compressor,
+                                       /*ephemeris_series_directory=*/"");
+    EXPECT_THAT(plugin, NotNull());
+    principia__DeletePlugin(&plugin);
+  }
+}
+
 TEST_F(InterfaceDeathTest, SettersAndGetters) {
   // We use EXPECT_EXITs in this test to avoid interfering with the execution of
   // the other tests.
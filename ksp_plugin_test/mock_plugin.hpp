@@ -69,6 +69,9 @@ class MockPlugin : public Plugin {
   MOCK_CONST_METHOD1(CelestialFromParent,
                      RelativeDegreesOfFreedom<AliceSun>(Index celestial_index));
 
+  MOCK_CONST_METHOD1(UpdatePredictions,
+                     void(std::vector<GUID> const& vessel_guids));
+
   MOCK_CONST_METHOD3(CreateFlightPlan,
                      void(GUID const& vessel_guid,
                           Instant const& final_time,
@@ -89,6 +92,12 @@ class MockPlugin : public Plugin {
 
   MOCK_METHOD1(SetPredictionLength, void(Time const& t));
 
+  MOCK_METHOD1(SetMaxWorkers, void(int max_workers));
+  MOCK_METHOD1(SetEphemerisProlongationHorizon, void(Time const& horizon));
+  MOCK_METHOD1(SetCompactEphemerisSerialization, void(bool compact));
+  MOCK_METHOD1(SetEphemerisSeriesDirectory,
+               void(std::experimental::filesystem::path const& directory));
+
   MOCK_METHOD1(SetPredictionAdaptiveStepParameters,
                void(Ephemeris<Barycentric>::AdaptiveStepParameters const&
                         prediction_adaptive_step_parameters));
@@ -726,6 +726,128 @@ TEST_F(PluginIntegrationTest, Prediction) {
       AllOf(Gt(2 * Milli(Metre)), Lt(3 * Milli(Metre))));
 }
 
+// Checks that the predictions computed concurrently are the same as those
+// computed serially, point by point.
+TEST_F(PluginIntegrationTest, ConcurrentPredictions) {
+  Index const sun = 0;
+  Index const planet = 1;
+  std::vector<GUID> const vessel_guids = {"1", "2", "3", "4", "5", "6"};
+
+  // Returns a plugin whose vessels have had their predictions updated with
+  // the given number of workers.
+  auto const make_plugin = [&vessel_guids, planet, sun](int const max_workers) {
+    auto plugin =
+        make_not_null_unique<Plugin>(Instant(), Instant(), 0 * Radian);
+    auto sun_body = make_not_null_unique<RotatingBody<Barycentric>>(
+        MassiveBody::Parameters(1 * SIUnit<GravitationalParameter>()),
+        RotatingBody<Barycentric>::Parameters(
+            /*mean_radius=*/1 * Metre,
+            /*reference_angle=*/1 * Radian,
+            /*reference_instant=*/astronomy::J2000,
+            /*angular_frequency=*/1 * Radian / Second,
+            /*right_ascension_of_pole=*/0 * Degree,
+            /*declination_of_pole=*/90 * Degree));
+    auto planet_body = make_not_null_unique<RotatingBody<Barycentric>>(
+        MassiveBody::Parameters(1e-3 * SIUnit<GravitationalParameter>()),
+        RotatingBody<Barycentric>::Parameters(
+            /*mean_radius=*/1e-3 * Metre,
+            /*reference_angle=*/1 * Radian,
+            /*reference_instant=*/astronomy::J2000,
+            /*angular_frequency=*/1 * Radian / Second,
+            /*right_ascension_of_pole=*/0 * Degree,
+            /*declination_of_pole=*/90 * Degree));
+    plugin->InsertCelestialAbsoluteCartesian(
+        sun,
+        /*parent_index=*/std::experimental::nullopt,
+        {Barycentric::origin, Velocity<Barycentric>()},
+        std::move(sun_body));
+    plugin->InsertCelestialAbsoluteCartesian(
+        planet,
+        sun,
+        {Barycentric::origin +
+             Displacement<Barycentric>({10 * Metre, 0 * Metre, 0 * Metre}),
+         Velocity<Barycentric>({0 * Metre / Second,
+                                std::sqrt(0.1) * Metre / Second,
+                                0 * Metre / Second})},
+        std::move(planet_body));
+    plugin->EndInitialization();
+
+    for (int i = 0; i < vessel_guids.size(); ++i) {
+      bool inserted;
+      plugin->InsertOrKeepVessel(vessel_guids[i],
+                                 vessel_name,
+                                 sun,
+                                 /*loaded=*/false,
+                                 inserted);
+      double const r = 1 + i;
+      plugin->InsertUnloadedPart(
+          part_id + i,
+          part_name,
+          vessel_guids[i],
+          {Displacement<AliceSun>({r * Metre, 0 * Metre, 0 * Metre}),
+           Velocity<AliceSun>({0 * Metre / Second,
+                               1 / std::sqrt(r) * Metre / Second,
+                               0 * Metre / Second})});
+    }
+    plugin->PrepareToReportCollisions();
+    plugin->FreeVesselsAndPartsAndCollectPileUps();
+
+    plugin->SetPlottingFrame(
+        plugin->NewBodyCentredNonRotatingNavigationFrame(sun));
+    plugin->SetPredictionLength(2 * π * Second);
+    Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters(
+        DormandElMikkawyPrince1986RKN434FM<Position<Barycentric>>(),
+        /*max_steps=*/1000,
+        /*length_integration_tolerance=*/1 * Milli(Metre),
+        /*speed_integration_tolerance=*/1 * Milli(Metre) / Second);
+    plugin->SetPredictionAdaptiveStepParameters(adaptive_step_parameters);
+    plugin->AdvanceTime(Instant() + 1e-10 * Second, 0 * Radian);
+
+    plugin->SetMaxWorkers(max_workers);
+    plugin->UpdatePredictions(vessel_guids);
+    return plugin;
+  };
+
+  auto const serial_plugin = make_plugin(/*max_workers=*/1);
+  auto const parallel_plugin = make_plugin(/*max_workers=*/4);
+  for (GUID const& vessel_guid : vessel_guids) {
+    auto const& serial_prediction =
+        serial_plugin->GetVessel(vessel_guid)->prediction();
+    auto const& parallel_prediction =
+        parallel_plugin->GetVessel(vessel_guid)->prediction();
+    EXPECT_LT(2, parallel_prediction.Size()) << vessel_guid;
+    ASSERT_EQ(serial_prediction.Size(), parallel_prediction.Size())
+        << vessel_guid;
+    for (auto serial_it = serial_prediction.Begin(),
+              parallel_it = parallel_prediction.Begin();
+         serial_it != serial_prediction.End();
+         ++serial_it, ++parallel_it) {
+      EXPECT_EQ(serial_it.time(), parallel_it.time()) << vessel_guid;
+      EXPECT_EQ(serial_it.degrees_of_freedom(),
+                parallel_it.degrees_of_freedom()) << vessel_guid;
+    }
+  }
+
+  // Updating again with the other number of workers doesn't change the
+  // predictions either.
+  parallel_plugin->SetMaxWorkers(1);
+  parallel_plugin->UpdatePredictions(vessel_guids);
+  serial_plugin->SetMaxWorkers(4);
+  serial_plugin->UpdatePredictions(vessel_guids);
+  for (GUID const& vessel_guid : vessel_guids) {
+    auto const& serial_prediction =
+        serial_plugin->GetVessel(vessel_guid)->prediction();
+    auto const& parallel_prediction =
+        parallel_plugin->GetVessel(vessel_guid)->prediction();
+    ASSERT_EQ(serial_prediction.Size(), parallel_prediction.Size())
+        << vessel_guid;
+    EXPECT_EQ(serial_prediction.last().time(),
+              parallel_prediction.last().time()) << vessel_guid;
+    EXPECT_EQ(serial_prediction.last().degrees_of_freedom(),
+              parallel_prediction.last().degrees_of_freedom()) << vessel_guid;
+  }
+}
+
 }  // namespace internal_plugin
 }  // namespace ksp_plugin
 }  // namespace principia
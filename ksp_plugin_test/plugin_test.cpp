@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <experimental/filesystem>
 #include <limits>
 #include <map>
 #include <memory>
@@ -97,6 +98,7 @@ using ::testing::Eq;
 using ::testing::Ge;
 using ::testing::Gt;
 using ::testing::InSequence;
+using ::testing::InvokeWithoutArgs;
 using ::testing::Le;
 using ::testing::Lt;
 using ::testing::Ref;
@@ -546,6 +548,25 @@ TEST_F(PluginTest, Serialization) {
             message.plotting_frame().GetExtension(
                 serialization::BodyCentredNonRotatingDynamicFrame::extension).
                     centre());
+
+  // Same round trip, with the series of the ephemeris in a file.
+  std::experimental::filesystem::path const directory = TEMP_DIR;
+  plugin->SetEphemerisSeriesDirectory(directory);
+  serialization::Plugin third_message;
+  plugin->WriteToMessage(&third_message);
+  ASSERT_TRUE(third_message.ephemeris().has_series_file_identifier());
+  EXPECT_LT(third_message.ByteSize(), message.ByteSize());
+  auto const series_file = Plugin::EphemerisSeriesFile(
+      directory, third_message.ephemeris().series_file_identifier());
+  EXPECT_TRUE(std::experimental::filesystem::exists(series_file));
+  {
+    // The file must be unmapped before it is removed.
+    auto const read_plugin = Plugin::ReadFromMessage(third_message, directory);
+    serialization::Plugin fourth_message;
+    read_plugin->WriteToMessage(&fourth_message);
+    EXPECT_EQ(message.SerializeAsString(), fourth_message.SerializeAsString());
+  }
+  std::experimental::filesystem::remove(series_file);
 }
 
 TEST_F(PluginTest, Initialization) {
@@ -888,6 +909,8 @@ TEST_F(PluginTest, ForgetAllHistoriesBeforeAfterPredictionFork) {
   EXPECT_CALL(plugin_->mock_ephemeris(), Prolong(_)).Times(AnyNumber());
   EXPECT_CALL(plugin_->mock_ephemeris(), FlowWithAdaptiveStep(_, _, _, _, _, _))
       .WillRepeatedly(DoAll(AppendToDiscreteTrajectory(dof), Return(true)));
+  EXPECT_CALL(plugin_->mock_ephemeris(), FlowWithDenseOutput(_, _, _, _, _, _, _))
+      .WillRepeatedly(DoAll(AppendToDenseTrajectory(dof), Return(true)));
   EXPECT_CALL(plugin_->mock_ephemeris(), FlowWithFixedStep(_, _))
       .WillRepeatedly(AppendToDiscreteTrajectory2(&trajectories[0], dof));
   EXPECT_CALL(plugin_->mock_ephemeris(), planetary_integrator())
@@ -934,6 +957,137 @@ TEST_F(PluginTest, ForgetAllHistoriesBeforeAfterPredictionFork) {
       plugin_->RenderBarycentricTrajectoryInWorld(prediction.Begin(),
                                                   prediction.End(),
                                                   World::origin);
+
+  // The second rendering of the psychohistory comes from the cache populated
+  // by the first one.
+  auto const& psychohistory = plugin_->GetVessel(guid)->psychohistory();
+  auto const rendered_psychohistory1 =
+      plugin_->RenderBarycentricTrajectoryInWorld(psychohistory.Begin(),
+                                                  psychohistory.End(),
+                                                  World::origin);
+  auto const rendered_psychohistory2 =
+      plugin_->RenderBarycentricTrajectoryInWorld(psychohistory.Begin(),
+                                                  psychohistory.End(),
+                                                  World::origin);
+  EXPECT_EQ(rendered_psychohistory1->Size(), rendered_psychohistory2->Size());
+  EXPECT_EQ(psychohistory.last().time(),
+            rendered_psychohistory2->last().time());
+}
+
+TEST_F(PluginTest, RenderingCache) {
+  GUID const guid = "Test Satellite";
+  PartId const part_id = 666;
+  auto const dof = DegreesOfFreedom<Barycentric>(Barycentric::origin,
+                                                 Velocity<Barycentric>());
+
+  std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories = {
+      make_not_null<DiscreteTrajectory<Barycentric>*>()};
+  auto instance = make_not_null_unique<MockFixedStepSizeIntegrator<
+      Ephemeris<Barycentric>::NewtonianMotionEquation>::MockInstance>();
+  EXPECT_CALL(plugin_->mock_ephemeris(), NewInstance(_, _, _))
+      .WillOnce(DoAll(SaveArg<0>(&trajectories),
+                      Return(ByMove(std::move(instance)))));
+  EXPECT_CALL(plugin_->mock_ephemeris(), t_max())
+      .WillRepeatedly(Return(Instant()));
+  EXPECT_CALL(plugin_->mock_ephemeris(), empty()).WillRepeatedly(Return(false));
+  EXPECT_CALL(plugin_->mock_ephemeris(), Prolong(_)).Times(AnyNumber());
+  EXPECT_CALL(plugin_->mock_ephemeris(), FlowWithAdaptiveStep(_, _, _, _, _, _))
+      .WillRepeatedly(DoAll(AppendToDiscreteTrajectory(dof), Return(true)));
+  EXPECT_CALL(plugin_->mock_ephemeris(), FlowWithFixedStep(_, _))
+      .WillRepeatedly(AppendToDiscreteTrajectory2(&trajectories[0], dof));
+  EXPECT_CALL(plugin_->mock_ephemeris(), planetary_integrator())
+      .WillRepeatedly(
+          ReturnRef(QuinlanTremaine1990Order12<Position<Barycentric>>()));
+  EXPECT_CALL(plugin_->mock_ephemeris(), ForgetBefore(_)).Times(1);
+
+  InsertAllSolarSystemBodies();
+  EXPECT_CALL(plugin_->mock_ephemeris(), WriteToMessage(_))
+      .WillOnce(SetArgPointee<0>(valid_ephemeris_message_));
+  plugin_->EndInitialization();
+
+  bool inserted;
+  plugin_->InsertOrKeepVessel(guid,
+                              "v" + guid,
+                              SolarSystemFactory::Earth,
+                              /*loaded=*/false,
+                              inserted);
+  plugin_->InsertUnloadedPart(
+      part_id,
+      "part",
+      guid,
+      RelativeDegreesOfFreedom<AliceSun>(satellite_initial_displacement_,
+                                         satellite_initial_velocity_));
+  plugin_->PrepareToReportCollisions();
+  plugin_->FreeVesselsAndPartsAndCollectPileUps();
+
+  Instant const& time = initial_time_ + 1 * Second;
+  plugin_->AdvanceTime(time, Angle());
+  for (int step = 1; step <= 10; ++step) {
+    KeepVessel(guid);
+    plugin_->AdvanceTime(HistoryTime(time, step), Angle());
+  }
+
+  // Count the evaluations of the plotting frame, which dominate the cost of
+  // rendering.
+  int evaluations = 0;
+  auto* const mock_dynamic_frame =
+      new MockDynamicFrame<Barycentric, Navigation>();
+  EXPECT_CALL(*mock_dynamic_frame, ToThisFrameAtTime(_))
+      .WillRepeatedly(DoAll(
+          InvokeWithoutArgs([&evaluations]() { ++evaluations; }),
+          Return(RigidMotion<Barycentric, Navigation>(
+              RigidTransformation<Barycentric, Navigation>::Identity(),
+              AngularVelocity<Barycentric>(),
+              Velocity<Barycentric>()))));
+  EXPECT_CALL(*mock_dynamic_frame, FromThisFrameAtTime(_))
+      .WillRepeatedly(Return(RigidMotion<Navigation, Barycentric>(
+          RigidTransformation<Navigation, Barycentric>::Identity(),
+          AngularVelocity<Navigation>(),
+          Velocity<Navigation>())));
+  plugin_->SetPlottingFrame(
+      std::unique_ptr<MockDynamicFrame<Barycentric, Navigation>>(
+          mock_dynamic_frame));
+
+  auto const& psychohistory = plugin_->GetVessel(guid)->psychohistory();
+  auto const render = [this, &psychohistory]() {
+    return plugin_->RenderBarycentricTrajectoryInWorld(psychohistory.Begin(),
+                                                       psychohistory.End(),
+                                                       World::origin);
+  };
+  ASSERT_LT(10, psychohistory.Size());
+
+  // The first rendering evaluates the frame at every point.
+  auto const rendered1 = render();
+  EXPECT_EQ(psychohistory.Size(), evaluations);
+
+  // The second rendering only evaluates the frame at the last point, which is
+  // not cached because it may not be authoritative.
+  evaluations = 0;
+  auto const rendered2 = render();
+  EXPECT_EQ(1, evaluations);
+  EXPECT_EQ(rendered1->Size(), rendered2->Size());
+  EXPECT_EQ(psychohistory.last().time(), rendered2->last().time());
+
+  // After time advances, only the new points are evaluated.
+  int const old_size = psychohistory.Size();
+  KeepVessel(guid);
+  plugin_->AdvanceTime(HistoryTime(time, 11), Angle());
+  ASSERT_LT(old_size, psychohistory.Size());
+  evaluations = 0;
+  auto const rendered3 = render();
+  EXPECT_THAT(evaluations, Le(psychohistory.Size() - old_size + 2));
+  EXPECT_EQ(psychohistory.last().time(), rendered3->last().time());
+
+  // Forgetting the beginning of the histories trims the cache instead of
+  // dropping it, so at most the new first point and the last point are
+  // evaluated.
+  plugin_->ForgetAllHistoriesBefore(HistoryTime(time, 5));
+  ASSERT_LT(2, psychohistory.Size());
+  evaluations = 0;
+  auto const rendered4 = render();
+  EXPECT_THAT(evaluations, Le(2));
+  EXPECT_EQ(psychohistory.Begin().time(), rendered4->Begin().time());
+  EXPECT_EQ(psychohistory.last().time(), rendered4->last().time());
 }
 
 TEST_F(PluginDeathTest, VesselFromParentError) {
@@ -213,9 +213,9 @@ TEST_F(VesselTest, AdvanceTime) {
 TEST_F(VesselTest, Prediction) {
   vessel_.PreparePsychohistory(astronomy::J2000);
 
-  EXPECT_CALL(ephemeris_, FlowWithAdaptiveStep(_, _, _, _, _, _))
+  EXPECT_CALL(ephemeris_, FlowWithDenseOutput(_, _, _, _, _, _, _))
       .WillOnce(
-          DoAll(AppendToDiscreteTrajectory(
+          DoAll(AppendToDenseTrajectory(
                     astronomy::J2000 + 1.0 * Second,
                     DegreesOfFreedom<Barycentric>(
                         Barycentric::origin +
@@ -264,9 +264,9 @@ TEST_F(VesselTest, PredictBeyondTheInfinite) {
       .WillOnce(Return(astronomy::J2000 + 0.5 * Second));
   EXPECT_CALL(
       ephemeris_,
-      FlowWithAdaptiveStep(_, _, astronomy::J2000 + 0.5 * Second, _, _, _))
+      FlowWithDenseOutput(_, _, _, astronomy::J2000 + 0.5 * Second, _, _, _))
       .WillOnce(
-          DoAll(AppendToDiscreteTrajectory(
+          DoAll(AppendToDenseTrajectory(
                     astronomy::J2000 + 0.5 * Second,
                     DegreesOfFreedom<Barycentric>(
                         Barycentric::origin +
@@ -279,9 +279,9 @@ TEST_F(VesselTest, PredictBeyondTheInfinite) {
                 Return(true)));
   EXPECT_CALL(
       ephemeris_,
-      FlowWithAdaptiveStep(_, _, astronomy::InfiniteFuture, _, _, _))
+      FlowWithDenseOutput(_, _, _, astronomy::InfiniteFuture, _, _, _))
       .WillOnce(
-          DoAll(AppendToDiscreteTrajectory(
+          DoAll(AppendToDenseTrajectory(
                     astronomy::J2000 + 1.0 * Second,
                     DegreesOfFreedom<Barycentric>(
                         Barycentric::origin +
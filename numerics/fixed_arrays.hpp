@@ -55,6 +55,11 @@ class FixedMatrix final {
   bool operator==(FixedMatrix const& right) const;
   FixedMatrix& operator=(std::initializer_list<Scalar> const& right);
 
+  // For  0 <= i < rows and 0 <= j < columns, the entry a_ij is accessed as
+  // |a[i][j]|.
+  Scalar* operator[](int index);
+  constexpr Scalar const* operator[](int index) const;
+
  private:
   std::array<Scalar, rows * columns> data_;
 
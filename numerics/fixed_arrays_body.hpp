@@ -92,6 +92,17 @@ FixedMatrix<Scalar, rows, columns>::operator=(
   return *this;
 }
 
+template<typename Scalar, int rows, int columns>
+Scalar* FixedMatrix<Scalar, rows, columns>::operator[](int const index) {
+  return &data_[index * columns];
+}
+
+template<typename Scalar, int rows, int columns>
+constexpr Scalar const* FixedMatrix<Scalar, rows, columns>::operator[](
+    int const index) const {
+  return &data_[index * columns];
+}
+
 template<typename ScalarLeft, typename ScalarRight, int rows, int columns>
 FixedVector<Product<ScalarLeft, ScalarRight>, rows> operator*(
     FixedMatrix<ScalarLeft, rows, columns> const& left,
@@ -70,6 +70,15 @@ TEST_F(FixedArraysTest, VectorIndexing) {
   EXPECT_EQ(-666, v3_[2]);
 }
 
+TEST_F(FixedArraysTest, MatrixIndexing) {
+  EXPECT_EQ(-8, m34_[0][0]);
+  EXPECT_EQ(-7, m34_[0][3]);
+  EXPECT_EQ(9, m34_[1][2]);
+  EXPECT_EQ(-9, m34_[2][3]);
+  m34_[2][1] = -666;
+  EXPECT_EQ(-666, m34_[2][1]);
+}
+
 TEST_F(FixedArraysTest, StrictlyLowerTriangularMatrixIndexing) {
   EXPECT_EQ(6, (FixedStrictlyLowerTriangularMatrix<double, 4>::dimension));
   EXPECT_EQ(1, l4_[1][0]);
@@ -29,6 +29,8 @@ class Hermite3 final {
   Derivative1 EvaluateDerivative(Argument const& argument) const;
 
   std::set<Argument> FindExtrema() const;
+  // The arguments where the polynomial vanishes, computed in closed form.
+  std::set<Argument> FindRoots() const;
 
  private:
   using Derivative2 = Derivative<Derivative1, Argument>;
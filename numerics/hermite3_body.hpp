@@ -65,6 +65,12 @@ std::set<Argument> Hermite3<Argument, Value>::FindExtrema() const {
       arguments_.first, a1_, 2.0 * a2_, 3.0 * a3_);
 }
 
+template<typename Argument, typename Value>
+std::set<Argument> Hermite3<Argument, Value>::FindRoots() const {
+  return SolveCubicEquation<Argument, Value>(
+      arguments_.first, a0_, a1_, a2_, a3_);
+}
+
 }  // namespace internal_hermite3
 }  // namespace numerics
 }  // namespace principia
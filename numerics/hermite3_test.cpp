@@ -54,6 +54,18 @@ TEST_F(Hermite3Test, Precomputed) {
                           t0_ + ((64.0 + sqrt(430.0)) / 39.0) * Second));
 }
 
+TEST_F(Hermite3Test, Roots) {
+  // The polynomial (t - t0_ - 1 s) (t - t0_ - 2 s) (t - t0_ - 3 s) m/s^3.
+  Hermite3<Instant, Length> h({t0_, t0_ + 4 * Second},
+                              {-6 * Metre, 6 * Metre},
+                              {11 * Metre / Second, 11 * Metre / Second});
+
+  EXPECT_THAT(h.FindRoots(),
+              ElementsAre(AlmostEquals(t0_ + 1 * Second, 1),
+                          AlmostEquals(t0_ + 2 * Second, 0),
+                          AlmostEquals(t0_ + 3 * Second, 0)));
+}
+
 TEST_F(Hermite3Test, Typed) {
   // Just here to check that the types work in the presence of affine spaces.
   Hermite3<Instant, Position<World>> h({t0_ + 1 * Second, t0_ + 2 * Second},
@@ -0,0 +1,99 @@
+﻿
+#pragma once
+
+#include "numerics/hermite5.hpp"
+
+#include <set>
+#include <utility>
+
+#include "numerics/root_finders.hpp"
+
+namespace principia {
+namespace numerics {
+namespace internal_hermite5 {
+
+using quantities::Difference;
+
+template<typename Argument, typename Value>
+Hermite5<Argument, Value>::Hermite5(
+    std::pair<Argument, Argument> const& arguments,
+    std::pair<Value, Value> const& values,
+    std::pair<Derivative1, Derivative1> const& derivatives,
+    std::pair<Derivative2, Derivative2> const& second_derivatives)
+    : arguments_(arguments) {
+  a0_ = values.first;
+  a1_ = derivatives.first;
+  a2_ = 0.5 * second_derivatives.first;
+  Difference<Argument> const h = arguments_.second - arguments_.first;
+  // As for |Hermite3|, if we were given the same point twice, there is a
+  // removable singularity.
+  if (h == Difference<Argument>{} &&
+      values.first == values.second &&
+      derivatives.first == derivatives.second &&
+      second_derivatives.first == second_derivatives.second) {
+    a3_ = {};
+    a4_ = {};
+    a5_ = {};
+    return;
+  }
+  auto const one_over_h = 1.0 / h;
+  auto const one_over_h² = one_over_h * one_over_h;
+  auto const one_over_h³ = one_over_h * one_over_h²;
+  // The differences between the values and derivatives at the upper bound and
+  // those of the Taylor polynomial of degree 2 at the lower bound.
+  Difference<Value> const Δ0 = values.second -
+                               (values.first +
+                                (derivatives.first +
+                                 a2_ * h) * h);
+  Derivative1 const Δ1 = derivatives.second -
+                         (derivatives.first + second_derivatives.first * h);
+  Derivative2 const Δ2 = second_derivatives.second - second_derivatives.first;
+  a3_ = (10.0 * Δ0 * one_over_h - 4.0 * Δ1 + 0.5 * Δ2 * h) * one_over_h²;
+  a4_ = (-15.0 * Δ0 * one_over_h + 7.0 * Δ1 - Δ2 * h) * one_over_h³;
+  a5_ = (6.0 * Δ0 * one_over_h - 3.0 * Δ1 + 0.5 * Δ2 * h) *
+        one_over_h² * one_over_h²;
+}
+
+template<typename Argument, typename Value>
+Argument const& Hermite5<Argument, Value>::lower_bound() const {
+  return arguments_.first;
+}
+
+template<typename Argument, typename Value>
+Argument const& Hermite5<Argument, Value>::upper_bound() const {
+  return arguments_.second;
+}
+
+template<typename Argument, typename Value>
+Value Hermite5<Argument, Value>::Evaluate(Argument const& argument) const {
+  Difference<Argument> const Δargument = argument - arguments_.first;
+  return ((((a5_ * Δargument + a4_) * Δargument + a3_) * Δargument + a2_) *
+              Δargument + a1_) * Δargument + a0_;
+}
+
+template<typename Argument, typename Value>
+typename Hermite5<Argument, Value>::Derivative1
+Hermite5<Argument, Value>::EvaluateDerivative(Argument const& argument) const {
+  Difference<Argument> const Δargument = argument - arguments_.first;
+  return (((5.0 * a5_ * Δargument + 4.0 * a4_) * Δargument + 3.0 * a3_) *
+              Δargument + 2.0 * a2_) * Δargument + a1_;
+}
+
+template<typename Argument, typename Value>
+typename Hermite5<Argument, Value>::Derivative2
+Hermite5<Argument, Value>::EvaluateSecondDerivative(
+    Argument const& argument) const {
+  Difference<Argument> const Δargument = argument - arguments_.first;
+  return ((20.0 * a5_ * Δargument + 12.0 * a4_) * Δargument + 6.0 * a3_) *
+             Δargument + 2.0 * a2_;
+}
+
+template<typename Argument, typename Value>
+std::set<Argument> Hermite5<Argument, Value>::FindExtrema() const {
+  return SolveQuarticEquation<Argument, Derivative1>(
+      arguments_.first, a1_, 2.0 * a2_, 3.0 * a3_, 4.0 * a4_, 5.0 * a5_);
+}
+
+}  // namespace internal_hermite5
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,133 @@
+﻿
+#include "numerics/hermite5.hpp"
+
+#include "geometry/frame.hpp"
+#include "geometry/named_quantities.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "testing_utilities/almost_equals.hpp"
+
+namespace principia {
+
+using geometry::Frame;
+using geometry::Instant;
+using geometry::Position;
+using geometry::Vector;
+using geometry::Velocity;
+using quantities::Acceleration;
+using quantities::Length;
+using quantities::Pow;
+using quantities::Speed;
+using quantities::Time;
+using quantities::si::Metre;
+using quantities::si::Second;
+using testing_utilities::AlmostEquals;
+
+namespace numerics {
+
+class Hermite5Test : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST1, true>;
+
+  Instant const t0_;
+};
+
+// A polynomial of degree 5 is its own Hermite interpolant.
+TEST_F(Hermite5Test, Quintic) {
+  auto const p = [this](Instant const& t) {
+    Time const τ = t - t0_;
+    return 1 * Metre - 2 * Metre / Second * τ +
+           3 * Metre / Pow<2>(Second) * Pow<2>(τ) -
+           1 * Metre / Pow<3>(Second) * Pow<3>(τ) +
+           2 * Metre / Pow<4>(Second) * Pow<4>(τ) +
+           1 * Metre / Pow<5>(Second) * Pow<5>(τ);
+  };
+  auto const dp = [this](Instant const& t) {
+    Time const τ = t - t0_;
+    return -2 * Metre / Second +
+           6 * Metre / Pow<2>(Second) * τ -
+           3 * Metre / Pow<3>(Second) * Pow<2>(τ) +
+           8 * Metre / Pow<4>(Second) * Pow<3>(τ) +
+           5 * Metre / Pow<5>(Second) * Pow<4>(τ);
+  };
+  auto const d2p = [this](Instant const& t) {
+    Time const τ = t - t0_;
+    return 6 * Metre / Pow<2>(Second) -
+           6 * Metre / Pow<3>(Second) * τ +
+           24 * Metre / Pow<4>(Second) * Pow<2>(τ) +
+           20 * Metre / Pow<5>(Second) * Pow<3>(τ);
+  };
+
+  Instant const t1 = t0_ + 1 * Second;
+  Instant const t2 = t0_ + 3 * Second;
+  Hermite5<Instant, Length> const h({t1, t2},
+                                    {p(t1), p(t2)},
+                                    {dp(t1), dp(t2)},
+                                    {d2p(t1), d2p(t2)});
+  EXPECT_EQ(t1, h.lower_bound());
+  EXPECT_EQ(t2, h.upper_bound());
+  for (Instant t = t1; t <= t2; t += 0.25 * Second) {
+    EXPECT_THAT(h.Evaluate(t), AlmostEquals(p(t), 0, 2)) << t;
+    EXPECT_THAT(h.EvaluateDerivative(t), AlmostEquals(dp(t), 0, 2)) << t;
+    EXPECT_THAT(h.EvaluateSecondDerivative(t), AlmostEquals(d2p(t), 0, 4))
+        << t;
+  }
+}
+
+TEST_F(Hermite5Test, Extrema) {
+  // A polynomial whose derivative is
+  // (t - t0_ - 1 s) (t - t0_ - 2 s) (t - t0_ - 3 s) (t - t0_ - 4 s) m/s^5.
+  auto const p = [this](Instant const& t) {
+    Time const τ = t - t0_;
+    return 24 * Metre / Second * τ -
+           25 * Metre / Pow<2>(Second) * Pow<2>(τ) +
+           35.0 / 3.0 * Metre / Pow<3>(Second) * Pow<3>(τ) -
+           2.5 * Metre / Pow<4>(Second) * Pow<4>(τ) +
+           0.2 * Metre / Pow<5>(Second) * Pow<5>(τ);
+  };
+  auto const dp = [this](Instant const& t) {
+    Time const τ = t - t0_;
+    return 24 * Metre / Second -
+           50 * Metre / Pow<2>(Second) * τ +
+           35 * Metre / Pow<3>(Second) * Pow<2>(τ) -
+           10 * Metre / Pow<4>(Second) * Pow<3>(τ) +
+           1 * Metre / Pow<5>(Second) * Pow<4>(τ);
+  };
+  auto const d2p = [this](Instant const& t) {
+    Time const τ = t - t0_;
+    return -50 * Metre / Pow<2>(Second) +
+           70 * Metre / Pow<3>(Second) * τ -
+           30 * Metre / Pow<4>(Second) * Pow<2>(τ) +
+           4 * Metre / Pow<5>(Second) * Pow<3>(τ);
+  };
+
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 5 * Second;
+  Hermite5<Instant, Length> const h({t1, t2},
+                                    {p(t1), p(t2)},
+                                    {dp(t1), dp(t2)},
+                                    {d2p(t1), d2p(t2)});
+  EXPECT_THAT(h.FindExtrema(),
+              ElementsAre(AlmostEquals(t0_ + 1 * Second, 19),
+                          AlmostEquals(t0_ + 2 * Second, 67),
+                          AlmostEquals(t0_ + 3 * Second, 165),
+                          AlmostEquals(t0_ + 4 * Second, 50)));
+}
+
+TEST_F(Hermite5Test, Typed) {
+  // Just here to check that the types work in the presence of affine spaces.
+  Hermite5<Instant, Position<World>> h(
+      {t0_ + 1 * Second, t0_ + 2 * Second},
+      {World::origin, World::origin},
+      {Velocity<World>(), Velocity<World>()},
+      {Vector<Acceleration, World>(), Vector<Acceleration, World>()});
+
+  EXPECT_EQ(World::origin, h.Evaluate(t0_ + 1.3 * Second));
+  EXPECT_EQ(Velocity<World>(), h.EvaluateDerivative(t0_ + 1.7 * Second));
+}
+
+}  // namespace numerics
+}  // namespace principia
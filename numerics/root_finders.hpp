@@ -31,10 +31,44 @@ std::set<Argument> SolveQuadraticEquation(
     Derivative<Value, Argument> const& a1,
     Derivative<Derivative<Value, Argument>, Argument> const& a2);
 
+// Returns the solutions of the cubic equation:
+//   a3 * (x - origin)^3 + a2 * (x - origin)^2 + a1 * (x - origin) + a0 == 0
+// The solutions are computed in closed form and refined by Newton's method.
+// The result may have 1, 2 or 3 values.  If |a3| is zero, this is the same as
+// |SolveQuadraticEquation|.
+template<typename Argument, typename Value>
+std::set<Argument> SolveCubicEquation(
+    Argument const& origin,
+    Value const& a0,
+    Derivative<Value, Argument> const& a1,
+    Derivative<Derivative<Value, Argument>, Argument> const& a2,
+    Derivative<Derivative<Derivative<Value, Argument>, Argument>,
+               Argument> const& a3);
+
+// Returns the solutions of the quartic equation:
+//   a4 * (x - origin)^4 + a3 * (x - origin)^3 + a2 * (x - origin)^2 +
+//   a1 * (x - origin) + a0 == 0
+// The solutions are computed in closed form and refined by Newton's method.
+// The result may have 0 to 4 values.  If |a4| is zero, this is the same as
+// |SolveCubicEquation|.
+template<typename Argument, typename Value>
+std::set<Argument> SolveQuarticEquation(
+    Argument const& origin,
+    Value const& a0,
+    Derivative<Value, Argument> const& a1,
+    Derivative<Derivative<Value, Argument>, Argument> const& a2,
+    Derivative<Derivative<Derivative<Value, Argument>, Argument>,
+               Argument> const& a3,
+    Derivative<Derivative<Derivative<Derivative<Value, Argument>, Argument>,
+                          Argument>,
+               Argument> const& a4);
+
 }  // namespace internal_root_finders
 
 using internal_root_finders::Bisect;
+using internal_root_finders::SolveCubicEquation;
 using internal_root_finders::SolveQuadraticEquation;
+using internal_root_finders::SolveQuarticEquation;
 
 }  // namespace numerics
 }  // namespace principia
@@ -3,6 +3,9 @@
 
 #include "root_finders.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <set>
 
 #include "geometry/barycentre_calculator.hpp"
@@ -16,9 +19,148 @@ namespace internal_root_finders {
 
 using geometry::Barycentre;
 using geometry::Sign;
+using quantities::Difference;
+using quantities::SIUnit;
 using quantities::Square;
 using quantities::Sqrt;
 
+// The maximum number of Newton iterations used to refine the solutions
+// computed in closed form.
+constexpr int max_newton_iterations = 4;
+
+// Refines the root |x| of the monic polynomial whose coefficients, by
+// decreasing degree, are |coefficients|, using Newton's method.  Stops as soon
+// as an iteration fails to decrease the magnitude of the polynomial.
+template<std::size_t size>
+double PolishRoot(std::array<double, size> const& coefficients, double x) {
+  auto const evaluate = [&coefficients](double const x,
+                                        double& value,
+                                        double& derivative) {
+    value = coefficients[0];
+    derivative = 0;
+    for (int i = 1; i < size; ++i) {
+      derivative = derivative * x + value;
+      value = value * x + coefficients[i];
+    }
+  };
+  double value;
+  double derivative;
+  evaluate(x, value, derivative);
+  for (int i = 0; i < max_newton_iterations; ++i) {
+    if (value == 0 || derivative == 0) {
+      break;
+    }
+    double const next_x = x - value / derivative;
+    double next_value;
+    double next_derivative;
+    evaluate(next_x, next_value, next_derivative);
+    if (!(std::abs(next_value) < std::abs(value))) {
+      break;
+    }
+    x = next_x;
+    value = next_value;
+    derivative = next_derivative;
+  }
+  return x;
+}
+
+// Returns the real solutions of x^3 + b * x^2 + c * x + d == 0.
+inline std::set<double> SolveMonicCubicEquation(double const b,
+                                                double const c,
+                                                double const d) {
+  // With x = y - b / 3 the equation becomes y^3 + p * y + q == 0.
+  double const b_over_3 = b / 3;
+  double const p = c - b * b_over_3;
+  double const q = (2 * b_over_3 * b_over_3 - c) * b_over_3 + d;
+  double const p_over_3 = p / 3;
+  double const q_over_2 = q / 2;
+  double const discriminant =
+      q_over_2 * q_over_2 + p_over_3 * p_over_3 * p_over_3;
+
+  std::array<double, 3> y;
+  int number_of_solutions;
+  if (discriminant > 0) {
+    // One real solution.  This is Cardano's formula, with the sign of the
+    // square root chosen to avoid cancellations; then u * v == -p / 3.
+    double const u =
+        std::cbrt(-q_over_2 - std::copysign(std::sqrt(discriminant), q_over_2));
+    y[0] = u - p_over_3 / u;
+    number_of_solutions = 1;
+  } else if (p == 0) {
+    // A triple solution.
+    y[0] = 0;
+    number_of_solutions = 1;
+  } else {
+    // Three real solutions, from Viète's trigonometric formula.
+    double const two_sqrt_minus_p_over_3 = 2 * std::sqrt(-p_over_3);
+    double const cos_3θ = std::min(
+        1.0, std::max(-1.0, 3 * q / (p * two_sqrt_minus_p_over_3)));
+    double const θ = std::acos(cos_3θ) / 3;
+    double const two_π_over_3 = 2 * std::acos(-1.0) / 3;
+    for (int k = 0; k < 3; ++k) {
+      y[k] = two_sqrt_minus_p_over_3 * std::cos(θ - k * two_π_over_3);
+    }
+    number_of_solutions = 3;
+  }
+
+  std::set<double> solutions;
+  for (int k = 0; k < number_of_solutions; ++k) {
+    solutions.insert(PolishRoot<4>({1, b, c, d}, y[k] - b_over_3));
+  }
+  return solutions;
+}
+
+// Returns the real solutions of x^4 + b * x^3 + c * x^2 + d * x + e == 0.
+inline std::set<double> SolveMonicQuarticEquation(double const b,
+                                                  double const c,
+                                                  double const d,
+                                                  double const e) {
+  // With x = y - b / 4 the equation becomes y^4 + p * y^2 + q * y + r == 0.
+  double const b_over_4 = b / 4;
+  double const b_over_4² = b_over_4 * b_over_4;
+  double const p = c - 6 * b_over_4²;
+  double const q = d - 2 * c * b_over_4 + 8 * b_over_4² * b_over_4;
+  double const r =
+      e - d * b_over_4 + c * b_over_4² - 3 * b_over_4² * b_over_4²;
+
+  std::set<double> y;
+  // Adds the solutions of y^2 + β * y + γ == 0 to |y|.
+  auto const solve_quadratic = [&y](double const β, double const γ) {
+    for (double const solution :
+         SolveQuadraticEquation<double, double>(0, γ, β, 1)) {
+      y.insert(solution);
+    }
+  };
+
+  // Ferrari's method: for m a solution of the resolvent cubic
+  //   m^3 + p * m^2 + (p^2 / 4 - r) * m - q^2 / 8 == 0,
+  // the quartic is (y^2 + p / 2 + m)^2 - 2 * m * (y - q / (4 * m))^2 and
+  // factors into two quadratics.  The largest solution is positive when
+  // q != 0.
+  double const m =
+      q == 0 ? 0
+             : *SolveMonicCubicEquation(p, p * p / 4 - r, -q * q / 8).rbegin();
+  if (m > 0) {
+    double const s = std::sqrt(2 * m);
+    solve_quadratic(-s, p / 2 + m + q / (2 * s));
+    solve_quadratic(s, p / 2 + m - q / (2 * s));
+  } else {
+    // A biquadratic equation, z^2 + p * z + r == 0 with z = y^2.
+    for (double const z : SolveQuadraticEquation<double, double>(0, r, p, 1)) {
+      if (z >= 0) {
+        y.insert(std::sqrt(z));
+        y.insert(-std::sqrt(z));
+      }
+    }
+  }
+
+  std::set<double> solutions;
+  for (double const y_k : y) {
+    solutions.insert(PolishRoot<5>({1, b, c, d, e}, y_k - b_over_4));
+  }
+  return solutions;
+}
+
 template<typename Argument, typename Function>
 Argument Bisect(Function f,
                 Argument const& lower_bound,
@@ -100,6 +242,70 @@ std::set<Argument> SolveQuadraticEquation(
   return solutions;
 }
 
+template<typename Argument, typename Value>
+std::set<Argument> SolveCubicEquation(
+    Argument const& origin,
+    Value const& a0,
+    Derivative<Value, Argument> const& a1,
+    Derivative<Derivative<Value, Argument>, Argument> const& a2,
+    Derivative<Derivative<Derivative<Value, Argument>, Argument>,
+               Argument> const& a3) {
+  using Derivative1 = Derivative<Value, Argument>;
+  using Derivative2 = Derivative<Derivative1, Argument>;
+  using Derivative3 = Derivative<Derivative2, Argument>;
+
+  // The closed-form solution is computed on the coefficients expressed in SI
+  // units.
+  double const c0 = a0 / SIUnit<Value>();
+  double const c1 = a1 / SIUnit<Derivative1>();
+  double const c2 = a2 / SIUnit<Derivative2>();
+  double const c3 = a3 / SIUnit<Derivative3>();
+  if (c3 == 0) {
+    return SolveQuadraticEquation<Argument, Value>(origin, a0, a1, a2);
+  }
+
+  std::set<Argument> solutions;
+  for (double const x : SolveMonicCubicEquation(c2 / c3, c1 / c3, c0 / c3)) {
+    solutions.insert(origin + x * SIUnit<Difference<Argument>>());
+  }
+  return solutions;
+}
+
+template<typename Argument, typename Value>
+std::set<Argument> SolveQuarticEquation(
+    Argument const& origin,
+    Value const& a0,
+    Derivative<Value, Argument> const& a1,
+    Derivative<Derivative<Value, Argument>, Argument> const& a2,
+    Derivative<Derivative<Derivative<Value, Argument>, Argument>,
+               Argument> const& a3,
+    Derivative<Derivative<Derivative<Derivative<Value, Argument>, Argument>,
+                          Argument>,
+               Argument> const& a4) {
+  using Derivative1 = Derivative<Value, Argument>;
+  using Derivative2 = Derivative<Derivative1, Argument>;
+  using Derivative3 = Derivative<Derivative2, Argument>;
+  using Derivative4 = Derivative<Derivative3, Argument>;
+
+  // The closed-form solution is computed on the coefficients expressed in SI
+  // units.
+  double const c0 = a0 / SIUnit<Value>();
+  double const c1 = a1 / SIUnit<Derivative1>();
+  double const c2 = a2 / SIUnit<Derivative2>();
+  double const c3 = a3 / SIUnit<Derivative3>();
+  double const c4 = a4 / SIUnit<Derivative4>();
+  if (c4 == 0) {
+    return SolveCubicEquation<Argument, Value>(origin, a0, a1, a2, a3);
+  }
+
+  std::set<Argument> solutions;
+  for (double const x :
+       SolveMonicQuarticEquation(c3 / c4, c2 / c4, c1 / c4, c0 / c4)) {
+    solutions.insert(origin + x * SIUnit<Difference<Argument>>());
+  }
+  return solutions;
+}
+
 }  // namespace internal_root_finders
 }  // namespace numerics
 }  // namespace principia
@@ -1,6 +1,7 @@
 ﻿
 #include "numerics/root_finders.hpp"
 
+#include <cmath>
 #include <set>
 
 #include "geometry/named_quantities.hpp"
@@ -85,5 +86,67 @@ TEST_F(RootFindersTest, QuadraticEquations) {
   EXPECT_THAT(s5, ElementsAre(t0 - 1.0 * Second));
 }
 
+TEST_F(RootFindersTest, CubicEquations) {
+  // Three solutions: (x - 1) (x - 2) (x - 3).
+  auto const s1 = SolveCubicEquation(0.0, -6.0, 11.0, -6.0, 1.0);
+  EXPECT_THAT(s1,
+              ElementsAre(AlmostEquals(1.0, 1),
+                          AlmostEquals(2.0, 0),
+                          AlmostEquals(3.0, 0)));
+
+  // One solution.
+  auto const s2 = SolveCubicEquation(0.0, -2.0, 0.0, 0.0, 1.0);
+  EXPECT_THAT(s2, ElementsAre(AlmostEquals(std::cbrt(2.0), 0)));
+
+  // A triple solution: (x - 1)^3.
+  auto const s3 = SolveCubicEquation(0.0, -1.0, 3.0, -3.0, 1.0);
+  EXPECT_THAT(s3, ElementsAre(1.0));
+
+  // Degenerates to a quadratic equation.
+  auto const s4 = SolveCubicEquation(0.0, 1.0, 2.0, 1.0, 0.0);
+  EXPECT_THAT(s4, ElementsAre(-1.0));
+
+  // A typed system: (x - t0 + 1 s) (x - t0 - 2 s)^2.
+  Instant const t0;
+  std::set<Instant> s5 = SolveCubicEquation(t0,
+                                            4.0 * Metre,
+                                            0.0 * Metre / Second,
+                                            -3.0 * Metre / Pow<2>(Second),
+                                            1.0 * Metre / Pow<3>(Second));
+  EXPECT_THAT(s5,
+              ElementsAre(AlmostEquals(t0 - 1.0 * Second, 0),
+                          AlmostEquals(t0 + 2.0 * Second, 0, 2)));
+}
+
+TEST_F(RootFindersTest, QuarticEquations) {
+  // Four solutions: (x - 1) (x - 2) (x - 3) (x - 4).
+  auto const s1 = SolveQuarticEquation(0.0, 24.0, -50.0, 35.0, -10.0, 1.0);
+  EXPECT_THAT(s1,
+              ElementsAre(AlmostEquals(1.0, 0),
+                          AlmostEquals(2.0, 0),
+                          AlmostEquals(3.0, 0),
+                          AlmostEquals(4.0, 0)));
+
+  // A biquadratic equation: (x^2 - 1) (x^2 - 4).
+  auto const s2 = SolveQuarticEquation(0.0, 4.0, 0.0, -5.0, 0.0, 1.0);
+  EXPECT_THAT(s2, ElementsAre(-2.0, -1.0, 1.0, 2.0));
+
+  // No solutions.
+  auto const s3 = SolveQuarticEquation(0.0, 1.0, 0.0, 0.0, 0.0, 1.0);
+  EXPECT_THAT(s3, IsEmpty());
+
+  // Two solutions: (x^2 + 1) (x - 1) (x + 2).
+  auto const s4 = SolveQuarticEquation(0.0, -2.0, 1.0, -1.0, 1.0, 1.0);
+  EXPECT_THAT(s4,
+              ElementsAre(AlmostEquals(-2.0, 0), AlmostEquals(1.0, 0)));
+
+  // Degenerates to a cubic equation.
+  auto const s5 = SolveQuarticEquation(0.0, -6.0, 11.0, -6.0, 1.0, 0.0);
+  EXPECT_THAT(s5,
+              ElementsAre(AlmostEquals(1.0, 1),
+                          AlmostEquals(2.0, 0),
+                          AlmostEquals(3.0, 0)));
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -1,9 +1,12 @@
 ﻿
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "geometry/named_quantities.hpp"
+#include "geometry/r3_element.hpp"
+#include "numerics/fixed_arrays.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/numerics.pb.h"
 
@@ -19,18 +22,47 @@ namespace internal_чебышёв_series {
 
 using base::not_null;
 using geometry::Instant;
+using geometry::R3Element;
 using quantities::Time;
 using quantities::Variation;
 
+// The degrees for which the evaluation of an |R3Element<double>| series is
+// specialized.  This is the range of degrees produced by
+// |ContinuousTrajectory|.
+int const min_specialized_degree = 3;
+int const max_specialized_degree = 17;
+
+// The representation of a |ЧебышёвSeries| with values in a three-dimensional
+// vector space in a flat file, suitable for memory-mapping.  All the blocks have
+// the same size irrespective of the degree, so that the block for a given time
+// may be found by indexing into an array of blocks.  The times are in seconds
+// since |Instant()| and the coefficients are in SI units.  The alignment
+// ensures that a block doesn't straddle cache lines and that the coefficients
+// are suitable for vector loads.
+struct alignas(64) ЧебышёвSeriesBlock final {
+  double t_min;
+  double t_max;
+  double one_over_duration;
+  // Between |min_specialized_degree| and |max_specialized_degree|.
+  std::int64_t degree;
+  R3Element<double> coefficients[max_specialized_degree + 1];
+};
+
 // A helper class for implementing |Evaluate| that can be specialized for speed.
 template<typename Vector>
 class EvaluationHelper final {
  public:
   EvaluationHelper(std::vector<Vector> const& coefficients, int degree);
+  EvaluationHelper(EvaluationHelper const& other) = default;
   EvaluationHelper(EvaluationHelper&& other) = default;
   EvaluationHelper& operator=(EvaluationHelper&& other) = default;
 
   Vector EvaluateImplementation(double scaled_t) const;
+  // The derivative with respect to |scaled_t|.
+  Vector EvaluateDerivativeImplementation(double scaled_t) const;
+  void EvaluateWithDerivativeImplementation(double scaled_t,
+                                            Vector& value,
+                                            Vector& derivative) const;
 
   Vector coefficients(int index) const;
   int degree() const;
@@ -51,6 +83,7 @@ class ЧебышёвSeries final {
   ЧебышёвSeries(std::vector<Vector> const& coefficients,
                 Instant const& t_min,
                 Instant const& t_max);
+  ЧебышёвSeries(ЧебышёвSeries const& other) = default;
   ЧебышёвSeries(ЧебышёвSeries&& other) = default;
   ЧебышёвSeries& operator=(ЧебышёвSeries&& other) = default;
 
@@ -71,11 +104,35 @@ class ЧебышёвSeries final {
   // Uses the Clenshaw algorithm.  |t| must be in the range [t_min, t_max].
   Vector Evaluate(Instant const& t) const;
   Variation<Vector> EvaluateDerivative(Instant const& t) const;
+  // Equivalent to, but faster than, calling |Evaluate| and
+  // |EvaluateDerivative| for the same |t|.
+  void EvaluateWithDerivative(Instant const& t,
+                              Vector& value,
+                              Variation<Vector>& derivative) const;
 
   void WriteToMessage(not_null<serialization::ЧебышёвSeries*> message) const;
   static ЧебышёвSeries ReadFromMessage(
       serialization::ЧебышёвSeries const& message);
 
+  // Only for a |Vector| which is a |Multivector|, and a degree between
+  // |min_specialized_degree| and |max_specialized_degree|.
+  void WriteToBlock(not_null<ЧебышёвSeriesBlock*> block) const;
+  static ЧебышёвSeries ReadFromBlock(ЧебышёвSeriesBlock const& block);
+
+  // Evaluate the series stored in |block| without constructing an
+  // |ЧебышёвSeries|.  The results are identical to those of |Evaluate|,
+  // |EvaluateDerivative| and |EvaluateWithDerivative| on the series returned by
+  // |ReadFromBlock(block)|.
+  static Vector EvaluateBlock(ЧебышёвSeriesBlock const& block,
+                              Instant const& t);
+  static Variation<Vector> EvaluateBlockDerivative(
+      ЧебышёвSeriesBlock const& block,
+      Instant const& t);
+  static void EvaluateBlockWithDerivative(ЧебышёвSeriesBlock const& block,
+                                          Instant const& t,
+                                          Vector& value,
+                                          Variation<Vector>& derivative);
+
   // Computes a Newhall approximation of the given |degree|.  |q| and |v| are
   // the positions and velocities over a constant division of [t_min, t_max].
   static ЧебышёвSeries NewhallApproximation(
@@ -92,8 +149,41 @@ class ЧебышёвSeries final {
   EvaluationHelper<Vector> helper_;
 };
 
+// Computes Newhall approximations of various degrees for the same positions
+// and velocities.  The data is preprocessed once, and the coefficient of
+// highest degree of an approximation, which estimates its error, may be
+// obtained without computing the other coefficients.  This makes it cheap to
+// try several degrees before building the approximation.
+template<typename Vector>
+class NewhallApproximator final {
+ public:
+  // |q| and |v| are the positions and velocities over a constant division of
+  // [t_min, t_max].  Only supports 8 divisions for now.
+  NewhallApproximator(std::vector<Vector> const& q,
+                      std::vector<Variation<Vector>> const& v,
+                      Instant const& t_min,
+                      Instant const& t_max);
+
+  // Returns |Approximation(degree).last_coefficient()|.
+  Vector LastCoefficient(int degree) const;
+
+  ЧебышёвSeries<Vector> Approximation(int degree) const;
+
+ private:
+  static int constexpr divisions = 8;
+
+  Instant const t_min_;
+  Instant const t_max_;
+  // The positions and scaled velocities in the order of Newhall's matrices.
+  FixedVector<Vector, 2 * divisions + 2> qv_;
+};
+
 }  // namespace internal_чебышёв_series
 
+using internal_чебышёв_series::max_specialized_degree;
+using internal_чебышёв_series::min_specialized_degree;
+using internal_чебышёв_series::NewhallApproximator;
+using internal_чебышёв_series::ЧебышёвSeriesBlock;
 using internal_чебышёв_series::ЧебышёвSeries;
 
 }  // namespace numerics
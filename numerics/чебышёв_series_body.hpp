@@ -1,8 +1,12 @@
 ﻿
 #include "numerics/чебышёв_series.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
+#include "base/macros.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/serialization.hpp"
@@ -16,9 +20,239 @@ namespace internal_чебышёв_series {
 
 using geometry::DoubleOrQuantityOrMultivectorSerializer;
 using geometry::Multivector;
-using geometry::R3Element;
 using quantities::SIUnit;
 
+// The Clenshaw recurrences for the value and for the derivative (with respect
+// to |scaled_t|) of a series with the given |coefficients| and |degree|, which
+// must be at least 2.  |Degree| is either |int| or an |std::integral_constant|;
+// in the latter case the compiler may fully unroll the loops.
+template<typename Degree>
+R3Element<double> ClenshawValue(
+    Degree const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t) {
+  double const two_scaled_t = scaled_t + scaled_t;
+  // b_degree   = c_degree.
+  R3Element<double> b_kplus2 = coefficients[degree];
+  // b_degree-1 = c_degree-1 + 2 t b_degree.
+  R3Element<double> b_kplus1 = coefficients[degree - 1] +
+                               two_scaled_t * b_kplus2;
+  for (int k = degree - 2; k >= 1; --k) {
+    // b_k = c_k + 2 t b_k+1 - b_k+2.
+    R3Element<double> const& c_k = coefficients[k];
+    R3Element<double> const b_k = {
+        c_k.x + two_scaled_t * b_kplus1.x - b_kplus2.x,
+        c_k.y + two_scaled_t * b_kplus1.y - b_kplus2.y,
+        c_k.z + two_scaled_t * b_kplus1.z - b_kplus2.z};
+    b_kplus2 = b_kplus1;
+    b_kplus1 = b_k;
+  }
+  // c_0 + t b_1 - b_2.
+  return coefficients[0] + scaled_t * b_kplus1 - b_kplus2;
+}
+
+template<typename Degree>
+R3Element<double> ClenshawDerivative(
+    Degree const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t) {
+  double const two_scaled_t = scaled_t + scaled_t;
+  R3Element<double> b_kplus2{};
+  R3Element<double> b_kplus1{};
+  for (int k = degree - 1; k >= 1; --k) {
+    // b_k = (k + 1) c_k+1 + 2 t b_k+1 - b_k+2.
+    R3Element<double> const c_kplus1 = coefficients[k + 1] * (k + 1);
+    R3Element<double> const b_k = {
+        c_kplus1.x + two_scaled_t * b_kplus1.x - b_kplus2.x,
+        c_kplus1.y + two_scaled_t * b_kplus1.y - b_kplus2.y,
+        c_kplus1.z + two_scaled_t * b_kplus1.z - b_kplus2.z};
+    b_kplus2 = b_kplus1;
+    b_kplus1 = b_k;
+  }
+  // c_1 + 2 t b_1 - b_2.
+  return coefficients[1] + two_scaled_t * b_kplus1 - b_kplus2;
+}
+
+// The two recurrences above fused in a single pass over the coefficients.
+// They are independent, so the processor may interleave them, and each
+// coefficient is loaded only once.  The results are identical to those of the
+// separate recurrences.
+template<typename Degree>
+void ClenshawValueAndDerivative(
+    Degree const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t,
+    R3Element<double>& value,
+    R3Element<double>& derivative) {
+  double const two_scaled_t = scaled_t + scaled_t;
+  // b_degree   = c_degree.
+  R3Element<double> value_b_kplus2 = coefficients[degree];
+  // b_degree-1 = c_degree-1 + 2 t b_degree.
+  R3Element<double> value_b_kplus1 = coefficients[degree - 1] +
+                                     two_scaled_t * value_b_kplus2;
+  // For the derivative, b_degree = 0 and b_degree-1 = degree c_degree.
+  R3Element<double> derivative_b_kplus2{};
+  R3Element<double> derivative_b_kplus1 = coefficients[degree] * degree;
+  for (int k = degree - 2; k >= 1; --k) {
+    R3Element<double> const& c_k = coefficients[k];
+    R3Element<double> const c_kplus1 = coefficients[k + 1] * (k + 1);
+    R3Element<double> const value_b_k = {
+        c_k.x + two_scaled_t * value_b_kplus1.x - value_b_kplus2.x,
+        c_k.y + two_scaled_t * value_b_kplus1.y - value_b_kplus2.y,
+        c_k.z + two_scaled_t * value_b_kplus1.z - value_b_kplus2.z};
+    R3Element<double> const derivative_b_k = {
+        c_kplus1.x + two_scaled_t * derivative_b_kplus1.x -
+            derivative_b_kplus2.x,
+        c_kplus1.y + two_scaled_t * derivative_b_kplus1.y -
+            derivative_b_kplus2.y,
+        c_kplus1.z + two_scaled_t * derivative_b_kplus1.z -
+            derivative_b_kplus2.z};
+    value_b_kplus2 = value_b_kplus1;
+    value_b_kplus1 = value_b_k;
+    derivative_b_kplus2 = derivative_b_kplus1;
+    derivative_b_kplus1 = derivative_b_k;
+  }
+  // c_0 + t b_1 - b_2.
+  value = coefficients[0] + scaled_t * value_b_kplus1 - value_b_kplus2;
+  // c_1 + 2 t b_1 - b_2.
+  derivative = coefficients[1] + two_scaled_t * derivative_b_kplus1 -
+               derivative_b_kplus2;
+}
+
+// Same as above, for a degree which is only known at run time and may be less
+// than 2.
+inline R3Element<double> ClenshawValue(
+    int const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t) {
+  switch (degree) {
+    case 0:
+      return coefficients[0];
+    case 1:
+      return coefficients[0] + scaled_t * coefficients[1];
+    default:
+      return ClenshawValue<int>(degree, coefficients, scaled_t);
+  }
+}
+
+inline R3Element<double> ClenshawDerivative(
+    int const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t) {
+  switch (degree) {
+    case 0:
+      return R3Element<double>();
+    case 1:
+      return coefficients[1];
+    default:
+      return ClenshawDerivative<int>(degree, coefficients, scaled_t);
+  }
+}
+
+inline void ClenshawValueAndDerivative(
+    int const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t,
+    R3Element<double>& value,
+    R3Element<double>& derivative) {
+  switch (degree) {
+    case 0:
+      value = coefficients[0];
+      derivative = R3Element<double>();
+      return;
+    case 1:
+      value = coefficients[0] + scaled_t * coefficients[1];
+      derivative = coefficients[1];
+      return;
+    default:
+      ClenshawValueAndDerivative<int>(
+          degree, coefficients, scaled_t, value, derivative);
+  }
+}
+
+// Returns |f(std::integral_constant<int, degree>())| if |degree| is between
+// |min_specialized_degree| and |max_specialized_degree|, so that the compiler
+// may fully unroll and inline the recurrences called by |f|, and |f(degree)|
+// otherwise.
+template<typename F>
+decltype(auto) WithSpecializedDegree(int const degree, F const& f) {
+  static_assert(min_specialized_degree == 3 && max_specialized_degree == 17,
+                "Update the cases below");
+  switch (degree) {
+    case 3:
+      return f(std::integral_constant<int, 3>());
+    case 4:
+      return f(std::integral_constant<int, 4>());
+    case 5:
+      return f(std::integral_constant<int, 5>());
+    case 6:
+      return f(std::integral_constant<int, 6>());
+    case 7:
+      return f(std::integral_constant<int, 7>());
+    case 8:
+      return f(std::integral_constant<int, 8>());
+    case 9:
+      return f(std::integral_constant<int, 9>());
+    case 10:
+      return f(std::integral_constant<int, 10>());
+    case 11:
+      return f(std::integral_constant<int, 11>());
+    case 12:
+      return f(std::integral_constant<int, 12>());
+    case 13:
+      return f(std::integral_constant<int, 13>());
+    case 14:
+      return f(std::integral_constant<int, 14>());
+    case 15:
+      return f(std::integral_constant<int, 15>());
+    case 16:
+      return f(std::integral_constant<int, 16>());
+    case 17:
+      return f(std::integral_constant<int, 17>());
+    default:
+      return f(degree);
+  }
+}
+
+// The evaluation of a series of the given |degree| whose coefficients, in SI
+// units, start at |coefficients|.
+inline R3Element<double> EvaluateR3Element(
+    int const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t) {
+  return WithSpecializedDegree(
+      degree,
+      [coefficients, scaled_t](auto const specialized_degree) {
+        return ClenshawValue(specialized_degree, coefficients, scaled_t);
+      });
+}
+
+inline R3Element<double> EvaluateR3ElementDerivative(
+    int const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t) {
+  return WithSpecializedDegree(
+      degree,
+      [coefficients, scaled_t](auto const specialized_degree) {
+        return ClenshawDerivative(specialized_degree, coefficients, scaled_t);
+      });
+}
+
+inline void EvaluateR3ElementWithDerivative(
+    int const degree,
+    R3Element<double> const* const coefficients,
+    double const scaled_t,
+    R3Element<double>& value,
+    R3Element<double>& derivative) {
+  WithSpecializedDegree(
+      degree,
+      [coefficients, scaled_t, &value, &derivative](
+          auto const specialized_degree) {
+        ClenshawValueAndDerivative(
+            specialized_degree, coefficients, scaled_t, value, derivative);
+      });
+}
+
 // The compiler does a much better job on an |R3Element<double>| than on a
 // |Vector<Quantity>| so we specialize this case.
 template<typename Scalar, typename Frame, int rank>
@@ -27,16 +261,49 @@ class EvaluationHelper<Multivector<Scalar, Frame, rank>> final {
   EvaluationHelper(
       std::vector<Multivector<Scalar, Frame, rank>> const& coefficients,
       int const degree);
+  EvaluationHelper(EvaluationHelper const& other) = default;
   EvaluationHelper(EvaluationHelper&& other) = default;
   EvaluationHelper& operator=(EvaluationHelper&& other) = default;
 
   Multivector<Scalar, Frame, rank> EvaluateImplementation(
       double const scaled_t) const;
+  Multivector<Scalar, Frame, rank> EvaluateDerivativeImplementation(
+      double const scaled_t) const;
+  void EvaluateWithDerivativeImplementation(
+      double const scaled_t,
+      Multivector<Scalar, Frame, rank>& value,
+      Multivector<Scalar, Frame, rank>& derivative) const;
 
   Multivector<Scalar, Frame, rank> coefficients(int const index) const;
   int degree() const;
 
+  void WriteToBlock(not_null<ЧебышёвSeriesBlock*> block) const;
+  static std::vector<Multivector<Scalar, Frame, rank>> BlockCoefficients(
+      ЧебышёвSeriesBlock const& block);
+
+  // Same as the |...Implementation| functions above for the series stored in
+  // |block|.
+  static Multivector<Scalar, Frame, rank> EvaluateBlockImplementation(
+      ЧебышёвSeriesBlock const& block,
+      double scaled_t);
+  static Multivector<Scalar, Frame, rank> EvaluateBlockDerivativeImplementation(
+      ЧебышёвSeriesBlock const& block,
+      double scaled_t);
+  static void EvaluateBlockWithDerivativeImplementation(
+      ЧебышёвSeriesBlock const& block,
+      double scaled_t,
+      Multivector<Scalar, Frame, rank>& value,
+      Multivector<Scalar, Frame, rank>& derivative);
+
  private:
+  // The coefficients in SI units.
+  R3Element<double> const* coefficients_data() const;
+
+  // If |degree_| is at most |max_specialized_degree|, which is the case for all
+  // the series of a |ContinuousTrajectory|, the coefficients are stored
+  // contiguously in |block_.coefficients|, padded with zeroes, and the times of
+  // |block_| are unused.  Otherwise they are stored in |coefficients_|.
+  ЧебышёвSeriesBlock block_{};
   std::vector<R3Element<double>> coefficients_;
   int degree_;
 };
@@ -80,6 +347,32 @@ Vector EvaluationHelper<Vector>::EvaluateImplementation(
   }
 }
 
+template<typename Vector>
+Vector EvaluationHelper<Vector>::EvaluateDerivativeImplementation(
+    double const scaled_t) const {
+  double const two_scaled_t = scaled_t + scaled_t;
+  Vector b_kplus2{};
+  Vector b_kplus1{};
+  for (int k = degree_ - 1; k >= 1; --k) {
+    // b_k = (k + 1) c_k+1 + 2 t b_k+1 - b_k+2.
+    Vector const b_k = coefficients_[k + 1] * (k + 1) +
+                       two_scaled_t * b_kplus1 - b_kplus2;
+    b_kplus2 = b_kplus1;
+    b_kplus1 = b_k;
+  }
+  // c_1 + 2 t b_1 - b_2.
+  return coefficients_[1] + two_scaled_t * b_kplus1 - b_kplus2;
+}
+
+template<typename Vector>
+void EvaluationHelper<Vector>::EvaluateWithDerivativeImplementation(
+    double const scaled_t,
+    Vector& value,
+    Vector& derivative) const {
+  value = EvaluateImplementation(scaled_t);
+  derivative = EvaluateDerivativeImplementation(scaled_t);
+}
+
 template<typename Vector>
 Vector EvaluationHelper<Vector>::coefficients(int const index) const {
   return coefficients_[index];
@@ -94,8 +387,16 @@ template<typename Scalar, typename Frame, int rank>
 EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluationHelper(
     std::vector<Multivector<Scalar, Frame, rank>> const& coefficients,
     int const degree) : degree_(degree) {
-  for (auto const& coefficient : coefficients) {
-    coefficients_.push_back(coefficient.coordinates() / SIUnit<Scalar>());
+  if (degree_ <= max_specialized_degree) {
+    block_.degree = degree_;
+    for (int k = 0; k < coefficients.size(); ++k) {
+      block_.coefficients[k] =
+          coefficients[k].coordinates() / SIUnit<Scalar>();
+    }
+  } else {
+    for (auto const& coefficient : coefficients) {
+      coefficients_.push_back(coefficient.coordinates() / SIUnit<Scalar>());
+    }
   }
 }
 
@@ -103,44 +404,94 @@ template<typename Scalar, typename Frame, int rank>
 Multivector<Scalar, Frame, rank>
 EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluateImplementation(
     double const scaled_t) const {
-  double const two_scaled_t = scaled_t + scaled_t;
-  R3Element<double> const c_0 = coefficients_[0];
-  switch (degree_) {
-    case 0:
-      return Multivector<double, Frame, rank>(c_0) * SIUnit<Scalar>();
-    case 1:
-      return Multivector<double, Frame, rank>(
-                 c_0 + scaled_t * coefficients_[1]) * SIUnit<Scalar>();
-    default:
-      // b_degree   = c_degree.
-      R3Element<double> b_i = coefficients_[degree_];
-      // b_degree-1 = c_degree-1 + 2 t b_degree.
-      R3Element<double> b_j = coefficients_[degree_ - 1] + two_scaled_t * b_i;
-      int k = degree_ - 3;
-      for (; k >= 1; k -= 2) {
-        // b_k+1 = c_k+1 + 2 t b_k+2 - b_k+3.
-        R3Element<double> const c_kplus1 = coefficients_[k + 1];
-        b_i.x = c_kplus1.x + two_scaled_t * b_j.x - b_i.x;
-        b_i.y = c_kplus1.y + two_scaled_t * b_j.y - b_i.y;
-        b_i.z = c_kplus1.z + two_scaled_t * b_j.z - b_i.z;
-        // b_k   = c_k   + 2 t b_k+1 - b_k+2.
-        R3Element<double> const c_k = coefficients_[k];
-        b_j.x = c_k.x + two_scaled_t * b_i.x - b_j.x;
-        b_j.y = c_k.y + two_scaled_t * b_i.y - b_j.y;
-        b_j.z = c_k.z + two_scaled_t * b_i.z - b_j.z;
-      }
-      if (k == 0) {
-        // b_1 = c_1 + 2 t b_2 - b_3.
-        b_i = coefficients_[1] + two_scaled_t * b_j - b_i;
-        // c_0 + t b_1 - b_2.
-        return Multivector<double, Frame, rank>(
-                   c_0 + scaled_t * b_i - b_j) * SIUnit<Scalar>();
-      } else {
-        // c_0 + t b_1 - b_2.
-        return Multivector<double, Frame, rank>(
-                   c_0 + scaled_t * b_j - b_i) * SIUnit<Scalar>();
-      }
-    }
+  return Multivector<double, Frame, rank>(
+             EvaluateR3Element(degree_, coefficients_data(), scaled_t)) *
+         SIUnit<Scalar>();
+}
+
+template<typename Scalar, typename Frame, int rank>
+Multivector<Scalar, Frame, rank>
+EvaluationHelper<Multivector<Scalar, Frame, rank>>::
+EvaluateDerivativeImplementation(double const scaled_t) const {
+  return Multivector<double, Frame, rank>(EvaluateR3ElementDerivative(
+             degree_, coefficients_data(), scaled_t)) *
+         SIUnit<Scalar>();
+}
+
+template<typename Scalar, typename Frame, int rank>
+void EvaluationHelper<Multivector<Scalar, Frame, rank>>::
+EvaluateWithDerivativeImplementation(
+    double const scaled_t,
+    Multivector<Scalar, Frame, rank>& value,
+    Multivector<Scalar, Frame, rank>& derivative) const {
+  R3Element<double> r3_value;
+  R3Element<double> r3_derivative;
+  EvaluateR3ElementWithDerivative(
+      degree_, coefficients_data(), scaled_t, r3_value, r3_derivative);
+  value = Multivector<double, Frame, rank>(r3_value) * SIUnit<Scalar>();
+  derivative =
+      Multivector<double, Frame, rank>(r3_derivative) * SIUnit<Scalar>();
+}
+
+template<typename Scalar, typename Frame, int rank>
+void EvaluationHelper<Multivector<Scalar, Frame, rank>>::WriteToBlock(
+    not_null<ЧебышёвSeriesBlock*> const block) const {
+  CHECK_LE(min_specialized_degree, degree_);
+  CHECK_GE(max_specialized_degree, degree_);
+  block->degree = degree_;
+  std::copy(std::begin(block_.coefficients),
+            std::end(block_.coefficients),
+            std::begin(block->coefficients));
+}
+
+template<typename Scalar, typename Frame, int rank>
+std::vector<Multivector<Scalar, Frame, rank>>
+EvaluationHelper<Multivector<Scalar, Frame, rank>>::BlockCoefficients(
+    ЧебышёвSeriesBlock const& block) {
+  std::vector<Multivector<Scalar, Frame, rank>> coefficients;
+  coefficients.reserve(block.degree + 1);
+  for (int k = 0; k <= block.degree; ++k) {
+    coefficients.push_back(
+        Multivector<double, Frame, rank>(block.coefficients[k]) *
+        SIUnit<Scalar>());
+  }
+  return coefficients;
+}
+
+template<typename Scalar, typename Frame, int rank>
+Multivector<Scalar, Frame, rank>
+EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluateBlockImplementation(
+    ЧебышёвSeriesBlock const& block,
+    double const scaled_t) {
+  return Multivector<double, Frame, rank>(
+             EvaluateR3Element(block.degree, block.coefficients, scaled_t)) *
+         SIUnit<Scalar>();
+}
+
+template<typename Scalar, typename Frame, int rank>
+Multivector<Scalar, Frame, rank>
+EvaluationHelper<Multivector<Scalar, Frame, rank>>::
+EvaluateBlockDerivativeImplementation(ЧебышёвSeriesBlock const& block,
+                                      double const scaled_t) {
+  return Multivector<double, Frame, rank>(EvaluateR3ElementDerivative(
+             block.degree, block.coefficients, scaled_t)) *
+         SIUnit<Scalar>();
+}
+
+template<typename Scalar, typename Frame, int rank>
+void EvaluationHelper<Multivector<Scalar, Frame, rank>>::
+EvaluateBlockWithDerivativeImplementation(
+    ЧебышёвSeriesBlock const& block,
+    double const scaled_t,
+    Multivector<Scalar, Frame, rank>& value,
+    Multivector<Scalar, Frame, rank>& derivative) {
+  R3Element<double> r3_value;
+  R3Element<double> r3_derivative;
+  EvaluateR3ElementWithDerivative(
+      block.degree, block.coefficients, scaled_t, r3_value, r3_derivative);
+  value = Multivector<double, Frame, rank>(r3_value) * SIUnit<Scalar>();
+  derivative =
+      Multivector<double, Frame, rank>(r3_derivative) * SIUnit<Scalar>();
 }
 
 template<typename Scalar, typename Frame, int rank>
@@ -148,7 +499,7 @@ Multivector<Scalar, Frame, rank>
 EvaluationHelper<Multivector<Scalar, Frame, rank>>::coefficients(
     int const index) const {
   return Multivector<double, Frame, rank>(
-             coefficients_[index]) * SIUnit<Scalar>();
+             coefficients_data()[index]) * SIUnit<Scalar>();
 }
 
 template<typename Scalar, typename Frame, int rank>
@@ -156,6 +507,13 @@ int EvaluationHelper<Multivector<Scalar, Frame, rank>>::degree() const {
   return degree_;
 }
 
+template<typename Scalar, typename Frame, int rank>
+R3Element<double> const*
+EvaluationHelper<Multivector<Scalar, Frame, rank>>::coefficients_data() const {
+  return degree_ <= max_specialized_degree ? block_.coefficients
+                                           : coefficients_.data();
+}
+
 template<typename Vector>
 ЧебышёвSeries<Vector>::ЧебышёвSeries(std::vector<Vector> const& coefficients,
                                      Instant const& t_min,
@@ -233,28 +591,33 @@ Variation<Vector> ЧебышёвSeries<Vector>::EvaluateDerivative(
     Instant const& t) const {
   // See comments above.
   double const scaled_t = ((t - t_max_) + (t - t_min_)) * one_over_duration_;
-  double const two_scaled_t = scaled_t + scaled_t;
 #ifdef _DEBUG
   CHECK_LE(scaled_t, 1.1);
   CHECK_GE(scaled_t, -1.1);
 #endif
 
-  Vector b_kplus2_vector{};
-  Vector b_kplus1_vector{};
-  Vector* b_kplus2 = &b_kplus2_vector;
-  Vector* b_kplus1 = &b_kplus1_vector;
-  Vector* const& b_k = b_kplus2;  // An overlay.
-  for (int k = helper_.degree() - 1; k >= 1; --k) {
-    *b_k = helper_.coefficients(k + 1) * (k + 1) +
-           two_scaled_t * *b_kplus1 - *b_kplus2;
-    Vector* const last_b_k = b_k;
-    b_kplus2 = b_kplus1;
-    b_kplus1 = last_b_k;
-  }
-  return (helper_.coefficients(1) + two_scaled_t * *b_kplus1 - *b_kplus2) *
+  return helper_.EvaluateDerivativeImplementation(scaled_t) *
              (one_over_duration_ + one_over_duration_);
 }
 
+template<typename Vector>
+void ЧебышёвSeries<Vector>::EvaluateWithDerivative(
+    Instant const& t,
+    Vector& value,
+    Variation<Vector>& derivative) const {
+  // See comments above.
+  double const scaled_t = ((t - t_max_) + (t - t_min_)) * one_over_duration_;
+#ifdef _DEBUG
+  CHECK_LE(scaled_t, 1.1);
+  CHECK_GE(scaled_t, -1.1);
+#endif
+
+  Vector scaled_derivative;
+  helper_.EvaluateWithDerivativeImplementation(
+      scaled_t, value, scaled_derivative);
+  derivative = scaled_derivative * (one_over_duration_ + one_over_duration_);
+}
+
 template<typename Vector>
 void ЧебышёвSeries<Vector>::WriteToMessage(
     not_null<serialization::ЧебышёвSeries*> const message) const {
@@ -287,6 +650,69 @@ template<typename Vector>
                        Instant::ReadFromMessage(message.t_max()));
 }
 
+template<typename Vector>
+void ЧебышёвSeries<Vector>::WriteToBlock(
+    not_null<ЧебышёвSeriesBlock*> const block) const {
+  block->t_min = (t_min_ - Instant()) / SIUnit<Time>();
+  block->t_max = (t_max_ - Instant()) / SIUnit<Time>();
+  block->one_over_duration = one_over_duration_ / SIUnit<Time::Inverse>();
+  helper_.WriteToBlock(block);
+}
+
+template<typename Vector>
+ЧебышёвSeries<Vector> ЧебышёвSeries<Vector>::ReadFromBlock(
+    ЧебышёвSeriesBlock const& block) {
+  return ЧебышёвSeries(EvaluationHelper<Vector>::BlockCoefficients(block),
+                       Instant() + block.t_min * SIUnit<Time>(),
+                       Instant() + block.t_max * SIUnit<Time>());
+}
+
+template<typename Vector>
+Vector ЧебышёвSeries<Vector>::EvaluateBlock(ЧебышёвSeriesBlock const& block,
+                                            Instant const& t) {
+  // The same computation as in |Evaluate|, which may be done in seconds
+  // because the conversions to and from SI units are exact.
+  double const t_in_seconds = (t - Instant()) / SIUnit<Time>();
+  double const scaled_t = ((t_in_seconds - block.t_max) +
+                           (t_in_seconds - block.t_min)) *
+                          block.one_over_duration;
+  return EvaluationHelper<Vector>::EvaluateBlockImplementation(block, scaled_t);
+}
+
+template<typename Vector>
+Variation<Vector> ЧебышёвSeries<Vector>::EvaluateBlockDerivative(
+    ЧебышёвSeriesBlock const& block,
+    Instant const& t) {
+  // See comments above.
+  double const t_in_seconds = (t - Instant()) / SIUnit<Time>();
+  double const scaled_t = ((t_in_seconds - block.t_max) +
+                           (t_in_seconds - block.t_min)) *
+                          block.one_over_duration;
+  return EvaluationHelper<Vector>::EvaluateBlockDerivativeImplementation(
+             block, scaled_t) *
+         ((block.one_over_duration + block.one_over_duration) *
+          SIUnit<Time::Inverse>());
+}
+
+template<typename Vector>
+void ЧебышёвSeries<Vector>::EvaluateBlockWithDerivative(
+    ЧебышёвSeriesBlock const& block,
+    Instant const& t,
+    Vector& value,
+    Variation<Vector>& derivative) {
+  // See comments above.
+  double const t_in_seconds = (t - Instant()) / SIUnit<Time>();
+  double const scaled_t = ((t_in_seconds - block.t_max) +
+                           (t_in_seconds - block.t_min)) *
+                          block.one_over_duration;
+  Vector scaled_derivative;
+  EvaluationHelper<Vector>::EvaluateBlockWithDerivativeImplementation(
+      block, scaled_t, value, scaled_derivative);
+  derivative = scaled_derivative *
+               ((block.one_over_duration + block.one_over_duration) *
+                SIUnit<Time::Inverse>());
+}
+
 template<typename Vector>
 ЧебышёвSeries<Vector> ЧебышёвSeries<Vector>::NewhallApproximation(
     int const degree,
@@ -294,8 +720,60 @@ template<typename Vector>
     std::vector<Variation<Vector>> const& v,
     Instant const& t_min,
     Instant const& t_max) {
-  // Only supports 8 divisions for now.
-  int const divisions = 8;
+  return NewhallApproximator<Vector>(q, v, t_min, t_max).Approximation(degree);
+}
+
+// Returns the last row of Newhall's matrix for the given |degree|, i.e., the
+// row that yields the coefficient of highest degree.
+inline double const* NewhallLastRow(int const degree) {
+  switch (degree) {
+    case 3:
+      return newhall_c_matrix_degree_3_divisions_8_w04[3];
+    case 4:
+      return newhall_c_matrix_degree_4_divisions_8_w04[4];
+    case 5:
+      return newhall_c_matrix_degree_5_divisions_8_w04[5];
+    case 6:
+      return newhall_c_matrix_degree_6_divisions_8_w04[6];
+    case 7:
+      return newhall_c_matrix_degree_7_divisions_8_w04[7];
+    case 8:
+      return newhall_c_matrix_degree_8_divisions_8_w04[8];
+    case 9:
+      return newhall_c_matrix_degree_9_divisions_8_w04[9];
+    case 10:
+      return newhall_c_matrix_degree_10_divisions_8_w04[10];
+    case 11:
+      return newhall_c_matrix_degree_11_divisions_8_w04[11];
+    case 12:
+      return newhall_c_matrix_degree_12_divisions_8_w04[12];
+    case 13:
+      return newhall_c_matrix_degree_13_divisions_8_w04[13];
+    case 14:
+      return newhall_c_matrix_degree_14_divisions_8_w04[14];
+    case 15:
+      return newhall_c_matrix_degree_15_divisions_8_w04[15];
+    case 16:
+      return newhall_c_matrix_degree_16_divisions_8_w04[16];
+    case 17:
+      return newhall_c_matrix_degree_17_divisions_8_w04[17];
+    default:
+      LOG(FATAL) << "Unexpected degree " << degree;
+      base::noreturn();
+  }
+}
+
+template<typename Vector>
+int constexpr NewhallApproximator<Vector>::divisions;
+
+template<typename Vector>
+NewhallApproximator<Vector>::NewhallApproximator(
+    std::vector<Vector> const& q,
+    std::vector<Variation<Vector>> const& v,
+    Instant const& t_min,
+    Instant const& t_max)
+    : t_min_(t_min),
+      t_max_(t_max) {
   CHECK_EQ(divisions + 1, q.size());
   CHECK_EQ(divisions + 1, v.size());
 
@@ -303,68 +781,82 @@ template<typename Vector>
 
   // Tricky.  The order in Newhall's matrices is such that the entries for the
   // largest time occur first.
-  FixedVector<Vector, 2 * divisions + 2> qv;
   for (int i = 0, j = 2 * divisions;
        i < divisions + 1 && j >= 0;
        ++i, j -= 2) {
-    qv[j] = q[i];
-    qv[j + 1] = v[i] * duration_over_two;
+    qv_[j] = q[i];
+    qv_[j + 1] = v[i] * duration_over_two;
   }
+}
+
+template<typename Vector>
+Vector NewhallApproximator<Vector>::LastCoefficient(int const degree) const {
+  // Same computation as the last row of the product in |Approximation|.
+  double const* const row = NewhallLastRow(degree);
+  Vector result{};
+  for (int j = 0; j < 2 * divisions + 2; ++j) {
+    result += row[j] * qv_[j];
+  }
+  return result;
+}
 
+template<typename Vector>
+ЧебышёвSeries<Vector> NewhallApproximator<Vector>::Approximation(
+    int const degree) const {
   std::vector<Vector> coefficients;
   coefficients.reserve(degree);
   switch (degree) {
     case 3:
-      coefficients = newhall_c_matrix_degree_3_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_3_divisions_8_w04 * qv_;
       break;
     case 4:
-      coefficients = newhall_c_matrix_degree_4_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_4_divisions_8_w04 * qv_;
       break;
     case 5:
-      coefficients = newhall_c_matrix_degree_5_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_5_divisions_8_w04 * qv_;
       break;
     case 6:
-      coefficients = newhall_c_matrix_degree_6_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_6_divisions_8_w04 * qv_;
       break;
     case 7:
-      coefficients = newhall_c_matrix_degree_7_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_7_divisions_8_w04 * qv_;
       break;
     case 8:
-      coefficients = newhall_c_matrix_degree_8_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_8_divisions_8_w04 * qv_;
       break;
     case 9:
-      coefficients = newhall_c_matrix_degree_9_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_9_divisions_8_w04 * qv_;
       break;
     case 10:
-      coefficients = newhall_c_matrix_degree_10_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_10_divisions_8_w04 * qv_;
       break;
     case 11:
-      coefficients = newhall_c_matrix_degree_11_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_11_divisions_8_w04 * qv_;
       break;
     case 12:
-      coefficients = newhall_c_matrix_degree_12_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_12_divisions_8_w04 * qv_;
       break;
     case 13:
-      coefficients = newhall_c_matrix_degree_13_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_13_divisions_8_w04 * qv_;
       break;
     case 14:
-      coefficients = newhall_c_matrix_degree_14_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_14_divisions_8_w04 * qv_;
       break;
     case 15:
-      coefficients = newhall_c_matrix_degree_15_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_15_divisions_8_w04 * qv_;
       break;
     case 16:
-      coefficients = newhall_c_matrix_degree_16_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_16_divisions_8_w04 * qv_;
       break;
     case 17:
-      coefficients = newhall_c_matrix_degree_17_divisions_8_w04 * qv;
+      coefficients = newhall_c_matrix_degree_17_divisions_8_w04 * qv_;
       break;
     default:
       LOG(FATAL) << "Unexpected degree " << degree;
       break;
   }
   CHECK_EQ(degree + 1, coefficients.size());
-  return ЧебышёвSeries(coefficients, t_min, t_max);
+  return ЧебышёвSeries<Vector>(coefficients, t_min_, t_max_);
 }
 
 }  // namespace internal_чебышёв_series
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <random>
 #include <vector>
 
 #include "astronomy/frames.hpp"
@@ -24,6 +25,7 @@ using geometry::Instant;
 using geometry::Vector;
 using quantities::Length;
 using quantities::Speed;
+using quantities::Variation;
 using quantities::si::Metre;
 using quantities::si::Second;
 using testing_utilities::AbsoluteError;
@@ -210,6 +212,55 @@ TEST_F(ЧебышёвSeriesTest, X6Vector) {
             x6.Evaluate(t0_ + 3 * Second));
 }
 
+// Checks that the evaluation of a vector series, which is specialized for
+// some degrees, gives the same results as that of its components, for the
+// value, for the derivative, and for both at once.
+TEST_F(ЧебышёвSeriesTest, VectorEvaluationAllDegrees) {
+  using V = Vector<Length, ICRFJ2000Ecliptic>;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1.0, 1.0);
+  for (int degree = 0; degree <= 20; ++degree) {
+    std::vector<V> coefficients;
+    std::vector<Length> x_coefficients;
+    std::vector<Length> y_coefficients;
+    std::vector<Length> z_coefficients;
+    for (int k = 0; k <= degree; ++k) {
+      coefficients.push_back(V({distribution(random) * Metre,
+                                distribution(random) * Metre,
+                                distribution(random) * Metre}));
+      x_coefficients.push_back(coefficients.back().coordinates().x);
+      y_coefficients.push_back(coefficients.back().coordinates().y);
+      z_coefficients.push_back(coefficients.back().coordinates().z);
+    }
+    ЧебышёвSeries<V> const series(coefficients, t_min_, t_max_);
+    ЧебышёвSeries<Length> const x_series(x_coefficients, t_min_, t_max_);
+    ЧебышёвSeries<Length> const y_series(y_coefficients, t_min_, t_max_);
+    ЧебышёвSeries<Length> const z_series(z_coefficients, t_min_, t_max_);
+    for (Instant t = t_min_; t <= t_max_; t += 0.25 * Second) {
+      V const value = series.Evaluate(t);
+      EXPECT_EQ(x_series.Evaluate(t), value.coordinates().x) << degree;
+      EXPECT_EQ(y_series.Evaluate(t), value.coordinates().y) << degree;
+      EXPECT_EQ(z_series.Evaluate(t), value.coordinates().z) << degree;
+      if (degree == 0) {
+        continue;
+      }
+      Variation<V> const derivative = series.EvaluateDerivative(t);
+      EXPECT_EQ(x_series.EvaluateDerivative(t), derivative.coordinates().x)
+          << degree;
+      EXPECT_EQ(y_series.EvaluateDerivative(t), derivative.coordinates().y)
+          << degree;
+      EXPECT_EQ(z_series.EvaluateDerivative(t), derivative.coordinates().z)
+          << degree;
+      V value_with_derivative;
+      Variation<V> derivative_with_value;
+      series.EvaluateWithDerivative(
+          t, value_with_derivative, derivative_with_value);
+      EXPECT_EQ(value, value_with_derivative) << degree;
+      EXPECT_EQ(derivative, derivative_with_value) << degree;
+    }
+  }
+}
+
 TEST_F(ЧебышёвSeriesDeathTest, SerializationError) {
   ЧебышёвSeries<Speed> v({1 * Metre / Second,
                           -2 * Metre / Second,
@@ -396,6 +447,63 @@ TEST_F(ЧебышёвSeriesTest, NewhallApproximation) {
                               near_speed(1.3e-12 * Metre / Second)));
 }
 
+TEST_F(ЧебышёвSeriesTest, NewhallApproximatorLastCoefficient) {
+  using V = Vector<Length, ICRFJ2000Ecliptic>;
+  std::vector<V> positions;
+  std::vector<Variation<V>> velocities;
+  for (Instant t = t_min_; t <= t_max_; t += 0.5 * Second) {
+    double const τ = (t - t_min_) / (1 * Second);
+    positions.push_back(
+        V({std::sin(τ) * Metre, std::exp(τ) * Metre, τ * τ * τ * Metre}));
+    velocities.push_back(Variation<V>({std::cos(τ) * Metre / Second,
+                                       std::exp(τ) * Metre / Second,
+                                       3 * τ * τ * Metre / Second}));
+  }
+  NewhallApproximator<V> const approximator(
+      positions, velocities, t_min_, t_max_);
+  for (int degree = 3; degree <= 17; ++degree) {
+    ЧебышёвSeries<V> const approximation =
+        ЧебышёвSeries<V>::NewhallApproximation(
+            degree, positions, velocities, t_min_, t_max_);
+    EXPECT_EQ(approximation.last_coefficient(),
+              approximator.LastCoefficient(degree)) << degree;
+    EXPECT_EQ(approximation, approximator.Approximation(degree)) << degree;
+  }
+}
+
+TEST_F(ЧебышёвSeriesTest, Block) {
+  using V = Vector<Length, ICRFJ2000Ecliptic>;
+  std::vector<V> positions;
+  std::vector<Variation<V>> velocities;
+  for (Instant t = t_min_; t <= t_max_; t += 0.5 * Second) {
+    double const τ = (t - t_min_) / (1 * Second);
+    positions.push_back(
+        V({std::cos(τ) * Metre, std::exp(-τ) * Metre, τ * τ * Metre}));
+    velocities.push_back(Variation<V>({-std::sin(τ) * Metre / Second,
+                                       -std::exp(-τ) * Metre / Second,
+                                       2 * τ * Metre / Second}));
+  }
+  for (int degree = 3; degree <= 17; ++degree) {
+    ЧебышёвSeries<V> const series = ЧебышёвSeries<V>::NewhallApproximation(
+        degree, positions, velocities, t_min_, t_max_);
+    ЧебышёвSeriesBlock block;
+    series.WriteToBlock(&block);
+    EXPECT_EQ(degree, block.degree);
+    EXPECT_EQ(series, ЧебышёвSeries<V>::ReadFromBlock(block)) << degree;
+    for (Instant t = t_min_; t <= t_max_; t += 0.3 * Second) {
+      EXPECT_EQ(series.Evaluate(t), ЧебышёвSeries<V>::EvaluateBlock(block, t));
+      EXPECT_EQ(series.EvaluateDerivative(t),
+                ЧебышёвSeries<V>::EvaluateBlockDerivative(block, t));
+      V value;
+      Variation<V> derivative;
+      ЧебышёвSeries<V>::EvaluateBlockWithDerivative(
+          block, t, value, derivative);
+      EXPECT_EQ(series.Evaluate(t), value);
+      EXPECT_EQ(series.EvaluateDerivative(t), derivative);
+    }
+  }
+}
+
 }  // namespace internal_чебышёв_series
 }  // namespace numerics
 }  // namespace principia
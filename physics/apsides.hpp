@@ -1,5 +1,6 @@
 #pragma once
 
+#include "physics/continuous_trajectory.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/trajectory.hpp"
 
@@ -30,17 +31,28 @@ void ComputeNodes(typename DiscreteTrajectory<Frame>::Iterator begin,
                   DiscreteTrajectory<Frame>& ascending,
                   DiscreteTrajectory<Frame>& descending);
 
-// TODO(egg): when we can usefully iterate over an arbitrary |Trajectory|, move
-// the following from |Ephemeris|.
-#if 0
+// Computes the apsides of the relative motion of |trajectory1| and
+// |trajectory2| over the intersection of their ranges.  The trajectories are
+// evaluated once per |trajectory1.step()|.  The time of an apsis is first
+// estimated in closed form on a Hermite approximation of the squared distance
+// over the step where it occurs, and then refined to within one ULP on the
+// trajectories.  Appends to the given trajectories one point for each apsis.
 template<typename Frame>
-void ComputeApsides(Trajectory<Frame> const& trajectory1,
-                    Trajectory<Frame> const& trajectory2,
+void ComputeApsides(ContinuousTrajectory<Frame> const& trajectory1,
+                    ContinuousTrajectory<Frame> const& trajectory2,
                     DiscreteTrajectory<Frame>& apoapsides1,
                     DiscreteTrajectory<Frame>& periapsides1,
                     DiscreteTrajectory<Frame>& apoapsides2,
                     DiscreteTrajectory<Frame>& periapsides2);
-#endif
+
+// Same as above for the crossings of |trajectory| with the xy plane.  The time
+// of a node is estimated on a Hermite approximation of z over the step where it
+// occurs and refined on the trajectory.
+template<typename Frame>
+void ComputeNodes(ContinuousTrajectory<Frame> const& trajectory,
+                  Vector<double, Frame> const& north,
+                  DiscreteTrajectory<Frame>& ascending,
+                  DiscreteTrajectory<Frame>& descending);
 
 }  // namespace internal_apsides
 
@@ -2,6 +2,7 @@
 
 #include "physics/apsides.hpp"
 
+#include <algorithm>
 #include <set>
 
 #include "numerics/root_finders.hpp"
@@ -19,8 +20,160 @@ using numerics::Hermite3;
 using quantities::Length;
 using quantities::Speed;
 using quantities::Square;
+using quantities::Time;
 using quantities::Variation;
 
+// Returns the time of the extremum of the Hermite approximation of the squared
+// distance over [t1, t2], whose derivative is known to change sign between
+// these bounds.
+inline Instant ApsisTime(
+    Instant const& t1,
+    Instant const& t2,
+    Square<Length> const& squared_distance1,
+    Square<Length> const& squared_distance2,
+    Variation<Square<Length>> const& squared_distance_derivative1,
+    Variation<Square<Length>> const& squared_distance_derivative2) {
+  // Construct a Hermite approximation of |squared_distance| and find its
+  // extrema.
+  Hermite3<Instant, Square<Length>> const squared_distance_approximation(
+      {t1, t2},
+      {squared_distance1, squared_distance2},
+      {squared_distance_derivative1, squared_distance_derivative2});
+  std::set<Instant> const extrema =
+      squared_distance_approximation.FindExtrema();
+
+  // Now look at the extrema and check that exactly one is in the required time
+  // interval.  This is normally the case, but it can fail due to
+  // ill-conditioning.
+  Instant apsis_time;
+  int valid_extrema = 0;
+  for (auto const& extremum : extrema) {
+    if (extremum >= t1 && extremum <= t2) {
+      apsis_time = extremum;
+      ++valid_extrema;
+    }
+  }
+  if (valid_extrema != 1) {
+    // Something went wrong when finding the extrema of
+    // |squared_distance_approximation|. Use a linear interpolation of
+    // |squared_distance_derivative| instead.
+    apsis_time = Barycentre<Instant, Variation<Square<Length>>>(
+        {t2, t1},
+        {squared_distance_derivative1, -squared_distance_derivative2});
+  }
+  return apsis_time;
+}
+
+// Returns the zero of the Hermite approximation of z over [t1, t2], which is
+// known to change sign between these bounds.
+inline Instant NodeTime(Instant const& t1,
+                        Instant const& t2,
+                        Length const& z1,
+                        Length const& z2,
+                        Speed const& z_speed1,
+                        Speed const& z_speed2) {
+  // Construct a Hermite approximation of |z| and find its zeros in closed
+  // form.
+  Hermite3<Instant, Length> const z_approximation(
+      {t1, t2}, {z1, z2}, {z_speed1, z_speed2});
+  std::set<Instant> const roots = z_approximation.FindRoots();
+
+  Instant node_time;
+  int valid_roots = 0;
+  for (auto const& root : roots) {
+    if (root >= t1 && root <= t2) {
+      node_time = root;
+      ++valid_roots;
+    }
+  }
+  if (valid_roots != 1) {
+    // The closed form is ill-conditioned, e.g., because the approximation is
+    // nearly tangent to the xy plane.  Bisection is slow but it always
+    // produces a zero in the interval.
+    node_time = Bisect(
+        [&z_approximation](Instant const& t) {
+          return z_approximation.Evaluate(t);
+        },
+        t1,
+        t2);
+  }
+  return node_time;
+}
+
+// Returns a zero of |f| in [t1, t2] to within one ULP.  |f(t1)| and |f(t2)|
+// must be of opposite signs or zero.  |estimate|, which must be in [t1, t2],
+// is an approximation of the zero from which the secant method starts.  A
+// bracket of the zero is maintained, and it is bisected if a secant step
+// leaves it.  This usually takes a handful of evaluations, where bisection
+// alone would take about 50.
+template<typename Function>
+Instant RefineZero(Function const& f,
+                   Instant const& t1,
+                   Instant const& t2,
+                   Instant const& estimate) {
+  using Value = decltype(f(t1));
+  Value const zero{};
+  Instant lower = t1;
+  Instant upper = t2;
+  Value const f_lower = f(lower);
+  Value const f_upper = f(upper);
+  if (f_lower == zero) {
+    return lower;
+  }
+  if (f_upper == zero) {
+    return upper;
+  }
+  CHECK(Sign(f_lower) != Sign(f_upper))
+      << "\nlower: " << lower << " :-> " << f_lower << ", "
+      << "\nupper: " << upper << " :-> " << f_upper;
+
+  // The secant goes through the last two iterates.  The first one is the
+  // bound of the bracket that is not replaced by |estimate|.
+  Instant current = estimate;
+  Value f_current = f(current);
+  Instant previous = Sign(f_current) == Sign(f_lower) ? upper : lower;
+  Value f_previous = Sign(f_current) == Sign(f_lower) ? f_upper : f_lower;
+  for (;;) {
+    if (f_current == zero) {
+      return current;
+    }
+    if (Sign(f_current) == Sign(f_lower)) {
+      lower = current;
+    } else {
+      upper = current;
+    }
+    Instant const middle = Barycentre<Instant, double>({lower, upper}, {1, 1});
+    // The size of the bracket has reached one ULP.
+    if (middle == lower || middle == upper) {
+      return middle;
+    }
+    Instant next = current - f_current * (current - previous) /
+                                 (f_current - f_previous);
+    // The secant step is below one ULP, |current| is as good as it gets.
+    if (next == current) {
+      return current;
+    }
+    // The secant step left the bracket (or is not a number because the last
+    // two values are equal): bisect.
+    if (!(lower < next && next < upper)) {
+      next = middle;
+    }
+    previous = current;
+    f_previous = f_current;
+    current = next;
+    f_current = f(current);
+  }
+}
+
+// Returns the time that follows |time| when a continuous trajectory is sampled
+// every |step|.  |t_max| is always sampled, even if it is not on the grid, and
+// the result is after |t_max| once it has been.
+inline Instant NextSamplingTime(Instant const& time,
+                                Time const& step,
+                                Instant const& t_max) {
+  return time < t_max ? std::min(time + step, t_max) : time + step;
+}
+
 template<typename Frame>
 void ComputeApsides(Trajectory<Frame> const& reference,
                     typename DiscreteTrajectory<Frame>::Iterator const begin,
@@ -62,37 +215,14 @@ void ComputeApsides(Trajectory<Frame> const& reference,
             previous_degrees_of_freedom &&
             previous_squared_distance);
 
-      // The derivative of |squared_distance| changed sign.  Construct a Hermite
-      // approximation of |squared_distance| and find its extrema.
-      Hermite3<Instant, Square<Length>> const
-          squared_distance_approximation(
-              {*previous_time, time},
-              {*previous_squared_distance, squared_distance},
-              {*previous_squared_distance_derivative,
-               squared_distance_derivative});
-      std::set<Instant> const extrema =
-          squared_distance_approximation.FindExtrema();
-
-      // Now look at the extrema and check that exactly one is in the required
-      // time interval.  This is normally the case, but it can fail due to
-      // ill-conditioning.
-      Instant apsis_time;
-      int valid_extrema = 0;
-      for (auto const& extremum : extrema) {
-        if (extremum >= *previous_time && extremum <= time) {
-          apsis_time = extremum;
-          ++valid_extrema;
-        }
-      }
-      if (valid_extrema != 1) {
-        // Something went wrong when finding the extrema of
-        // |squared_distance_approximation|. Use a linear interpolation of
-        // |squared_distance_derivative| instead.
-        apsis_time = Barycentre<Instant, Variation<Square<Length>>>(
-            {time, *previous_time},
-            {*previous_squared_distance_derivative,
-             -squared_distance_derivative});
-      }
+      // The derivative of |squared_distance| changed sign.  Find the extremum
+      // of its Hermite approximation.
+      Instant const apsis_time = ApsisTime(*previous_time,
+                                           time,
+                                           *previous_squared_distance,
+                                           squared_distance,
+                                           *previous_squared_distance_derivative,
+                                           squared_distance_derivative);
 
       // Now that we know the time of the apsis, use a Hermite approximation to
       // derive its degrees of freedom.  Note that an extremum of
@@ -137,20 +267,9 @@ void ComputeNodes(typename DiscreteTrajectory<Frame>::Iterator begin,
     if (previous_z && Sign(z) != Sign(*previous_z)) {
       CHECK(previous_time && previous_z_speed);
 
-      // |z| changed sign.  Construct a Hermite approximation of |z| and find
-      // its zeros.
-      // TODO(egg): Bisection on a polynomial seems daft; we should have
-      // Newton's method.
-      Hermite3<Instant, Length> const z_approximation(
-          {*previous_time, time},
-          {*previous_z, z},
-          {*previous_z_speed, z_speed});
-      Instant const node_time = Bisect(
-          [&z_approximation](Instant const& t) {
-            return z_approximation.Evaluate(t);
-          },
-          *previous_time,
-          time);
+      // |z| changed sign.  Find the zero of its Hermite approximation.
+      Instant const node_time = NodeTime(
+          *previous_time, time, *previous_z, z, *previous_z_speed, z_speed);
 
       DegreesOfFreedom<Frame> const node_degrees_of_freedom =
           begin.trajectory()->EvaluateDegreesOfFreedom(node_time);
@@ -170,6 +289,139 @@ void ComputeNodes(typename DiscreteTrajectory<Frame>::Iterator begin,
   }
 }
 
+template<typename Frame>
+void ComputeApsides(ContinuousTrajectory<Frame> const& trajectory1,
+                    ContinuousTrajectory<Frame> const& trajectory2,
+                    DiscreteTrajectory<Frame>& apoapsides1,
+                    DiscreteTrajectory<Frame>& periapsides1,
+                    DiscreteTrajectory<Frame>& apoapsides2,
+                    DiscreteTrajectory<Frame>& periapsides2) {
+  std::experimental::optional<Instant> previous_time;
+  std::experimental::optional<Square<Length>> previous_squared_distance;
+  std::experimental::optional<Variation<Square<Length>>>
+      previous_squared_distance_derivative;
+
+  Instant const t_min = std::max(trajectory1.t_min(), trajectory2.t_min());
+  Instant const t_max = std::min(trajectory1.t_max(), trajectory2.t_max());
+
+  // Computes the derivative of the squared distance between the trajectories
+  // at time |t|.
+  auto const evaluate_squared_distance_derivative =
+      [&trajectory1, &trajectory2](
+          Instant const& t) -> Variation<Square<Length>> {
+    RelativeDegreesOfFreedom<Frame> const relative =
+        trajectory1.EvaluateDegreesOfFreedom(t) -
+        trajectory2.EvaluateDegreesOfFreedom(t);
+    return 2.0 * InnerProduct(relative.displacement(), relative.velocity());
+  };
+
+  for (Instant time = t_min;
+       time <= t_max;
+       time = NextSamplingTime(time, trajectory1.step(), t_max)) {
+    RelativeDegreesOfFreedom<Frame> const relative =
+        trajectory1.EvaluateDegreesOfFreedom(time) -
+        trajectory2.EvaluateDegreesOfFreedom(time);
+    Square<Length> const squared_distance =
+        InnerProduct(relative.displacement(), relative.displacement());
+    // This is the derivative of |squared_distance|.
+    Variation<Square<Length>> const squared_distance_derivative =
+        2.0 * InnerProduct(relative.displacement(), relative.velocity());
+
+    if (previous_squared_distance_derivative &&
+        Sign(squared_distance_derivative) !=
+            Sign(*previous_squared_distance_derivative)) {
+      CHECK(previous_time && previous_squared_distance);
+
+      // The derivative of |squared_distance| changed sign.  The extremum of
+      // its Hermite approximation is close to the time of the apsis; refine it
+      // on the exact derivative.  Then compute the apsis and append it to one
+      // of the output trajectories.
+      Instant const apsis_time = RefineZero(
+          evaluate_squared_distance_derivative,
+          *previous_time,
+          time,
+          ApsisTime(*previous_time,
+                    time,
+                    *previous_squared_distance,
+                    squared_distance,
+                    *previous_squared_distance_derivative,
+                    squared_distance_derivative));
+      DegreesOfFreedom<Frame> const apsis1_degrees_of_freedom =
+          trajectory1.EvaluateDegreesOfFreedom(apsis_time);
+      DegreesOfFreedom<Frame> const apsis2_degrees_of_freedom =
+          trajectory2.EvaluateDegreesOfFreedom(apsis_time);
+      if (Sign(squared_distance_derivative).Negative()) {
+        apoapsides1.Append(apsis_time, apsis1_degrees_of_freedom);
+        apoapsides2.Append(apsis_time, apsis2_degrees_of_freedom);
+      } else {
+        periapsides1.Append(apsis_time, apsis1_degrees_of_freedom);
+        periapsides2.Append(apsis_time, apsis2_degrees_of_freedom);
+      }
+    }
+
+    previous_time = time;
+    previous_squared_distance = squared_distance;
+    previous_squared_distance_derivative = squared_distance_derivative;
+  }
+}
+
+template<typename Frame>
+void ComputeNodes(ContinuousTrajectory<Frame> const& trajectory,
+                  Vector<double, Frame> const& north,
+                  DiscreteTrajectory<Frame>& ascending,
+                  DiscreteTrajectory<Frame>& descending) {
+  std::experimental::optional<Instant> previous_time;
+  std::experimental::optional<Length> previous_z;
+  std::experimental::optional<Speed> previous_z_speed;
+
+  auto const evaluate_z = [&trajectory](Instant const& t) -> Length {
+    return (trajectory.EvaluatePosition(t) - Frame::origin).coordinates().z;
+  };
+
+  Instant const t_max = trajectory.t_max();
+  for (Instant time = trajectory.t_min();
+       time <= t_max;
+       time = NextSamplingTime(time, trajectory.step(), t_max)) {
+    DegreesOfFreedom<Frame> const degrees_of_freedom =
+        trajectory.EvaluateDegreesOfFreedom(time);
+    Length const z =
+        (degrees_of_freedom.position() - Frame::origin).coordinates().z;
+    Speed const z_speed = degrees_of_freedom.velocity().coordinates().z;
+
+    if (previous_z && Sign(z) != Sign(*previous_z)) {
+      CHECK(previous_time && previous_z_speed);
+
+      // |z| changed sign.  The zero of its Hermite approximation is close to
+      // the time of the node; refine it on the exact |z|.
+      Instant const node_time = RefineZero(
+          evaluate_z,
+          *previous_time,
+          time,
+          NodeTime(*previous_time,
+                   time,
+                   *previous_z,
+                   z,
+                   *previous_z_speed,
+                   z_speed));
+
+      DegreesOfFreedom<Frame> const node_degrees_of_freedom =
+          trajectory.EvaluateDegreesOfFreedom(node_time);
+      if (Sign(InnerProduct(north, Vector<double, Frame>({0, 0, 1}))) ==
+          Sign(z_speed)) {
+        // |north| is up and we are going up, or |north| is down and we are
+        // going down.
+        ascending.Append(node_time, node_degrees_of_freedom);
+      } else {
+        descending.Append(node_time, node_degrees_of_freedom);
+      }
+    }
+
+    previous_time = time;
+    previous_z = z;
+    previous_z_speed = z_speed;
+  }
+}
+
 }  // namespace internal_apsides
 }  // namespace physics
 }  // namespace principia
@@ -12,6 +12,7 @@
 #include "physics/ephemeris.hpp"
 #include "physics/kepler_orbit.hpp"
 #include "quantities/astronomy.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "testing_utilities/almost_equals.hpp"
 
 namespace principia {
@@ -24,6 +25,7 @@ using geometry::Frame;
 using geometry::Velocity;
 using integrators::DormandElMikkawyPrince1986RKN434FM;
 using integrators::QuinlanTremaine1990Order12;
+using quantities::Cos;
 using quantities::GravitationalParameter;
 using quantities::Pow;
 using quantities::Speed;
@@ -41,6 +43,7 @@ using quantities::si::Radian;
 using quantities::si::Second;
 using testing_utilities::AlmostEquals;
 using ::testing::Eq;
+using ::testing::Le;
 
 class ApsidesTest : public ::testing::Test {
  protected:
@@ -208,7 +211,7 @@ TEST_F(ApsidesTest, ComputeNodes) {
                     .longitude,
                 AlmostEquals(elements.longitude_of_ascending_node, 2, 100));
     if (previous_time) {
-      EXPECT_THAT(time - *previous_time, AlmostEquals(period, 1, 19));
+      EXPECT_THAT(time - *previous_time, AlmostEquals(period, 0, 19));
     }
     previous_time = time;
   }
@@ -260,6 +263,193 @@ TEST_F(ApsidesTest, ComputeNodes) {
   }
 }
 
+TEST_F(ApsidesTest, ComputeApsidesContinuousTrajectory) {
+  Instant const t0;
+  GravitationalParameter const μ = GravitationalConstant * SolarMass;
+  auto const sun = new MassiveBody(μ);
+  auto const planet = new MassiveBody(1e-3 * μ);
+
+  KeplerianElements<World> elements;
+  elements.eccentricity = 0.25;
+  elements.semimajor_axis = 1 * AstronomicalUnit;
+  elements.inclination = 10 * Degree;
+  elements.longitude_of_ascending_node = 42 * Degree;
+  elements.argument_of_periapsis = 100 * Degree;
+  KeplerOrbit<World> const orbit{*sun, *planet, elements, t0};
+  elements = orbit.elements_at_epoch();
+  Time const period = 2 * π * Radian / *elements.mean_motion;
+  Length const a = *elements.semimajor_axis;
+  double const e = elements.eccentricity;
+
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<World>> initial_state;
+  bodies.emplace_back(std::unique_ptr<MassiveBody const>(sun));
+  bodies.emplace_back(std::unique_ptr<MassiveBody const>(planet));
+  initial_state.emplace_back(World::origin, Velocity<World>());
+  initial_state.push_back(initial_state[0] + orbit.StateVectors(t0));
+
+  // A realistic step, so that an apsis is far from the ends of the step where
+  // it occurs.
+  Ephemeris<World>
+      ephemeris(
+          std::move(bodies),
+          initial_state,
+          t0,
+          5 * Milli(Metre),
+          Ephemeris<World>::FixedStepParameters(
+              QuinlanTremaine1990Order12<Position<World>>(),
+              10 * Minute));
+  ephemeris.Prolong(t0 + 10 * JulianYear);
+
+  DiscreteTrajectory<World> apoapsides1;
+  DiscreteTrajectory<World> periapsides1;
+  DiscreteTrajectory<World> apoapsides2;
+  DiscreteTrajectory<World> periapsides2;
+  ComputeApsides(*ephemeris.trajectory(sun),
+                 *ephemeris.trajectory(planet),
+                 apoapsides1,
+                 periapsides1,
+                 apoapsides2,
+                 periapsides2);
+  EXPECT_THAT(apoapsides1.Size(), Eq(10));
+  EXPECT_THAT(periapsides1.Size(), Eq(10));
+  EXPECT_THAT(apoapsides2.Size(), Eq(10));
+  EXPECT_THAT(periapsides2.Size(), Eq(10));
+
+  std::experimental::optional<Instant> previous_time;
+  for (auto it1 = apoapsides1.Begin(), it2 = apoapsides2.Begin();
+       it1 != apoapsides1.End();
+       ++it1, ++it2) {
+    Instant const time = it1.time();
+    EXPECT_EQ(time, it2.time());
+    EXPECT_THAT((it2.degrees_of_freedom().position() -
+                 it1.degrees_of_freedom().position()).Norm(),
+                AlmostEquals((1 + e) * a, 4, 7));
+    if (previous_time) {
+      EXPECT_THAT(time - *previous_time, AlmostEquals(period, 1155, 6051));
+    }
+    previous_time = time;
+  }
+
+  previous_time = std::experimental::nullopt;
+  for (auto it1 = periapsides1.Begin(), it2 = periapsides2.Begin();
+       it1 != periapsides1.End();
+       ++it1, ++it2) {
+    Instant const time = it1.time();
+    EXPECT_EQ(time, it2.time());
+    EXPECT_THAT((it2.degrees_of_freedom().position() -
+                 it1.degrees_of_freedom().position()).Norm(),
+                AlmostEquals((1 - e) * a, 0, 2));
+    if (previous_time) {
+      EXPECT_THAT(time - *previous_time, AlmostEquals(period, 29, 787));
+    }
+    previous_time = time;
+  }
+}
+
+TEST_F(ApsidesTest, ComputeNodesContinuousTrajectory) {
+  Instant const t0;
+  GravitationalParameter const μ = GravitationalConstant * SolarMass;
+  auto const sun = new MassiveBody(μ);
+  auto const planet = new MassiveBody(1e-9 * μ);
+
+  KeplerianElements<World> elements;
+  elements.eccentricity = 0.25;
+  elements.semimajor_axis = 1 * AstronomicalUnit;
+  elements.inclination = 10 * Degree;
+  elements.longitude_of_ascending_node = 42 * Degree;
+  elements.argument_of_periapsis = 100 * Degree;
+  KeplerOrbit<World> const orbit{*sun, *planet, elements, t0};
+  elements = orbit.elements_at_epoch();
+  Time const period = 2 * π * Radian / *elements.mean_motion;
+
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<World>> initial_state;
+  bodies.emplace_back(std::unique_ptr<MassiveBody const>(sun));
+  bodies.emplace_back(std::unique_ptr<MassiveBody const>(planet));
+  // Put the barycentre at rest at the origin, so that the orbital plane of the
+  // planet doesn't drift.
+  RelativeDegreesOfFreedom<World> const relative = orbit.StateVectors(t0);
+  double const sun_fraction = sun->mass() / (sun->mass() + planet->mass());
+  initial_state.emplace_back(
+      World::origin - (1 - sun_fraction) * relative.displacement(),
+      -(1 - sun_fraction) * relative.velocity());
+  initial_state.emplace_back(
+      World::origin + sun_fraction * relative.displacement(),
+      sun_fraction * relative.velocity());
+
+  Ephemeris<World>
+      ephemeris(
+          std::move(bodies),
+          initial_state,
+          t0,
+          5 * Milli(Metre),
+          Ephemeris<World>::FixedStepParameters(
+              QuinlanTremaine1990Order12<Position<World>>(),
+              10 * Minute));
+  ephemeris.Prolong(t0 + 10 * JulianYear);
+
+  DiscreteTrajectory<World> ascending_nodes;
+  DiscreteTrajectory<World> descending_nodes;
+  ComputeNodes(*ephemeris.trajectory(planet),
+               Vector<double, World>({0, 0, 1}),
+               ascending_nodes,
+               descending_nodes);
+  EXPECT_THAT(ascending_nodes.Size(), Eq(10));
+  EXPECT_THAT(descending_nodes.Size(), Eq(10));
+
+  std::experimental::optional<Instant> previous_time;
+  for (auto it = ascending_nodes.Begin(); it != ascending_nodes.End(); ++it) {
+    Instant const time = it.time();
+    EXPECT_THAT((it.degrees_of_freedom().position() - World::origin)
+                    .coordinates()
+                    .ToSpherical()
+                    .longitude,
+                AlmostEquals(elements.longitude_of_ascending_node, 0, 44));
+    if (previous_time) {
+      EXPECT_THAT(time - *previous_time, AlmostEquals(period, 1, 15));
+    }
+    previous_time = time;
+  }
+
+  previous_time = std::experimental::nullopt;
+  for (auto it = descending_nodes.Begin(); it != descending_nodes.End(); ++it) {
+    Instant const time = it.time();
+    EXPECT_THAT(
+        (it.degrees_of_freedom().position() - World::origin)
+                .coordinates()
+                .ToSpherical()
+                .longitude,
+        AlmostEquals(elements.longitude_of_ascending_node - π * Radian, 0, 26));
+    if (previous_time) {
+      EXPECT_THAT(time - *previous_time, AlmostEquals(period, 1, 15));
+    }
+    previous_time = time;
+  }
+}
+
+// The secant iteration converges to one ULP in far fewer evaluations than
+// bisection.
+TEST_F(ApsidesTest, RefineZero) {
+  Instant const t0;
+  int evaluations = 0;
+  auto const f = [t0, &evaluations](Instant const& t) -> Length {
+    ++evaluations;
+    return Cos((t - t0) * Radian / Second) * Metre;
+  };
+  Instant const zero =
+      RefineZero(f, t0 + 1 * Second, t0 + 2 * Second, t0 + 1.5 * Second);
+  EXPECT_THAT(zero - t0, AlmostEquals(π / 2 * Second, 0, 1));
+  EXPECT_THAT(evaluations, Le(10));
+
+  // A poor estimate still converges.
+  evaluations = 0;
+  EXPECT_THAT(RefineZero(f, t0 + 1 * Second, t0 + 2 * Second, t0 + 2 * Second) -
+                  t0,
+              AlmostEquals(π / 2 * Second, 0, 1));
+  EXPECT_THAT(evaluations, Le(10));
+}
+
 }  // namespace internal_apsides
 }  // namespace physics
 }  // namespace principia
@@ -47,9 +47,6 @@ class BarycentricRotatingDynamicFrame
       not_null<MassiveBody const*> primary,
       not_null<MassiveBody const*> secondary);
 
-  RigidMotion<InertialFrame, ThisFrame> ToThisFrameAtTime(
-      Instant const& t) const override;
-
   void WriteToMessage(
       not_null<serialization::DynamicFrame*> message) const override;
 
@@ -64,6 +61,8 @@ class BarycentricRotatingDynamicFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  RigidMotion<InertialFrame, ThisFrame> ComputeToThisFrameAtTime(
+      Instant const& t) const override;
 
   // Fills |rotation| with the rotation that maps the basis of |InertialFrame|
   // to the basis of |ThisFrame|.  Fills |angular_velocity| with the
@@ -41,8 +41,8 @@ BarycentricRotatingDynamicFrame(
 
 template<typename InertialFrame, typename ThisFrame>
 RigidMotion<InertialFrame, ThisFrame>
-BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
-    Instant const& t) const {
+BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::
+    ComputeToThisFrameAtTime(Instant const& t) const {
   DegreesOfFreedom<InertialFrame> const primary_degrees_of_freedom =
       primary_trajectory_->EvaluateDegreesOfFreedom(t);
   DegreesOfFreedom<InertialFrame> const secondary_degrees_of_freedom =
@@ -116,7 +116,7 @@ BarycentricRotatingDynamicFrame<InertialFrame, ThisFrame>::MotionOfThisFrame(
   Vector<Acceleration, InertialFrame> const secondary_acceleration =
       ephemeris_->ComputeGravitationalAccelerationOnMassiveBody(secondary_, t);
 
-  auto const to_this_frame = ToThisFrameAtTime(t);
+  auto const to_this_frame = this->ToThisFrameAtTime(t);
 
   // TODO(egg): TeX and reference.
   RelativeDegreesOfFreedom<InertialFrame> const secondary_primary =
@@ -52,9 +52,6 @@ class BodyCentredBodyDirectionDynamicFrame
       std::function<Trajectory<InertialFrame> const&()> primary_trajectory,
       not_null<MassiveBody const*> secondary);
 
-  RigidMotion<InertialFrame, ThisFrame> ToThisFrameAtTime(
-      Instant const& t) const override;
-
   void WriteToMessage(
       not_null<serialization::DynamicFrame*> message) const override;
 
@@ -69,6 +66,11 @@ class BodyCentredBodyDirectionDynamicFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  RigidMotion<InertialFrame, ThisFrame> ComputeToThisFrameAtTime(
+      Instant const& t) const override;
+  // The trajectory of a primary that is not a massive body, e.g., a vessel
+  // prediction, may be recomputed, so the motion is not memoized in that case.
+  bool IsMemoizable() const override;
 
   // Fills |rotation| with the rotation that maps the basis of |InertialFrame|
   // to the basis of |ThisFrame|.  Fills |angular_velocity| with the
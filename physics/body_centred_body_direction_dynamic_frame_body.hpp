@@ -64,7 +64,7 @@ BodyCentredBodyDirectionDynamicFrame(
 template<typename InertialFrame, typename ThisFrame>
 RigidMotion<InertialFrame, ThisFrame>
 BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
-    ToThisFrameAtTime(Instant const& t) const {
+    ComputeToThisFrameAtTime(Instant const& t) const {
   DegreesOfFreedom<InertialFrame> const primary_degrees_of_freedom =
       primary_trajectory_().EvaluateDegreesOfFreedom(t);
   DegreesOfFreedom<InertialFrame> const secondary_degrees_of_freedom =
@@ -136,7 +136,7 @@ MotionOfThisFrame(Instant const& t) const {
   Vector<Acceleration, InertialFrame> const secondary_acceleration =
       ephemeris_->ComputeGravitationalAccelerationOnMassiveBody(secondary_, t);
 
-  auto const to_this_frame = ToThisFrameAtTime(t);
+  auto const to_this_frame = this->ToThisFrameAtTime(t);
 
   // TODO(egg): TeX and reference.
   RelativeDegreesOfFreedom<InertialFrame> const secondary_primary =
@@ -160,6 +160,12 @@ MotionOfThisFrame(Instant const& t) const {
              acceleration_of_to_frame_origin);
 }
 
+template<typename InertialFrame, typename ThisFrame>
+bool BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
+IsMemoizable() const {
+  return primary_ != nullptr;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 void BodyCentredBodyDirectionDynamicFrame<InertialFrame, ThisFrame>::
 ComputeAngularDegreesOfFreedom(
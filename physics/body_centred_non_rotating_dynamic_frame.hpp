@@ -40,9 +40,6 @@ class BodyCentredNonRotatingDynamicFrame
       not_null<Ephemeris<InertialFrame> const*> ephemeris,
       not_null<MassiveBody const*> centre);
 
-  RigidMotion<InertialFrame, ThisFrame> ToThisFrameAtTime(
-      Instant const& t) const override;
-
   void WriteToMessage(
       not_null<serialization::DynamicFrame*> message) const override;
 
@@ -57,6 +54,8 @@ class BodyCentredNonRotatingDynamicFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  RigidMotion<InertialFrame, ThisFrame> ComputeToThisFrameAtTime(
+      Instant const& t) const override;
 
   not_null<Ephemeris<InertialFrame> const*> const ephemeris_;
   not_null<MassiveBody const*> const centre_;
@@ -23,8 +23,8 @@ BodyCentredNonRotatingDynamicFrame(
 
 template<typename InertialFrame, typename ThisFrame>
 RigidMotion<InertialFrame, ThisFrame>
-BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
-    Instant const& t) const {
+BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::
+    ComputeToThisFrameAtTime(Instant const& t) const {
   DegreesOfFreedom<InertialFrame> const centre_degrees_of_freedom =
       centre_trajectory_->EvaluateDegreesOfFreedom(t);
   RigidTransformation<InertialFrame, ThisFrame> const
@@ -69,7 +69,7 @@ AcceleratedRigidMotion<InertialFrame, ThisFrame>
 BodyCentredNonRotatingDynamicFrame<InertialFrame, ThisFrame>::MotionOfThisFrame(
     Instant const& t) const {
   return AcceleratedRigidMotion<InertialFrame, ThisFrame>(
-             ToThisFrameAtTime(t),
+             this->ToThisFrameAtTime(t),
              /*angular_acceleration_of_to_frame=*/{},
              /*acceleration_of_to_frame_origin=*/ephemeris_->
                  ComputeGravitationalAccelerationOnMassiveBody(centre_, t));
@@ -41,9 +41,6 @@ class BodySurfaceDynamicFrame
   BodySurfaceDynamicFrame(not_null<Ephemeris<InertialFrame> const*> ephemeris,
                           not_null<RotatingBody<InertialFrame> const*> centre);
 
-  RigidMotion<InertialFrame, ThisFrame> ToThisFrameAtTime(
-      Instant const& t) const override;
-
   not_null<RotatingBody<InertialFrame> const*> centre() const;
 
   void WriteToMessage(
@@ -59,6 +56,8 @@ class BodySurfaceDynamicFrame
       Position<InertialFrame> const& q) const override;
   AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  RigidMotion<InertialFrame, ThisFrame> ComputeToThisFrameAtTime(
+      Instant const& t) const override;
 
   not_null<Ephemeris<InertialFrame> const*> const ephemeris_;
   not_null<RotatingBody<InertialFrame> const*> const centre_;
@@ -27,8 +27,8 @@ BodySurfaceDynamicFrame(
 
 template<typename InertialFrame, typename ThisFrame>
 RigidMotion<InertialFrame, ThisFrame>
-BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
-    Instant const& t) const {
+BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::
+    ComputeToThisFrameAtTime(Instant const& t) const {
   DegreesOfFreedom<InertialFrame> const centre_degrees_of_freedom =
       centre_trajectory_->EvaluateDegreesOfFreedom(t);
 
@@ -88,7 +88,7 @@ BodySurfaceDynamicFrame<InertialFrame, ThisFrame>::MotionOfThisFrame(
   Vector<Acceleration, InertialFrame> const centre_acceleration =
       ephemeris_->ComputeGravitationalAccelerationOnMassiveBody(centre_, t);
 
-  auto const to_this_frame = ToThisFrameAtTime(t);
+  auto const to_this_frame = this->ToThisFrameAtTime(t);
 
   Variation<AngularVelocity<InertialFrame>> const
       angular_acceleration_of_to_frame;
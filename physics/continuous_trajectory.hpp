@@ -1,10 +1,15 @@
 ﻿
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <experimental/optional>
+#include <memory>
+#include <ostream>
 #include <vector>
 #include <utility>
 
+#include "base/mapped_file.hpp"
 #include "base/status.hpp"
 #include "geometry/named_quantities.hpp"
 #include "numerics/чебышёв_series.hpp"
@@ -17,6 +22,7 @@ namespace principia {
 namespace physics {
 namespace internal_continuous_trajectory {
 
+using base::MappedFile;
 using base::not_null;
 using base::Status;
 using geometry::Displacement;
@@ -25,8 +31,18 @@ using geometry::Position;
 using geometry::Velocity;
 using quantities::Length;
 using quantities::Time;
+using numerics::NewhallApproximator;
 using numerics::ЧебышёвSeries;
-
+using numerics::ЧебышёвSeriesBlock;
+
+// Thread-safety: |Append| may run on one thread while other threads call
+// |empty|, |t_min|, |t_max| and the |Evaluate...| functions.  The readers see
+// the series that were fitted by the last completed |Append|: a series is
+// published once its degree has been chosen, and is never modified or moved
+// afterwards.  |ForgetBefore|, |Prepend| and |ReadFromMessage| must not run
+// concurrently with any other member function.
+// The oldest series may be stored in a memory-mapped file, in which case they
+// are evaluated in place, without being deserialized.
 template<typename Frame>
 class ContinuousTrajectory : public Trajectory<Frame> {
  public:
@@ -59,6 +75,10 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // benchmarking or analyzing performance.  Do not use in real code.
   double average_degree() const;
 
+  // The |step| given at construction.  Each Чебышёв series spans a fixed number
+  // of steps.
+  Time const& step() const;
+
   // Appends one point to the trajectory.  |time| must be after the last time
   // passed to |Append| if the trajectory is not empty.  The |time|s passed to
   // successive calls to |Append| must be equally spaced with the |step| given
@@ -69,6 +89,13 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // Removes all data for times strictly less than |time|.
   void ForgetBefore(Instant const& time);
 
+  // Prepends to this trajectory the series of |prefix| that end at or before
+  // the start of the first series of this trajectory.  One of them must end
+  // exactly there.  Used to restore the series that precede a checkpoint, see
+  // |WriteCheckpointToMessage|.  Neither trajectory may have series stored in
+  // a file.
+  void Prepend(ContinuousTrajectory&& prefix);
+
   // Implementation of the interface |Trajectory|.
 
   // |t_max| may be less than the last time passed to Append.  For an empty
@@ -96,6 +123,36 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   static not_null<std::unique_ptr<ContinuousTrajectory>> ReadFromMessage(
       serialization::ContinuousTrajectory const& message);
 
+  // Serializes the state of this object as it existed when the checkpoint was
+  // taken, but none of the series.  The trajectory read from |message| has no
+  // series, starts at the end of the series that preceded the checkpoint, and
+  // may be extended by |Append| exactly as this object was after the
+  // checkpoint.
+  void WriteCheckpointToMessage(
+      not_null<serialization::ContinuousTrajectory*> message,
+      Checkpoint const& checkpoint) const;
+
+  // Same as above, except that the series are written to |blocks| instead of
+  // |message|, as consecutive |ЧебышёвSeriesBlock|s.  |first_block| is the
+  // index of the first of these blocks in the file.  Returns the number of
+  // blocks written.
+  std::int64_t WriteToMessage(
+      not_null<serialization::ContinuousTrajectory*> message,
+      Checkpoint const& checkpoint,
+      std::int64_t first_block,
+      not_null<std::ostream*> blocks) const;
+  // Reads a |message| that may have been produced by the above function.
+  // |blocks| is the array of all the |number_of_blocks| blocks of the file that
+  // |series_file| maps in memory.  The trajectory keeps |series_file| alive and
+  // evaluates its blocks in place.  Since the file may be truncated, stale or
+  // corrupted, fails a CHECK if the blocks of |message| are not within
+  // |blocks|, do not have a specialized degree, or are not consecutive.
+  static not_null<std::unique_ptr<ContinuousTrajectory>> ReadFromMessage(
+      serialization::ContinuousTrajectory const& message,
+      std::shared_ptr<MappedFile const> const& series_file,
+      ЧебышёвSeriesBlock const* blocks,
+      std::int64_t number_of_blocks);
+
   // A |Checkpoint| contains the impermanent state of a trajectory, i.e., the
   // state that gets incrementally updated as the Чебышёв polynomials are
   // constructed.  The client may get a |Checkpoint| at any time and use it to
@@ -129,23 +186,52 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   // Computes the best Newhall approximation based on the desired tolerance.
   // Adjust the |degree_| and other member variables to stay within the
   // tolerance while minimizing the computational cost and avoiding numerical
-  // instabilities.
+  // instabilities.  The candidate degrees are assessed using
+  // |approximator.LastCoefficient|, and the approximation is only built, using
+  // |approximator.Approximation|, for the degree finally chosen.
+  // |Approximator| is a |NewhallApproximator<Displacement<Frame>>| except in
+  // tests.
+  template<typename Approximator>
   Status ComputeBestNewhallApproximation(
       Instant const& time,
       std::vector<Displacement<Frame>> const& q,
       std::vector<Velocity<Frame>> const& v,
-      ЧебышёвSeries<Displacement<Frame>> (*newhall_approximation)(
-          int degree,
-          std::vector<Displacement<Frame>> const& q,
-          std::vector<Velocity<Frame>> const& v,
-          Instant const& t_min,
-          Instant const& t_max));
-
-  // Returns an iterator to the series applicable for the given |time|, or
-  // |begin()| if |time| is before the first series or |end()| if |time| is
-  // after the last series.  Time complexity is O(N Log N).
-  typename std::vector<ЧебышёвSeries<Displacement<Frame>>>::const_iterator
-  FindSeriesForInstant(Instant const& time) const;
+      Approximator const& approximator);
+
+  // Makes the series appended to |series_| visible to the readers.
+  void PublishSeries();
+
+  // Serializes everything but the series.
+  void WriteStateToMessage(
+      not_null<serialization::ContinuousTrajectory*> message,
+      Checkpoint const& checkpoint) const;
+
+  // Calls |write_block| for each of the |blocks_| and then |write_series| for
+  // each of the |series_|, up to and including the time designated by
+  // |checkpoint|.
+  template<typename WriteBlock, typename WriteSeries>
+  void ForEachSeries(Checkpoint const& checkpoint,
+                     WriteBlock const& write_block,
+                     WriteSeries const& write_series) const;
+
+  // |Series| is either |ЧебышёвSeries<Displacement<Frame>>| or
+  // |ЧебышёвSeriesBlock|.  Returns a pointer to the element of [begin,
+  // begin + size) applicable for the given |time|, or to |begin| if |time| is
+  // before the first element, or nullptr if |time| is after the last element
+  // or |size| is 0.  Since all the series span the same number of steps, the
+  // element is found by indexing, and time complexity is O(1).  If the
+  // intervals are not uniform (which should not happen), falls back to a
+  // binary search, in O(Log N).
+  template<typename Series>
+  Series const* FindForInstant(Series const* begin,
+                               int size,
+                               Instant const& time) const;
+
+  // Applies |FindForInstant| to the published series and to the blocks,
+  // respectively.
+  ЧебышёвSeries<Displacement<Frame>> const* FindSeriesForInstant(
+      Instant const& time) const;
+  ЧебышёвSeriesBlock const* FindBlockForInstant(Instant const& time) const;
 
   // Construction parameters;
   Time const step_;
@@ -162,10 +248,33 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   int degree_age_;
 
   // The series are in increasing time order.  Their intervals are consecutive.
+  // Only accessed by the thread that calls |Append|; the elements of this
+  // vector are never moved because readers may be using them, so it only grows
+  // by being copied to a new buffer.
   std::vector<ЧебышёвSeries<Displacement<Frame>>> series_;
 
+  // The readers use the first |published_size_| elements of the array at
+  // |published_series_|.  The array is either the buffer of |series_| or one of
+  // the |retired_series_|, which hold copies of the same series.  The pointer
+  // is published before the size, so that the array is never too short.
+  std::atomic<ЧебышёвSeries<Displacement<Frame>> const*> published_series_{
+      nullptr};
+  std::atomic<int> published_size_{0};
+
+  // The buffers previously used by |series_|, which may still be accessed by
+  // readers.  Freed by |ForgetBefore|.
+  std::vector<std::vector<ЧебышёвSeries<Displacement<Frame>>>> retired_series_;
+
+  // The series that precede |series_|, stored in a memory-mapped file.  They
+  // are in increasing time order and their intervals are consecutive.  Only
+  // modified by |ForgetBefore|.
+  std::shared_ptr<MappedFile const> series_file_;
+  ЧебышёвSeriesBlock const* blocks_ = nullptr;
+  int number_of_blocks_ = 0;
+
   // The time at which this trajectory starts.  Set for a nonempty trajectory.
-  // |*first_time_ >= series_.front().t_min()|
+  // |*first_time_ >= series_.front().t_min()|, or the start of the first block
+  // if there are blocks.
   std::experimental::optional<Instant> first_time_;
 
   // The points that have not yet been incorporated in a series.  Nonempty for a
@@ -19,6 +19,8 @@ namespace internal_continuous_trajectory {
 
 using base::Error;
 using base::make_not_null_unique;
+using numerics::max_specialized_degree;
+using numerics::min_specialized_degree;
 using numerics::ULPDistance;
 using quantities::DebugString;
 using quantities::SIUnit;
@@ -29,9 +31,31 @@ int const max_degree = 17;
 int const min_degree = 3;
 int const max_degree_age = 100;
 
+// The initial capacity of the vector of series.
+int const min_series_capacity = 64;
+
 // Only supports 8 divisions for now.
 int const divisions = 8;
 
+// The intervals of the series held in memory and of those stored in blocks.
+template<typename Vector>
+Instant const& TMin(ЧебышёвSeries<Vector> const& series) {
+  return series.t_min();
+}
+
+template<typename Vector>
+Instant const& TMax(ЧебышёвSeries<Vector> const& series) {
+  return series.t_max();
+}
+
+inline Instant TMin(ЧебышёвSeriesBlock const& block) {
+  return Instant() + block.t_min * Second;
+}
+
+inline Instant TMax(ЧебышёвSeriesBlock const& block) {
+  return Instant() + block.t_max * Second;
+}
+
 template<typename Frame>
 ContinuousTrajectory<Frame>::ContinuousTrajectory(Time const& step,
                                                   Length const& tolerance)
@@ -46,7 +70,8 @@ ContinuousTrajectory<Frame>::ContinuousTrajectory(Time const& step,
 
 template<typename Frame>
 bool ContinuousTrajectory<Frame>::empty() const {
-  return series_.empty();
+  return published_size_.load(std::memory_order_acquire) == 0 &&
+         number_of_blocks_ == 0;
 }
 
 template<typename Frame>
@@ -55,13 +80,21 @@ double ContinuousTrajectory<Frame>::average_degree() const {
     return 0;
   } else {
     double total = 0;
+    for (int i = 0; i < number_of_blocks_; ++i) {
+      total += blocks_[i].degree;
+    }
     for (auto const& series : series_) {
       total += series.degree();
     }
-    return total / series_.size();
+    return total / (number_of_blocks_ + series_.size());
   }
 }
 
+template<typename Frame>
+Time const& ContinuousTrajectory<Frame>::step() const {
+  return step_;
+}
+
 template<typename Frame>
 Status ContinuousTrajectory<Frame>::Append(
     Instant const& time,
@@ -97,7 +130,11 @@ Status ContinuousTrajectory<Frame>::Append(
     v.push_back(degrees_of_freedom.velocity());
 
     status = ComputeBestNewhallApproximation(
-        time, q, v, &ЧебышёвSeries<Displacement<Frame>>::NewhallApproximation);
+        time,
+        q,
+        v,
+        NewhallApproximator<Displacement<Frame>>(
+            q, v, last_points_.cbegin()->first, time));
 
     // Wipe-out the points that have just been incorporated in a series.
     last_points_.clear();
@@ -118,11 +155,28 @@ void ContinuousTrajectory<Frame>::ForgetBefore(Instant const& time) {
     // |FindSeriesForInstant|.
     return;
   }
-  series_.erase(series_.begin(), FindSeriesForInstant(time));
+  ЧебышёвSeriesBlock const* const first_block = FindBlockForInstant(time);
+  if (first_block == nullptr) {
+    series_file_.reset();
+    blocks_ = nullptr;
+    number_of_blocks_ = 0;
+  } else {
+    number_of_blocks_ -= first_block - blocks_;
+    blocks_ = first_block;
+  }
 
-  // If there are no |series_| left, clear everything.  Otherwise, update the
+  ЧебышёвSeries<Displacement<Frame>> const* const first =
+      FindSeriesForInstant(time);
+  series_.erase(series_.begin(),
+                first == nullptr ? series_.end()
+                                 : series_.begin() + (first - series_.data()));
+  // There are no concurrent readers, so the old buffers can go.
+  retired_series_.clear();
+  PublishSeries();
+
+  // If there are no series left, clear everything.  Otherwise, update the
   // first time.
-  if (series_.empty()) {
+  if (empty()) {
     first_time_ = std::experimental::nullopt;
     last_points_.clear();
   } else {
@@ -130,6 +184,32 @@ void ContinuousTrajectory<Frame>::ForgetBefore(Instant const& time) {
   }
 }
 
+template<typename Frame>
+void ContinuousTrajectory<Frame>::Prepend(ContinuousTrajectory&& prefix) {
+  CHECK_EQ(0, number_of_blocks_);
+  CHECK_EQ(0, prefix.number_of_blocks_);
+  CHECK(!series_.empty());
+  Instant const t_min = series_.front().t_min();
+  std::vector<ЧебышёвSeries<Displacement<Frame>>> series;
+  series.reserve(prefix.series_.size() + series_.size());
+  for (auto& s : prefix.series_) {
+    if (s.t_max() > t_min) {
+      break;
+    }
+    series.push_back(std::move(s));
+  }
+  CHECK(!series.empty() && series.back().t_max() == t_min)
+      << "Prefix does not end at " << t_min;
+  for (auto const& s : series_) {
+    series.push_back(s);
+  }
+  // There are no concurrent readers, so the old buffers can go.
+  retired_series_.clear();
+  series_ = std::move(series);
+  PublishSeries();
+  first_time_ = prefix.first_time_;
+}
+
 template<typename Frame>
 Instant ContinuousTrajectory<Frame>::t_min() const {
   if (empty()) {
@@ -140,10 +220,14 @@ Instant ContinuousTrajectory<Frame>::t_min() const {
 
 template<typename Frame>
 Instant ContinuousTrajectory<Frame>::t_max() const {
-  if (empty()) {
+  int const size = published_size_.load(std::memory_order_acquire);
+  if (size > 0) {
+    return published_series_.load(std::memory_order_acquire)[size - 1].t_max();
+  } else if (number_of_blocks_ > 0) {
+    return TMax(blocks_[number_of_blocks_ - 1]);
+  } else {
     return astronomy::InfinitePast;
   }
-  return series_.back().t_max();
 }
 
 template<typename Frame>
@@ -151,8 +235,13 @@ Position<Frame> ContinuousTrajectory<Frame>::EvaluatePosition(
     Instant const& time) const {
   CHECK_LE(t_min(), time);
   CHECK_GE(t_max(), time);
+  auto const block = FindBlockForInstant(time);
+  if (block != nullptr) {
+    return ЧебышёвSeries<Displacement<Frame>>::EvaluateBlock(*block, time) +
+           Frame::origin;
+  }
   auto const it = FindSeriesForInstant(time);
-  CHECK(it != series_.end());
+  CHECK(it != nullptr);
   return it->Evaluate(time) + Frame::origin;
 }
 
@@ -161,8 +250,13 @@ Velocity<Frame> ContinuousTrajectory<Frame>::EvaluateVelocity(
     Instant const& time) const {
   CHECK_LE(t_min(), time);
   CHECK_GE(t_max(), time);
+  auto const block = FindBlockForInstant(time);
+  if (block != nullptr) {
+    return ЧебышёвSeries<Displacement<Frame>>::EvaluateBlockDerivative(*block,
+                                                                      time);
+  }
   auto const it = FindSeriesForInstant(time);
-  CHECK(it != series_.end());
+  CHECK(it != nullptr);
   return it->EvaluateDerivative(time);
 }
 
@@ -171,16 +265,27 @@ DegreesOfFreedom<Frame> ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedom(
     Instant const& time) const {
   CHECK_LE(t_min(), time);
   CHECK_GE(t_max(), time);
+  Displacement<Frame> displacement;
+  Velocity<Frame> velocity;
+  auto const block = FindBlockForInstant(time);
+  if (block != nullptr) {
+    ЧебышёвSeries<Displacement<Frame>>::EvaluateBlockWithDerivative(
+        *block, time, displacement, velocity);
+    return DegreesOfFreedom<Frame>(displacement + Frame::origin, velocity);
+  }
   auto const it = FindSeriesForInstant(time);
-  CHECK(it != series_.end());
-  return DegreesOfFreedom<Frame>(it->Evaluate(time) + Frame::origin,
-                                 it->EvaluateDerivative(time));
+  CHECK(it != nullptr);
+  it->EvaluateWithDerivative(time, displacement, velocity);
+  return DegreesOfFreedom<Frame>(displacement + Frame::origin, velocity);
 }
 
 template<typename Frame>
 typename ContinuousTrajectory<Frame>::Checkpoint
 ContinuousTrajectory<Frame>::GetCheckpoint() const {
-  return {t_max(),
+  // Before the first series is fitted, the checkpoint designates the start of
+  // the trajectory.
+  return {empty() && !last_points_.empty() ? last_points_.front().first
+                                           : t_max(),
           adjusted_tolerance_,
           is_unstable_,
           degree_,
@@ -198,41 +303,24 @@ template<typename Frame>
 void ContinuousTrajectory<Frame>::WriteToMessage(
       not_null<serialization::ContinuousTrajectory*> const message,
       Checkpoint const& checkpoint) const {
-  step_.WriteToMessage(message->mutable_step());
-  tolerance_.WriteToMessage(message->mutable_tolerance());
-  checkpoint.adjusted_tolerance_.WriteToMessage(
-      message->mutable_adjusted_tolerance());
-  message->set_is_unstable(checkpoint.is_unstable_);
-  message->set_degree(checkpoint.degree_);
-  message->set_degree_age(checkpoint.degree_age_);
-  for (auto const& s : series_) {
-    if (s.t_max() <= checkpoint.t_max_) {
-      s.WriteToMessage(message->add_series());
-    }
-    if (s.t_max() == checkpoint.t_max_) {
-      break;
-    }
-    CHECK_LT(s.t_max(), checkpoint.t_max_);
-  }
-  if (first_time_) {
-    first_time_->WriteToMessage(message->mutable_first_time());
-  }
-  for (auto const& pair : checkpoint.last_points_) {
-    Instant const& instant = pair.first;
-    DegreesOfFreedom<Frame> const& degrees_of_freedom = pair.second;
-    not_null<
-        serialization::ContinuousTrajectory::InstantaneousDegreesOfFreedom*>
-        const instantaneous_degrees_of_freedom = message->add_last_point();
-    instant.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
-    degrees_of_freedom.WriteToMessage(
-        instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
-  }
+  WriteStateToMessage(message, checkpoint);
+  ForEachSeries(
+      checkpoint,
+      [message](ЧебышёвSeriesBlock const& block) {
+        ЧебышёвSeries<Displacement<Frame>>::ReadFromBlock(block).WriteToMessage(
+            message->add_series());
+      },
+      [message](ЧебышёвSeries<Displacement<Frame>> const& series) {
+        series.WriteToMessage(message->add_series());
+      });
 }
 
 template<typename Frame>
 not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
 ContinuousTrajectory<Frame>::ReadFromMessage(
       serialization::ContinuousTrajectory const& message) {
+  CHECK(!message.has_series_blocks())
+      << "The series file is needed to read this trajectory";
   not_null<std::unique_ptr<ContinuousTrajectory<Frame>>> continuous_trajectory =
       std::make_unique<ContinuousTrajectory<Frame>>(
           Time::ReadFromMessage(message.step()),
@@ -246,6 +334,7 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
     continuous_trajectory->series_.push_back(
         ЧебышёвSeries<Displacement<Frame>>::ReadFromMessage(s));
   }
+  continuous_trajectory->PublishSeries();
   if (message.has_first_time()) {
     continuous_trajectory->first_time_ =
         Instant::ReadFromMessage(message.first_time());
@@ -258,6 +347,85 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
   return continuous_trajectory;
 }
 
+template<typename Frame>
+void ContinuousTrajectory<Frame>::WriteCheckpointToMessage(
+    not_null<serialization::ContinuousTrajectory*> const message,
+    Checkpoint const& checkpoint) const {
+  WriteStateToMessage(message, checkpoint);
+  // The first of the |last_points_| is the end of the last series at the time
+  // of the checkpoint, and therefore the start of the deserialized trajectory.
+  if (checkpoint.last_points_.empty()) {
+    message->clear_first_time();
+  } else {
+    checkpoint.last_points_.front().first.WriteToMessage(
+        message->mutable_first_time());
+  }
+}
+
+template<typename Frame>
+std::int64_t ContinuousTrajectory<Frame>::WriteToMessage(
+    not_null<serialization::ContinuousTrajectory*> const message,
+    Checkpoint const& checkpoint,
+    std::int64_t const first_block,
+    not_null<std::ostream*> const blocks) const {
+  WriteStateToMessage(message, checkpoint);
+  std::int64_t number_of_blocks = 0;
+  auto const write_block = [blocks, &number_of_blocks](
+                               ЧебышёвSeriesBlock const& block) {
+    blocks->write(reinterpret_cast<char const*>(&block), sizeof(block));
+    ++number_of_blocks;
+  };
+  ForEachSeries(
+      checkpoint,
+      write_block,
+      [&write_block](ЧебышёвSeries<Displacement<Frame>> const& series) {
+        ЧебышёвSeriesBlock block{};
+        series.WriteToBlock(&block);
+        write_block(block);
+      });
+  CHECK(blocks->good());
+  auto* const series_blocks = message->mutable_series_blocks();
+  series_blocks->set_first_block(first_block);
+  series_blocks->set_number_of_blocks(number_of_blocks);
+  return number_of_blocks;
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
+ContinuousTrajectory<Frame>::ReadFromMessage(
+    serialization::ContinuousTrajectory const& message,
+    std::shared_ptr<MappedFile const> const& series_file,
+    ЧебышёвSeriesBlock const* const blocks,
+    std::int64_t const number_of_blocks) {
+  serialization::ContinuousTrajectory message_without_blocks = message;
+  message_without_blocks.clear_series_blocks();
+  auto continuous_trajectory = ReadFromMessage(message_without_blocks);
+  if (message.has_series_blocks() &&
+      message.series_blocks().number_of_blocks() > 0) {
+    std::int64_t const first_block = message.series_blocks().first_block();
+    std::int64_t const size = message.series_blocks().number_of_blocks();
+    CHECK_LE(0, first_block);
+    CHECK_LE(size, number_of_blocks - first_block)
+        << "Blocks [" << first_block << ", " << first_block + size
+        << "[ are not in a series file of " << number_of_blocks << " blocks";
+    ЧебышёвSeriesBlock const* const trajectory_blocks = blocks + first_block;
+    for (std::int64_t i = 0; i < size; ++i) {
+      ЧебышёвSeriesBlock const& block = trajectory_blocks[i];
+      CHECK_LE(min_specialized_degree, block.degree) << first_block + i;
+      CHECK_GE(max_specialized_degree, block.degree) << first_block + i;
+      CHECK_LT(block.t_min, block.t_max) << first_block + i;
+      if (i > 0) {
+        CHECK_EQ(trajectory_blocks[i - 1].t_max, block.t_min)
+            << first_block + i;
+      }
+    }
+    continuous_trajectory->series_file_ = series_file;
+    continuous_trajectory->blocks_ = trajectory_blocks;
+    continuous_trajectory->number_of_blocks_ = size;
+  }
+  return continuous_trajectory;
+}
+
 template<typename Frame>
 ContinuousTrajectory<Frame>::Checkpoint::Checkpoint(
     Instant const& t_max,
@@ -277,16 +445,12 @@ template<typename Frame>
 ContinuousTrajectory<Frame>::ContinuousTrajectory() {}
 
 template<typename Frame>
+template<typename Approximator>
 Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     Instant const& time,
     std::vector<Displacement<Frame>> const& q,
     std::vector<Velocity<Frame>> const& v,
-    ЧебышёвSeries<Displacement<Frame>> (*newhall_approximation)(
-        int const degree,
-        std::vector<Displacement<Frame>> const& q,
-        std::vector<Velocity<Frame>> const& v,
-        Instant const& t_min,
-        Instant const& t_max)) {
+    Approximator const& approximator) {
   Length const previous_adjusted_tolerance = adjusted_tolerance_;
 
   // If the degree is too old, restart from the lowest degree.  This ensures
@@ -300,13 +464,12 @@ Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     degree_age_ = 0;
   }
 
-  // Compute the approximation with the current degree.
-  series_.push_back(
-      newhall_approximation(degree_, q, v, last_points_.cbegin()->first, time));
-
-  // Estimate the error.  For initializing |previous_error_estimate|, any value
-  // greater than |error_estimate| will do.
-  Length error_estimate = series_.back().last_coefficient().Norm();
+  // Estimate the error of the approximation with the current degree.  For
+  // initializing |previous_error_estimate|, any value greater than
+  // |error_estimate| will do.  The degree of the approximation that we
+  // eventually keep is that of the last error estimate.
+  int approximation_degree = degree_;
+  Length error_estimate = approximator.LastCoefficient(degree_).Norm();
   Length previous_error_estimate = error_estimate + error_estimate;
 
   // If we are in the zone of numerical instabilities and we exceeded the
@@ -334,11 +497,9 @@ Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
     ++degree_;
     VLOG(1) << "Increasing degree for " << this << " to " <<degree_
             << " because error estimate was " << error_estimate;
-    series_.back() =
-        newhall_approximation(
-            degree_, q, v, last_points_.cbegin()->first, time);
+    approximation_degree = degree_;
     previous_error_estimate = error_estimate;
-    error_estimate = series_.back().last_coefficient().Norm();
+    error_estimate = approximator.LastCoefficient(degree_).Norm();
   }
 
   // If we have entered the zone of numerical instability, go back to the
@@ -361,6 +522,24 @@ Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
 
   ++degree_age_;
 
+  // Build the approximation, making room for it first.  The published series
+  // are copied, not moved, to a new buffer because readers may be evaluating
+  // them; the old buffer is kept alive until the next |ForgetBefore|.
+  if (series_.size() == series_.capacity()) {
+    std::vector<ЧебышёвSeries<Displacement<Frame>>> series;
+    series.reserve(std::max<std::size_t>(min_series_capacity,
+                                         2 * series_.capacity()));
+    for (auto const& s : series_) {
+      series.push_back(s);
+    }
+    retired_series_.push_back(std::move(series_));
+    series_ = std::move(series);
+    published_series_.store(series_.data(), std::memory_order_release);
+  }
+
+  series_.push_back(approximator.Approximation(approximation_degree));
+  PublishSeries();
+
   // Check that the tolerance did not explode.
   if (adjusted_tolerance_ < 1e6 * previous_adjusted_tolerance) {
     return Status::OK;
@@ -378,18 +557,119 @@ Status ContinuousTrajectory<Frame>::ComputeBestNewhallApproximation(
 }
 
 template<typename Frame>
-typename std::vector<ЧебышёвSeries<Displacement<Frame>>>::const_iterator
-ContinuousTrajectory<Frame>::FindSeriesForInstant(Instant const& time) const {
+void ContinuousTrajectory<Frame>::PublishSeries() {
+  published_series_.store(series_.data(), std::memory_order_release);
+  published_size_.store(series_.size(), std::memory_order_release);
+}
+
+template<typename Frame>
+void ContinuousTrajectory<Frame>::WriteStateToMessage(
+    not_null<serialization::ContinuousTrajectory*> const message,
+    Checkpoint const& checkpoint) const {
+  step_.WriteToMessage(message->mutable_step());
+  tolerance_.WriteToMessage(message->mutable_tolerance());
+  checkpoint.adjusted_tolerance_.WriteToMessage(
+      message->mutable_adjusted_tolerance());
+  message->set_is_unstable(checkpoint.is_unstable_);
+  message->set_degree(checkpoint.degree_);
+  message->set_degree_age(checkpoint.degree_age_);
+  if (first_time_) {
+    first_time_->WriteToMessage(message->mutable_first_time());
+  }
+  for (auto const& pair : checkpoint.last_points_) {
+    Instant const& instant = pair.first;
+    DegreesOfFreedom<Frame> const& degrees_of_freedom = pair.second;
+    not_null<
+        serialization::ContinuousTrajectory::InstantaneousDegreesOfFreedom*>
+        const instantaneous_degrees_of_freedom = message->add_last_point();
+    instant.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
+    degrees_of_freedom.WriteToMessage(
+        instantaneous_degrees_of_freedom->mutable_degrees_of_freedom());
+  }
+}
+
+template<typename Frame>
+template<typename WriteBlock, typename WriteSeries>
+void ContinuousTrajectory<Frame>::ForEachSeries(
+    Checkpoint const& checkpoint,
+    WriteBlock const& write_block,
+    WriteSeries const& write_series) const {
+  // The blocks are older than the checkpoint.
+  for (int i = 0; i < number_of_blocks_; ++i) {
+    CHECK_LE(TMax(blocks_[i]), checkpoint.t_max_);
+    write_block(blocks_[i]);
+  }
+  if (number_of_blocks_ > 0 &&
+      TMax(blocks_[number_of_blocks_ - 1]) == checkpoint.t_max_) {
+    return;
+  }
+  for (auto const& s : series_) {
+    if (s.t_max() <= checkpoint.t_max_) {
+      write_series(s);
+    }
+    if (s.t_max() == checkpoint.t_max_) {
+      break;
+    }
+    CHECK_LT(s.t_max(), checkpoint.t_max_);
+  }
+}
+
+template<typename Frame>
+template<typename Series>
+Series const* ContinuousTrajectory<Frame>::FindForInstant(
+    Series const* const begin,
+    int const size,
+    Instant const& time) const {
+  Series const* const end = begin + size;
+  if (size == 0) {
+    return nullptr;
+  }
+
+  // Each series spans |divisions| steps, so the index of the series containing
+  // |time| is a simple computation, except for rounding errors which may put
+  // us off by one when |time| is near the boundary of two series.  We check
+  // that the candidate is the first series |s| such that |time <= TMax(s)|.
+  double const scaled_time =
+      (time - TMin(*begin)) / (divisions * step_);
+  int const index = !(scaled_time > 0) ? 0
+                        : scaled_time >= size ? size - 1
+                        : static_cast<int>(scaled_time);
+  for (int i = std::max(0, index - 1); i <= std::min(size - 1, index + 1);
+       ++i) {
+    Series const* const it = begin + i;
+    if (time <= TMax(*it) && (it == begin || TMax(*(it - 1)) < time)) {
+      return it;
+    }
+  }
+  if (time > TMax(begin[size - 1])) {
+    return nullptr;
+  }
+
   // Need to use |lower_bound|, not |upper_bound|, because it allows
   // heterogeneous arguments.  This returns the first series |s| such that
-  // |time <= s.t_max()|.
-  auto const it = std::lower_bound(
-                      series_.begin(), series_.end(), time,
-                      [](ЧебышёвSeries<Displacement<Frame>> const& left,
-                         Instant const& right) {
-                        return left.t_max() < right;
-                      });
-  return it;
+  // |time <= TMax(s)|.
+  auto const it = std::lower_bound(begin, end, time,
+                                   [](Series const& left,
+                                      Instant const& right) {
+                                     return TMax(left) < right;
+                                   });
+  return it == end ? nullptr : it;
+}
+
+template<typename Frame>
+ЧебышёвSeries<Displacement<Frame>> const*
+ContinuousTrajectory<Frame>::FindSeriesForInstant(Instant const& time) const {
+  // The size must be loaded first, see |published_series_|.
+  int const size = published_size_.load(std::memory_order_acquire);
+  return FindForInstant(published_series_.load(std::memory_order_acquire),
+                        size,
+                        time);
+}
+
+template<typename Frame>
+ЧебышёвSeriesBlock const* ContinuousTrajectory<Frame>::FindBlockForInstant(
+    Instant const& time) const {
+  return FindForInstant(blocks_, number_of_blocks_, time);
 }
 
 }  // namespace internal_continuous_trajectory
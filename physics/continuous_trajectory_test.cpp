@@ -1,9 +1,16 @@
 ﻿
 #include "physics/continuous_trajectory.hpp"
 
+#include <atomic>
+#include <cstring>
 #include <deque>
+#include <fstream>
 #include <functional>
 #include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "geometry/frame.hpp"
@@ -24,10 +31,12 @@ namespace principia {
 namespace physics {
 namespace internal_continuous_trajectory {
 
+using base::MappedFile;
 using geometry::Displacement;
 using geometry::Frame;
 using geometry::Velocity;
 using numerics::ЧебышёвSeries;
+using numerics::ЧебышёвSeriesBlock;
 using quantities::Angle;
 using quantities::AngularFrequency;
 using quantities::Length;
@@ -47,16 +56,27 @@ class ContinuousTrajectoryTest : public testing::Test {
                       serialization::Frame::TEST1, true>;
 
  protected:
-  static ЧебышёвSeries<Displacement<World>> SimulatedNewhallApproximation(
-      int const degree,
-      std::vector<Displacement<World>> const& q,
-      std::vector<Velocity<World>> const& v,
-      Instant const& t_min,
-      Instant const& t_max) {
-    Displacement<World> const error_estimate = error_estimates_->front();
-    error_estimates_->pop_front();
-    return ЧебышёвSeries<Displacement<World>>({error_estimate}, t_min, t_max);
-  }
+  // An approximator that returns the given error estimates in sequence.
+  class SimulatedNewhallApproximator {
+   public:
+    explicit SimulatedNewhallApproximator(Instant const& t_min)
+        : t_min_(t_min) {}
+
+    Displacement<World> LastCoefficient(int const degree) const {
+      Displacement<World> const error_estimate = error_estimates_->front();
+      error_estimates_->pop_front();
+      return error_estimate;
+    }
+
+    ЧебышёвSeries<Displacement<World>> Approximation(int const degree) const {
+      return ЧебышёвSeries<Displacement<World>>({Displacement<World>()},
+                                               t_min_,
+                                               t_min_ + 1 * Second);
+    }
+
+   private:
+    Instant const t_min_;
+  };
 
   void FillTrajectory(
       int const number_of_steps,
@@ -84,7 +104,7 @@ class ContinuousTrajectoryTest : public testing::Test {
     std::vector<Displacement<World>> const q;
     std::vector<Velocity<World>> const v;
     trajectory_->ComputeBestNewhallApproximation(
-        t, q, v, &SimulatedNewhallApproximation);
+        t, q, v, SimulatedNewhallApproximator(t0_));
   }
 
   int degree() const {
@@ -103,6 +123,40 @@ class ContinuousTrajectoryTest : public testing::Test {
     trajectory_->degree_age_ = std::numeric_limits<int>::max();
   }
 
+  // Returns the index in |series| of the element found by |FindForInstant|, or
+  // -1 if it returns a null pointer.
+  template<typename Series>
+  int FindForInstant(std::vector<Series> const& series,
+                     Instant const& time) const {
+    Series const* const found =
+        trajectory_->FindForInstant(series.data(), series.size(), time);
+    return found == nullptr ? -1 : found - series.data();
+  }
+
+  // Checks that |FindForInstant| finds, both in series and in blocks, the first
+  // of the intervals delimited by consecutive |boundaries| whose upper bound is
+  // at or after |time|, or the first interval if |time| is before all of them.
+  void ExpectFoundForInstant(std::vector<Instant> const& boundaries,
+                             Instant const& time) const {
+    std::vector<ЧебышёвSeries<Displacement<World>>> series;
+    std::vector<ЧебышёвSeriesBlock> blocks(boundaries.size() - 1);
+    for (int i = 0; i + 1 < boundaries.size(); ++i) {
+      series.emplace_back(std::vector<Displacement<World>>(4),
+                          boundaries[i],
+                          boundaries[i + 1]);
+      series.back().WriteToBlock(&blocks[i]);
+    }
+    int expected_index = -1;
+    for (int i = 0; i + 1 < boundaries.size(); ++i) {
+      if (time <= boundaries[i + 1]) {
+        expected_index = i;
+        break;
+      }
+    }
+    EXPECT_EQ(expected_index, FindForInstant(series, time)) << time;
+    EXPECT_EQ(expected_index, FindForInstant(blocks, time)) << time;
+  }
+
   static std::deque<Displacement<World>>* error_estimates_;
   Instant const t0_;
   std::unique_ptr<ContinuousTrajectory<World>> trajectory_;
@@ -461,6 +515,178 @@ TEST_F(ContinuousTrajectoryTest, Serialization) {
       << "SECOND\n" << second_message.DebugString();
 }
 
+TEST_F(ContinuousTrajectoryTest, SeriesFile) {
+  int const number_of_steps1 = 100;
+  int const number_of_steps2 = 30;
+  int const number_of_substeps = 10;
+  Time const step = 10 * Second;
+  Length const tolerance = 1 * Milli(Metre);
+  AngularFrequency const ω = 1e-3 * Radian / Second;
+  Length const r = 1e7 * Metre;
+
+  auto position_function =
+      [this, r, ω](Instant const t) {
+        return World::origin +
+            Displacement<World>({r * Cos(ω * (t - t0_)),
+                                 r * Sin(ω * (t - t0_)),
+                                 0 * Metre});
+      };
+  auto velocity_function =
+      [this, r, ω](Instant const t) {
+        return Velocity<World>({-r * ω * Sin(ω * (t - t0_)) / Radian,
+                                r * ω * Cos(ω * (t - t0_)) / Radian,
+                                0 * Metre / Second});
+      };
+
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step, tolerance);
+  FillTrajectory(
+      number_of_steps1, step, position_function, velocity_function, t0_);
+
+  auto const path = TEMP_DIR / "continuous_trajectory_test_series_file.bin";
+  serialization::ContinuousTrajectory message;
+  {
+    std::ofstream blocks(path, std::ios::binary | std::ios::trunc);
+    EXPECT_EQ(12,
+              trajectory_->WriteToMessage(&message,
+                                          trajectory_->GetCheckpoint(),
+                                          /*first_block=*/0,
+                                          &blocks));
+  }
+  EXPECT_EQ(0, message.series_size());
+  EXPECT_EQ(0, message.series_blocks().first_block());
+  EXPECT_EQ(12, message.series_blocks().number_of_blocks());
+
+  {
+    auto const series_file = std::make_shared<MappedFile const>(path);
+    EXPECT_EQ(12 * sizeof(ЧебышёвSeriesBlock), series_file->size());
+    auto const trajectory = ContinuousTrajectory<World>::ReadFromMessage(
+        message,
+        series_file,
+        reinterpret_cast<ЧебышёвSeriesBlock const*>(series_file->data()),
+        /*number_of_blocks=*/12);
+    EXPECT_EQ(trajectory_->t_min(), trajectory->t_min());
+    EXPECT_EQ(trajectory_->t_max(), trajectory->t_max());
+    EXPECT_EQ(trajectory_->average_degree(), trajectory->average_degree());
+
+    // The blocks are followed by series computed in memory.
+    FillTrajectory(number_of_steps2,
+                   step,
+                   position_function,
+                   velocity_function,
+                   t0_ + number_of_steps1 * step);
+    for (int i = 0; i < number_of_steps2; ++i) {
+      Instant const ti = t0_ + (number_of_steps1 + i + 1) * step;
+      trajectory->Append(ti,
+                         DegreesOfFreedom<World>(position_function(ti),
+                                                 velocity_function(ti)));
+    }
+    EXPECT_EQ(trajectory_->t_max(), trajectory->t_max());
+    for (Instant time = trajectory_->t_min();
+         time <= trajectory_->t_max();
+         time += step / number_of_substeps) {
+      EXPECT_EQ(trajectory_->EvaluateDegreesOfFreedom(time),
+                trajectory->EvaluateDegreesOfFreedom(time));
+      EXPECT_EQ(trajectory_->EvaluatePosition(time),
+                trajectory->EvaluatePosition(time));
+      EXPECT_EQ(trajectory_->EvaluateVelocity(time),
+                trajectory->EvaluateVelocity(time));
+    }
+
+    serialization::ContinuousTrajectory message1;
+    serialization::ContinuousTrajectory message2;
+    trajectory_->WriteToMessage(&message1);
+    trajectory->WriteToMessage(&message2);
+    EXPECT_EQ(message1.SerializeAsString(), message2.SerializeAsString());
+
+    Instant const forget_time = t0_ + 50 * step;
+    trajectory_->ForgetBefore(forget_time);
+    trajectory->ForgetBefore(forget_time);
+    EXPECT_EQ(trajectory_->t_min(), trajectory->t_min());
+    EXPECT_EQ(trajectory_->EvaluateDegreesOfFreedom(forget_time),
+              trajectory->EvaluateDegreesOfFreedom(forget_time));
+  }
+  std::experimental::filesystem::remove(path);
+}
+
+using ContinuousTrajectoryDeathTest = ContinuousTrajectoryTest;
+
+// A series file that doesn't match the message is detected when it is read,
+// not when its blocks are evaluated.
+TEST_F(ContinuousTrajectoryDeathTest, SeriesFileError) {
+  Time const step = 10 * Second;
+  auto position_function = [this](Instant const t) {
+    return World::origin +
+        Displacement<World>({(t - t0_) * 3 * Metre / Second,
+                             (t - t0_) * 5 * Metre / Second,
+                             (t - t0_) * (-2) * Metre / Second});
+  };
+  auto velocity_function = [](Instant const t) {
+    return Velocity<World>({3 * Metre / Second,
+                            5 * Metre / Second,
+                            -2 * Metre / Second});
+  };
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step,
+                    /*tolerance=*/1 * Milli(Metre));
+  FillTrajectory(/*number_of_steps=*/50,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_);
+
+  serialization::ContinuousTrajectory message;
+  std::stringstream stream;
+  std::int64_t const number_of_blocks =
+      trajectory_->WriteToMessage(&message,
+                                  trajectory_->GetCheckpoint(),
+                                  /*first_block=*/0,
+                                  &stream);
+  EXPECT_EQ(6, number_of_blocks);
+  std::string const bytes = stream.str();
+  std::vector<ЧебышёвSeriesBlock> blocks(number_of_blocks);
+  std::memcpy(blocks.data(), bytes.data(), bytes.size());
+  auto const read = [&message](std::vector<ЧебышёвSeriesBlock> const& blocks,
+                               std::int64_t const number_of_blocks) {
+    ContinuousTrajectory<World>::ReadFromMessage(
+        message,
+        /*series_file=*/nullptr,
+        blocks.data(),
+        number_of_blocks);
+  };
+  read(blocks, number_of_blocks);
+
+  // The file is truncated.
+  EXPECT_DEATH({
+    read(blocks, number_of_blocks - 1);
+  }, "are not in a series file");
+
+  // The message designates blocks past the end of the file.
+  message.mutable_series_blocks()->set_first_block(1);
+  EXPECT_DEATH({
+    read(blocks, number_of_blocks);
+  }, "are not in a series file");
+  message.mutable_series_blocks()->set_first_block(-1);
+  EXPECT_DEATH({
+    read(blocks, number_of_blocks);
+  }, "first_block");
+  message.mutable_series_blocks()->set_first_block(0);
+
+  // A block has a degree that cannot be evaluated.
+  auto corrupted_blocks = blocks;
+  corrupted_blocks[3].degree = 42;
+  EXPECT_DEATH({
+    read(corrupted_blocks, number_of_blocks);
+  }, "degree");
+
+  // The blocks are not consecutive.
+  corrupted_blocks = blocks;
+  std::swap(corrupted_blocks[2], corrupted_blocks[4]);
+  EXPECT_DEATH({
+    read(corrupted_blocks, number_of_blocks);
+  }, "t_m");
+}
+
 TEST_F(ContinuousTrajectoryTest, Checkpoint) {
   int const number_of_steps1 = 30;
   int const number_of_steps2 = 20;
@@ -523,6 +749,197 @@ TEST_F(ContinuousTrajectoryTest, Checkpoint) {
   }
 }
 
+TEST_F(ContinuousTrajectoryTest, CheckpointAndPrepend) {
+  int const number_of_steps1 = 30;
+  int const number_of_steps2 = 20;
+  int const number_of_substeps = 50;
+  Time const step = 0.01 * Second;
+  Length const tolerance = 0.1 * Metre;
+
+  auto position_function =
+      [this](Instant const t) {
+        return World::origin +
+            Displacement<World>({Sin((t - t0_) * Radian / Second) * Metre,
+                                 Cos((t - t0_) * Radian / Second) * Metre,
+                                 (t - t0_) * (-2) * Metre / Second});
+      };
+  auto velocity_function =
+      [this](Instant const t) {
+        return Velocity<World>(
+            {Cos((t - t0_) * Radian / Second) * Metre / Second,
+             -Sin((t - t0_) * Radian / Second) * Metre / Second,
+             -2 * Metre / Second});
+      };
+
+  // The reference trajectory.
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step, tolerance);
+  FillTrajectory(
+      number_of_steps1, step, position_function, velocity_function, t0_);
+  ContinuousTrajectory<World>::Checkpoint const checkpoint =
+      trajectory_->GetCheckpoint();
+  Instant const checkpoint_t_max = trajectory_->t_max();
+  serialization::ContinuousTrajectory message;
+  trajectory_->WriteCheckpointToMessage(&message, checkpoint);
+  FillTrajectory(number_of_steps2,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_ + number_of_steps1 * step);
+  auto const reference = std::move(trajectory_);
+  EXPECT_EQ(0, message.series_size());
+  EXPECT_EQ(6, message.last_point_size());
+
+  // The trajectory restored from the checkpoint starts there and, once
+  // extended, is identical to the reference trajectory.
+  trajectory_ = ContinuousTrajectory<World>::ReadFromMessage(message);
+  EXPECT_TRUE(trajectory_->empty());
+  FillTrajectory(number_of_steps2,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_ + number_of_steps1 * step);
+  EXPECT_EQ(checkpoint_t_max, trajectory_->t_min());
+  EXPECT_EQ(reference->t_max(), trajectory_->t_max());
+  auto suffix = std::move(trajectory_);
+
+  // Prepending a recomputation of the series before the checkpoint restores
+  // the entire trajectory.
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step, tolerance);
+  FillTrajectory(
+      number_of_steps1, step, position_function, velocity_function, t0_);
+  suffix->Prepend(std::move(*trajectory_));
+  EXPECT_EQ(reference->t_min(), suffix->t_min());
+  EXPECT_EQ(reference->t_max(), suffix->t_max());
+  for (Instant time = reference->t_min();
+       time <= reference->t_max();
+       time += step / number_of_substeps) {
+    EXPECT_EQ(reference->EvaluateDegreesOfFreedom(time),
+              suffix->EvaluateDegreesOfFreedom(time));
+  }
+}
+
+TEST_F(ContinuousTrajectoryTest, FindForInstantUniform) {
+  // A step that is not a binary fraction and a large |t_min| cause rounding
+  // errors in the computation of the index.
+  Time const step = 0.1 * Second;
+  Instant const t_min = t0_ + 123456789.123 * Second;
+  int const size = 10;
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step,
+                    /*tolerance=*/1 * Metre);
+  std::vector<Instant> boundaries;
+  for (int i = 0; i <= size; ++i) {
+    boundaries.push_back(t_min + i * 8 * step);
+  }
+  Time const ε = 1 * Milli(Second);
+
+  EXPECT_EQ(-1,
+            FindForInstant(std::vector<ЧебышёвSeries<Displacement<World>>>(),
+                           t_min));
+  EXPECT_EQ(-1, FindForInstant(std::vector<ЧебышёвSeriesBlock>(), t_min));
+
+  // The extremities.
+  ExpectFoundForInstant(boundaries, t_min - 1 * Second);
+  ExpectFoundForInstant(boundaries, t_min);
+  ExpectFoundForInstant(boundaries, boundaries.back());
+  ExpectFoundForInstant(boundaries, boundaries.back() + ε);
+
+  // The boundaries between series belong to the earlier series.
+  for (int i = 1; i < size; ++i) {
+    ExpectFoundForInstant(boundaries, boundaries[i] - ε);
+    ExpectFoundForInstant(boundaries, boundaries[i]);
+    ExpectFoundForInstant(boundaries, boundaries[i] + ε);
+  }
+
+  // Going backwards by several series at a time.
+  for (int i = size - 1; i >= 0; i -= 3) {
+    ExpectFoundForInstant(boundaries, boundaries[i] + 4 * step);
+  }
+}
+
+// If the intervals are not uniform, the index computed from the time is wrong
+// by more than one series and |FindForInstant| falls back to a binary search.
+TEST_F(ContinuousTrajectoryTest, FindForInstantNonUniform) {
+  Time const step = 1 * Second;
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step,
+                    /*tolerance=*/1 * Metre);
+  std::vector<Instant> boundaries = {t0_};
+  for (int i = 0; i < 20; ++i) {
+    boundaries.push_back(boundaries.back() + (i % 3 == 1 ? 1 : 8) * step);
+  }
+  Time const ε = 1 * Milli(Second);
+
+  ExpectFoundForInstant(boundaries, t0_ - 1 * Second);
+  for (int i = 0; i < boundaries.size(); ++i) {
+    ExpectFoundForInstant(boundaries, boundaries[i] - ε);
+    ExpectFoundForInstant(boundaries, boundaries[i]);
+    ExpectFoundForInstant(boundaries, boundaries[i] + ε);
+  }
+  for (int i = boundaries.size() - 2; i >= 0; i -= 5) {
+    ExpectFoundForInstant(
+        boundaries,
+        boundaries[i] + (boundaries[i + 1] - boundaries[i]) / 2);
+  }
+}
+
+// Evaluates the trajectory on another thread while it is being appended to, and
+// checks that the results match those obtained once the appends are done.
+TEST_F(ContinuousTrajectoryTest, ConcurrentEvaluation) {
+  int const number_of_steps = 10000;
+  Length const distance = 1 * Kilo(Metre);
+  Time const period = 100 * Second;
+  Time const step = 10 * Milli(Second);
+
+  auto position_function = [this, distance, period](Instant const t) {
+    Angle const angle = 2 * π * Radian * (t - t0_) / period;
+    return World::origin +
+        Displacement<World>({
+            distance * Cos(angle),
+            distance * Sin(angle),
+            0 * Metre});
+  };
+  auto velocity_function = [this, distance, period](Instant const t) {
+    AngularFrequency const ω = 2 * π * Radian / period;
+    Angle const angle = ω * (t - t0_);
+    return Velocity<World>({
+        -ω * distance * Sin(angle) / Radian,
+        ω * distance * Cos(angle) / Radian,
+        0 * Metre / Second});
+  };
+
+  trajectory_ = std::make_unique<ContinuousTrajectory<World>>(
+                    step,
+                    /*tolerance=*/1 * Milli(Metre));
+
+  std::atomic<bool> done(false);
+  std::vector<std::pair<Instant, DegreesOfFreedom<World>>> evaluations;
+  std::thread reader([this, &done, &evaluations]() {
+    while (!done) {
+      if (trajectory_->empty()) {
+        continue;
+      }
+      Instant const t_min = trajectory_->t_min();
+      Instant const t_max = trajectory_->t_max();
+      for (Instant const& time : {t_min, t_min + (t_max - t_min) / 3, t_max}) {
+        evaluations.emplace_back(time,
+                                 trajectory_->EvaluateDegreesOfFreedom(time));
+      }
+    }
+  });
+  FillTrajectory(
+      number_of_steps, step, position_function, velocity_function, t0_);
+  done = true;
+  reader.join();
+
+  for (auto const& evaluation : evaluations) {
+    EXPECT_EQ(trajectory_->EvaluateDegreesOfFreedom(evaluation.first),
+              evaluation.second);
+  }
+}
+
 }  // namespace internal_continuous_trajectory
 }  // namespace physics
 }  // namespace principia
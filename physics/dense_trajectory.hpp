@@ -0,0 +1,127 @@
+﻿
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "base/not_null.hpp"
+#include "geometry/named_quantities.hpp"
+#include "numerics/hermite5.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/trajectory.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_dense_trajectory {
+
+using base::not_null;
+using geometry::Instant;
+using geometry::Position;
+using geometry::Velocity;
+using numerics::Hermite5;
+using quantities::Length;
+using quantities::Time;
+
+// A trajectory made of contiguous polynomial pieces, typically the dense output
+// of an adaptive step size integrator.  It may be evaluated at any instant and
+// sampled at whatever density is needed, e.g., for rendering.  A piece takes
+// more memory than a point of a |DiscreteTrajectory|, so this trajectory is
+// only more compact than one holding every step of the integration if its
+// pieces are merged, see the constructor.
+template<typename Frame>
+class DenseTrajectory : public Trajectory<Frame> {
+ public:
+  using Interpolant = Hermite5<Instant, Position<Frame>>;
+
+  // If |tolerance| is positive, |Append| merges each new piece with the last
+  // one as long as the merged piece stays within |tolerance| of all the pieces
+  // that it replaces, at their midpoints and upper bounds.  Otherwise, the
+  // pieces are kept as appended.
+  explicit DenseTrajectory(Length const& tolerance = Length());
+
+  // Appends a piece to this trajectory.  Its lower bound must be the upper
+  // bound of the last piece, if any.
+  void Append(Interpolant const& interpolant);
+
+  // Returns true iff this trajectory cannot be evaluated for any time.
+  bool empty() const;
+
+  // The number of pieces of this trajectory.
+  int size() const;
+
+  // Implementation of the interface |Trajectory|.
+  Instant t_min() const override;
+  Instant t_max() const override;
+  Position<Frame> EvaluatePosition(Instant const& time) const override;
+  Velocity<Frame> EvaluateVelocity(Instant const& time) const override;
+  DegreesOfFreedom<Frame> EvaluateDegreesOfFreedom(
+      Instant const& time) const override;
+
+  // Appends to |trajectory| the points of this trajectory at |t_min()|,
+  // |t_min() + interval|, |t_min() + 2 * interval|... and at |t_max()|, except
+  // for those that are not after the last point of |trajectory|.
+  void Sample(Time const& interval,
+              not_null<DiscreteTrajectory<Frame>*> trajectory) const;
+
+  // Appends to |trajectory| the bounds of the pieces of this trajectory, and
+  // as many points in between as needed for the cubic interpolation of
+  // |trajectory| to stay within |tolerance| of this trajectory, as checked at
+  // the midpoints of the intervals.  As above, the points that are not after
+  // the last point of |trajectory| are not appended.
+  void Sample(Length const& tolerance,
+              not_null<DiscreteTrajectory<Frame>*> trajectory) const;
+
+  // Appends to |trajectory| the last of the |points|, and those of the others
+  // that are needed for the cubic interpolation of |trajectory| to stay within
+  // |tolerance| of this trajectory, as checked at the points that are skipped
+  // and at the midpoints of consecutive |points|.  The |points| must lie on
+  // this trajectory, e.g., they are the steps of the integration that produced
+  // it; they are appended exactly, and there are never more points appended
+  // than there are |points|.  As above, the points that are not after the last
+  // point of |trajectory| are not appended.
+  void Thin(DiscreteTrajectory<Frame> const& points,
+            Length const& tolerance,
+            not_null<DiscreteTrajectory<Frame>*> trajectory) const;
+
+ private:
+  // Appends to |trajectory| the point of |interpolant| at |t2|, preceded by
+  // the points of ]t1, t2[ that are needed to interpolate it within
+  // |tolerance|, found by bisecting at most |bisections| times.
+  static void SampleInterval(Interpolant const& interpolant,
+                             Instant const& t1,
+                             Instant const& t2,
+                             Length const& tolerance,
+                             int bisections,
+                             not_null<DiscreteTrajectory<Frame>*> trajectory);
+
+  // Returns true iff the cubic that joins |first| to the point at |last| stays
+  // within |tolerance| of this trajectory at the points of [begin, last[,
+  // which lie between them, and at the midpoints of the intervals that these
+  // points delimit.
+  bool IsInterpolable(
+      std::pair<Instant, DegreesOfFreedom<Frame>> const& first,
+      typename DiscreteTrajectory<Frame>::Iterator const& begin,
+      typename DiscreteTrajectory<Frame>::Iterator const& last,
+      Length const& tolerance) const;
+
+  // Returns the piece that covers |time|, which must be in
+  // [t_min(), t_max()].
+  Interpolant const& FindInterpolantForInstant(Instant const& time) const;
+
+  Length const tolerance_;
+  std::vector<Interpolant> interpolants_;
+  // The midpoints and upper bounds of the appended pieces that were merged
+  // into |interpolants_.back()|, with the positions of these pieces.
+  std::vector<std::pair<Instant, Position<Frame>>> last_piece_samples_;
+};
+
+}  // namespace internal_dense_trajectory
+
+using internal_dense_trajectory::DenseTrajectory;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/dense_trajectory_body.hpp"
@@ -0,0 +1,283 @@
+﻿
+#pragma once
+
+#include "physics/dense_trajectory.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "astronomy/epoch.hpp"
+#include "glog/logging.h"
+#include "numerics/hermite3.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_dense_trajectory {
+
+using astronomy::InfiniteFuture;
+using astronomy::InfinitePast;
+using numerics::Hermite3;
+
+// The bisections of |Sample| stop there even if the tolerance is not met, which
+// can only happen if it is commensurate with the rounding errors.
+int const max_bisections = 16;
+
+template<typename Frame>
+DenseTrajectory<Frame>::DenseTrajectory(Length const& tolerance)
+    : tolerance_(tolerance) {}
+
+template<typename Frame>
+void DenseTrajectory<Frame>::Append(Interpolant const& interpolant) {
+  CHECK(interpolants_.empty() ||
+        interpolants_.back().upper_bound() == interpolant.lower_bound())
+      << "Noncontiguous interpolant from " << interpolant.lower_bound()
+      << " after " << interpolants_.back().upper_bound();
+  Instant const& t1 = interpolant.lower_bound();
+  Instant const& t2 = interpolant.upper_bound();
+  Instant const midpoint = t1 + (t2 - t1) / 2;
+  std::pair<Instant, Position<Frame>> const samples[] = {
+      {midpoint, interpolant.Evaluate(midpoint)},
+      {t2, interpolant.Evaluate(t2)}};
+
+  if (tolerance_ > Length() && !interpolants_.empty()) {
+    Interpolant const& last = interpolants_.back();
+    Instant const& t0 = last.lower_bound();
+    Interpolant const merged(
+        {t0, t2},
+        {last.Evaluate(t0), interpolant.Evaluate(t2)},
+        {last.EvaluateDerivative(t0), interpolant.EvaluateDerivative(t2)},
+        {last.EvaluateSecondDerivative(t0),
+         interpolant.EvaluateSecondDerivative(t2)});
+    auto const is_within_tolerance =
+        [this, &merged](std::pair<Instant, Position<Frame>> const& sample) {
+          return (merged.Evaluate(sample.first) - sample.second).Norm() <=
+                 tolerance_;
+        };
+    if (std::all_of(std::begin(samples), std::end(samples),
+                    is_within_tolerance) &&
+        std::all_of(last_piece_samples_.begin(), last_piece_samples_.end(),
+                    is_within_tolerance)) {
+      interpolants_.back() = merged;
+      last_piece_samples_.insert(last_piece_samples_.end(),
+                                 std::begin(samples), std::end(samples));
+      return;
+    }
+  }
+
+  interpolants_.push_back(interpolant);
+  last_piece_samples_.assign(std::begin(samples), std::end(samples));
+}
+
+template<typename Frame>
+bool DenseTrajectory<Frame>::empty() const {
+  return interpolants_.empty();
+}
+
+template<typename Frame>
+int DenseTrajectory<Frame>::size() const {
+  return interpolants_.size();
+}
+
+template<typename Frame>
+Instant DenseTrajectory<Frame>::t_min() const {
+  if (empty()) {
+    return InfiniteFuture;
+  }
+  return interpolants_.front().lower_bound();
+}
+
+template<typename Frame>
+Instant DenseTrajectory<Frame>::t_max() const {
+  if (empty()) {
+    return InfinitePast;
+  }
+  return interpolants_.back().upper_bound();
+}
+
+template<typename Frame>
+Position<Frame> DenseTrajectory<Frame>::EvaluatePosition(
+    Instant const& time) const {
+  return FindInterpolantForInstant(time).Evaluate(time);
+}
+
+template<typename Frame>
+Velocity<Frame> DenseTrajectory<Frame>::EvaluateVelocity(
+    Instant const& time) const {
+  return FindInterpolantForInstant(time).EvaluateDerivative(time);
+}
+
+template<typename Frame>
+DegreesOfFreedom<Frame> DenseTrajectory<Frame>::EvaluateDegreesOfFreedom(
+    Instant const& time) const {
+  Interpolant const& interpolant = FindInterpolantForInstant(time);
+  return DegreesOfFreedom<Frame>(interpolant.Evaluate(time),
+                                 interpolant.EvaluateDerivative(time));
+}
+
+template<typename Frame>
+void DenseTrajectory<Frame>::Sample(
+    Time const& interval,
+    not_null<DiscreteTrajectory<Frame>*> const trajectory) const {
+  CHECK_LT(Time(), interval);
+  if (empty()) {
+    return;
+  }
+  Instant const t_last = t_max();
+  auto it = interpolants_.begin();
+  for (int i = 0;; ++i) {
+    // Multiplying rather than accumulating avoids drift over long
+    // trajectories.
+    Instant const t = std::min(t_min() + i * interval, t_last);
+    if (trajectory->Empty() || trajectory->last().time() < t) {
+      while (it->upper_bound() < t) {
+        ++it;
+      }
+      trajectory->Append(t,
+                         DegreesOfFreedom<Frame>(it->Evaluate(t),
+                                                 it->EvaluateDerivative(t)));
+    }
+    if (t == t_last) {
+      break;
+    }
+  }
+}
+
+template<typename Frame>
+void DenseTrajectory<Frame>::Sample(
+    Length const& tolerance,
+    not_null<DiscreteTrajectory<Frame>*> const trajectory) const {
+  if (empty()) {
+    return;
+  }
+  Interpolant const& first = interpolants_.front();
+  if (trajectory->Empty() || trajectory->last().time() < first.lower_bound()) {
+    trajectory->Append(
+        first.lower_bound(),
+        DegreesOfFreedom<Frame>(first.Evaluate(first.lower_bound()),
+                                first.EvaluateDerivative(first.lower_bound())));
+  }
+  for (auto const& interpolant : interpolants_) {
+    SampleInterval(interpolant,
+                   interpolant.lower_bound(),
+                   interpolant.upper_bound(),
+                   tolerance,
+                   max_bisections,
+                   trajectory);
+  }
+}
+
+template<typename Frame>
+void DenseTrajectory<Frame>::Thin(
+    DiscreteTrajectory<Frame> const& points,
+    Length const& tolerance,
+    not_null<DiscreteTrajectory<Frame>*> const trajectory) const {
+  auto begin = points.Begin();
+  if (!trajectory->Empty()) {
+    begin = points.LowerBound(trajectory->last().time());
+    if (begin != points.End() &&
+        begin.time() == trajectory->last().time()) {
+      ++begin;
+    }
+  }
+  if (begin == points.End()) {
+    return;
+  }
+  if (trajectory->Empty()) {
+    trajectory->Append(begin.time(), begin.degrees_of_freedom());
+    if (++begin == points.End()) {
+      return;
+    }
+  }
+
+  // Extend the cubic from the last appended point as far as possible, and
+  // append the last point that it reaches when it fails.
+  std::pair<Instant, DegreesOfFreedom<Frame>> first(
+      trajectory->last().time(), trajectory->last().degrees_of_freedom());
+  auto reached = begin;
+  for (auto it = begin; it != points.End(); ++it) {
+    if (it != begin && !IsInterpolable(first, begin, it, tolerance)) {
+      trajectory->Append(reached.time(), reached.degrees_of_freedom());
+      first = {reached.time(), reached.degrees_of_freedom()};
+      begin = it;
+    }
+    reached = it;
+  }
+  trajectory->Append(reached.time(), reached.degrees_of_freedom());
+}
+
+template<typename Frame>
+bool DenseTrajectory<Frame>::IsInterpolable(
+    std::pair<Instant, DegreesOfFreedom<Frame>> const& first,
+    typename DiscreteTrajectory<Frame>::Iterator const& begin,
+    typename DiscreteTrajectory<Frame>::Iterator const& last,
+    Length const& tolerance) const {
+  Hermite3<Instant, Position<Frame>> const cubic(
+      {first.first, last.time()},
+      {first.second.position(), last.degrees_of_freedom().position()},
+      {first.second.velocity(), last.degrees_of_freedom().velocity()});
+  auto const is_within_tolerance = [&cubic, &tolerance](
+                                       Instant const& time,
+                                       Position<Frame> const& position) {
+    return (cubic.Evaluate(time) - position).Norm() <= tolerance;
+  };
+  Instant previous_time = first.first;
+  for (auto it = begin;; ++it) {
+    Instant const midpoint = previous_time + (it.time() - previous_time) / 2;
+    if (!is_within_tolerance(midpoint, EvaluatePosition(midpoint))) {
+      return false;
+    }
+    if (it == last) {
+      return true;
+    }
+    if (!is_within_tolerance(it.time(), it.degrees_of_freedom().position())) {
+      return false;
+    }
+    previous_time = it.time();
+  }
+}
+
+template<typename Frame>
+void DenseTrajectory<Frame>::SampleInterval(
+    Interpolant const& interpolant,
+    Instant const& t1,
+    Instant const& t2,
+    Length const& tolerance,
+    int const bisections,
+    not_null<DiscreteTrajectory<Frame>*> const trajectory) {
+  Instant const midpoint = t1 + (t2 - t1) / 2;
+  Hermite3<Instant, Position<Frame>> const cubic(
+      {t1, t2},
+      {interpolant.Evaluate(t1), interpolant.Evaluate(t2)},
+      {interpolant.EvaluateDerivative(t1), interpolant.EvaluateDerivative(t2)});
+  if (bisections > 0 &&
+      (cubic.Evaluate(midpoint) - interpolant.Evaluate(midpoint)).Norm() >
+          tolerance) {
+    SampleInterval(interpolant, t1, midpoint, tolerance, bisections - 1,
+                   trajectory);
+    SampleInterval(interpolant, midpoint, t2, tolerance, bisections - 1,
+                   trajectory);
+  } else if (trajectory->Empty() || trajectory->last().time() < t2) {
+    trajectory->Append(t2,
+                       DegreesOfFreedom<Frame>(
+                           interpolant.Evaluate(t2),
+                           interpolant.EvaluateDerivative(t2)));
+  }
+}
+
+template<typename Frame>
+typename DenseTrajectory<Frame>::Interpolant const&
+DenseTrajectory<Frame>::FindInterpolantForInstant(Instant const& time) const {
+  CHECK_LE(t_min(), time);
+  CHECK_GE(t_max(), time);
+  // The first piece whose upper bound is not before |time|.
+  auto const it = std::lower_bound(
+      interpolants_.begin(), interpolants_.end(), time,
+      [](Interpolant const& interpolant, Instant const& time) {
+        return interpolant.upper_bound() < time;
+      });
+  return *it;
+}
+
+}  // namespace internal_dense_trajectory
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,278 @@
+﻿
+#include "physics/dense_trajectory.hpp"
+
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+#include "testing_utilities/almost_equals.hpp"
+#include "testing_utilities/numerics.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_dense_trajectory {
+
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::Vector;
+using quantities::Acceleration;
+using quantities::AngularFrequency;
+using quantities::Cos;
+using quantities::Sin;
+using quantities::si::Metre;
+using quantities::si::Micro;
+using quantities::si::Radian;
+using quantities::si::Second;
+using testing_utilities::AbsoluteError;
+using testing_utilities::AlmostEquals;
+using ::testing::Lt;
+
+class DenseTrajectoryTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST, true>;
+  using Interpolant = DenseTrajectory<World>::Interpolant;
+
+  // A piece of the uniformly accelerated motion x = t², starting at rest at
+  // the origin at |t0_|.
+  Interpolant MakePiece(Instant const& t1, Instant const& t2) {
+    auto const position = [this](Instant const& t) {
+      return World::origin +
+             Displacement<World>({(t - t0_) * (t - t0_) * Metre /
+                                      (Second * Second),
+                                  0 * Metre,
+                                  0 * Metre});
+    };
+    auto const velocity = [this](Instant const& t) {
+      return Velocity<World>({2 * (t - t0_) * Metre / (Second * Second),
+                              0 * Metre / Second,
+                              0 * Metre / Second});
+    };
+    Vector<Acceleration, World> const acceleration(
+        {2 * Metre / (Second * Second),
+         0 * Metre / (Second * Second),
+         0 * Metre / (Second * Second)});
+    return Interpolant({t1, t2},
+                       {position(t1), position(t2)},
+                       {velocity(t1), velocity(t2)},
+                       {acceleration, acceleration});
+  }
+
+  // A piece of the uniform circular motion of radius 1 m and angular frequency
+  // 1 rad/s, starting on the x axis at |t0_|.
+  Interpolant MakeCircularPiece(Instant const& t1, Instant const& t2) {
+    AngularFrequency const ω = 1 * Radian / Second;
+    auto const position = [this, ω](Instant const& t) {
+      return World::origin + Displacement<World>({Cos(ω * (t - t0_)) * Metre,
+                                                  Sin(ω * (t - t0_)) * Metre,
+                                                  0 * Metre});
+    };
+    auto const velocity = [this, ω](Instant const& t) {
+      return Velocity<World>({-Sin(ω * (t - t0_)) * Metre / Second,
+                              Cos(ω * (t - t0_)) * Metre / Second,
+                              0 * Metre / Second});
+    };
+    auto const acceleration = [this, ω](Instant const& t) {
+      return Vector<Acceleration, World>(
+          {-Cos(ω * (t - t0_)) * Metre / (Second * Second),
+           -Sin(ω * (t - t0_)) * Metre / (Second * Second),
+           0 * Metre / (Second * Second)});
+    };
+    return Interpolant({t1, t2},
+                       {position(t1), position(t2)},
+                       {velocity(t1), velocity(t2)},
+                       {acceleration(t1), acceleration(t2)});
+  }
+
+  Position<World> CircularPosition(Instant const& t) {
+    double const τ = (t - t0_) / Second;
+    return World::origin + Displacement<World>({std::cos(τ) * Metre,
+                                                std::sin(τ) * Metre,
+                                                0 * Metre});
+  }
+
+  Instant const t0_;
+  DenseTrajectory<World> trajectory_;
+};
+
+TEST_F(DenseTrajectoryTest, Evaluate) {
+  EXPECT_TRUE(trajectory_.empty());
+  trajectory_.Append(MakePiece(t0_, t0_ + 1 * Second));
+  trajectory_.Append(MakePiece(t0_ + 1 * Second, t0_ + 3 * Second));
+  trajectory_.Append(MakePiece(t0_ + 3 * Second, t0_ + 4 * Second));
+  EXPECT_FALSE(trajectory_.empty());
+  EXPECT_EQ(3, trajectory_.size());
+  EXPECT_EQ(t0_, trajectory_.t_min());
+  EXPECT_EQ(t0_ + 4 * Second, trajectory_.t_max());
+
+  for (Instant t = t0_; t <= t0_ + 4 * Second; t += 0.25 * Second) {
+    double const τ = (t - t0_) / Second;
+    DegreesOfFreedom<World> const degrees_of_freedom =
+        trajectory_.EvaluateDegreesOfFreedom(t);
+    EXPECT_THAT(degrees_of_freedom.position() - World::origin,
+                AlmostEquals(Displacement<World>({τ * τ * Metre,
+                                                  0 * Metre,
+                                                  0 * Metre}), 0, 4));
+    EXPECT_THAT(degrees_of_freedom.velocity(),
+                AlmostEquals(Velocity<World>({2 * τ * Metre / Second,
+                                              0 * Metre / Second,
+                                              0 * Metre / Second}), 0, 4));
+    EXPECT_EQ(degrees_of_freedom.position(), trajectory_.EvaluatePosition(t));
+    EXPECT_EQ(degrees_of_freedom.velocity(), trajectory_.EvaluateVelocity(t));
+  }
+}
+
+TEST_F(DenseTrajectoryTest, Sample) {
+  trajectory_.Append(MakePiece(t0_, t0_ + 1 * Second));
+  trajectory_.Append(MakePiece(t0_ + 1 * Second, t0_ + 3.5 * Second));
+
+  DiscreteTrajectory<World> sampled;
+  trajectory_.Sample(1 * Second, &sampled);
+  EXPECT_EQ(5, sampled.Size());
+  Instant expected_time = t0_;
+  for (auto it = sampled.Begin(); it != sampled.End(); ++it) {
+    EXPECT_EQ(expected_time, it.time());
+    EXPECT_EQ(trajectory_.EvaluateDegreesOfFreedom(it.time()),
+              it.degrees_of_freedom());
+    expected_time = std::min(expected_time + 1 * Second, t0_ + 3.5 * Second);
+  }
+
+  // The points that are not after the end of |sampled| are not appended.
+  trajectory_.Append(MakePiece(t0_ + 3.5 * Second, t0_ + 5 * Second));
+  trajectory_.Sample(1 * Second, &sampled);
+  EXPECT_EQ(7, sampled.Size());
+  EXPECT_EQ(t0_ + 4 * Second, (--(--sampled.End())).time());
+  EXPECT_EQ(t0_ + 5 * Second, sampled.last().time());
+}
+
+// Pieces of a quadratic motion are merged into a single one.
+TEST_F(DenseTrajectoryTest, MergeExact) {
+  DenseTrajectory<World> trajectory(1 * Micro(Metre));
+  for (int i = 0; i < 10; ++i) {
+    trajectory.Append(
+        MakePiece(t0_ + i * Second, t0_ + (i + 1) * Second));
+  }
+  EXPECT_EQ(1, trajectory.size());
+  EXPECT_EQ(t0_, trajectory.t_min());
+  EXPECT_EQ(t0_ + 10 * Second, trajectory.t_max());
+  for (Instant t = t0_; t <= t0_ + 10 * Second; t += 0.25 * Second) {
+    double const τ = (t - t0_) / Second;
+    EXPECT_THAT(trajectory.EvaluatePosition(t) - World::origin,
+                AlmostEquals(Displacement<World>({τ * τ * Metre,
+                                                  0 * Metre,
+                                                  0 * Metre}), 0, 20));
+  }
+}
+
+// Pieces of a circular motion are merged as long as the tolerance is met.
+TEST_F(DenseTrajectoryTest, MergeWithinTolerance) {
+  Length const tolerance = 1 * Micro(Metre);
+  DenseTrajectory<World> trajectory(tolerance);
+  int const steps = 1000;
+  Instant const t_final = t0_ + 2 * π * Second;
+  for (int i = 0; i < steps; ++i) {
+    trajectory.Append(MakeCircularPiece(t0_ + i * (t_final - t0_) / steps,
+                                        t0_ + (i + 1) * (t_final - t0_) /
+                                                  steps));
+  }
+  EXPECT_EQ(11, trajectory.size());
+  for (Instant t = t0_; t <= t_final; t += 0.01 * Second) {
+    EXPECT_THAT(AbsoluteError(CircularPosition(t),
+                              trajectory.EvaluatePosition(t)),
+                Lt(tolerance)) << t;
+  }
+}
+
+// Only the points needed for cubic interpolation are sampled.
+TEST_F(DenseTrajectoryTest, SampleWithinTolerance) {
+  Length const tolerance = 1 * Micro(Metre);
+  DenseTrajectory<World> trajectory(tolerance);
+  int const steps = 1000;
+  Instant const t_final = t0_ + 2 * π * Second;
+  for (int i = 0; i < steps; ++i) {
+    trajectory.Append(MakeCircularPiece(t0_ + i * (t_final - t0_) / steps,
+                                        t0_ + (i + 1) * (t_final - t0_) /
+                                                  steps));
+  }
+
+  DiscreteTrajectory<World> sampled;
+  trajectory.Sample(tolerance, &sampled);
+  EXPECT_EQ(85, sampled.Size());
+  EXPECT_EQ(t0_, sampled.Begin().time());
+  EXPECT_EQ(t_final, sampled.last().time());
+  for (Instant t = t0_; t <= t_final; t += 0.01 * Second) {
+    EXPECT_THAT(AbsoluteError(trajectory.EvaluatePosition(t),
+                              sampled.EvaluatePosition(t)),
+                Lt(tolerance)) << t;
+  }
+
+  // A quadratic motion is sampled only at the bounds of its pieces.
+  trajectory_.Append(MakePiece(t0_, t0_ + 1 * Second));
+  trajectory_.Append(MakePiece(t0_ + 1 * Second, t0_ + 3 * Second));
+  DiscreteTrajectory<World> sampled_quadratic;
+  trajectory_.Sample(tolerance, &sampled_quadratic);
+  EXPECT_EQ(3, sampled_quadratic.Size());
+}
+
+// Only the points needed for cubic interpolation are kept, and they are not
+// altered.
+TEST_F(DenseTrajectoryTest, ThinWithinTolerance) {
+  Length const tolerance = 1 * Micro(Metre);
+  DenseTrajectory<World> trajectory(tolerance);
+  DiscreteTrajectory<World> steps;
+  int const steps_count = 1000;
+  Instant const t_final = t0_ + 2 * π * Second;
+  for (int i = 0; i < steps_count; ++i) {
+    Interpolant const piece =
+        MakeCircularPiece(t0_ + i * (t_final - t0_) / steps_count,
+                          t0_ + (i + 1) * (t_final - t0_) / steps_count);
+    if (i == 0) {
+      steps.Append(piece.lower_bound(),
+                   DegreesOfFreedom<World>(
+                       piece.Evaluate(piece.lower_bound()),
+                       piece.EvaluateDerivative(piece.lower_bound())));
+    }
+    steps.Append(piece.upper_bound(),
+                 DegreesOfFreedom<World>(
+                     piece.Evaluate(piece.upper_bound()),
+                     piece.EvaluateDerivative(piece.upper_bound())));
+    trajectory.Append(piece);
+  }
+
+  DiscreteTrajectory<World> thinned;
+  trajectory.Thin(steps, tolerance, &thinned);
+  EXPECT_EQ(47, thinned.Size());
+  EXPECT_EQ(t0_, thinned.Begin().time());
+  EXPECT_EQ(t_final, thinned.last().time());
+  for (auto it = thinned.Begin(); it != thinned.End(); ++it) {
+    EXPECT_EQ(steps.Find(it.time()).degrees_of_freedom(),
+              it.degrees_of_freedom());
+  }
+  for (Instant t = t0_; t <= t_final; t += 0.01 * Second) {
+    EXPECT_THAT(AbsoluteError(trajectory.EvaluatePosition(t),
+                              thinned.EvaluatePosition(t)),
+                Lt(tolerance)) << t;
+  }
+
+  // A quadratic motion is reduced to its bounds.  The points that are not after
+  // the end of |thinned_quadratic| are not appended.
+  trajectory_.Append(MakePiece(t0_, t0_ + 1 * Second));
+  trajectory_.Append(MakePiece(t0_ + 1 * Second, t0_ + 3 * Second));
+  DiscreteTrajectory<World> quadratic_steps;
+  for (int i = 0; i <= 3; ++i) {
+    Instant const t = t0_ + i * Second;
+    quadratic_steps.Append(t, trajectory_.EvaluateDegreesOfFreedom(t));
+  }
+  DiscreteTrajectory<World> thinned_quadratic;
+  thinned_quadratic.Append(t0_, quadratic_steps.Begin().degrees_of_freedom());
+  trajectory_.Thin(quadratic_steps, tolerance, &thinned_quadratic);
+  EXPECT_EQ(2, thinned_quadratic.Size());
+  EXPECT_EQ(t0_ + 3 * Second, thinned_quadratic.last().time());
+}
+
+}  // namespace internal_dense_trajectory
+}  // namespace physics
+}  // namespace principia
@@ -3,7 +3,6 @@
 
 #include <functional>
 #include <list>
-#include <map>
 #include <memory>
 #include <vector>
 
@@ -14,6 +13,7 @@
 #include "numerics/hermite3.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/forkable.hpp"
+#include "physics/timeline.hpp"
 #include "physics/trajectory.hpp"
 #include "quantities/named_quantities.hpp"
 #include "serialization/physics.pb.h"
@@ -32,8 +32,7 @@ using base::not_constructible;
 
 template<typename Frame>
 struct ForkableTraits<DiscreteTrajectory<Frame>> : not_constructible {
-  using TimelineConstIterator =
-      typename std::map<Instant, DegreesOfFreedom<Frame>>::const_iterator;
+  using TimelineConstIterator = typename Timeline<Frame>::const_iterator;
   static Instant const& time(TimelineConstIterator it);
 };
 
@@ -69,7 +68,6 @@ template<typename Frame>
 class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
                                            DiscreteTrajectoryIterator<Frame>>,
                            public Trajectory<Frame> {
-  using Timeline = std::map<Instant, DegreesOfFreedom<Frame>>;
   using TimelineConstIterator = typename Forkable<
       DiscreteTrajectory<Frame>,
       DiscreteTrajectoryIterator<Frame>>::TimelineConstIterator;
@@ -190,7 +188,7 @@ class DiscreteTrajectory : public Forkable<DiscreteTrajectory<Frame>,
   Hermite3<Instant, Position<Frame>> GetInterpolation(
       Instant const& time) const;
 
-  Timeline timeline_;
+  Timeline<Frame> timeline_;
 
   template<typename, typename>
   friend class internal_forkable::ForkableIterator;
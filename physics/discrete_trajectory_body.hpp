@@ -4,8 +4,8 @@
 #include "physics/discrete_trajectory.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <list>
-#include <map>
 #include <vector>
 
 #include "astronomy/epoch.hpp"
@@ -21,18 +21,18 @@ using geometry::Instant;
 template<typename Frame>
 Instant const& ForkableTraits<DiscreteTrajectory<Frame>>::time(
     TimelineConstIterator const it) {
-  return it->first;
+  return it.time();
 }
 
 template<typename Frame>
 Instant const& DiscreteTrajectoryIterator<Frame>::time() const {
-  return this->current()->first;
+  return this->current().time();
 }
 
 template<typename Frame>
 DegreesOfFreedom<Frame> const&
 DiscreteTrajectoryIterator<Frame>::degrees_of_freedom() const {
-  return this->current()->second;
+  return this->current().degrees_of_freedom();
 }
 
 template<typename Frame>
@@ -74,7 +74,10 @@ DiscreteTrajectory<Frame>::NewForkWithCopy(Instant const& time) {
 
   // Copy the tail of the trajectory in the child object.
   if (timeline_it != timeline_.end()) {
-    fork->timeline_.insert(++timeline_it, timeline_.end());
+    for (++timeline_it; timeline_it != timeline_.end(); ++timeline_it) {
+      fork->timeline_.push_back(timeline_it.time(),
+                                timeline_it.degrees_of_freedom());
+    }
   }
   return fork;
 }
@@ -111,14 +114,14 @@ void DiscreteTrajectory<Frame>::AttachFork(
   // Append to this trajectory a copy of the first point of |fork|.
   auto& fork_timeline = fork->timeline_;
   auto fork_begin = fork_timeline.begin();
-  Append(fork_begin->first, fork_begin->second);
+  Append(fork_begin.time(), fork_begin.degrees_of_freedom());
 
   // Attach |fork| to this trajectory.
   this->AttachForkToCopiedBegin(std::move(fork));
 
   // Remove the first point of |fork| now that it properly attached to its
   // parent.
-  fork_timeline.erase(fork_begin);
+  fork_timeline.pop_front();
 }
 
 template<typename Frame>
@@ -129,9 +132,7 @@ DiscreteTrajectory<Frame>::DetachFork() {
   // Insert a new point in the timeline for the fork time.  It should go at the
   // beginning of the timeline.
   auto const fork_it = this->Fork();
-  auto const begin_it = timeline_.emplace_hint(
-      timeline_.begin(), fork_it.time(), fork_it.degrees_of_freedom());
-  CHECK(begin_it == timeline_.begin());
+  timeline_.push_front(fork_it.time(), fork_it.degrees_of_freedom());
 
   // Detach this trajectory and tell the caller that it owns the pieces.
   return this->DetachForkWithCopiedBegin();
@@ -145,17 +146,17 @@ void DiscreteTrajectory<Frame>::Append(
        << "Append at " << time << " which is before fork time "
        << this->Fork().time();
 
-  if (!timeline_.empty() && timeline_.cbegin()->first == time) {
+  if (!timeline_.empty() && timeline_.begin().time() == time) {
     LOG(WARNING) << "Append at existing time " << time
                  << ", time range = [" << this->Begin().time() << ", "
                  << last().time() << "]";
     return;
   }
-  auto it = timeline_.emplace_hint(timeline_.end(),
-                                   time,
-                                   degrees_of_freedom);
-  // Decrementing |end()| is much faster than incrementing |it|.  Don't ask.
-  CHECK(--timeline_.end() == it) << "Append out of order at " << time;
+  // Appending at the time of the last point is silently ignored.
+  if (!timeline_.empty() && std::prev(timeline_.end()).time() == time) {
+    return;
+  }
+  timeline_.push_back(time, degrees_of_freedom);
 }
 
 template<typename Frame>
@@ -289,9 +290,10 @@ void DiscreteTrajectory<Frame>::WriteSubTreeToMessage(
     not_null<serialization::DiscreteTrajectory*> const message,
     std::vector<DiscreteTrajectory<Frame>*>& forks) const {
   Forkable<DiscreteTrajectory, Iterator>::WriteSubTreeToMessage(message, forks);
-  for (auto const& pair : timeline_) {
-    Instant const& instant = pair.first;
-    DegreesOfFreedom<Frame> const& degrees_of_freedom = pair.second;
+  for (auto it = timeline_.begin(); it != timeline_.end(); ++it) {
+    Instant const& instant = it.time();
+    DegreesOfFreedom<Frame> const& degrees_of_freedom =
+        it.degrees_of_freedom();
     auto const instantaneous_degrees_of_freedom = message->add_timeline();
     instant.WriteToMessage(instantaneous_degrees_of_freedom->mutable_instant());
     degrees_of_freedom.WriteToMessage(
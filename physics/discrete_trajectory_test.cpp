@@ -545,6 +545,15 @@ TEST_F(DiscreteTrajectoryTest, AppendAtExistingTime) {
   massive_trajectory_->Append(t1_, d1_);
 }
 
+TEST_F(DiscreteTrajectoryTest, AppendAtExistingLastTime) {
+  massive_trajectory_->Append(t1_, d1_);
+  massive_trajectory_->Append(t2_, d2_);
+  massive_trajectory_->Append(t2_, d3_);
+  EXPECT_EQ(2, massive_trajectory_->Size());
+  EXPECT_EQ(t2_, massive_trajectory_->last().time());
+  EXPECT_EQ(d2_, massive_trajectory_->last().degrees_of_freedom());
+}
+
 TEST_F(DiscreteTrajectoryTest, AppendSuccess) {
   massive_trajectory_->Append(t1_, d1_);
   massive_trajectory_->Append(t2_, d2_);
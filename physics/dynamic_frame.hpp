@@ -2,6 +2,11 @@
 #ifndef PRINCIPIA_PHYSICS_DYNAMIC_FRAME_HPP_
 #define PRINCIPIA_PHYSICS_DYNAMIC_FRAME_HPP_
 
+#include <array>
+#include <experimental/optional>
+#include <mutex>
+#include <vector>
+
 #include "geometry/frame.hpp"
 #include "geometry/rotation.hpp"
 #include "physics/ephemeris.hpp"
@@ -34,16 +39,27 @@ class DynamicFrame {
   static_assert(InertialFrame::is_inertial, "InertialFrame must be inertial");
 
  public:
+  DynamicFrame() = default;
+  DynamicFrame(DynamicFrame const&) = delete;
+  DynamicFrame(DynamicFrame&&) = delete;
+  DynamicFrame& operator=(DynamicFrame const&) = delete;
+  DynamicFrame& operator=(DynamicFrame&&) = delete;
   virtual ~DynamicFrame() = default;
 
-  // At least one of |ToThisFrameAtTime| and |FromThisFrameAtTime| must be
-  // overriden in derived classes; the default implementation inverts the other
-  // one.
+  // The motion of |ThisFrame| at |t|, as computed by
+  // |ComputeToThisFrameAtTime|.  The results are memoized (unless
+  // |IsMemoizable| returns false), so repeated calls at the same instants,
+  // which are frequent when rendering, are cheap.  Thread-safe.
   virtual RigidMotion<InertialFrame, ThisFrame> ToThisFrameAtTime(
       Instant const& t) const;
   virtual RigidMotion<ThisFrame, InertialFrame> FromThisFrameAtTime(
       Instant const& t) const;
 
+  // Same as calling |ToThisFrameAtTime| for each element of |times|, but only
+  // locks the memoization table twice.
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> ToThisFrameAtTimes(
+      std::vector<Instant> const& times) const;
+
   // The acceleration due to the non-inertial motion of |ThisFrame| and gravity.
   // A particle in free fall follows a trajectory whose second derivative
   // is |GeometricAcceleration|.
@@ -72,6 +88,39 @@ class DynamicFrame {
       Position<InertialFrame> const& q) const = 0;
   virtual AcceleratedRigidMotion<InertialFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const = 0;
+
+  // Computes the motion of |ThisFrame| at |t|, without memoization.
+  virtual RigidMotion<InertialFrame, ThisFrame> ComputeToThisFrameAtTime(
+      Instant const& t) const = 0;
+
+  // Returns false if the motion of |ThisFrame| at a given instant may change
+  // over time, e.g., because it is defined by a trajectory that gets
+  // recomputed.  The results are not memoized in that case.
+  virtual bool IsMemoizable() const;
+
+  struct MemoizedMotion final {
+    Instant time;
+    RigidMotion<InertialFrame, ThisFrame> to_this_frame;
+  };
+
+  // Returns the memoized motion at |t|, or null if there is none.  |lock_|
+  // must be held.
+  RigidMotion<InertialFrame, ThisFrame> const* FindMemoizedMotion(
+      Instant const& t) const;
+  // Memoizes |to_this_frame| as the motion at |t|, evicting the oldest
+  // memoized motion if needed.  |lock_| must be held.
+  void Memoize(Instant const& t,
+               RigidMotion<InertialFrame, ThisFrame> const& to_this_frame) const;
+
+  // The number of instants whose motion is memoized.  The lookup is linear,
+  // which is cheap compared to the evaluation of the trajectories.
+  static constexpr int memoized_motions_size_ = 64;
+
+  mutable std::mutex lock_;
+  // A ring buffer of the motions most recently computed.
+  mutable std::array<std::experimental::optional<MemoizedMotion>,
+                     memoized_motions_size_> memoized_motions_;
+  mutable int next_memoized_motion_ = 0;
 };
 
 }  // namespace internal_dynamic_frame
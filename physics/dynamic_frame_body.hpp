@@ -1,6 +1,9 @@
 ﻿
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "physics/barycentric_rotating_dynamic_frame.hpp"
 #include "physics/body_centred_body_direction_dynamic_frame.hpp"
 #include "physics/body_centred_non_rotating_dynamic_frame.hpp"
@@ -26,11 +29,31 @@ using quantities::Sqrt;
 using quantities::Variation;
 using quantities::si::Radian;
 
+template<typename InertialFrame, typename ThisFrame>
+constexpr int DynamicFrame<InertialFrame, ThisFrame>::memoized_motions_size_;
+
 template<typename InertialFrame, typename ThisFrame>
 RigidMotion<InertialFrame, ThisFrame>
 DynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTime(
     Instant const& t) const {
-  return FromThisFrameAtTime(t).Inverse();
+  if (!IsMemoizable()) {
+    return ComputeToThisFrameAtTime(t);
+  }
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    auto const memoized_motion = FindMemoizedMotion(t);
+    if (memoized_motion != nullptr) {
+      return *memoized_motion;
+    }
+  }
+  // Don't hold the lock while computing, the computation may be expensive.
+  RigidMotion<InertialFrame, ThisFrame> const to_this_frame =
+      ComputeToThisFrameAtTime(t);
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    Memoize(t, to_this_frame);
+  }
+  return to_this_frame;
 }
 
 template<typename InertialFrame, typename ThisFrame>
@@ -40,6 +63,54 @@ DynamicFrame<InertialFrame, ThisFrame>::FromThisFrameAtTime(
   return ToThisFrameAtTime(t).Inverse();
 }
 
+template<typename InertialFrame, typename ThisFrame>
+std::vector<RigidMotion<InertialFrame, ThisFrame>>
+DynamicFrame<InertialFrame, ThisFrame>::ToThisFrameAtTimes(
+    std::vector<Instant> const& times) const {
+  std::vector<RigidMotion<InertialFrame, ThisFrame>> motions;
+  motions.reserve(times.size());
+  if (!IsMemoizable()) {
+    for (Instant const& t : times) {
+      motions.push_back(ComputeToThisFrameAtTime(t));
+    }
+    return motions;
+  }
+
+  std::vector<std::experimental::optional<
+      RigidMotion<InertialFrame, ThisFrame>>> memoized(times.size());
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    for (int i = 0; i < times.size(); ++i) {
+      auto const memoized_motion = FindMemoizedMotion(times[i]);
+      if (memoized_motion != nullptr) {
+        memoized[i].emplace(*memoized_motion);
+      }
+    }
+  }
+  std::vector<int> computed;
+  for (int i = 0; i < times.size(); ++i) {
+    if (memoized[i]) {
+      motions.push_back(*memoized[i]);
+    } else {
+      motions.push_back(ComputeToThisFrameAtTime(times[i]));
+      computed.push_back(i);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    // Only the most recent motions would survive in the ring buffer.
+    for (int j = std::max(0,
+                          static_cast<int>(computed.size()) -
+                              memoized_motions_size_);
+         j < computed.size();
+         ++j) {
+      int const i = computed[j];
+      Memoize(times[i], motions[i]);
+    }
+  }
+  return motions;
+}
+
 template<typename InertialFrame, typename ThisFrame>
 Vector<Acceleration, ThisFrame>
 DynamicFrame<InertialFrame, ThisFrame>::GeometricAcceleration(
@@ -156,6 +227,32 @@ DynamicFrame<InertialFrame, ThisFrame>::ReadFromMessage(
   return std::move(result);
 }
 
+template<typename InertialFrame, typename ThisFrame>
+bool DynamicFrame<InertialFrame, ThisFrame>::IsMemoizable() const {
+  return true;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+RigidMotion<InertialFrame, ThisFrame> const*
+DynamicFrame<InertialFrame, ThisFrame>::FindMemoizedMotion(
+    Instant const& t) const {
+  for (auto const& memoized_motion : memoized_motions_) {
+    if (memoized_motion && memoized_motion->time == t) {
+      return &memoized_motion->to_this_frame;
+    }
+  }
+  return nullptr;
+}
+
+template<typename InertialFrame, typename ThisFrame>
+void DynamicFrame<InertialFrame, ThisFrame>::Memoize(
+    Instant const& t,
+    RigidMotion<InertialFrame, ThisFrame> const& to_this_frame) const {
+  memoized_motions_[next_memoized_motion_].emplace(
+      MemoizedMotion{t, to_this_frame});
+  next_memoized_motion_ = (next_memoized_motion_ + 1) % memoized_motions_size_;
+}
+
 }  // namespace internal_dynamic_frame
 }  // namespace physics
 }  // namespace principia
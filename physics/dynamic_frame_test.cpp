@@ -53,18 +53,20 @@ class InertialFrame : public DynamicFrame<OtherFrame, ThisFrame> {
           Instant const& t,
           Position<OtherFrame> const& q)> gravity);
 
-  RigidMotion<OtherFrame, ThisFrame> ToThisFrameAtTime(
-      Instant const& t) const override;
-
   void WriteToMessage(
       not_null<serialization::DynamicFrame*> message) const override;
 
+  // The number of calls to |ComputeToThisFrameAtTime|.
+  int computations() const;
+
  private:
   Vector<Acceleration, OtherFrame> GravitationalAcceleration(
       Instant const& t,
       Position<OtherFrame> const& q) const override;
   AcceleratedRigidMotion<OtherFrame, ThisFrame> MotionOfThisFrame(
       Instant const& t) const override;
+  RigidMotion<OtherFrame, ThisFrame> ComputeToThisFrameAtTime(
+      Instant const& t) const override;
 
   DegreesOfFreedom<OtherFrame> const origin_degrees_of_freedom_at_epoch_;
   Instant const epoch_;
@@ -72,6 +74,7 @@ class InertialFrame : public DynamicFrame<OtherFrame, ThisFrame> {
   std::function<Vector<Acceleration, OtherFrame>(
       Instant const& t,
       Position<OtherFrame> const& q)> gravity_;
+  mutable int computations_ = 0;
 };
 
 template<typename OtherFrame, typename ThisFrame>
@@ -89,8 +92,9 @@ InertialFrame<OtherFrame, ThisFrame>::InertialFrame(
 
 template<typename OtherFrame, typename ThisFrame>
 RigidMotion<OtherFrame, ThisFrame>
-InertialFrame<OtherFrame, ThisFrame>::ToThisFrameAtTime(
+InertialFrame<OtherFrame, ThisFrame>::ComputeToThisFrameAtTime(
     Instant const& t) const {
+  ++computations_;
   return RigidMotion<OtherFrame, ThisFrame>(
              RigidTransformation<OtherFrame, ThisFrame>(
                  origin_degrees_of_freedom_at_epoch_.position() +
@@ -106,6 +110,11 @@ template<typename OtherFrame, typename ThisFrame>
 void InertialFrame<OtherFrame, ThisFrame>::WriteToMessage(
     not_null<serialization::DynamicFrame*> message) const {}
 
+template<typename OtherFrame, typename ThisFrame>
+int InertialFrame<OtherFrame, ThisFrame>::computations() const {
+  return computations_;
+}
+
 template<typename OtherFrame, typename ThisFrame>
 Vector<Acceleration, OtherFrame>
 InertialFrame<OtherFrame, ThisFrame>::GravitationalAcceleration(
@@ -119,7 +128,7 @@ AcceleratedRigidMotion<OtherFrame, ThisFrame>
 InertialFrame<OtherFrame, ThisFrame>::MotionOfThisFrame(
     Instant const& t) const {
   return AcceleratedRigidMotion<OtherFrame, ThisFrame>(
-      ToThisFrameAtTime(t),
+      this->ToThisFrameAtTime(t),
       /*angular_acceleration_of_to_frame=*/{},
       /*acceleration_of_to_frame_origin=*/{});
 }
@@ -134,14 +143,13 @@ class DynamicFrameTest : public testing::Test {
       Velocity<Circular>(
           {0 * Metre / Second, 1 * Metre / Second, 0 * Metre / Second})};
 
-  InertialFrame<Circular, Helical> helix_frame_ =
-      InertialFrame<Circular, Helical>(
-          {Circular::origin,
-           Velocity<Circular>(
-               {0 * Metre / Second, 0 * Metre / Second, 1 * Metre / Second})},
-          /*epoch=*/Instant() ,
-          OrthogonalMap<Circular, Helical>::Identity(),
-          &Gravity);
+  InertialFrame<Circular, Helical> helix_frame_{
+      {Circular::origin,
+       Velocity<Circular>(
+           {0 * Metre / Second, 0 * Metre / Second, 1 * Metre / Second})},
+      /*epoch=*/Instant(),
+      OrthogonalMap<Circular, Helical>::Identity(),
+      &Gravity};
 };
 
 TEST_F(DynamicFrameTest, Helix) {
@@ -159,6 +167,34 @@ TEST_F(DynamicFrameTest, Helix) {
                             AlmostEquals(-Sqrt(0.5), 1)));
 }
 
+TEST_F(DynamicFrameTest, Memoization) {
+  std::vector<Instant> times;
+  for (int i = 0; i < 10; ++i) {
+    times.push_back(Instant() + i * Second);
+  }
+  std::vector<RigidMotion<Circular, Helical>> const motions =
+      helix_frame_.ToThisFrameAtTimes(times);
+  EXPECT_EQ(10, helix_frame_.computations());
+  ASSERT_EQ(times.size(), motions.size());
+
+  // The motions are memoized, and they are the same as the ones computed
+  // individually.
+  for (int i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(motions[i](circular_degrees_of_freedom_),
+              helix_frame_.ToThisFrameAtTime(times[i])(
+                  circular_degrees_of_freedom_));
+    EXPECT_EQ(circular_degrees_of_freedom_,
+              helix_frame_.FromThisFrameAtTime(times[i])(
+                  motions[i](circular_degrees_of_freedom_)));
+  }
+  EXPECT_EQ(10, helix_frame_.computations());
+
+  // Only the new instants are computed.
+  times.push_back(Instant() + 10 * Second);
+  helix_frame_.ToThisFrameAtTimes(times);
+  EXPECT_EQ(11, helix_frame_.computations());
+}
+
 }  // namespace internal_dynamic_frame
 }  // namespace physics
 }  // namespace principia
@@ -1,21 +1,31 @@
 ﻿
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <experimental/filesystem>
 #include <experimental/optional>
 #include <functional>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
 #include <vector>
 
+#include "base/mapped_file.hpp"
 #include "base/not_null.hpp"
 #include "base/status.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/named_quantities.hpp"
 #include "google/protobuf/repeated_field.h"
 #include "integrators/integrators.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "physics/continuous_trajectory.hpp"
+#include "physics/dense_trajectory.hpp"
 #include "physics/discrete_trajectory.hpp"
 #include "physics/massive_body.hpp"
 #include "physics/oblate_body.hpp"
@@ -26,8 +36,10 @@ namespace principia {
 namespace physics {
 namespace internal_ephemeris {
 
+using base::MappedFile;
 using base::not_null;
 using base::Status;
+using base::ThreadPool;
 using geometry::Instant;
 using geometry::Position;
 using geometry::Vector;
@@ -41,6 +53,12 @@ using quantities::Length;
 using quantities::Speed;
 using quantities::Time;
 
+// |Prolong| and |ProlongTowards| may be called on one thread while the others
+// call the member functions that read the trajectories, e.g., |t_max|,
+// |trajectory| or |FlowWithAdaptiveStep|; they are serialized with respect to
+// each other and to |ForgetBefore|, |Reanimate|, |RequestReanimation|, |t_min|,
+// |last_severe_integration_status| and the |Write...| functions.  The other
+// member functions are not thread-safe.
 template<typename Frame>
 class Ephemeris {
   static_assert(Frame::is_inertial, "Frame must be inertial");
@@ -148,12 +166,66 @@ class Ephemeris {
 
   virtual Status last_severe_integration_status() const;
 
-  // Calls |ForgetBefore| on all trajectories.  On return |t_min() == t|.
+  // If |vectorized_gravity| is true (the default), the accelerations exerted
+  // by the spherical massive bodies, on each other and on batches of massless
+  // bodies, are computed by vectorized kernels operating on structure-of-arrays
+  // copies of the positions.  Otherwise they are computed by the scalar loops.
+  // Both produce bit-for-bit identical results.
+  virtual void set_vectorized_gravity(bool vectorized_gravity);
+
+  // If |max_workers| is greater than 1, |Prolong| computes the mutual
+  // accelerations of the massive bodies and fits their trajectories on up to
+  // |max_workers| threads, which persist until the next call.  The
+  // accelerations are computed pairwise by tiles sized from the number of
+  // workers and summed for each body in the order of the serial loop, so the
+  // results are bit-for-bit identical to those obtained with a single worker
+  // (the default).  This is only worthwhile for systems with many bodies.
+  virtual void set_max_workers(int max_workers);
+
+  // Bounds the number of threads used by |Reanimate| and |RequestReanimation|
+  // to recompute the intervals between checkpoints.  The threads are created
+  // by the first reanimation after the call and persist until the next call; a
+  // reanimation in progress keeps its threads.  The default is the number of
+  // hardware threads.
+  virtual void set_max_reanimation_workers(int max_workers);
+
+  // Calls |ForgetBefore| on all trajectories.  On return |t_min() == t|.  The
+  // last checkpoint before |t| is kept, see |Reanimate|.
   virtual void ForgetBefore(Instant const& t);
 
+  // Recomputes the series of the trajectories before |t_min()| from the
+  // checkpoints that were read by |ReadFromMessage| or kept by |ForgetBefore|,
+  // so that |t_min() <= desired_t_min| if the checkpoints go back far enough.
+  // The intervals between consecutive checkpoints are recomputed in parallel.
+  // Has no effect if |t_min() <= desired_t_min|.  First completes the
+  // reanimation started by |RequestReanimation|, if any, waiting for it if
+  // needed.  May run concurrently with |Prolong| and |ProlongTowards|, but not
+  // with the readers of the trajectories.
+  virtual void Reanimate(Instant const& desired_t_min);
+
+  // Same as |Reanimate|, but the series are recomputed on a background thread
+  // and this function returns immediately.  They are only prepended to the
+  // trajectories by the next call to |Reanimate|, |RequestReanimation| or
+  // |ForgetBefore|, so the readers of the trajectories are not affected in the
+  // meantime.
+  virtual void RequestReanimation(Instant const& desired_t_min);
+
+  // Same as |Reanimate|, but never blocks, so that it may be called when
+  // rendering.  If the reanimation started by |RequestReanimation| has
+  // completed, it is prepended to the trajectories; if none is pending, one is
+  // started as if by |RequestReanimation|.  On return |t_min()| may still be
+  // after |desired_t_min|.
+  virtual void PollReanimation(Instant const& desired_t_min);
+
   // Prolongs the ephemeris up to at least |t|.  After the call, |t_max() >= t|.
   virtual void Prolong(Instant const& t);
 
+  // Prolongs the ephemeris towards |t| by at most |max_steps| steps of the
+  // planetary integrator.  Returns true if and only if |t_max() >= t| after the
+  // call.  Used to prolong the ephemeris in small increments, e.g., on a
+  // background thread, without holding back |Prolong| for long.
+  virtual bool ProlongTowards(Instant const& t, std::int64_t max_steps);
+
   // Creates an instance suitable for integrating the given |trajectories| with
   // their |intrinsic_accelerations| using a fixed-step integrator parameterized
   // by |parameters|.
@@ -179,6 +251,19 @@ class Ephemeris {
       std::int64_t max_ephemeris_steps,
       bool last_point_only);
 
+  // Same as |FlowWithAdaptiveStep|, but also appends to |dense_trajectory| one
+  // piece for each step of the integration.  |dense_trajectory| must be empty
+  // or end at the last time of |trajectory|.  The integrator of |parameters|
+  // must have the first-same-as-last property.
+  virtual bool FlowWithDenseOutput(
+      not_null<DiscreteTrajectory<Frame>*> trajectory,
+      not_null<DenseTrajectory<Frame>*> dense_trajectory,
+      IntrinsicAcceleration intrinsic_acceleration,
+      Instant const& t,
+      AdaptiveStepParameters const& parameters,
+      std::int64_t max_ephemeris_steps,
+      bool last_point_only);
+
   // Integrates, until at most |t|, the trajectories followed by massless
   // bodies in the gravitational potential described by |*this|.  If
   // |t > t_max()|, calls |Prolong(t)| beforehand.  The trajectories and
@@ -194,6 +279,23 @@ class Ephemeris {
       Position<Frame> const& position,
       Instant const& t) const;
 
+  // Returns the gravitational accelerations on massless bodies located at the
+  // given |positions| at time |t|.  The trajectory of each massive body is
+  // evaluated only once, irrespective of the number of |positions|, so this is
+  // much cheaper than calling the previous function for each position.
+  virtual std::vector<Vector<Acceleration, Frame>>
+  ComputeGravitationalAccelerationsOnMasslessBodies(
+      std::vector<Position<Frame>> const& positions,
+      Instant const& t) const;
+
+  // Same as above, but the result is stored in |accelerations|, which is
+  // resized to the size of |positions|.  Doesn't allocate if |accelerations|
+  // already has the right size.
+  virtual void ComputeGravitationalAccelerationsOnMasslessBodies(
+      std::vector<Position<Frame>> const& positions,
+      Instant const& t,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
   // Returns the gravitational acceleration on the massless body having the
   // given |trajectory| at time |t|.  |t| must be one of the times of the
   // |trajectory|.
@@ -234,6 +336,26 @@ class Ephemeris {
   static not_null<std::unique_ptr<Ephemeris>> ReadFromMessage(
       serialization::Ephemeris const& message);
 
+  // Same as above, but the Чебышёв series of the trajectories are written to
+  // the file at |series_file| instead of |message|, as fixed-size blocks.  That
+  // file must be kept along with |message|.  Reading maps it in memory and the
+  // series are evaluated in place, so they are neither deserialized nor copied
+  // in the private memory of the process.
+  void WriteToMessage(
+      not_null<serialization::Ephemeris*> message,
+      std::experimental::filesystem::path const& series_file) const;
+  static not_null<std::unique_ptr<Ephemeris>> ReadFromMessage(
+      serialization::Ephemeris const& message,
+      std::experimental::filesystem::path const& series_file);
+
+  // Same as |WriteToMessage|, but compact: only the checkpoints of the
+  // integration are written, not the series.  The ephemeris returned by
+  // |ReadFromMessage| starts recomputing the series from |desired_t_min|
+  // onward, as if by |RequestReanimation|, and the older ones are only
+  // recomputed if |Reanimate| is called.
+  void WriteCheckpointsToMessage(not_null<serialization::Ephemeris*> message,
+                                 Instant const& desired_t_min) const;
+
  protected:
   // For mocking purposes, leaves everything uninitialized and uses the given
   // |integrator|.
@@ -249,6 +371,39 @@ class Ephemeris {
     std::vector<typename ContinuousTrajectory<Frame>::Checkpoint> checkpoints;
   };
 
+  // The recomputation of the series between a dormant checkpoint and the next
+  // one.
+  struct Reanimation final {
+    serialization::IntegratorInstance instance;
+    std::vector<serialization::ContinuousTrajectory> checkpoints;
+    // The time of the dormant checkpoint.
+    Instant t_initial;
+    // The integration stops once the series reach this time.
+    Instant t_final;
+    std::vector<not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>>
+        prefixes;
+  };
+
+  // Serializes the dormant checkpoints to reanimate, starting from the last one
+  // at or before |desired_t_min|, to have a copy that is not subject to changes
+  // by a concurrent |Prolong| and that may be deserialized with other
+  // callbacks.
+  std::vector<Reanimation> PrepareReanimations(
+      Instant const& desired_t_min) const;
+  // Returns the threads used to compute the reanimations, creating them if
+  // needed.
+  std::shared_ptr<ThreadPool> ReanimationThreadPool();
+  // Computes the |prefixes| of the |reanimations|, in parallel on
+  // |thread_pool|.  Does not access the trajectories.
+  void ComputeReanimations(std::vector<Reanimation>& reanimations,
+                           ThreadPool& thread_pool) const;
+  // Prepends the |prefixes| of the |reanimations| to the trajectories and
+  // makes the corresponding checkpoints live.
+  void SpliceReanimations(std::vector<Reanimation>& reanimations);
+  // Waits for the reanimation started by |RequestReanimation|, if any, and
+  // splices it.
+  void FinishReanimation();
+
   void AppendMassiveBodiesState(
       typename NewtonianMotionEquation::SystemState const& state);
   static void AppendMasslessBodiesState(
@@ -257,6 +412,28 @@ class Ephemeris {
 
   Checkpoint GetCheckpoint();
 
+  // The implementation of the public |FlowWithAdaptiveStep| and
+  // |FlowWithDenseOutput|.  |dense_trajectory| may be null.
+  bool FlowWithAdaptiveStep(
+      not_null<DiscreteTrajectory<Frame>*> trajectory,
+      DenseTrajectory<Frame>* dense_trajectory,
+      IntrinsicAcceleration intrinsic_acceleration,
+      Instant const& t,
+      AdaptiveStepParameters const& parameters,
+      std::int64_t max_ephemeris_steps,
+      bool last_point_only);
+
+  // If |series_file| is null, the series are written to |message|.  Otherwise
+  // they are written to |series_file|, which is identified by
+  // |series_file_identifier|, and the number of blocks is returned.
+  std::int64_t WriteToMessage(not_null<serialization::Ephemeris*> message,
+                              std::ostream* series_file,
+                              std::uint64_t series_file_identifier) const;
+  // |series_file| is null iff |message| doesn't have a series file.
+  static not_null<std::unique_ptr<Ephemeris>> ReadFromMessage(
+      serialization::Ephemeris const& message,
+      std::shared_ptr<MappedFile const> const& series_file);
+
   // Computes the accelerations between one body, |body1| (with index |b1| in
   // the |positions| and |accelerations| arrays) and the bodies |bodies2| (with
   // indices [b2_begin, b2_end[ in the |bodies2|, |positions| and
@@ -288,12 +465,67 @@ class Ephemeris {
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) const;
 
+  // Computes the accelerations between the spherical bodies in |bodies_| using
+  // |spherical_bodies_buffers_|.  The accelerations exerted by the oblate
+  // bodies must already have been accumulated in |accelerations|.
+  void ComputeSphericalBodiesGravitationalAccelerationsVectorized(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Computes the contributions of the pairs (b1, b2) with b2 in
+  // [b2_begin, b2_end[ to the accelerations of b1 and b2, storing them in
+  // |pairwise_accelerations_|.  The floating-point operations are the same as
+  // in |ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies|.
+  template<bool body1_is_oblate, bool body2_is_oblate>
+  void ComputePairwiseGravitationalAccelerations(
+      std::size_t b1,
+      std::size_t b2_begin,
+      std::size_t b2_end,
+      std::vector<Position<Frame>> const& positions) const;
+
   // Computes the accelerations between all the massive bodies in |bodies_|.
   void ComputeMassiveBodiesGravitationalAccelerations(
       Instant const& t,
       std::vector<Position<Frame>> const& positions,
       std::vector<Vector<Acceleration, Frame>>& accelerations) const;
 
+  // Same as above, but on the calling thread, and with the vectorized kernels
+  // only if |vectorized|.  If |vectorized| is false, uses no scratch storage
+  // and may therefore run concurrently with any function.
+  void ComputeMassiveBodiesGravitationalAccelerationsSerially(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations,
+      bool vectorized) const;
+
+  // Same as above, but on up to |max_workers_| threads, with bit-for-bit
+  // identical results.
+  void ComputeMassiveBodiesGravitationalAccelerationsInParallel(
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
+  // Calls |task| for each index in [0, tasks[, on the |thread_pool_| if there
+  // is one, and returns once all the calls have completed.
+  void RunInParallel(int tasks,
+                     std::function<void(int task)> const& task) const;
+
+  // The number of tiles into which the parallel computations are split.
+  int Tiles() const;
+  // The number of bodies in each tile for the computations that are split by
+  // body.
+  std::size_t BodiesPerTile() const;
+
+  // The index in |pairwise_accelerations_| of the pair (b1, b2), b1 < b2.
+  std::size_t PairIndex(std::size_t b1, std::size_t b2) const;
+
+  // Computes the accelerations exerted by the spherical bodies in |bodies_| on
+  // massless bodies at the given |positions| using a vectorized kernel.  The
+  // accelerations exerted by the oblate bodies must already have been
+  // accumulated in |accelerations|.
+  void ComputeMasslessBodiesGravitationalAccelerationsVectorized(
+      Instant const& t,
+      std::vector<Position<Frame>> const& positions,
+      std::vector<Vector<Acceleration, Frame>>& accelerations) const;
+
   // Computes the acceleration exerted by the massive bodies in |bodies_| on
   // massless bodies.  The massless bodies are at the given |positions|.
   void ComputeMasslessBodiesGravitationalAccelerations(
@@ -341,12 +573,76 @@ class Ephemeris {
   // These are the states other that the last which we preserve in order to
   // implement compact serialization.  The vector is time-ordered.
   std::vector<Checkpoint> checkpoints_;
+  // The states before |t_min()| from which the series may be recomputed by
+  // |Reanimate|.  The vector is time-ordered.
+  std::vector<Checkpoint> dormant_checkpoints_;
 
   int number_of_oblate_bodies_ = 0;
   int number_of_spherical_bodies_ = 0;
 
+  // Structure-of-arrays copies, in SI units, of the gravitational parameters,
+  // positions and accelerations of the spherical bodies, in the order of
+  // |bodies_|.  Only used by the vectorized computation of the accelerations;
+  // the positions and accelerations are scratch storage.
+  struct SphericalBodiesBuffers final {
+    std::vector<double> μ;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> ax;
+    std::vector<double> ay;
+    std::vector<double> az;
+  };
+  mutable SphericalBodiesBuffers spherical_bodies_buffers_;
+  bool vectorized_gravity_ = true;
+
+  // The contributions of a pair of massive bodies (b1, b2), b1 < b2, to their
+  // accelerations, kept separate so that they can be accumulated in the order
+  // of the serial loop.  Only used by the parallel computation of the
+  // accelerations.
+  struct PairwiseAccelerations final {
+    // Subtracted from the acceleration of b1.
+    Vector<Acceleration, Frame> on_b1;
+    // Added to the acceleration of b2.
+    Vector<Acceleration, Frame> on_b2;
+  };
+  // The contributions of the oblateness of b1 and b2, only set for the pairs
+  // where the bodies are oblate.  Since the oblate bodies come first, these
+  // pairs are the first ones in |pairwise_accelerations_|.
+  struct PairwiseZonalAccelerations final {
+    // Subtracted from the acceleration of b1, added to that of b2.
+    Vector<Acceleration, Frame> zonal1_on_b1;
+    Vector<Acceleration, Frame> zonal1_on_b2;
+    // Added to the acceleration of b1, subtracted from that of b2.
+    Vector<Acceleration, Frame> zonal2_on_b1;
+    Vector<Acceleration, Frame> zonal2_on_b2;
+  };
+  // Indexed by |PairIndex|.
+  mutable std::vector<PairwiseAccelerations> pairwise_accelerations_;
+  mutable std::vector<PairwiseZonalAccelerations>
+      pairwise_zonal_accelerations_;
+  int max_workers_ = 1;
+  // Null if |max_workers_ == 1|.
+  std::unique_ptr<ThreadPool> thread_pool_;
+  int max_reanimation_workers_ =
+      std::max<int>(1, std::thread::hardware_concurrency());
+  // Null until the first reanimation after |set_max_reanimation_workers|.
+  // Shared with the pending reanimation, if any, which keeps it alive if it is
+  // replaced.
+  std::shared_ptr<ThreadPool> reanimation_thread_pool_;
+
+  // Held while integrating the massive bodies and while accessing |instance_|,
+  // the checkpoints, |last_severe_integration_status_| or the reanimation
+  // threads, except during construction and deserialization.
+  mutable std::mutex lock_;
+
   Status last_severe_integration_status_;
 
+  // The reanimation started by |RequestReanimation|, if any.  Declared after
+  // the members used by the computation, so that its destruction waits for the
+  // computation before they are destroyed.
+  std::future<std::vector<Reanimation>> pending_reanimations_;
+
 #if defined(WE_LOVE_228)
   // https://m.popkey.co/6bee24/6GJWk.gif.
   std::experimental::optional<typename NewtonianMotionEquation::SystemState>
@@ -4,8 +4,14 @@
 #include "physics/ephemeris.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <limits>
+#include <random>
 #include <set>
 #include <vector>
 
@@ -18,12 +24,17 @@
 #include "integrators/integrators.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "numerics/hermite3.hpp"
+#include "physics/apsides.hpp"
 #include "physics/continuous_trajectory.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 
+#if PRINCIPIA_USE_SSE2
+#include <immintrin.h>
+#endif
+
 namespace principia {
 namespace physics {
 namespace internal_ephemeris {
@@ -36,20 +47,19 @@ using geometry::Displacement;
 using geometry::InnerProduct;
 using geometry::Position;
 using geometry::R3Element;
-using geometry::Sign;
 using geometry::Velocity;
 using integrators::Integrator;
 using integrators::IntegrationProblem;
-using numerics::Bisect;
 using numerics::DoublePrecision;
 using numerics::Hermite3;
+using numerics::ЧебышёвSeriesBlock;
 using quantities::Abs;
 using quantities::Exponentiation;
 using quantities::GravitationalParameter;
 using quantities::Quotient;
+using quantities::SIUnit;
 using quantities::Square;
 using quantities::Time;
-using quantities::Variation;
 using quantities::si::Day;
 using quantities::si::Second;
 using ::std::placeholders::_1;
@@ -58,6 +68,29 @@ using ::std::placeholders::_3;
 
 Time const max_time_between_checkpoints = 180 * Day;
 
+// When the massive bodies are integrated in parallel, each computation is split
+// into that many tiles per worker, so that the load is balanced even though the
+// tiles don't have exactly the same cost.
+int const tiles_per_worker = 4;
+// The pairs of bodies are split into tiles of at most about that many pairs, so
+// that the contributions computed by a task fit in the L2 cache.
+std::size_t const max_pairs_per_tile = 1 << 12;
+
+// The header of a series file, which is followed by the
+// |ЧебышёвSeriesBlock|s of all the trajectories.  The size of the header
+// preserves the alignment of the blocks.
+struct alignas(64) SeriesFileHeader final {
+  char magic[16];
+  std::int32_t version;
+  std::int32_t block_size;
+  std::uint64_t identifier;
+  std::int64_t number_of_blocks;
+};
+
+char const series_file_magic[sizeof(SeriesFileHeader::magic)] =
+    "PrincipiaSeries";
+std::int32_t const series_file_version = 1;
+
 // If j is a unit vector along the axis of rotation, and r a vector from the
 // center of |body| to some point in space, the acceleration computed here is:
 //
@@ -92,6 +125,238 @@ Order2ZonalAcceleration(OblateBody<Frame> const& body,
   return axis_effect + radial_effect;
 }
 
+// Accumulates in |ax|, |ay| and |az| the mutual accelerations of the |n|
+// spherical bodies whose gravitational parameters and coordinates are given by
+// |μ|, |x|, |y| and |z|.  All the values are in SI units.  The pairs are
+// visited in the same order and the same floating-point operations are
+// performed as in
+// |Ephemeris::ComputeGravitationalAccelerationByMassiveBodyOnMassiveBodies|: the
+// vector lanes handle consecutive values of b2, and their contributions to the
+// acceleration of b1 are subtracted one at a time, so that the result is
+// bit-for-bit identical to that of the scalar loop.
+inline void ComputeMutualAccelerationsOfSphericalBodies(
+    std::size_t const n,
+    double const* const μ,
+    double const* const x,
+    double const* const y,
+    double const* const z,
+    double* const ax,
+    double* const ay,
+    double* const az) {
+  for (std::size_t b1 = 0; b1 < n; ++b1) {
+    double const μ1 = μ[b1];
+    double const x1 = x[b1];
+    double const y1 = y[b1];
+    double const z1 = z[b1];
+    double ax1 = ax[b1];
+    double ay1 = ay[b1];
+    double az1 = az[b1];
+    std::size_t b2 = b1 + 1;
+#if PRINCIPIA_USE_AVX
+    {
+      __m256d const μ1_4 = _mm256_set1_pd(μ1);
+      __m256d const x1_4 = _mm256_set1_pd(x1);
+      __m256d const y1_4 = _mm256_set1_pd(y1);
+      __m256d const z1_4 = _mm256_set1_pd(z1);
+      for (; b2 + 4 <= n; b2 += 4) {
+        __m256d const Δx = _mm256_sub_pd(x1_4, _mm256_loadu_pd(&x[b2]));
+        __m256d const Δy = _mm256_sub_pd(y1_4, _mm256_loadu_pd(&y[b2]));
+        __m256d const Δz = _mm256_sub_pd(z1_4, _mm256_loadu_pd(&z[b2]));
+        __m256d const Δq_squared =
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(Δx, Δx),
+                                        _mm256_mul_pd(Δy, Δy)),
+                          _mm256_mul_pd(Δz, Δz));
+        __m256d const one_over_Δq_cubed =
+            _mm256_div_pd(_mm256_sqrt_pd(Δq_squared),
+                          _mm256_mul_pd(Δq_squared, Δq_squared));
+
+        __m256d const μ1_over_Δq_cubed =
+            _mm256_mul_pd(μ1_4, one_over_Δq_cubed);
+        _mm256_storeu_pd(&ax[b2],
+                         _mm256_add_pd(_mm256_loadu_pd(&ax[b2]),
+                                       _mm256_mul_pd(Δx, μ1_over_Δq_cubed)));
+        _mm256_storeu_pd(&ay[b2],
+                         _mm256_add_pd(_mm256_loadu_pd(&ay[b2]),
+                                       _mm256_mul_pd(Δy, μ1_over_Δq_cubed)));
+        _mm256_storeu_pd(&az[b2],
+                         _mm256_add_pd(_mm256_loadu_pd(&az[b2]),
+                                       _mm256_mul_pd(Δz, μ1_over_Δq_cubed)));
+
+        __m256d const μ2_over_Δq_cubed =
+            _mm256_mul_pd(_mm256_loadu_pd(&μ[b2]), one_over_Δq_cubed);
+        alignas(32) double reaction_x[4];
+        alignas(32) double reaction_y[4];
+        alignas(32) double reaction_z[4];
+        _mm256_store_pd(reaction_x, _mm256_mul_pd(Δx, μ2_over_Δq_cubed));
+        _mm256_store_pd(reaction_y, _mm256_mul_pd(Δy, μ2_over_Δq_cubed));
+        _mm256_store_pd(reaction_z, _mm256_mul_pd(Δz, μ2_over_Δq_cubed));
+        for (int i = 0; i < 4; ++i) {
+          ax1 -= reaction_x[i];
+          ay1 -= reaction_y[i];
+          az1 -= reaction_z[i];
+        }
+      }
+    }
+#endif
+#if PRINCIPIA_USE_SSE2
+    {
+      __m128d const μ1_2 = _mm_set1_pd(μ1);
+      __m128d const x1_2 = _mm_set1_pd(x1);
+      __m128d const y1_2 = _mm_set1_pd(y1);
+      __m128d const z1_2 = _mm_set1_pd(z1);
+      for (; b2 + 2 <= n; b2 += 2) {
+        __m128d const Δx = _mm_sub_pd(x1_2, _mm_loadu_pd(&x[b2]));
+        __m128d const Δy = _mm_sub_pd(y1_2, _mm_loadu_pd(&y[b2]));
+        __m128d const Δz = _mm_sub_pd(z1_2, _mm_loadu_pd(&z[b2]));
+        __m128d const Δq_squared =
+            _mm_add_pd(_mm_add_pd(_mm_mul_pd(Δx, Δx), _mm_mul_pd(Δy, Δy)),
+                       _mm_mul_pd(Δz, Δz));
+        __m128d const one_over_Δq_cubed =
+            _mm_div_pd(_mm_sqrt_pd(Δq_squared),
+                       _mm_mul_pd(Δq_squared, Δq_squared));
+
+        __m128d const μ1_over_Δq_cubed = _mm_mul_pd(μ1_2, one_over_Δq_cubed);
+        _mm_storeu_pd(&ax[b2],
+                      _mm_add_pd(_mm_loadu_pd(&ax[b2]),
+                                 _mm_mul_pd(Δx, μ1_over_Δq_cubed)));
+        _mm_storeu_pd(&ay[b2],
+                      _mm_add_pd(_mm_loadu_pd(&ay[b2]),
+                                 _mm_mul_pd(Δy, μ1_over_Δq_cubed)));
+        _mm_storeu_pd(&az[b2],
+                      _mm_add_pd(_mm_loadu_pd(&az[b2]),
+                                 _mm_mul_pd(Δz, μ1_over_Δq_cubed)));
+
+        __m128d const μ2_over_Δq_cubed =
+            _mm_mul_pd(_mm_loadu_pd(&μ[b2]), one_over_Δq_cubed);
+        __m128d const reaction_x = _mm_mul_pd(Δx, μ2_over_Δq_cubed);
+        __m128d const reaction_y = _mm_mul_pd(Δy, μ2_over_Δq_cubed);
+        __m128d const reaction_z = _mm_mul_pd(Δz, μ2_over_Δq_cubed);
+        ax1 -= _mm_cvtsd_f64(reaction_x);
+        ay1 -= _mm_cvtsd_f64(reaction_y);
+        az1 -= _mm_cvtsd_f64(reaction_z);
+        ax1 -= _mm_cvtsd_f64(_mm_unpackhi_pd(reaction_x, reaction_x));
+        ay1 -= _mm_cvtsd_f64(_mm_unpackhi_pd(reaction_y, reaction_y));
+        az1 -= _mm_cvtsd_f64(_mm_unpackhi_pd(reaction_z, reaction_z));
+      }
+    }
+#endif
+    for (; b2 < n; ++b2) {
+      double const Δx = x1 - x[b2];
+      double const Δy = y1 - y[b2];
+      double const Δz = z1 - z[b2];
+      double const Δq_squared = Δx * Δx + Δy * Δy + Δz * Δz;
+      double const one_over_Δq_cubed =
+          std::sqrt(Δq_squared) / (Δq_squared * Δq_squared);
+
+      double const μ1_over_Δq_cubed = μ1 * one_over_Δq_cubed;
+      ax[b2] += Δx * μ1_over_Δq_cubed;
+      ay[b2] += Δy * μ1_over_Δq_cubed;
+      az[b2] += Δz * μ1_over_Δq_cubed;
+
+      double const μ2_over_Δq_cubed = μ[b2] * one_over_Δq_cubed;
+      ax1 -= Δx * μ2_over_Δq_cubed;
+      ay1 -= Δy * μ2_over_Δq_cubed;
+      az1 -= Δz * μ2_over_Δq_cubed;
+    }
+    ax[b1] = ax1;
+    ay[b1] = ay1;
+    az[b1] = az1;
+  }
+}
+
+// Accumulates in |ax|, |ay| and |az| the accelerations exerted by a spherical
+// body having gravitational parameter |μ1| and coordinates |x1|, |y1|, |z1| on
+// the |n| massless bodies whose coordinates are given by |x|, |y| and |z|.  All
+// the values are in SI units.  The same floating-point operations are
+// performed as in
+// |Ephemeris::ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies|,
+// so that the result is bit-for-bit identical to that of the scalar loop.
+inline void ComputeAccelerationsBySphericalBodyOnMasslessBodies(
+    double const μ1,
+    double const x1,
+    double const y1,
+    double const z1,
+    std::size_t const n,
+    double const* const x,
+    double const* const y,
+    double const* const z,
+    double* const ax,
+    double* const ay,
+    double* const az) {
+  std::size_t b2 = 0;
+#if PRINCIPIA_USE_AVX
+  {
+    __m256d const μ1_4 = _mm256_set1_pd(μ1);
+    __m256d const x1_4 = _mm256_set1_pd(x1);
+    __m256d const y1_4 = _mm256_set1_pd(y1);
+    __m256d const z1_4 = _mm256_set1_pd(z1);
+    for (; b2 + 4 <= n; b2 += 4) {
+      __m256d const Δx = _mm256_sub_pd(x1_4, _mm256_loadu_pd(&x[b2]));
+      __m256d const Δy = _mm256_sub_pd(y1_4, _mm256_loadu_pd(&y[b2]));
+      __m256d const Δz = _mm256_sub_pd(z1_4, _mm256_loadu_pd(&z[b2]));
+      __m256d const Δq_squared =
+          _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(Δx, Δx),
+                                      _mm256_mul_pd(Δy, Δy)),
+                        _mm256_mul_pd(Δz, Δz));
+      __m256d const one_over_Δq_cubed =
+          _mm256_div_pd(_mm256_sqrt_pd(Δq_squared),
+                        _mm256_mul_pd(Δq_squared, Δq_squared));
+      __m256d const μ1_over_Δq_cubed = _mm256_mul_pd(μ1_4, one_over_Δq_cubed);
+      _mm256_storeu_pd(&ax[b2],
+                       _mm256_add_pd(_mm256_loadu_pd(&ax[b2]),
+                                     _mm256_mul_pd(Δx, μ1_over_Δq_cubed)));
+      _mm256_storeu_pd(&ay[b2],
+                       _mm256_add_pd(_mm256_loadu_pd(&ay[b2]),
+                                     _mm256_mul_pd(Δy, μ1_over_Δq_cubed)));
+      _mm256_storeu_pd(&az[b2],
+                       _mm256_add_pd(_mm256_loadu_pd(&az[b2]),
+                                     _mm256_mul_pd(Δz, μ1_over_Δq_cubed)));
+    }
+  }
+#endif
+#if PRINCIPIA_USE_SSE2
+  {
+    __m128d const μ1_2 = _mm_set1_pd(μ1);
+    __m128d const x1_2 = _mm_set1_pd(x1);
+    __m128d const y1_2 = _mm_set1_pd(y1);
+    __m128d const z1_2 = _mm_set1_pd(z1);
+    for (; b2 + 2 <= n; b2 += 2) {
+      __m128d const Δx = _mm_sub_pd(x1_2, _mm_loadu_pd(&x[b2]));
+      __m128d const Δy = _mm_sub_pd(y1_2, _mm_loadu_pd(&y[b2]));
+      __m128d const Δz = _mm_sub_pd(z1_2, _mm_loadu_pd(&z[b2]));
+      __m128d const Δq_squared =
+          _mm_add_pd(_mm_add_pd(_mm_mul_pd(Δx, Δx), _mm_mul_pd(Δy, Δy)),
+                     _mm_mul_pd(Δz, Δz));
+      __m128d const one_over_Δq_cubed =
+          _mm_div_pd(_mm_sqrt_pd(Δq_squared),
+                     _mm_mul_pd(Δq_squared, Δq_squared));
+      __m128d const μ1_over_Δq_cubed = _mm_mul_pd(μ1_2, one_over_Δq_cubed);
+      _mm_storeu_pd(&ax[b2],
+                    _mm_add_pd(_mm_loadu_pd(&ax[b2]),
+                               _mm_mul_pd(Δx, μ1_over_Δq_cubed)));
+      _mm_storeu_pd(&ay[b2],
+                    _mm_add_pd(_mm_loadu_pd(&ay[b2]),
+                               _mm_mul_pd(Δy, μ1_over_Δq_cubed)));
+      _mm_storeu_pd(&az[b2],
+                    _mm_add_pd(_mm_loadu_pd(&az[b2]),
+                               _mm_mul_pd(Δz, μ1_over_Δq_cubed)));
+    }
+  }
+#endif
+  for (; b2 < n; ++b2) {
+    double const Δx = x1 - x[b2];
+    double const Δy = y1 - y[b2];
+    double const Δz = z1 - z[b2];
+    double const Δq_squared = Δx * Δx + Δy * Δy + Δz * Δz;
+    double const one_over_Δq_cubed =
+        std::sqrt(Δq_squared) / (Δq_squared * Δq_squared);
+    double const μ1_over_Δq_cubed = μ1 * one_over_Δq_cubed;
+    ax[b2] += Δx * μ1_over_Δq_cubed;
+    ay[b2] += Δy * μ1_over_Δq_cubed;
+    az[b2] += Δz * μ1_over_Δq_cubed;
+  }
+}
+
 template<typename Frame>
 Ephemeris<Frame>::AdaptiveStepParameters::AdaptiveStepParameters(
     AdaptiveStepSizeIntegrator<NewtonianMotionEquation> const& integrator,
@@ -265,11 +530,27 @@ Ephemeris<Frame>::Ephemeris(
     }
   }
 
+  for (int b = number_of_oblate_bodies_; b < bodies_.size(); ++b) {
+    spherical_bodies_buffers_.μ.push_back(
+        bodies_[b]->gravitational_parameter() /
+        SIUnit<GravitationalParameter>());
+  }
+  spherical_bodies_buffers_.x.resize(number_of_spherical_bodies_);
+  spherical_bodies_buffers_.y.resize(number_of_spherical_bodies_);
+  spherical_bodies_buffers_.z.resize(number_of_spherical_bodies_);
+  spherical_bodies_buffers_.ax.resize(number_of_spherical_bodies_);
+  spherical_bodies_buffers_.ay.resize(number_of_spherical_bodies_);
+  spherical_bodies_buffers_.az.resize(number_of_spherical_bodies_);
+
   instance_ = parameters.integrator_->NewInstance(
       problem,
       /*append_state=*/std::bind(
           &Ephemeris::AppendMassiveBodiesState, this, _1),
       parameters.step_);
+
+  // The first checkpoint is only taken once series have been fitted, so keep
+  // the initial state to be able to recompute the series before it.
+  dormant_checkpoints_.push_back(GetCheckpoint());
 }
 
 template<typename Frame>
@@ -302,6 +583,7 @@ Instant Ephemeris<Frame>::t_min() const {
     auto const& trajectory = pair.second;
     t_min = std::max(t_min, trajectory->t_min());
   }
+  std::lock_guard<std::mutex> l(lock_);
   CHECK(checkpoints_.empty() ||
         checkpoints_.front().instance->time().value >= t_min);
   return t_min;
@@ -328,11 +610,40 @@ Ephemeris<Frame>::planetary_integrator() const {
 
 template<typename Frame>
 Status Ephemeris<Frame>::last_severe_integration_status() const {
+  std::lock_guard<std::mutex> l(lock_);
   return last_severe_integration_status_;
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::set_vectorized_gravity(bool const vectorized_gravity) {
+  vectorized_gravity_ = vectorized_gravity;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::set_max_workers(int const max_workers) {
+  CHECK_LE(1, max_workers);
+  std::lock_guard<std::mutex> l(lock_);
+  max_workers_ = max_workers;
+  if (max_workers_ > 1) {
+    thread_pool_ = std::make_unique<ThreadPool>(max_workers_);
+  } else {
+    thread_pool_.reset();
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::set_max_reanimation_workers(int const max_workers) {
+  CHECK_LE(1, max_workers);
+  std::lock_guard<std::mutex> l(lock_);
+  max_reanimation_workers_ = max_workers;
+  reanimation_thread_pool_.reset();
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ForgetBefore(Instant const& t) {
+  // The pending reanimation, if any, must end at the current |t_min()|.
+  FinishReanimation();
+  std::lock_guard<std::mutex> l(lock_);
   auto it = std::upper_bound(
                 checkpoints_.begin(), checkpoints_.end(), t,
                 [](Instant const& left, Checkpoint const& right) {
@@ -346,11 +657,72 @@ void Ephemeris<Frame>::ForgetBefore(Instant const& t) {
     ContinuousTrajectory<Frame>& trajectory = *pair.second;
     trajectory.ForgetBefore(t);
   }
+
+  // Keep the last checkpoint before |t|, from which the series after |t| may
+  // be recomputed, and forget the older ones.
+  if (it == checkpoints_.begin()) {
+    auto const dormant_it = std::upper_bound(
+        dormant_checkpoints_.begin(), dormant_checkpoints_.end(), t,
+        [](Instant const& left, Checkpoint const& right) {
+          return left < right.instance->time().value;
+        });
+    if (dormant_it != dormant_checkpoints_.begin()) {
+      dormant_checkpoints_.erase(dormant_checkpoints_.begin(),
+                                 std::prev(dormant_it));
+    }
+  } else {
+    dormant_checkpoints_.clear();
+    dormant_checkpoints_.push_back(std::move(*std::prev(it)));
+  }
   checkpoints_.erase(checkpoints_.begin(), it);
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::Reanimate(Instant const& desired_t_min) {
+  FinishReanimation();
+  if (t_min() <= desired_t_min) {
+    return;
+  }
+  std::vector<Reanimation> reanimations = PrepareReanimations(desired_t_min);
+  ComputeReanimations(reanimations, *ReanimationThreadPool());
+  SpliceReanimations(reanimations);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::RequestReanimation(Instant const& desired_t_min) {
+  FinishReanimation();
+  if (t_min() <= desired_t_min) {
+    return;
+  }
+  std::vector<Reanimation> reanimations = PrepareReanimations(desired_t_min);
+  if (reanimations.empty()) {
+    return;
+  }
+  pending_reanimations_ = std::async(
+      std::launch::async,
+      [this,
+       reanimations = std::move(reanimations),
+       thread_pool = ReanimationThreadPool()]() mutable {
+        ComputeReanimations(reanimations, *thread_pool);
+        return std::move(reanimations);
+      });
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::PollReanimation(Instant const& desired_t_min) {
+  if (pending_reanimations_.valid()) {
+    if (pending_reanimations_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return;
+    }
+    FinishReanimation();
+  }
+  RequestReanimation(desired_t_min);
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::Prolong(Instant const& t) {
+  std::lock_guard<std::mutex> l(lock_);
   // Note that |t| may be before the last time that we integrated and still
   // after |t_max()|.  In this case we want to make sure that the integrator
   // makes progress.
@@ -370,6 +742,21 @@ void Ephemeris<Frame>::Prolong(Instant const& t) {
   }
 }
 
+template<typename Frame>
+bool Ephemeris<Frame>::ProlongTowards(Instant const& t,
+                                      std::int64_t const max_steps) {
+  CHECK_LT(0, max_steps);
+  std::lock_guard<std::mutex> l(lock_);
+  if (t_max() < t) {
+    // As in |Prolong|, make sure that the integrator makes progress even if
+    // |t| is before the last time that we integrated.
+    Instant const last_time = instance_->time().value;
+    instance_->Solve(std::min(std::max(t, last_time + parameters_.step_),
+                              last_time + max_steps * parameters_.step_));
+  }
+  return t_max() >= t;
+}
+
 template<typename Frame>
 not_null<std::unique_ptr<typename Integrator<
     typename Ephemeris<Frame>::NewtonianMotionEquation>::Instance>>
@@ -427,6 +814,45 @@ bool Ephemeris<Frame>::FlowWithAdaptiveStep(
     AdaptiveStepParameters const& parameters,
     std::int64_t const max_ephemeris_steps,
     bool const last_point_only) {
+  return FlowWithAdaptiveStep(trajectory,
+                              /*dense_trajectory=*/nullptr,
+                              std::move(intrinsic_acceleration),
+                              t,
+                              parameters,
+                              max_ephemeris_steps,
+                              last_point_only);
+}
+
+template<typename Frame>
+bool Ephemeris<Frame>::FlowWithDenseOutput(
+    not_null<DiscreteTrajectory<Frame>*> const trajectory,
+    not_null<DenseTrajectory<Frame>*> const dense_trajectory,
+    IntrinsicAcceleration intrinsic_acceleration,
+    Instant const& t,
+    AdaptiveStepParameters const& parameters,
+    std::int64_t const max_ephemeris_steps,
+    bool const last_point_only) {
+  CHECK(dense_trajectory->empty() ||
+        dense_trajectory->t_max() == trajectory->last().time())
+      << dense_trajectory->t_max() << " " << trajectory->last().time();
+  return FlowWithAdaptiveStep(trajectory,
+                              dense_trajectory,
+                              std::move(intrinsic_acceleration),
+                              t,
+                              parameters,
+                              max_ephemeris_steps,
+                              last_point_only);
+}
+
+template<typename Frame>
+bool Ephemeris<Frame>::FlowWithAdaptiveStep(
+    not_null<DiscreteTrajectory<Frame>*> const trajectory,
+    DenseTrajectory<Frame>* const dense_trajectory,
+    IntrinsicAcceleration intrinsic_acceleration,
+    Instant const& t,
+    AdaptiveStepParameters const& parameters,
+    std::int64_t const max_ephemeris_steps,
+    bool const last_point_only) {
   Instant const& trajectory_last_time = trajectory->last().time();
   if (trajectory_last_time == t) {
     return true;
@@ -438,37 +864,48 @@ bool Ephemeris<Frame>::FlowWithAdaptiveStep(
       {std::move(intrinsic_acceleration)};
   // The |min| is here to prevent us from spending too much time computing the
   // ephemeris.  The |max| is here to ensure that we always try to integrate
-  // forward.  We use |last_state_.time.value| because this is always finite,
-  // contrary to |t_max()|, which is -∞ when |empty()|.
+  // forward.  We use the time of |instance_| because it is always finite,
+  // contrary to |t_max()|, which is -∞ when |empty()|.  It is read under
+  // |lock_| because |Prolong| may be advancing |instance_| on another thread.
+  Instant instance_time;
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    instance_time = instance_->time().value;
+  }
   Instant const t_final =
-      std::min(std::max(instance_->time().value +
+      std::min(std::max(instance_time +
                             max_ephemeris_steps * parameters_.step(),
                         trajectory_last_time + parameters_.step()),
                t);
   Prolong(t_final);
 
-  IntegrationProblem<NewtonianMotionEquation> problem;
-  problem.equation = {
-      std::bind(&Ephemeris::ComputeMasslessBodiesTotalAccelerations,
-                this,
-                std::cref(intrinsic_accelerations),
-                _1, _2, _3)};
+  // A lambda rather than a |std::function|, so that the integrator may inline
+  // it.
+  auto const compute_acceleration =
+      [this, &intrinsic_accelerations](
+          Instant const& time,
+          std::vector<Position<Frame>> const& positions,
+          std::vector<Vector<Acceleration, Frame>>& accelerations) {
+        ComputeMasslessBodiesTotalAccelerations(
+            intrinsic_accelerations, time, positions, accelerations);
+      };
 
   auto const trajectory_last = trajectory->last();
   auto const last_degrees_of_freedom = trajectory_last.degrees_of_freedom();
-  problem.initial_state = {{last_degrees_of_freedom.position()},
-                           {last_degrees_of_freedom.velocity()},
-                           trajectory_last.time()};
+  typename NewtonianMotionEquation::SystemState const initial_state(
+      {last_degrees_of_freedom.position()},
+      {last_degrees_of_freedom.velocity()},
+      trajectory_last.time());
 
   typename AdaptiveStepSizeIntegrator<NewtonianMotionEquation>::Parameters const
       integrator_parameters(
-          /*first_time_step=*/t_final - problem.initial_state.time.value,
+          /*first_time_step=*/t_final - initial_state.time.value,
           /*safety_factor=*/0.9,
           parameters.max_steps_,
           /*last_step_is_exact=*/true);
   CHECK_GT(integrator_parameters.first_time_step, 0 * Second)
       << "Flow back to the future: " << t_final
-      << " <= " << problem.initial_state.time.value;
+      << " <= " << initial_state.time.value;
   auto const tolerance_to_error_ratio =
       std::bind(&Ephemeris<Frame>::ToleranceToErrorRatio,
                 std::cref(parameters.length_integration_tolerance_),
@@ -488,11 +925,23 @@ bool Ephemeris<Frame>::FlowWithAdaptiveStep(
         &Ephemeris::AppendMasslessBodiesState, _1, std::cref(trajectories));
   }
 
+  typename AdaptiveStepSizeIntegrator<NewtonianMotionEquation>::DenseOutput
+      dense_output;
+  if (dense_trajectory != nullptr) {
+    dense_output = [dense_trajectory](
+        std::vector<typename DenseTrajectory<Frame>::Interpolant> const&
+            interpolants) {
+      dense_trajectory->Append(interpolants[0]);
+    };
+  }
+
   auto const instance =
-      parameters.integrator_->NewInstance(problem,
-                                          append_state,
-                                          tolerance_to_error_ratio,
-                                          integrator_parameters);
+      parameters.integrator_->NewSpecializedInstance(initial_state,
+                                                     compute_acceleration,
+                                                     append_state,
+                                                     tolerance_to_error_ratio,
+                                                     integrator_parameters,
+                                                     dense_output);
   auto const status = instance->Solve(t_final);
 
   if (last_point_only) {
@@ -539,6 +988,25 @@ ComputeGravitationalAccelerationOnMasslessBody(
   return accelerations[0];
 }
 
+template<typename Frame>
+std::vector<Vector<Acceleration, Frame>> Ephemeris<Frame>::
+ComputeGravitationalAccelerationsOnMasslessBodies(
+    std::vector<Position<Frame>> const& positions,
+    Instant const& t) const {
+  std::vector<Vector<Acceleration, Frame>> accelerations(positions.size());
+  ComputeMasslessBodiesGravitationalAccelerations(t, positions, accelerations);
+  return accelerations;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::ComputeGravitationalAccelerationsOnMasslessBodies(
+    std::vector<Position<Frame>> const& positions,
+    Instant const& t,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  accelerations.resize(positions.size());
+  ComputeMasslessBodiesGravitationalAccelerations(t, positions, accelerations);
+}
+
 template<typename Frame>
 Vector<Acceleration, Frame> Ephemeris<Frame>::
 ComputeGravitationalAccelerationOnMasslessBody(
@@ -624,59 +1092,12 @@ void Ephemeris<Frame>::ComputeApsides(not_null<MassiveBody const*> const body1,
                                       DiscreteTrajectory<Frame>& periapsides1,
                                       DiscreteTrajectory<Frame>& apoapsides2,
                                       DiscreteTrajectory<Frame>& periapsides2) {
-  not_null<ContinuousTrajectory<Frame> const*> const body1_trajectory =
-      trajectory(body1);
-  not_null<ContinuousTrajectory<Frame> const*> const body2_trajectory =
-      trajectory(body2);
-
-  // Computes the derivative of the squared distance between |body1| and |body2|
-  // at time |t|.
-  auto const evaluate_square_distance_derivative =
-      [body1_trajectory, body2_trajectory](
-          Instant const& t) -> Variation<Square<Length>> {
-    DegreesOfFreedom<Frame> const body1_degrees_of_freedom =
-        body1_trajectory->EvaluateDegreesOfFreedom(t);
-    DegreesOfFreedom<Frame> const body2_degrees_of_freedom =
-        body2_trajectory->EvaluateDegreesOfFreedom(t);
-    RelativeDegreesOfFreedom<Frame> const relative =
-        body1_degrees_of_freedom - body2_degrees_of_freedom;
-    return 2.0 * InnerProduct(relative.displacement(), relative.velocity());
-  };
-
-  std::experimental::optional<Instant> previous_time;
-  std::experimental::optional<Variation<Square<Length>>>
-      previous_squared_distance_derivative;
-
-  for (Instant time = t_min(); time <= t_max(); time += parameters_.step()) {
-    Variation<Square<Length>> const squared_distance_derivative =
-        evaluate_square_distance_derivative(time);
-    if (previous_squared_distance_derivative &&
-        Sign(squared_distance_derivative) !=
-            Sign(*previous_squared_distance_derivative)) {
-      CHECK(previous_time);
-
-      // The derivative of |squared_distance| changed sign.  Find its zero by
-      // bisection, this is the time of the apsis.  Then compute the apsis and
-      // append it to one of the output trajectories.
-      Instant const apsis_time = Bisect(evaluate_square_distance_derivative,
-                                        *previous_time,
-                                        time);
-      DegreesOfFreedom<Frame> const apsis1_degrees_of_freedom =
-          body1_trajectory->EvaluateDegreesOfFreedom(apsis_time);
-      DegreesOfFreedom<Frame> const apsis2_degrees_of_freedom =
-          body2_trajectory->EvaluateDegreesOfFreedom(apsis_time);
-      if (Sign(squared_distance_derivative).Negative()) {
-        apoapsides1.Append(apsis_time, apsis1_degrees_of_freedom);
-        apoapsides2.Append(apsis_time, apsis2_degrees_of_freedom);
-      } else {
-        periapsides1.Append(apsis_time, apsis1_degrees_of_freedom);
-        periapsides2.Append(apsis_time, apsis2_degrees_of_freedom);
-      }
-    }
-
-    previous_time = time;
-    previous_squared_distance_derivative = squared_distance_derivative;
-  }
+  physics::ComputeApsides(*trajectory(body1),
+                          *trajectory(body2),
+                          apoapsides1,
+                          periapsides1,
+                          apoapsides2,
+                          periapsides2);
 }
 
 template<typename Frame>
@@ -694,7 +1115,124 @@ not_null<MassiveBody const*> Ephemeris<Frame>::body_for_serialization_index(
 template<typename Frame>
 void Ephemeris<Frame>::WriteToMessage(
     not_null<serialization::Ephemeris*> const message) const {
+  WriteToMessage(message,
+                 /*series_file=*/nullptr,
+                 /*series_file_identifier=*/0);
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
+    serialization::Ephemeris const& message) {
+  CHECK(!message.has_series_file_identifier())
+      << "The series file is needed to read this ephemeris";
+  return ReadFromMessage(message, std::shared_ptr<MappedFile const>());
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::WriteToMessage(
+    not_null<serialization::Ephemeris*> const message,
+    std::experimental::filesystem::path const& series_file) const {
+  // The identifier ties the file to |message|, it doesn't need to be
+  // cryptographically random.
+  std::random_device random_device;
+  std::uint64_t const identifier =
+      (static_cast<std::uint64_t>(random_device()) << 32) | random_device();
+
+  std::ofstream stream(series_file, std::ios::binary | std::ios::trunc);
+  CHECK(stream.good()) << series_file;
+  SeriesFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, series_file_magic, sizeof(header.magic));
+  header.version = series_file_version;
+  header.block_size = sizeof(ЧебышёвSeriesBlock);
+  header.identifier = identifier;
+  // The header is written again at the end when the number of blocks is
+  // known.
+  stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  header.number_of_blocks = WriteToMessage(message, &stream, identifier);
+  stream.seekp(0);
+  stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  stream.close();
+  CHECK(stream.good()) << series_file;
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
+    serialization::Ephemeris const& message,
+    std::experimental::filesystem::path const& series_file) {
+  if (!message.has_series_file_identifier()) {
+    return ReadFromMessage(message);
+  }
+  auto const mapped_file = std::make_shared<MappedFile const>(series_file);
+  CHECK_LE(sizeof(SeriesFileHeader), mapped_file->size()) << series_file;
+  SeriesFileHeader const& header =
+      *reinterpret_cast<SeriesFileHeader const*>(mapped_file->data());
+  CHECK_EQ(0, std::memcmp(header.magic,
+                          series_file_magic,
+                          sizeof(header.magic))) << series_file;
+  CHECK_EQ(series_file_version, header.version) << series_file;
+  CHECK_EQ(sizeof(ЧебышёвSeriesBlock), header.block_size) << series_file;
+  CHECK_EQ(message.series_file_identifier(), header.identifier)
+      << series_file << " does not belong to this ephemeris";
+  CHECK_EQ(sizeof(SeriesFileHeader) +
+               header.number_of_blocks * sizeof(ЧебышёвSeriesBlock),
+           mapped_file->size()) << series_file;
+  return ReadFromMessage(message, mapped_file);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::WriteCheckpointsToMessage(
+    not_null<serialization::Ephemeris*> const message,
+    Instant const& desired_t_min) const {
+  LOG(INFO) << __FUNCTION__;
+  std::lock_guard<std::mutex> l(lock_);
+  for (auto const& unowned_body : unowned_bodies_) {
+    unowned_body->WriteToMessage(message->add_body());
+  }
+  // The state at the end of the integration.
+  for (auto const& trajectory : trajectories_) {
+    trajectory->WriteCheckpointToMessage(message->add_trajectory(),
+                                         trajectory->GetCheckpoint());
+  }
+  instance_->WriteToMessage(message->mutable_instance());
+  t_max().WriteToMessage(message->mutable_t_max());
+
+  auto const write_checkpoint = [this, message](Checkpoint const& checkpoint) {
+    // A checkpoint at the end of the integration is redundant with the state
+    // written above.
+    if (checkpoint.instance->time().value >= instance_->time().value) {
+      return;
+    }
+    auto* const checkpoint_message = message->add_checkpoint();
+    checkpoint.instance->WriteToMessage(
+        checkpoint_message->mutable_instance());
+    CHECK_EQ(trajectories_.size(), checkpoint.checkpoints.size());
+    for (int i = 0; i < trajectories_.size(); ++i) {
+      trajectories_[i]->WriteCheckpointToMessage(
+          checkpoint_message->add_trajectory(), checkpoint.checkpoints[i]);
+    }
+  };
+  for (auto const& checkpoint : dormant_checkpoints_) {
+    write_checkpoint(checkpoint);
+  }
+  for (auto const& checkpoint : checkpoints_) {
+    write_checkpoint(checkpoint);
+  }
+  desired_t_min.WriteToMessage(message->mutable_desired_t_min());
+
+  parameters_.WriteToMessage(message->mutable_fixed_step_parameters());
+  fitting_tolerance_.WriteToMessage(message->mutable_fitting_tolerance());
+  LOG(INFO) << NAMED(message->SpaceUsed());
+  LOG(INFO) << NAMED(message->ByteSize());
+}
+
+template<typename Frame>
+std::int64_t Ephemeris<Frame>::WriteToMessage(
+    not_null<serialization::Ephemeris*> const message,
+    std::ostream* const series_file,
+    std::uint64_t const series_file_identifier) const {
   LOG(INFO) << __FUNCTION__;
+  std::lock_guard<std::mutex> l(lock_);
   // The bodies are serialized in the order in which they were given at
   // construction.
   for (auto const& unowned_body : unowned_bodies_) {
@@ -702,31 +1240,51 @@ void Ephemeris<Frame>::WriteToMessage(
   }
   // The trajectories are serialized in the order resulting from the separation
   // between oblate and spherical bodies.
+  std::int64_t number_of_blocks = 0;
+  auto const write_trajectory =
+      [message, series_file, &number_of_blocks](
+          ContinuousTrajectory<Frame> const& trajectory,
+          typename ContinuousTrajectory<Frame>::Checkpoint const& checkpoint) {
+        if (series_file == nullptr) {
+          trajectory.WriteToMessage(message->add_trajectory(), checkpoint);
+        } else {
+          number_of_blocks += trajectory.WriteToMessage(
+              message->add_trajectory(),
+              checkpoint,
+              /*first_block=*/number_of_blocks,
+              series_file);
+        }
+      };
   if (checkpoints_.empty()) {
     for (auto const& trajectory : trajectories_) {
-      trajectory->WriteToMessage(message->add_trajectory());
+      write_trajectory(*trajectory, trajectory->GetCheckpoint());
     }
     instance_->WriteToMessage(message->mutable_instance());
   } else {
     auto const& checkpoints = checkpoints_.front().checkpoints;
     CHECK_EQ(trajectories_.size(), checkpoints.size());
     for (int i = 0; i < trajectories_.size(); ++i) {
-      trajectories_[i]->WriteToMessage(message->add_trajectory(),
-                                       checkpoints[i]);
+      write_trajectory(*trajectories_[i], checkpoints[i]);
     }
     checkpoints_.front().instance->WriteToMessage(
         message->mutable_instance());
     t_max().WriteToMessage(message->mutable_t_max());
   }
+  if (series_file != nullptr) {
+    message->set_series_file_identifier(series_file_identifier);
+  }
   parameters_.WriteToMessage(message->mutable_fixed_step_parameters());
   fitting_tolerance_.WriteToMessage(message->mutable_fitting_tolerance());
   LOG(INFO) << NAMED(message->SpaceUsed());
   LOG(INFO) << NAMED(message->ByteSize());
+  LOG(INFO) << NAMED(number_of_blocks);
+  return number_of_blocks;
 }
 
 template<typename Frame>
 not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
-    serialization::Ephemeris const& message) {
+    serialization::Ephemeris const& message,
+    std::shared_ptr<MappedFile const> const& series_file) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
   for (auto const& body : message.body()) {
     bodies.push_back(MassiveBody::ReadFromMessage(body));
@@ -753,31 +1311,61 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
   equation.compute_acceleration =
       std::bind(&Ephemeris::ComputeMassiveBodiesGravitationalAccelerations,
                 ephemeris.get(), _1, _2, _3);
+  auto const append_state =
+      std::bind(&Ephemeris::AppendMassiveBodiesState, ephemeris.get(), _1);
   ephemeris->instance_ =
       FixedStepSizeIntegrator<NewtonianMotionEquation>::Instance::
-      ReadFromMessage(
-          message.instance(),
-          equation,
-          /*append_state=*/std::bind(
-              &Ephemeris::AppendMassiveBodiesState, ephemeris.get(), _1));
-
+      ReadFromMessage(message.instance(), equation, append_state);
+
+  // The size of the file has been checked against its header.
+  std::int64_t const number_of_blocks =
+      series_file == nullptr
+          ? 0
+          : (series_file->size() - sizeof(SeriesFileHeader)) /
+                sizeof(ЧебышёвSeriesBlock);
   int index = 0;
   ephemeris->bodies_to_trajectories_.clear();
   ephemeris->trajectories_.clear();
+  ephemeris->dormant_checkpoints_.clear();
   for (auto const& trajectory : message.trajectory()) {
     not_null<MassiveBody const*> const body = ephemeris->bodies_[index].get();
     not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
         deserialized_trajectory =
-            ContinuousTrajectory<Frame>::ReadFromMessage(trajectory);
+            series_file == nullptr
+                ? ContinuousTrajectory<Frame>::ReadFromMessage(trajectory)
+                : ContinuousTrajectory<Frame>::ReadFromMessage(
+                      trajectory,
+                      series_file,
+                      reinterpret_cast<ЧебышёвSeriesBlock const*>(
+                          series_file->data() + sizeof(SeriesFileHeader)),
+                      number_of_blocks);
     ephemeris->trajectories_.push_back(deserialized_trajectory.get());
     ephemeris->bodies_to_trajectories_.emplace(
         body, std::move(deserialized_trajectory));
     ++index;
   }
+  for (auto const& checkpoint_message : message.checkpoint()) {
+    Checkpoint checkpoint;
+    checkpoint.instance =
+        FixedStepSizeIntegrator<NewtonianMotionEquation>::Instance::
+            ReadFromMessage(checkpoint_message.instance(),
+                            equation,
+                            append_state);
+    for (auto const& trajectory : checkpoint_message.trajectory()) {
+      checkpoint.checkpoints.push_back(
+          ContinuousTrajectory<Frame>::ReadFromMessage(trajectory)->
+              GetCheckpoint());
+    }
+    ephemeris->dormant_checkpoints_.push_back(std::move(checkpoint));
+  }
   if (message.has_t_max()) {
     ephemeris->checkpoints_.push_back(ephemeris->GetCheckpoint());
     ephemeris->Prolong(Instant::ReadFromMessage(message.t_max()));
   }
+  if (message.has_desired_t_min()) {
+    ephemeris->RequestReanimation(
+        Instant::ReadFromMessage(message.desired_t_min()));
+  }
   return ephemeris;
 }
 
@@ -787,16 +1375,168 @@ Ephemeris<Frame>::Ephemeris(
         typename Ephemeris<Frame>::NewtonianMotionEquation> const& integrator)
     : parameters_(integrator, 1 * Second) {}
 
+template<typename Frame>
+std::vector<typename Ephemeris<Frame>::Reanimation>
+Ephemeris<Frame>::PrepareReanimations(Instant const& desired_t_min) const {
+  Instant const t_min = this->t_min();
+  std::vector<Reanimation> reanimations;
+  std::lock_guard<std::mutex> l(lock_);
+  auto it = std::upper_bound(
+      dormant_checkpoints_.begin(), dormant_checkpoints_.end(), desired_t_min,
+      [](Instant const& left, Checkpoint const& right) {
+        return left < right.instance->time().value;
+      });
+  if (it != dormant_checkpoints_.begin()) {
+    --it;
+  }
+  for (; it != dormant_checkpoints_.end() && it->instance->time().value < t_min;
+       ++it) {
+    reanimations.emplace_back();
+    Reanimation& reanimation = reanimations.back();
+    it->instance->WriteToMessage(&reanimation.instance);
+    reanimation.t_initial = it->instance->time().value;
+    for (int i = 0; i < trajectories_.size(); ++i) {
+      reanimation.checkpoints.emplace_back();
+      trajectories_[i]->WriteCheckpointToMessage(
+          &reanimation.checkpoints.back(), it->checkpoints[i]);
+    }
+    reanimation.t_final =
+        std::next(it) == dormant_checkpoints_.end() ||
+                std::next(it)->instance->time().value >= t_min
+            ? t_min
+            : std::next(it)->instance->time().value;
+  }
+  return reanimations;
+}
+
+template<typename Frame>
+std::shared_ptr<ThreadPool> Ephemeris<Frame>::ReanimationThreadPool() {
+  std::lock_guard<std::mutex> l(lock_);
+  if (reanimation_thread_pool_ == nullptr) {
+    reanimation_thread_pool_ =
+        std::make_shared<ThreadPool>(max_reanimation_workers_);
+  }
+  return reanimation_thread_pool_;
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::ComputeReanimations(
+    std::vector<Reanimation>& reanimations,
+    ThreadPool& thread_pool) const {
+  // Integrate from each checkpoint on a separate set of trajectories.  The
+  // accelerations are computed without the scratch storage of this object, so
+  // the intervals may be processed in parallel, and concurrently with
+  // |Prolong|.  The results are identical to those of the original
+  // integration.  At most one reanimation is computed at a time, so
+  // |thread_pool| is not used concurrently.
+  thread_pool.ParallelFor(
+      reanimations.size(),
+      [this, &reanimations](int const k) {
+        Reanimation& reanimation = reanimations[k];
+        auto& prefixes = reanimation.prefixes;
+        for (auto const& checkpoint : reanimation.checkpoints) {
+          prefixes.push_back(
+              ContinuousTrajectory<Frame>::ReadFromMessage(checkpoint));
+        }
+        auto const prefixes_t_max = [&prefixes]() {
+          Instant t_max = astronomy::InfiniteFuture;
+          for (auto const& prefix : prefixes) {
+            t_max = std::min(t_max, prefix->t_max());
+          }
+          return t_max;
+        };
+
+        NewtonianMotionEquation equation;
+        equation.compute_acceleration =
+            [this](Instant const& t,
+                   std::vector<Position<Frame>> const& positions,
+                   std::vector<Vector<Acceleration, Frame>>& accelerations) {
+              ComputeMassiveBodiesGravitationalAccelerationsSerially(
+                  positions, accelerations, /*vectorized=*/false);
+            };
+        // The errors, if any, were reported by the original integration.
+        auto const append_state =
+            [&prefixes](
+                typename NewtonianMotionEquation::SystemState const& state) {
+              for (int i = 0; i < prefixes.size(); ++i) {
+                prefixes[i]->Append(
+                    state.time.value,
+                    DegreesOfFreedom<Frame>(state.positions[i].value,
+                                            state.velocities[i].value));
+              }
+            };
+        auto const instance =
+            FixedStepSizeIntegrator<NewtonianMotionEquation>::Instance::
+                ReadFromMessage(reanimation.instance, equation, append_state);
+        Instant t_final = reanimation.t_final;
+        while (prefixes_t_max() < reanimation.t_final) {
+          instance->Solve(t_final);
+          t_final += parameters_.step_;
+        }
+      });
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::SpliceReanimations(
+    std::vector<Reanimation>& reanimations) {
+  if (reanimations.empty()) {
+    return;
+  }
+  // Prepend the recomputed series, most recent first, and make the
+  // corresponding checkpoints live.  The dormant checkpoints have not changed
+  // since the reanimations were prepared.
+  std::lock_guard<std::mutex> l(lock_);
+  auto const first = std::lower_bound(
+      dormant_checkpoints_.begin(), dormant_checkpoints_.end(),
+      reanimations.front().t_initial,
+      [](Checkpoint const& left, Instant const& right) {
+        return left.instance->time().value < right;
+      });
+  CHECK(first != dormant_checkpoints_.end() &&
+        first->instance->time().value == reanimations.front().t_initial);
+  CHECK_LE(reanimations.size(),
+           static_cast<std::size_t>(dormant_checkpoints_.end() - first));
+  auto const last = first + reanimations.size();
+  for (auto it = reanimations.rbegin(); it != reanimations.rend(); ++it) {
+    for (int i = 0; i < trajectories_.size(); ++i) {
+      trajectories_[i]->Prepend(std::move(*it->prefixes[i]));
+    }
+  }
+  checkpoints_.insert(checkpoints_.begin(),
+                      std::make_move_iterator(first),
+                      std::make_move_iterator(last));
+  dormant_checkpoints_.erase(first, last);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::FinishReanimation() {
+  if (pending_reanimations_.valid()) {
+    std::vector<Reanimation> reanimations = pending_reanimations_.get();
+    SpliceReanimations(reanimations);
+  }
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::AppendMassiveBodiesState(
     typename NewtonianMotionEquation::SystemState const& state) {
-  int index = 0;
+  // The trajectories are independent, so they may be fitted in parallel.
+  std::vector<Status> statuses(trajectories_.size());
+  std::size_t const bodies_per_tile = BodiesPerTile();
+  RunInParallel(
+      (trajectories_.size() + bodies_per_tile - 1) / bodies_per_tile,
+      [this, &state, &statuses, bodies_per_tile](int const tile) {
+        for (std::size_t i = tile * bodies_per_tile;
+             i < std::min((tile + 1) * bodies_per_tile, trajectories_.size());
+             ++i) {
+          statuses[i] = trajectories_[i]->Append(
+              state.time.value,
+              DegreesOfFreedom<Frame>(state.positions[i].value,
+                                      state.velocities[i].value));
+        }
+      });
+
   for (int i = 0; i < trajectories_.size(); ++i) {
-    auto const& trajectory = trajectories_[i];
-    auto const status = trajectory->Append(
-        state.time.value,
-        DegreesOfFreedom<Frame>(state.positions[index].value,
-                                state.velocities[index].value));
+    auto const& status = statuses[i];
 
     // Handle the apocalypse.
     if (!status.ok()) {
@@ -806,8 +1546,6 @@ void Ephemeris<Frame>::AppendMassiveBodiesState(
                      status.message());
       LOG(ERROR) << "New Apocalypse: " << last_severe_integration_status_;
     }
-
-    ++index;
   }
 
   // Record an intermediate state if we haven't done so for too long.
@@ -953,11 +1691,123 @@ ComputeGravitationalAccelerationByMassiveBodyOnMasslessBodies(
   }
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeSphericalBodiesGravitationalAccelerationsVectorized(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  SphericalBodiesBuffers& buffers = spherical_bodies_buffers_;
+  for (std::size_t i = 0; i < number_of_spherical_bodies_; ++i) {
+    std::size_t const b = number_of_oblate_bodies_ + i;
+    R3Element<Length> const position =
+        (positions[b] - Frame::origin).coordinates();
+    R3Element<Acceleration> const acceleration = accelerations[b].coordinates();
+    buffers.x[i] = position.x / SIUnit<Length>();
+    buffers.y[i] = position.y / SIUnit<Length>();
+    buffers.z[i] = position.z / SIUnit<Length>();
+    buffers.ax[i] = acceleration.x / SIUnit<Acceleration>();
+    buffers.ay[i] = acceleration.y / SIUnit<Acceleration>();
+    buffers.az[i] = acceleration.z / SIUnit<Acceleration>();
+  }
+
+  ComputeMutualAccelerationsOfSphericalBodies(number_of_spherical_bodies_,
+                                              buffers.μ.data(),
+                                              buffers.x.data(),
+                                              buffers.y.data(),
+                                              buffers.z.data(),
+                                              buffers.ax.data(),
+                                              buffers.ay.data(),
+                                              buffers.az.data());
+
+  for (std::size_t i = 0; i < number_of_spherical_bodies_; ++i) {
+    accelerations[number_of_oblate_bodies_ + i] = Vector<Acceleration, Frame>(
+        {buffers.ax[i] * SIUnit<Acceleration>(),
+         buffers.ay[i] * SIUnit<Acceleration>(),
+         buffers.az[i] * SIUnit<Acceleration>()});
+  }
+}
+
+template<typename Frame>
+template<bool body1_is_oblate, bool body2_is_oblate>
+void Ephemeris<Frame>::ComputePairwiseGravitationalAccelerations(
+    std::size_t const b1,
+    std::size_t const b2_begin,
+    std::size_t const b2_end,
+    std::vector<Position<Frame>> const& positions) const {
+  MassiveBody const& body1 = *bodies_[b1];
+  Position<Frame> const& position_of_b1 = positions[b1];
+  GravitationalParameter const& μ1 = body1.gravitational_parameter();
+  for (std::size_t b2 = b2_begin; b2 < b2_end; ++b2) {
+    MassiveBody const& body2 = *bodies_[b2];
+    GravitationalParameter const& μ2 = body2.gravitational_parameter();
+    std::size_t const pair = PairIndex(b1, b2);
+    PairwiseAccelerations& pairwise_accelerations =
+        pairwise_accelerations_[pair];
+
+    // A vector from the center of |b2| to the center of |b1|.
+    Displacement<Frame> const Δq = position_of_b1 - positions[b2];
+
+    Square<Length> const Δq_squared = InnerProduct(Δq, Δq);
+    Exponentiation<Length, -3> const one_over_Δq_cubed =
+        Sqrt(Δq_squared) / (Δq_squared * Δq_squared);
+
+    auto const μ1_over_Δq_cubed = μ1 * one_over_Δq_cubed;
+    pairwise_accelerations.on_b2 = Δq * μ1_over_Δq_cubed;
+
+    auto const μ2_over_Δq_cubed = μ2 * one_over_Δq_cubed;
+    pairwise_accelerations.on_b1 = Δq * μ2_over_Δq_cubed;
+
+    if (body1_is_oblate || body2_is_oblate) {
+      PairwiseZonalAccelerations& pairwise_zonal_accelerations =
+          pairwise_zonal_accelerations_[pair];
+      Exponentiation<Length, -2> const one_over_Δq_squared = 1 / Δq_squared;
+      if (body1_is_oblate) {
+        Vector<Quotient<Acceleration,
+                        GravitationalParameter>, Frame> const
+            order_2_zonal_effect1 =
+                Order2ZonalAcceleration<Frame>(
+                    static_cast<OblateBody<Frame> const&>(body1),
+                    -Δq,
+                    one_over_Δq_squared,
+                    one_over_Δq_cubed);
+        pairwise_zonal_accelerations.zonal1_on_b1 = μ2 * order_2_zonal_effect1;
+        pairwise_zonal_accelerations.zonal1_on_b2 = μ1 * order_2_zonal_effect1;
+      }
+      if (body2_is_oblate) {
+        Vector<Quotient<Acceleration,
+                        GravitationalParameter>, Frame> const
+            order_2_zonal_effect2 =
+                Order2ZonalAcceleration<Frame>(
+                    static_cast<OblateBody<Frame> const&>(body2),
+                    Δq,
+                    one_over_Δq_squared,
+                    one_over_Δq_cubed);
+        pairwise_zonal_accelerations.zonal2_on_b1 = μ2 * order_2_zonal_effect2;
+        pairwise_zonal_accelerations.zonal2_on_b2 = μ1 * order_2_zonal_effect2;
+      }
+    }
+  }
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ComputeMassiveBodiesGravitationalAccelerations(
     Instant const& t,
     std::vector<Position<Frame>> const& positions,
     std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  if (thread_pool_ != nullptr) {
+    ComputeMassiveBodiesGravitationalAccelerationsInParallel(positions,
+                                                             accelerations);
+  } else {
+    ComputeMassiveBodiesGravitationalAccelerationsSerially(
+        positions, accelerations, vectorized_gravity_);
+  }
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::ComputeMassiveBodiesGravitationalAccelerationsSerially(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations,
+    bool const vectorized) const {
   accelerations.assign(accelerations.size(), Vector<Acceleration, Frame>());
 
   for (std::size_t b1 = 0; b1 < number_of_oblate_bodies_; ++b1) {
@@ -981,6 +1831,11 @@ void Ephemeris<Frame>::ComputeMassiveBodiesGravitationalAccelerations(
         positions,
         accelerations);
   }
+  if (vectorized) {
+    ComputeSphericalBodiesGravitationalAccelerationsVectorized(positions,
+                                                               accelerations);
+    return;
+  }
   for (std::size_t b1 = number_of_oblate_bodies_;
        b1 < number_of_oblate_bodies_ +
             number_of_spherical_bodies_;
@@ -998,6 +1853,139 @@ void Ephemeris<Frame>::ComputeMassiveBodiesGravitationalAccelerations(
   }
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::ComputeMassiveBodiesGravitationalAccelerationsInParallel(
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  std::size_t const n = bodies_.size();
+  std::size_t const number_of_oblate_bodies = number_of_oblate_bodies_;
+  pairwise_accelerations_.resize(n * (n - 1) / 2);
+  pairwise_zonal_accelerations_.resize(
+      number_of_oblate_bodies * (2 * n - number_of_oblate_bodies - 1) / 2);
+
+  // Split the rows of the triangle of pairs into tiles of about
+  // |pairs_per_tile| pairs.
+  std::size_t const pairs_per_tile = std::min(
+      max_pairs_per_tile,
+      std::max<std::size_t>(1, pairwise_accelerations_.size() / Tiles()));
+  std::vector<std::size_t> row_tiles = {0};
+  std::size_t pairs_in_tile = 0;
+  for (std::size_t b1 = 0; b1 < n; ++b1) {
+    pairs_in_tile += n - 1 - b1;
+    if (pairs_in_tile >= pairs_per_tile) {
+      row_tiles.push_back(b1 + 1);
+      pairs_in_tile = 0;
+    }
+  }
+  if (row_tiles.back() < n) {
+    row_tiles.push_back(n);
+  }
+
+  // First compute the contributions of all the pairs...
+  RunInParallel(
+      row_tiles.size() - 1,
+      [this, n, number_of_oblate_bodies, &positions, &row_tiles](
+          int const tile) {
+        for (std::size_t b1 = row_tiles[tile]; b1 < row_tiles[tile + 1]; ++b1) {
+          if (b1 < number_of_oblate_bodies) {
+            ComputePairwiseGravitationalAccelerations<
+                /*body1_is_oblate=*/true,
+                /*body2_is_oblate=*/true>(
+                b1,
+                /*b2_begin=*/b1 + 1,
+                /*b2_end=*/number_of_oblate_bodies,
+                positions);
+            ComputePairwiseGravitationalAccelerations<
+                /*body1_is_oblate=*/true,
+                /*body2_is_oblate=*/false>(
+                b1,
+                /*b2_begin=*/number_of_oblate_bodies,
+                /*b2_end=*/n,
+                positions);
+          } else {
+            ComputePairwiseGravitationalAccelerations<
+                /*body1_is_oblate=*/false,
+                /*body2_is_oblate=*/false>(
+                b1,
+                /*b2_begin=*/b1 + 1,
+                /*b2_end=*/n,
+                positions);
+          }
+        }
+      });
+
+  // ...then accumulate them for each body in the order in which
+  // |ComputeMassiveBodiesGravitationalAccelerations| does: first the actions
+  // of the bodies that precede it, then the reactions of those that follow it.
+  std::size_t const bodies_per_tile = BodiesPerTile();
+  RunInParallel(
+      (n + bodies_per_tile - 1) / bodies_per_tile,
+      [this, n, number_of_oblate_bodies, &accelerations, bodies_per_tile](
+          int const tile) {
+        for (std::size_t b = tile * bodies_per_tile;
+             b < std::min((tile + 1) * bodies_per_tile, n);
+             ++b) {
+          bool const b_is_oblate = b < number_of_oblate_bodies;
+          Vector<Acceleration, Frame> acceleration;
+          for (std::size_t b1 = 0; b1 < b; ++b1) {
+            std::size_t const pair = PairIndex(b1, b);
+            acceleration += pairwise_accelerations_[pair].on_b2;
+            if (b1 < number_of_oblate_bodies) {
+              PairwiseZonalAccelerations const& pairwise_zonal_accelerations =
+                  pairwise_zonal_accelerations_[pair];
+              acceleration += pairwise_zonal_accelerations.zonal1_on_b2;
+              if (b_is_oblate) {
+                acceleration -= pairwise_zonal_accelerations.zonal2_on_b2;
+              }
+            }
+          }
+          for (std::size_t b2 = b + 1; b2 < n; ++b2) {
+            std::size_t const pair = PairIndex(b, b2);
+            acceleration -= pairwise_accelerations_[pair].on_b1;
+            if (b_is_oblate) {
+              PairwiseZonalAccelerations const& pairwise_zonal_accelerations =
+                  pairwise_zonal_accelerations_[pair];
+              acceleration -= pairwise_zonal_accelerations.zonal1_on_b1;
+              if (b2 < number_of_oblate_bodies) {
+                acceleration += pairwise_zonal_accelerations.zonal2_on_b1;
+              }
+            }
+          }
+          accelerations[b] = acceleration;
+        }
+      });
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::RunInParallel(
+    int const tasks,
+    std::function<void(int task)> const& task) const {
+  if (thread_pool_ != nullptr && tasks > 1) {
+    thread_pool_->ParallelFor(tasks, task);
+    return;
+  }
+  for (int i = 0; i < tasks; ++i) {
+    task(i);
+  }
+}
+
+template<typename Frame>
+int Ephemeris<Frame>::Tiles() const {
+  return tiles_per_worker * max_workers_;
+}
+
+template<typename Frame>
+std::size_t Ephemeris<Frame>::BodiesPerTile() const {
+  return std::max<std::size_t>(1, (bodies_.size() + Tiles() - 1) / Tiles());
+}
+
+template<typename Frame>
+std::size_t Ephemeris<Frame>::PairIndex(std::size_t const b1,
+                                        std::size_t const b2) const {
+  std::size_t const n = bodies_.size();
+  return b1 * (2 * n - b1 - 1) / 2 + (b2 - b1 - 1);
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ComputeMasslessBodiesGravitationalAccelerations(
       Instant const& t,
@@ -1015,6 +2003,14 @@ void Ephemeris<Frame>::ComputeMasslessBodiesGravitationalAccelerations(
         positions,
         accelerations);
   }
+  // A single massless body doesn't fill a vector register and isn't worth the
+  // conversion to structure-of-arrays.
+  if (vectorized_gravity_ && positions.size() > 1) {
+    ComputeMasslessBodiesGravitationalAccelerationsVectorized(t,
+                                                              positions,
+                                                              accelerations);
+    return;
+  }
   for (std::size_t b1 = number_of_oblate_bodies_;
        b1 < number_of_oblate_bodies_ +
             number_of_spherical_bodies_;
@@ -1029,6 +2025,63 @@ void Ephemeris<Frame>::ComputeMasslessBodiesGravitationalAccelerations(
   }
 }
 
+template<typename Frame>
+void Ephemeris<Frame>::
+ComputeMasslessBodiesGravitationalAccelerationsVectorized(
+    Instant const& t,
+    std::vector<Position<Frame>> const& positions,
+    std::vector<Vector<Acceleration, Frame>>& accelerations) const {
+  // These buffers are thread-local because this function may be called
+  // concurrently for different flows, and to avoid deallocation/reallocation
+  // at each evaluation of the right-hand side.
+  thread_local std::vector<double> x;
+  thread_local std::vector<double> y;
+  thread_local std::vector<double> z;
+  thread_local std::vector<double> ax;
+  thread_local std::vector<double> ay;
+  thread_local std::vector<double> az;
+  std::size_t const n = positions.size();
+  x.resize(n);
+  y.resize(n);
+  z.resize(n);
+  ax.resize(n);
+  ay.resize(n);
+  az.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    R3Element<Length> const position =
+        (positions[i] - Frame::origin).coordinates();
+    R3Element<Acceleration> const acceleration = accelerations[i].coordinates();
+    x[i] = position.x / SIUnit<Length>();
+    y[i] = position.y / SIUnit<Length>();
+    z[i] = position.z / SIUnit<Length>();
+    ax[i] = acceleration.x / SIUnit<Acceleration>();
+    ay[i] = acceleration.y / SIUnit<Acceleration>();
+    az[i] = acceleration.z / SIUnit<Acceleration>();
+  }
+
+  for (std::size_t b1 = number_of_oblate_bodies_;
+       b1 < number_of_oblate_bodies_ + number_of_spherical_bodies_;
+       ++b1) {
+    R3Element<Length> const position1 =
+        (trajectories_[b1]->EvaluatePosition(t) - Frame::origin).coordinates();
+    ComputeAccelerationsBySphericalBodyOnMasslessBodies(
+        spherical_bodies_buffers_.μ[b1 - number_of_oblate_bodies_],
+        position1.x / SIUnit<Length>(),
+        position1.y / SIUnit<Length>(),
+        position1.z / SIUnit<Length>(),
+        n,
+        x.data(), y.data(), z.data(),
+        ax.data(), ay.data(), az.data());
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    accelerations[i] = Vector<Acceleration, Frame>(
+        {ax[i] * SIUnit<Acceleration>(),
+         ay[i] * SIUnit<Acceleration>(),
+         az[i] * SIUnit<Acceleration>()});
+  }
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::ComputeMasslessBodiesTotalAccelerations(
     IntrinsicAccelerations const& intrinsic_accelerations,
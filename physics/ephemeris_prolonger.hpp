@@ -0,0 +1,71 @@
+﻿
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <experimental/optional>
+#include <mutex>
+#include <thread>
+
+#include "base/macros.hpp"
+#include "base/not_null.hpp"
+#include "geometry/named_quantities.hpp"
+#include "physics/ephemeris.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_ephemeris_prolonger {
+
+using base::not_null;
+using geometry::Instant;
+
+// Prolongs an ephemeris speculatively on a background thread, so that the
+// calls to |Ephemeris::Prolong| made by its clients find that |t_max()| is
+// already past the time they need and return without integrating.  The
+// prolongation is done in increments of |steps_per_prolongation| steps of the
+// planetary integrator, so that a client calling |Prolong| on another thread
+// waits for at most one increment.  The ephemeris must outlive this object.
+template<typename Frame>
+class EphemerisProlonger final {
+ public:
+  explicit EphemerisProlonger(not_null<Ephemeris<Frame>*> ephemeris);
+
+  // Stops the background thread after the current increment, if any.
+  ~EphemerisProlonger();
+
+  // Requests that the ephemeris be prolonged until at least |t|.  Returns
+  // immediately.  The requests are not cumulative: only the latest time
+  // requested is relevant.
+  void RequestProlongation(Instant const& t);
+
+  // Blocks until the ephemeris has been prolonged until the time of the latest
+  // request.  Mostly useful for testing.
+  void WaitForProlongation();
+
+  static constexpr std::int64_t steps_per_prolongation = 8;
+
+ private:
+  // The body of |prolonger_|.
+  void ProlongRequested();
+
+  not_null<Ephemeris<Frame>*> const ephemeris_;
+
+  std::mutex lock_;
+  std::condition_variable has_request_or_done_;
+  std::condition_variable has_no_request_;
+  // The time requested and not yet reached by |t_max()|.
+  std::experimental::optional<Instant> requested_time_ GUARDED_BY(lock_);
+  bool done_ GUARDED_BY(lock_) = false;
+
+  // Must come last as it starts running during construction.
+  std::thread prolonger_;
+};
+
+}  // namespace internal_ephemeris_prolonger
+
+using internal_ephemeris_prolonger::EphemerisProlonger;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/ephemeris_prolonger_body.hpp"
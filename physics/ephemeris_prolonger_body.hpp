@@ -0,0 +1,74 @@
+﻿
+#pragma once
+
+#include "physics/ephemeris_prolonger.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_ephemeris_prolonger {
+
+template<typename Frame>
+constexpr std::int64_t EphemerisProlonger<Frame>::steps_per_prolongation;
+
+template<typename Frame>
+EphemerisProlonger<Frame>::EphemerisProlonger(
+    not_null<Ephemeris<Frame>*> const ephemeris)
+    : ephemeris_(ephemeris),
+      prolonger_([this]() { ProlongRequested(); }) {}
+
+template<typename Frame>
+EphemerisProlonger<Frame>::~EphemerisProlonger() {
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    done_ = true;
+  }
+  has_request_or_done_.notify_one();
+  prolonger_.join();
+}
+
+template<typename Frame>
+void EphemerisProlonger<Frame>::RequestProlongation(Instant const& t) {
+  {
+    std::lock_guard<std::mutex> l(lock_);
+    requested_time_ = t;
+  }
+  has_request_or_done_.notify_one();
+}
+
+template<typename Frame>
+void EphemerisProlonger<Frame>::WaitForProlongation() {
+  std::unique_lock<std::mutex> l(lock_);
+  has_no_request_.wait(l, [this]() { return !requested_time_ || done_; });
+}
+
+template<typename Frame>
+void EphemerisProlonger<Frame>::ProlongRequested() {
+  for (;;) {
+    Instant t;
+    {
+      std::unique_lock<std::mutex> l(lock_);
+      has_request_or_done_.wait(l, [this]() {
+        return requested_time_ || done_;
+      });
+      if (done_) {
+        return;
+      }
+      t = *requested_time_;
+    }
+    bool const reached = ephemeris_->ProlongTowards(t, steps_per_prolongation);
+    if (reached) {
+      {
+        std::lock_guard<std::mutex> l(lock_);
+        // Another request may have come in while we were prolonging.
+        if (requested_time_ && *requested_time_ <= t) {
+          requested_time_ = std::experimental::nullopt;
+        }
+      }
+      has_no_request_.notify_all();
+    }
+  }
+}
+
+}  // namespace internal_ephemeris_prolonger
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,165 @@
+﻿
+#include "physics/ephemeris_prolonger.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "astronomy/frames.hpp"
+#include "geometry/named_quantities.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "integrators/embedded_explicit_runge_kutta_nyström_integrator.hpp"
+#include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/solar_system.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_ephemeris_prolonger {
+
+using astronomy::ICRFJ2000Equator;
+using geometry::Displacement;
+using geometry::Position;
+using geometry::Velocity;
+using integrators::DormandElMikkawyPrince1986RKN434FM;
+using integrators::McLachlanAtela1992Order5Optimal;
+using quantities::si::Day;
+using quantities::si::Milli;
+using quantities::si::Metre;
+using quantities::si::Minute;
+using quantities::si::Second;
+using ::testing::Ge;
+using ::testing::Lt;
+
+class EphemerisProlongerTest : public ::testing::Test {
+ protected:
+  EphemerisProlongerTest() {
+    solar_system_.Initialize(
+        SOLUTION_DIR / "astronomy" / "gravity_model.proto.txt",
+        SOLUTION_DIR / "astronomy" /
+            "initial_state_jd_2433282_500000000.proto.txt");
+    t0_ = solar_system_.epoch();
+  }
+
+  not_null<std::unique_ptr<Ephemeris<ICRFJ2000Equator>>> MakeEphemeris() {
+    return solar_system_.MakeEphemeris(
+        /*fitting_tolerance=*/5 * Milli(Metre),
+        Ephemeris<ICRFJ2000Equator>::FixedStepParameters(
+            McLachlanAtela1992Order5Optimal<Position<ICRFJ2000Equator>>(),
+            /*step=*/10 * Minute));
+  }
+
+  SolarSystem<ICRFJ2000Equator> solar_system_;
+  Instant t0_;
+};
+
+TEST_F(EphemerisProlongerTest, Prolongation) {
+  auto const ephemeris = MakeEphemeris();
+  auto const expected_ephemeris = MakeEphemeris();
+  Instant const t_final = t0_ + 30 * Day;
+
+  EphemerisProlonger<ICRFJ2000Equator> prolonger(ephemeris.get());
+  prolonger.RequestProlongation(t0_ + 10 * Day);
+  prolonger.RequestProlongation(t_final);
+  prolonger.WaitForProlongation();
+  EXPECT_THAT(ephemeris->t_max(), Ge(t_final));
+
+  // The prolongation in increments yields the same trajectories as a single
+  // one.
+  expected_ephemeris->Prolong(t_final);
+  for (auto const& name : solar_system_.names()) {
+    auto const& trajectory = solar_system_.trajectory(*ephemeris, name);
+    auto const& expected_trajectory =
+        solar_system_.trajectory(*expected_ephemeris, name);
+    for (Instant t = t0_; t <= t_final; t += 1 * Day) {
+      EXPECT_EQ(expected_trajectory.EvaluateDegreesOfFreedom(t),
+                trajectory.EvaluateDegreesOfFreedom(t)) << name;
+    }
+  }
+}
+
+TEST_F(EphemerisProlongerTest, ConcurrentProlong) {
+  auto const ephemeris = MakeEphemeris();
+  auto const expected_ephemeris = MakeEphemeris();
+  Instant const t_final = t0_ + 30 * Day;
+  auto const& name = solar_system_.names().back();
+  auto const& trajectory = solar_system_.trajectory(*ephemeris, name);
+  auto const& expected_trajectory =
+      solar_system_.trajectory(*expected_ephemeris, name);
+  expected_ephemeris->Prolong(t_final);
+
+  {
+    EphemerisProlonger<ICRFJ2000Equator> prolonger(ephemeris.get());
+    prolonger.RequestProlongation(t0_ + 1000 * Day);
+    // The foreground calls interleave with the background prolongation.
+    for (Instant t = t0_; t <= t_final; t += 1 * Day) {
+      ephemeris->Prolong(t);
+      EXPECT_THAT(ephemeris->t_max(), Ge(t));
+      EXPECT_EQ(expected_trajectory.EvaluateDegreesOfFreedom(t),
+                trajectory.EvaluateDegreesOfFreedom(t));
+    }
+    // The destruction of |prolonger| doesn't wait for the request to
+    // complete.
+  }
+  EXPECT_THAT(ephemeris->t_max(), Lt(t0_ + 1000 * Day));
+}
+
+TEST_F(EphemerisProlongerTest, ConcurrentFlowWithAdaptiveStep) {
+  auto const ephemeris = MakeEphemeris();
+  auto const expected_ephemeris = MakeEphemeris();
+  Instant const t_final = t0_ + 30 * Day;
+  Ephemeris<ICRFJ2000Equator>::AdaptiveStepParameters const parameters(
+      DormandElMikkawyPrince1986RKN434FM<Position<ICRFJ2000Equator>>(),
+      /*max_steps=*/std::numeric_limits<std::int64_t>::max(),
+      /*length_integration_tolerance=*/1 * Metre,
+      /*speed_integration_tolerance=*/1 * Metre / Second);
+
+  // A probe in a high orbit around the Earth.
+  DegreesOfFreedom<ICRFJ2000Equator> const initial_state =
+      solar_system_.initial_state("Earth") +
+      RelativeDegreesOfFreedom<ICRFJ2000Equator>(
+          Displacement<ICRFJ2000Equator>({1e7 * Metre, 0 * Metre, 0 * Metre}),
+          Velocity<ICRFJ2000Equator>({0 * Metre / Second,
+                                      6.3e3 * Metre / Second,
+                                      0 * Metre / Second}));
+  DiscreteTrajectory<ICRFJ2000Equator> trajectory;
+  DiscreteTrajectory<ICRFJ2000Equator> expected_trajectory;
+  trajectory.Append(t0_, initial_state);
+  expected_trajectory.Append(t0_, initial_state);
+
+  {
+    EphemerisProlonger<ICRFJ2000Equator> prolonger(ephemeris.get());
+    prolonger.RequestProlongation(t0_ + 1000 * Day);
+    // The flows read the state of the integration of the ephemeris while it is
+    // being prolonged in the background.  They reach |t| because the limit on
+    // the number of steps of the ephemeris is much longer than a day.
+    for (Instant t = t0_ + 1 * Day; t <= t_final; t += 1 * Day) {
+      EXPECT_TRUE(ephemeris->FlowWithAdaptiveStep(
+          &trajectory,
+          Ephemeris<ICRFJ2000Equator>::NoIntrinsicAcceleration,
+          t,
+          parameters,
+          /*max_ephemeris_steps=*/1000,
+          /*last_point_only=*/true));
+      EXPECT_TRUE(expected_ephemeris->FlowWithAdaptiveStep(
+          &expected_trajectory,
+          Ephemeris<ICRFJ2000Equator>::NoIntrinsicAcceleration,
+          t,
+          parameters,
+          /*max_ephemeris_steps=*/1000,
+          /*last_point_only=*/true));
+      EXPECT_EQ(t, trajectory.last().time());
+      EXPECT_EQ(expected_trajectory.last().degrees_of_freedom(),
+                trajectory.last().degrees_of_freedom());
+    }
+  }
+}
+
+}  // namespace internal_ephemeris_prolonger
+}  // namespace physics
+}  // namespace principia
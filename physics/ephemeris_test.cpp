@@ -1,9 +1,11 @@
 ﻿
 #include "physics/ephemeris.hpp"
 
+#include <chrono>
 #include <limits>
 #include <map>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include "astronomy/frames.hpp"
@@ -45,6 +47,7 @@ using geometry::Frame;
 using geometry::Rotation;
 using geometry::Velocity;
 using integrators::DormandElMikkawyPrince1986RKN434FM;
+using integrators::DormandElMikkawyPrince1986RKN646FM;
 using integrators::McLachlanAtela1992Order5Optimal;
 using integrators::Quinlan1999Order8A;
 using quantities::Abs;
@@ -59,6 +62,7 @@ using quantities::astronomy::LunarDistance;
 using quantities::astronomy::SolarMass;
 using quantities::constants::GravitationalConstant;
 using quantities::si::AstronomicalUnit;
+using quantities::si::Day;
 using quantities::si::Hour;
 using quantities::si::Kilo;
 using quantities::si::Kilogram;
@@ -74,6 +78,7 @@ using testing_utilities::SolarSystemFactory;
 using testing_utilities::VanishesBefore;
 using ::testing::AnyOf;
 using ::testing::Eq;
+using ::testing::Ge;
 using ::testing::Gt;
 using ::testing::Lt;
 using ::testing::Ref;
@@ -253,6 +258,84 @@ TEST_P(EphemerisTest, FlowWithAdaptiveStepSpecialCase) {
       /*last_point_only=*/false));
 }
 
+// The dense output matches the steps of the integration, and interpolates
+// between them.
+TEST_P(EphemerisTest, FlowWithDenseOutput) {
+  Length const distance = 1e9 * Metre;
+  Speed const velocity = 1e3 * Metre / Second;
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRFJ2000Equator>> initial_state;
+  Position<ICRFJ2000Equator> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  Position<ICRFJ2000Equator> const earth_position =
+      initial_state[0].position();
+
+  Ephemeris<ICRFJ2000Equator>
+      ephemeris(
+          std::move(bodies),
+          initial_state,
+          t0_,
+          5 * Milli(Metre),
+          Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                           period / 100));
+  Ephemeris<ICRFJ2000Equator>::AdaptiveStepParameters const parameters(
+      DormandElMikkawyPrince1986RKN646FM<Position<ICRFJ2000Equator>>(),
+      max_steps,
+      1e-3 * Metre,
+      1e-6 * Metre / Second);
+
+  DiscreteTrajectory<ICRFJ2000Equator> steps;
+  steps.Append(t0_,
+               DegreesOfFreedom<ICRFJ2000Equator>(
+                   earth_position +
+                       Displacement<ICRFJ2000Equator>(
+                           {0 * Metre, distance, 0 * Metre}),
+                   Velocity<ICRFJ2000Equator>(
+                       {velocity, velocity, velocity})));
+  DiscreteTrajectory<ICRFJ2000Equator> last_point;
+  last_point.Append(steps.Begin().time(), steps.Begin().degrees_of_freedom());
+  DenseTrajectory<ICRFJ2000Equator> dense_trajectory;
+
+  EXPECT_TRUE(ephemeris.FlowWithAdaptiveStep(
+      &steps,
+      Ephemeris<ICRFJ2000Equator>::NoIntrinsicAcceleration,
+      t0_ + period,
+      parameters,
+      Ephemeris<ICRFJ2000Equator>::unlimited_max_ephemeris_steps,
+      /*last_point_only=*/false));
+  EXPECT_TRUE(ephemeris.FlowWithDenseOutput(
+      &last_point,
+      &dense_trajectory,
+      Ephemeris<ICRFJ2000Equator>::NoIntrinsicAcceleration,
+      t0_ + period,
+      parameters,
+      Ephemeris<ICRFJ2000Equator>::unlimited_max_ephemeris_steps,
+      /*last_point_only=*/true));
+
+  EXPECT_EQ(2, last_point.Size());
+  EXPECT_EQ(steps.last().time(), last_point.last().time());
+  EXPECT_EQ(steps.last().degrees_of_freedom(),
+            last_point.last().degrees_of_freedom());
+  EXPECT_EQ(steps.Size() - 1, dense_trajectory.size());
+  EXPECT_EQ(t0_, dense_trajectory.t_min());
+  EXPECT_EQ(t0_ + period, dense_trajectory.t_max());
+  for (auto it = steps.Begin(); it != steps.End(); ++it) {
+    EXPECT_THAT(
+        (dense_trajectory.EvaluatePosition(it.time()) -
+         it.degrees_of_freedom().position()).Norm(),
+        Lt(1e-6 * Metre));
+  }
+
+  // Sampling thins the trajectory to whatever density the client needs.
+  DiscreteTrajectory<ICRFJ2000Equator> sampled;
+  dense_trajectory.Sample(period / 10, &sampled);
+  EXPECT_EQ(11, sampled.Size());
+  EXPECT_EQ(t0_, sampled.Begin().time());
+  EXPECT_EQ(t0_ + period, sampled.last().time());
+}
+
 // The canonical Earth-Moon system, tuned to produce circular orbits.
 TEST_P(EphemerisTest, EarthMoon) {
   std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
@@ -716,6 +799,207 @@ TEST_P(EphemerisTest, Serialization) {
       << "SECOND\n" << second_message.DebugString();
 }
 
+TEST_P(EphemerisTest, SeriesFile) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRFJ2000Equator>> initial_state;
+  Position<ICRFJ2000Equator> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  MassiveBody const* const earth = bodies[0].get();
+  MassiveBody const* const moon = bodies[1].get();
+
+  Ephemeris<ICRFJ2000Equator>
+      ephemeris(
+          std::move(bodies),
+          initial_state,
+          t0_,
+          5 * Milli(Metre),
+          Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                           period / 100));
+  ephemeris.Prolong(t0_ + period);
+
+  auto const series_file = TEMP_DIR / "ephemeris_test_series_file.bin";
+  serialization::Ephemeris message;
+  ephemeris.WriteToMessage(&message, series_file);
+  EXPECT_TRUE(message.has_series_file_identifier());
+  for (auto const& trajectory : message.trajectory()) {
+    EXPECT_EQ(0, trajectory.series_size());
+    EXPECT_LT(0, trajectory.series_blocks().number_of_blocks());
+  }
+
+  {
+    auto const ephemeris_read =
+        Ephemeris<ICRFJ2000Equator>::ReadFromMessage(message, series_file);
+    MassiveBody const* const earth_read = ephemeris_read->bodies()[0];
+    MassiveBody const* const moon_read = ephemeris_read->bodies()[1];
+
+    EXPECT_EQ(ephemeris.t_min(), ephemeris_read->t_min());
+    EXPECT_EQ(ephemeris.t_max(), ephemeris_read->t_max());
+
+    // Prolonging appends series in memory after those in the file.
+    ephemeris.Prolong(t0_ + 2 * period);
+    ephemeris_read->Prolong(t0_ + 2 * period);
+    EXPECT_EQ(ephemeris.t_max(), ephemeris_read->t_max());
+    for (Instant time = ephemeris.t_min();
+         time <= ephemeris.t_max();
+         time += (ephemeris.t_max() - ephemeris.t_min()) / 100) {
+      EXPECT_EQ(
+          ephemeris.trajectory(earth)->EvaluateDegreesOfFreedom(time),
+          ephemeris_read->trajectory(earth_read)->
+              EvaluateDegreesOfFreedom(time));
+      EXPECT_EQ(
+          ephemeris.trajectory(moon)->EvaluateDegreesOfFreedom(time),
+          ephemeris_read->trajectory(moon_read)->
+              EvaluateDegreesOfFreedom(time));
+    }
+
+    serialization::Ephemeris message1;
+    serialization::Ephemeris message2;
+    ephemeris.WriteToMessage(&message1);
+    ephemeris_read->WriteToMessage(&message2);
+    EXPECT_EQ(message1.SerializeAsString(), message2.SerializeAsString());
+  }
+  std::experimental::filesystem::remove(series_file);
+}
+
+TEST_P(EphemerisTest, CompactSerialization) {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  std::vector<DegreesOfFreedom<ICRFJ2000Equator>> initial_state;
+  Position<ICRFJ2000Equator> centre_of_mass;
+  Time period;
+  SetUpEarthMoonSystem(bodies, initial_state, centre_of_mass, period);
+
+  MassiveBody const* const earth = bodies[0].get();
+  MassiveBody const* const moon = bodies[1].get();
+
+  Ephemeris<ICRFJ2000Equator>
+      ephemeris(
+          std::move(bodies),
+          initial_state,
+          t0_,
+          5 * Milli(Metre),
+          Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                           period / 100));
+  // Long enough to have several checkpoints.
+  ephemeris.Prolong(t0_ + 40 * period);
+  ephemeris.ForgetBefore(t0_ + 5 * period);
+
+  serialization::Ephemeris message;
+  ephemeris.WriteCheckpointsToMessage(&message,
+                                      /*desired_t_min=*/t0_ + 30 * period);
+  EXPECT_THAT(message.checkpoint_size(), Gt(4));
+  for (auto const& trajectory : message.trajectory()) {
+    EXPECT_EQ(0, trajectory.series_size());
+  }
+
+  auto const ephemeris_read =
+      Ephemeris<ICRFJ2000Equator>::ReadFromMessage(message);
+  MassiveBody const* const earth_read = ephemeris_read->bodies()[0];
+  MassiveBody const* const moon_read = ephemeris_read->bodies()[1];
+  // The bounds are excluded because the two ephemerides may not have the same
+  // series on either side of them.
+  auto const check_trajectories = [&](Instant const& t_min) {
+    Time const Δt = (ephemeris.t_max() - t_min) / 100;
+    for (Instant time = t_min + Δt; time < ephemeris.t_max(); time += Δt) {
+      EXPECT_EQ(
+          ephemeris.trajectory(earth)->EvaluateDegreesOfFreedom(time),
+          ephemeris_read->trajectory(earth_read)->
+              EvaluateDegreesOfFreedom(time));
+      EXPECT_EQ(
+          ephemeris.trajectory(moon)->EvaluateDegreesOfFreedom(time),
+          ephemeris_read->trajectory(moon_read)->
+              EvaluateDegreesOfFreedom(time));
+    }
+  };
+
+  // The series after |desired_t_min| are recomputed in the background, and
+  // only become visible when they are needed.
+  EXPECT_THAT(ephemeris_read->t_min(), Gt(t0_ + 30 * period));
+  check_trajectories(ephemeris_read->t_min());
+  ephemeris_read->Reanimate(t0_ + 30 * period);
+
+  // Only the series after |desired_t_min| have been recomputed.
+  EXPECT_THAT(ephemeris_read->t_min(), Lt(t0_ + 30 * period));
+  EXPECT_THAT(ephemeris_read->t_min(), Gt(t0_ + 20 * period));
+  EXPECT_THAT(ephemeris_read->t_max(), Ge(ephemeris.t_max()));
+  check_trajectories(ephemeris_read->t_min());
+
+  // The checkpoint before the time passed to |ForgetBefore| was kept.  The
+  // remaining intervals are recomputed in the background on a single thread,
+  // with the same results.
+  ephemeris_read->set_max_reanimation_workers(1);
+  while (ephemeris_read->t_min() >= ephemeris.t_min()) {
+    ephemeris_read->PollReanimation(t0_);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_THAT(ephemeris_read->t_min(), Lt(ephemeris.t_min()));
+  check_trajectories(ephemeris.t_min());
+}
+
+// The vectorized and scalar computations of the accelerations between the
+// massive bodies must give identical results.
+TEST_P(EphemerisTest, VectorizedGravity) {
+  auto const vectorized_ephemeris = solar_system_.MakeEphemeris(
+      /*fitting_tolerance=*/5 * Milli(Metre),
+      Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                       10 * Minute));
+  auto const scalar_ephemeris = solar_system_.MakeEphemeris(
+      /*fitting_tolerance=*/5 * Milli(Metre),
+      Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                       10 * Minute));
+  scalar_ephemeris->set_vectorized_gravity(false);
+
+  Instant const t_final = t0_ + 30 * Day;
+  vectorized_ephemeris->Prolong(t_final);
+  scalar_ephemeris->Prolong(t_final);
+
+  EXPECT_EQ(scalar_ephemeris->t_max(), vectorized_ephemeris->t_max());
+  for (auto const& name : solar_system_.names()) {
+    auto const& vectorized_trajectory =
+        solar_system_.trajectory(*vectorized_ephemeris, name);
+    auto const& scalar_trajectory =
+        solar_system_.trajectory(*scalar_ephemeris, name);
+    for (Instant t = t0_; t <= t_final; t += 1 * Day) {
+      EXPECT_EQ(scalar_trajectory.EvaluateDegreesOfFreedom(t),
+                vectorized_trajectory.EvaluateDegreesOfFreedom(t)) << name;
+    }
+  }
+}
+
+// The parallel computation of the accelerations between the massive bodies and
+// the parallel fitting of their trajectories are bit-for-bit identical to the
+// serial ones.
+// With 4 workers, the pairs of the 34 bodies of the solar system are split into
+// 12 tiles, and the bodies into 12 tiles.
+TEST_P(EphemerisTest, ParallelProlong) {
+  auto const serial_ephemeris = solar_system_.MakeEphemeris(
+      /*fitting_tolerance=*/5 * Milli(Metre),
+      Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                       10 * Minute));
+  auto const parallel_ephemeris = solar_system_.MakeEphemeris(
+      /*fitting_tolerance=*/5 * Milli(Metre),
+      Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                       10 * Minute));
+  parallel_ephemeris->set_max_workers(4);
+
+  Instant const t_final = t0_ + 30 * Day;
+  serial_ephemeris->Prolong(t_final);
+  parallel_ephemeris->Prolong(t_final);
+
+  EXPECT_EQ(serial_ephemeris->t_max(), parallel_ephemeris->t_max());
+  for (auto const& name : solar_system_.names()) {
+    auto const& serial_trajectory =
+        solar_system_.trajectory(*serial_ephemeris, name);
+    auto const& parallel_trajectory =
+        solar_system_.trajectory(*parallel_ephemeris, name);
+    for (Instant t = t0_; t <= t_final; t += 1 * Day) {
+      EXPECT_EQ(serial_trajectory.EvaluateDegreesOfFreedom(t),
+                parallel_trajectory.EvaluateDegreesOfFreedom(t)) << name;
+    }
+  }
+}
+
 // The gravitational acceleration on an elephant located at the pole.
 TEST_P(EphemerisTest, ComputeGravitationalAccelerationMasslessBody) {
   Time const duration = 1 * Second;
@@ -799,6 +1083,45 @@ TEST_P(EphemerisTest, ComputeGravitationalAccelerationMasslessBody) {
                           -9.832 * SIUnit<Acceleration>()), 6.7e-6);
 }
 
+// The accelerations computed for a batch of massless bodies must be identical
+// to those computed one body at a time, whether or not the computation is
+// vectorized.
+TEST_P(EphemerisTest, ComputeGravitationalAccelerationsMasslessBodies) {
+  auto const ephemeris = solar_system_.MakeEphemeris(
+      /*fitting_tolerance=*/5 * Milli(Metre),
+      Ephemeris<ICRFJ2000Equator>::FixedStepParameters(integrator(),
+                                                       10 * Minute));
+  Instant const t = t0_ + 1 * Day;
+  ephemeris->Prolong(t);
+
+  Position<ICRFJ2000Equator> const earth_position =
+      solar_system_.trajectory(*ephemeris, "Earth").EvaluatePosition(t);
+  std::vector<Position<ICRFJ2000Equator>> positions;
+  for (int i = 0; i < 11; ++i) {
+    positions.push_back(earth_position +
+                        Displacement<ICRFJ2000Equator>(
+                            {(i + 1) * earth_polar_radius,
+                             (i - 5) * 1000 * Kilo(Metre),
+                             i * i * 100 * Kilo(Metre)}));
+  }
+
+  auto const vectorized_accelerations =
+      ephemeris->ComputeGravitationalAccelerationsOnMasslessBodies(positions,
+                                                                   t);
+  ephemeris->set_vectorized_gravity(false);
+  auto const scalar_accelerations =
+      ephemeris->ComputeGravitationalAccelerationsOnMasslessBodies(positions,
+                                                                   t);
+  ASSERT_EQ(positions.size(), vectorized_accelerations.size());
+  ASSERT_EQ(positions.size(), scalar_accelerations.size());
+  for (int i = 0; i < positions.size(); ++i) {
+    EXPECT_EQ(ephemeris->ComputeGravitationalAccelerationOnMasslessBody(
+                  positions[i], t),
+              vectorized_accelerations[i]) << i;
+    EXPECT_EQ(scalar_accelerations[i], vectorized_accelerations[i]) << i;
+  }
+}
+
 TEST_P(EphemerisTest, ComputeGravitationalAccelerationMassiveBody) {
   Time const duration = 1 * Second;
   double const j2 = 1e6;
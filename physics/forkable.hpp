@@ -142,8 +142,14 @@ class Forkable {
   // object is a root.
   It3rator Fork() const;
 
-  // Returns the number of points in this object.  Complexity is O(|length| +
-  // |depth|).
+  // Returns an iterator to the point at the given |index| in this object,
+  // counting from |Begin()|.  |index| must be in [0, Size()].  Complexity is
+  // O(|depth|) if |TimelineConstIterator| is random-access, O(|length| +
+  // |depth|) otherwise.
+  It3rator At(std::int64_t index) const;
+
+  // Returns the number of points in this object.  Complexity is O(|depth|) if
+  // |TimelineConstIterator| is random-access, O(|length| + |depth|) otherwise.
   std::int64_t Size() const;
 
   // Returns true if this object is empty.  Complexity is O(1).
@@ -217,6 +223,10 @@ class Forkable {
   It3rator Wrap(not_null<Tr4jectory const*> ancestor,
                 TimelineConstIterator position_in_ancestor_timeline) const;
 
+  // Returns the number of points of the timeline of this object that are part
+  // of its child |fork|, i.e., that are at or before the fork time of |fork|.
+  std::int64_t ForkPrefixSize(not_null<Tr4jectory const*> fork) const;
+
   // There may be several forks starting from the same time, hence the multimap.
   // A level of indirection is needed to avoid referencing an incomplete type in
   // CRTP.
@@ -239,6 +239,34 @@ It3rator Forkable<Tr4jectory, It3rator>::Fork() const {
   return Wrap(ancestor, position_in_ancestor_timeline);
 }
 
+template<typename Tr4jectory, typename It3rator>
+It3rator Forkable<Tr4jectory, It3rator>::At(std::int64_t const index) const {
+  CHECK_LE(0, index);
+
+  // The ancestry, with the root at the front and this object at the back.
+  std::deque<not_null<Tr4jectory const*>> ancestry;
+  for (Tr4jectory const* ancestor = that();
+       ancestor != nullptr;
+       ancestor = ancestor->parent_) {
+    ancestry.push_front(ancestor);
+  }
+
+  // Go down the ancestry chain until we find the timeline that contains the
+  // point at |index|.
+  std::int64_t remaining = index;
+  for (auto it = ancestry.begin(); *it != that(); ++it) {
+    not_null<Tr4jectory const*> const ancestor = *it;
+    std::int64_t const prefix_size = ancestor->ForkPrefixSize(*std::next(it));
+    if (remaining < prefix_size) {
+      return Wrap(ancestor,
+                  std::next(ancestor->timeline_begin(), remaining));
+    }
+    remaining -= prefix_size;
+  }
+  CHECK_LE(remaining, timeline_size()) << "Index " << index << " out of range";
+  return Wrap(that(), std::next(timeline_begin(), remaining));
+}
+
 template<typename Tr4jectory, typename It3rator>
 std::int64_t Forkable<Tr4jectory, It3rator>::Size() const {
   Tr4jectory const* ancestor = that();
@@ -250,8 +278,7 @@ std::int64_t Forkable<Tr4jectory, It3rator>::Size() const {
   // Go up the ancestry chain adding the sizes.
   Tr4jectory const* parent = ancestor->parent_;
   while (parent != nullptr) {
-    size += std::distance(parent->timeline_begin(),
-                          *ancestor->position_in_parent_timeline_) + 1;
+    size += parent->ForkPrefixSize(ancestor);
     ancestor = parent;
     parent = ancestor->parent_;
   }
@@ -446,6 +473,20 @@ It3rator Forkable<Tr4jectory, It3rator>::Wrap(
   base::noreturn();
 }
 
+template<typename Tr4jectory, typename It3rator>
+std::int64_t Forkable<Tr4jectory, It3rator>::ForkPrefixSize(
+    not_null<Tr4jectory const*> const fork) const {
+  DCHECK_EQ(fork->parent_, that());
+  TimelineConstIterator const& position_in_timeline =
+      *fork->position_in_parent_timeline_;
+  // If the fork time is not in our timeline, it is our own fork time and none
+  // of our points are part of |fork|.
+  if (position_in_timeline == timeline_end()) {
+    return 0;
+  }
+  return std::distance(timeline_begin(), position_in_timeline) + 1;
+}
+
 }  // namespace internal_forkable
 }  // namespace physics
 }  // namespace principia
@@ -691,6 +691,41 @@ TEST_F(ForkableTest, IteratorLowerBoundSuccess) {
   EXPECT_EQ(it, fork->End());
 }
 
+TEST_F(ForkableTest, IteratorAtSuccess) {
+  EXPECT_EQ(trajectory_.End(), trajectory_.At(0));
+
+  trajectory_.push_back(t1_);
+  trajectory_.push_back(t2_);
+  trajectory_.push_back(t3_);
+
+  EXPECT_EQ(t1_, *trajectory_.At(0).current());
+  EXPECT_EQ(t3_, *trajectory_.At(2).current());
+  EXPECT_EQ(trajectory_.End(), trajectory_.At(3));
+
+  // |fork2| is forked at the fork time of |fork1|, which is not in the
+  // timeline of |fork1|.
+  not_null<FakeTrajectory*> const fork1 =
+      trajectory_.NewFork(trajectory_.timeline_find(t2_));
+  not_null<FakeTrajectory*> const fork2 =
+      fork1->NewFork(fork1->timeline_find(t2_));
+  fork1->push_back(t3_);
+  fork2->push_back(t4_);
+  EXPECT_EQ(3, fork1->Size());
+  EXPECT_EQ(3, fork2->Size());
+
+  for (std::int64_t i = 0; i < fork2->Size(); ++i) {
+    auto it = fork2->Begin();
+    for (std::int64_t j = 0; j < i; ++j) {
+      ++it;
+    }
+    EXPECT_EQ(it, fork2->At(i)) << i;
+  }
+  EXPECT_EQ(t2_, *fork2->At(1).current());
+  EXPECT_EQ(t4_, *fork2->At(2).current());
+  EXPECT_EQ(fork2->End(), fork2->At(3));
+  EXPECT_EQ(t3_, *fork1->At(2).current());
+}
+
 }  // namespace internal_forkable
 }  // namespace physics
 }  // namespace principia
@@ -44,6 +44,9 @@ class MockDynamicFrame : public DynamicFrame<InertialFrame, ThisFrame> {
   MOCK_CONST_METHOD1_T(
       MotionOfThisFrame,
       AcceleratedRigidMotion<InertialFrame, ThisFrame>(Instant const& t));
+  MOCK_CONST_METHOD1_T(
+      ComputeToThisFrameAtTime,
+      RigidMotion<InertialFrame, ThisFrame>(Instant const& t));
 };
 
 }  // namespace internal_dynamic_frame
@@ -11,6 +11,7 @@ namespace principia {
 namespace physics {
 namespace internal_ephemeris {
 
+using geometry::Velocity;
 using integrators::MockFixedStepSizeIntegrator;
 
 template<typename Frame>
@@ -38,8 +39,15 @@ class MockEphemeris : public Ephemeris<Frame> {
       planetary_integrator,
       FixedStepSizeIntegrator<NewtonianMotionEquation> const&());
 
+  MOCK_METHOD1_T(set_max_reanimation_workers, void(int max_workers));
+
   MOCK_METHOD1_T(ForgetBefore, void(Instant const& t));
+  MOCK_METHOD1_T(Reanimate, void(Instant const& desired_t_min));
+  MOCK_METHOD1_T(RequestReanimation, void(Instant const& desired_t_min));
+  MOCK_METHOD1_T(PollReanimation, void(Instant const& desired_t_min));
   MOCK_METHOD1_T(Prolong, void(Instant const& t));
+  MOCK_METHOD2_T(ProlongTowards,
+                 bool(Instant const& t, std::int64_t max_steps));
   MOCK_METHOD3_T(
       NewInstance,
       not_null<std::unique_ptr<
@@ -55,6 +63,15 @@ class MockEphemeris : public Ephemeris<Frame> {
            AdaptiveStepParameters const& parameters,
            std::int64_t max_ephemeris_steps,
            bool last_point_only));
+  MOCK_METHOD7_T(
+      FlowWithDenseOutput,
+      bool(not_null<DiscreteTrajectory<Frame>*> trajectory,
+           not_null<DenseTrajectory<Frame>*> dense_trajectory,
+           IntrinsicAcceleration intrinsic_acceleration,
+           Instant const& t,
+           AdaptiveStepParameters const& parameters,
+           std::int64_t max_ephemeris_steps,
+           bool last_point_only));
   MOCK_METHOD2_T(
       FlowWithFixedStep,
       void(Instant const& t,
@@ -65,6 +82,17 @@ class MockEphemeris : public Ephemeris<Frame> {
       Vector<Acceleration, Frame>(Position<Frame> const& position,
                                   Instant const & t));
 
+  MOCK_CONST_METHOD2_T(
+      ComputeGravitationalAccelerationsOnMasslessBodies,
+      std::vector<Vector<Acceleration, Frame>>(
+          std::vector<Position<Frame>> const& positions,
+          Instant const& t));
+  MOCK_CONST_METHOD3_T(
+      ComputeGravitationalAccelerationsOnMasslessBodies,
+      void(std::vector<Position<Frame>> const& positions,
+           Instant const& t,
+           std::vector<Vector<Acceleration, Frame>>& accelerations));
+
   // NOTE(phl): This overload introduces ambiguities in the expectations.
   // MOCK_CONST_METHOD2_T(
   //     ComputeGravitationalAccelerationOnMasslessBody,
@@ -90,6 +118,29 @@ class MockEphemeris : public Ephemeris<Frame> {
                        void(not_null<serialization::Ephemeris*> message));
 };
 
+template<typename Frame>
+void AppendCubicToDenseTrajectory(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom,
+    not_null<DiscreteTrajectory<Frame>*> const trajectory,
+    not_null<DenseTrajectory<Frame>*> const dense_trajectory) {
+  auto const last = trajectory->last();
+  Instant const t1 = last.time();
+  Position<Frame> const p1 = last.degrees_of_freedom().position();
+  Velocity<Frame> const v1 = last.degrees_of_freedom().velocity();
+  Position<Frame> const& p2 = degrees_of_freedom.position();
+  Velocity<Frame> const& v2 = degrees_of_freedom.velocity();
+  Time const h = time - t1;
+  // The second derivatives of the cubic Hermite interpolant at its bounds.
+  Vector<Acceleration, Frame> const a1 =
+      2.0 * (3.0 * (p2 - p1) / h - 2.0 * v1 - v2) / h;
+  Vector<Acceleration, Frame> const a2 =
+      a1 + 6.0 * (v1 + v2 - 2.0 * (p2 - p1) / h) / h;
+  dense_trajectory->Append(typename DenseTrajectory<Frame>::Interpolant(
+      {t1, time}, {p1, p2}, {v1, v2}, {a1, a2}));
+  trajectory->Append(time, degrees_of_freedom);
+}
+
 }  // namespace internal_ephemeris
 
 using internal_ephemeris::MockEphemeris;
@@ -116,6 +167,19 @@ ACTION_P2(AppendToDiscreteTrajectory, time, degrees_of_freedom) {
   arg0->Append(time, degrees_of_freedom);
 }
 
+// For |FlowWithDenseOutput|: appends the point to the discrete trajectory, and
+// to the dense trajectory the cubic that joins it to the previous last point,
+// so that sampling the dense trajectory only yields its bounds.
+ACTION_P(AppendToDenseTrajectory, degrees_of_freedom) {
+  physics::internal_ephemeris::AppendCubicToDenseTrajectory(
+      arg3, degrees_of_freedom, arg0, arg1);
+}
+
+ACTION_P2(AppendToDenseTrajectory, time, degrees_of_freedom) {
+  physics::internal_ephemeris::AppendCubicToDenseTrajectory(
+      time, degrees_of_freedom, arg0, arg1);
+}
+
 // TODO(phl): Remove "2" once the other actions are gone.
 ACTION_P2(AppendToDiscreteTrajectory2, trajectory, degrees_of_freedom) {
   (*trajectory)->Append(arg0, degrees_of_freedom);
@@ -0,0 +1,158 @@
+﻿
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "geometry/named_quantities.hpp"
+#include "physics/degrees_of_freedom.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_timeline {
+
+using geometry::Instant;
+
+// A sequence of degrees of freedom indexed by strictly increasing times, used
+// as the timeline of a |DiscreteTrajectory|.  The points are stored in chunks
+// of fixed size, with the times and the degrees of freedom in separate arrays,
+// so that iteration is sequential in memory and searches only touch the times.
+// Points may only be added or removed at either end.  An iterator remains valid
+// as long as the point that it denotes is not removed; in particular, like for
+// a |std::map|, |end()| remains |end()| when points are added.  However, the
+// first chunk starts small and is reallocated as it grows, so adding points
+// may invalidate the references returned by the iterators.
+template<typename Frame>
+class Timeline final {
+ public:
+  class const_iterator final {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::int64_t;
+    using value_type = void;
+    using pointer = void;
+    using reference = void;
+
+    const_iterator() = default;
+
+    Instant const& time() const;
+    DegreesOfFreedom<Frame> const& degrees_of_freedom() const;
+
+    const_iterator& operator++();
+    const_iterator& operator--();
+    const_iterator operator++(int);
+    const_iterator operator--(int);
+    const_iterator& operator+=(difference_type n);
+    const_iterator& operator-=(difference_type n);
+    const_iterator operator+(difference_type n) const;
+    const_iterator operator-(difference_type n) const;
+    difference_type operator-(const_iterator const& right) const;
+
+    bool operator==(const_iterator const& right) const;
+    bool operator!=(const_iterator const& right) const;
+
+   private:
+    // The representation of |end()|, which must not change when points are
+    // appended.
+    static constexpr std::int64_t end_index =
+        std::numeric_limits<std::int64_t>::max();
+
+    const_iterator(Timeline const* timeline, std::int64_t index);
+
+    // The index of the point denoted by this iterator, |timeline_->end_| if
+    // this iterator is at end.
+    std::int64_t index() const;
+
+    Timeline const* timeline_ = nullptr;
+    std::int64_t index_ = end_index;
+
+    friend class Timeline;
+  };
+
+  Timeline() = default;
+  Timeline(Timeline const&) = delete;
+  Timeline& operator=(Timeline const&) = delete;
+  ~Timeline();
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Same semantics as the members of |std::map| with the same names.
+  const_iterator find(Instant const& time) const;
+  const_iterator lower_bound(Instant const& time) const;
+  const_iterator upper_bound(Instant const& time) const;
+
+  bool empty() const;
+  std::int64_t size() const;
+
+  // |time| must be after the time of the last point.
+  void push_back(Instant const& time,
+                 DegreesOfFreedom<Frame> const& degrees_of_freedom);
+  // |time| must be before the time of the first point.
+  void push_front(Instant const& time,
+                  DegreesOfFreedom<Frame> const& degrees_of_freedom);
+  void pop_front();
+
+  // Removes the points in [first, last[.  Either |first| must be |begin()| or
+  // |last| must be |end()|.
+  void erase(const_iterator first, const_iterator last);
+
+ private:
+  // The number of slots of a chunk, except for the last one, which may have
+  // fewer.
+  static constexpr std::int64_t chunk_size = 64;
+  // Many timelines (those of short forks, in particular) only ever hold one or
+  // two points, so the first chunk starts with that many slots and its
+  // capacity doubles as needed.
+  static constexpr std::int64_t initial_chunk_capacity = 2;
+
+  using DegreesOfFreedomStorage = typename std::aligned_storage<
+      sizeof(DegreesOfFreedom<Frame>),
+      alignof(DegreesOfFreedom<Frame>)>::type;
+
+  struct Chunk final {
+    explicit Chunk(std::int64_t capacity);
+
+    std::int64_t capacity;
+    std::unique_ptr<Instant[]> times;
+    // Constructed only for the points that are in the timeline.
+    std::unique_ptr<DegreesOfFreedomStorage[]> degrees_of_freedom;
+  };
+
+  // The points are identified by indices that do not change when points are
+  // added or removed at either end.
+  Instant& time(std::int64_t index) const;
+  DegreesOfFreedom<Frame>* degrees_of_freedom(std::int64_t index) const;
+
+  // Returns the index of the first point whose time is not less than |time|
+  // (if |strict| is false) or is greater than |time| (if |strict| is true).
+  std::int64_t PartitionPoint(Instant const& time, bool strict) const;
+
+  // Returns an iterator to the point at |index|, or |end()| if |index| is
+  // |end_|.
+  const_iterator Wrap(std::int64_t index) const;
+
+  // Doubles the capacity of |chunks_.back()|, which must be less than
+  // |chunk_size|, and moves its points to the new storage.
+  void GrowLastChunk();
+
+  std::vector<Chunk> chunks_;
+  // The index of the first slot of |chunks_.front()|.
+  std::int64_t origin_ = 0;
+  // The points have indices in [begin_, end_[.
+  std::int64_t begin_ = 0;
+  std::int64_t end_ = 0;
+};
+
+}  // namespace internal_timeline
+
+using internal_timeline::Timeline;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/timeline_body.hpp"
@@ -0,0 +1,324 @@
+﻿
+#pragma once
+
+#include "physics/timeline.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace physics {
+namespace internal_timeline {
+
+template<typename Frame>
+constexpr std::int64_t Timeline<Frame>::const_iterator::end_index;
+
+template<typename Frame>
+constexpr std::int64_t Timeline<Frame>::chunk_size;
+
+template<typename Frame>
+constexpr std::int64_t Timeline<Frame>::initial_chunk_capacity;
+
+template<typename Frame>
+Instant const& Timeline<Frame>::const_iterator::time() const {
+  return timeline_->time(index_);
+}
+
+template<typename Frame>
+DegreesOfFreedom<Frame> const&
+Timeline<Frame>::const_iterator::degrees_of_freedom() const {
+  return *timeline_->degrees_of_freedom(index_);
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator&
+Timeline<Frame>::const_iterator::operator++() {
+  DCHECK_NE(end_index, index_);
+  ++index_;
+  if (index_ == timeline_->end_) {
+    index_ = end_index;
+  }
+  return *this;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator&
+Timeline<Frame>::const_iterator::operator--() {
+  index_ = index() - 1;
+  DCHECK_LE(timeline_->begin_, index_);
+  return *this;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator
+Timeline<Frame>::const_iterator::operator++(int) {
+  const_iterator const result = *this;
+  ++*this;
+  return result;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator
+Timeline<Frame>::const_iterator::operator--(int) {
+  const_iterator const result = *this;
+  --*this;
+  return result;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator&
+Timeline<Frame>::const_iterator::operator+=(difference_type const n) {
+  *this = timeline_->Wrap(index() + n);
+  return *this;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator&
+Timeline<Frame>::const_iterator::operator-=(difference_type const n) {
+  return *this += -n;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator
+Timeline<Frame>::const_iterator::operator+(difference_type const n) const {
+  const_iterator result = *this;
+  return result += n;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator
+Timeline<Frame>::const_iterator::operator-(difference_type const n) const {
+  const_iterator result = *this;
+  return result -= n;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator::difference_type
+Timeline<Frame>::const_iterator::operator-(const_iterator const& right) const {
+  DCHECK_EQ(timeline_, right.timeline_);
+  return index() - right.index();
+}
+
+template<typename Frame>
+bool Timeline<Frame>::const_iterator::operator==(
+    const_iterator const& right) const {
+  return timeline_ == right.timeline_ && index_ == right.index_;
+}
+
+template<typename Frame>
+bool Timeline<Frame>::const_iterator::operator!=(
+    const_iterator const& right) const {
+  return !(*this == right);
+}
+
+template<typename Frame>
+Timeline<Frame>::const_iterator::const_iterator(Timeline const* const timeline,
+                                                std::int64_t const index)
+    : timeline_(timeline),
+      index_(index) {}
+
+template<typename Frame>
+std::int64_t Timeline<Frame>::const_iterator::index() const {
+  return index_ == end_index ? timeline_->end_ : index_;
+}
+
+template<typename Frame>
+Timeline<Frame>::Chunk::Chunk(std::int64_t const capacity)
+    : capacity(capacity),
+      times(new Instant[capacity]),
+      degrees_of_freedom(new DegreesOfFreedomStorage[capacity]) {}
+
+template<typename Frame>
+Timeline<Frame>::~Timeline() {
+  for (std::int64_t index = begin_; index < end_; ++index) {
+    degrees_of_freedom(index)->~DegreesOfFreedom();
+  }
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator Timeline<Frame>::begin() const {
+  return Wrap(begin_);
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator Timeline<Frame>::end() const {
+  return Wrap(end_);
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator Timeline<Frame>::find(
+    Instant const& time) const {
+  std::int64_t const index = PartitionPoint(time, /*strict=*/false);
+  if (index == end_ || this->time(index) != time) {
+    return end();
+  }
+  return Wrap(index);
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator Timeline<Frame>::lower_bound(
+    Instant const& time) const {
+  return Wrap(PartitionPoint(time, /*strict=*/false));
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator Timeline<Frame>::upper_bound(
+    Instant const& time) const {
+  return Wrap(PartitionPoint(time, /*strict=*/true));
+}
+
+template<typename Frame>
+bool Timeline<Frame>::empty() const {
+  return begin_ == end_;
+}
+
+template<typename Frame>
+std::int64_t Timeline<Frame>::size() const {
+  return end_ - begin_;
+}
+
+template<typename Frame>
+void Timeline<Frame>::push_back(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  CHECK(empty() || this->time(end_ - 1) < time)
+      << "Append out of order at " << time;
+  // The arguments may refer to the last chunk, which may be reallocated.
+  Instant const copied_time = time;
+  DegreesOfFreedom<Frame> const copied_degrees_of_freedom = degrees_of_freedom;
+  std::int64_t const slot = end_ - origin_;
+  if (slot == static_cast<std::int64_t>(chunks_.size()) * chunk_size) {
+    chunks_.emplace_back(chunks_.empty() ? initial_chunk_capacity
+                                         : chunk_size);
+  } else if (slot % chunk_size == chunks_.back().capacity) {
+    GrowLastChunk();
+  }
+  this->time(end_) = copied_time;
+  new (this->degrees_of_freedom(end_))
+      DegreesOfFreedom<Frame>(copied_degrees_of_freedom);
+  ++end_;
+}
+
+template<typename Frame>
+void Timeline<Frame>::push_front(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  CHECK(empty() || time < this->time(begin_))
+      << "Prepend out of order at " << time;
+  if (begin_ == origin_) {
+    // The new first chunk is not the last one, so it must be full-size.
+    chunks_.insert(chunks_.begin(), Chunk(chunk_size));
+    origin_ -= chunk_size;
+  }
+  --begin_;
+  this->time(begin_) = time;
+  new (this->degrees_of_freedom(begin_))
+      DegreesOfFreedom<Frame>(degrees_of_freedom);
+}
+
+template<typename Frame>
+void Timeline<Frame>::pop_front() {
+  CHECK(!empty());
+  erase(begin(), ++begin());
+}
+
+template<typename Frame>
+void Timeline<Frame>::erase(const_iterator const first,
+                            const_iterator const last) {
+  DCHECK_EQ(this, first.timeline_);
+  DCHECK_EQ(this, last.timeline_);
+  std::int64_t const first_index = first.index();
+  std::int64_t const last_index = last.index();
+  CHECK_LE(first_index, last_index);
+  for (std::int64_t index = first_index; index < last_index; ++index) {
+    degrees_of_freedom(index)->~DegreesOfFreedom();
+  }
+  if (first_index == begin_) {
+    begin_ = last_index;
+    // Free the chunks that are entirely before the first point.
+    std::int64_t const unused_chunks = (begin_ - origin_) / chunk_size;
+    chunks_.erase(chunks_.begin(), chunks_.begin() + unused_chunks);
+    origin_ += unused_chunks * chunk_size;
+  } else {
+    CHECK_EQ(end_, last_index) << "Erasing in the middle of a timeline";
+    end_ = first_index;
+    // Free the chunks that are entirely after the last point.
+    std::int64_t const used_chunks =
+        (end_ - origin_ + chunk_size - 1) / chunk_size;
+    chunks_.erase(chunks_.begin() + used_chunks, chunks_.end());
+  }
+}
+
+template<typename Frame>
+Instant& Timeline<Frame>::time(std::int64_t const index) const {
+  std::int64_t const slot = index - origin_;
+  return chunks_[slot / chunk_size].times[slot % chunk_size];
+}
+
+template<typename Frame>
+DegreesOfFreedom<Frame>* Timeline<Frame>::degrees_of_freedom(
+    std::int64_t const index) const {
+  std::int64_t const slot = index - origin_;
+  return reinterpret_cast<DegreesOfFreedom<Frame>*>(
+      &chunks_[slot / chunk_size].degrees_of_freedom[slot % chunk_size]);
+}
+
+template<typename Frame>
+std::int64_t Timeline<Frame>::PartitionPoint(Instant const& time,
+                                             bool const strict) const {
+  // Binary search on the times.  Points are commonly looked up near the end of
+  // the timeline, so check the last point first.
+  if (empty() || (strict ? this->time(end_ - 1) <= time
+                         : this->time(end_ - 1) < time)) {
+    return end_;
+  }
+  std::int64_t low = begin_;
+  std::int64_t high = end_ - 1;
+  // The result is in [low, high].
+  while (low < high) {
+    std::int64_t const middle = low + (high - low) / 2;
+    Instant const& middle_time = this->time(middle);
+    if (strict ? middle_time <= time : middle_time < time) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+template<typename Frame>
+typename Timeline<Frame>::const_iterator Timeline<Frame>::Wrap(
+    std::int64_t const index) const {
+  DCHECK_LE(begin_, index);
+  DCHECK_LE(index, end_);
+  return const_iterator(this,
+                        index == end_ ? const_iterator::end_index : index);
+}
+
+template<typename Frame>
+void Timeline<Frame>::GrowLastChunk() {
+  Chunk& last_chunk = chunks_.back();
+  CHECK_LT(last_chunk.capacity, chunk_size);
+  Chunk grown_chunk(std::min(2 * last_chunk.capacity, chunk_size));
+  std::int64_t const last_chunk_origin =
+      origin_ + (static_cast<std::int64_t>(chunks_.size()) - 1) * chunk_size;
+  for (std::int64_t index = std::max(begin_, last_chunk_origin);
+       index < end_;
+       ++index) {
+    std::int64_t const slot = index - last_chunk_origin;
+    DegreesOfFreedom<Frame>* const degrees_of_freedom =
+        this->degrees_of_freedom(index);
+    grown_chunk.times[slot] = last_chunk.times[slot];
+    new (&grown_chunk.degrees_of_freedom[slot])
+        DegreesOfFreedom<Frame>(*degrees_of_freedom);
+    degrees_of_freedom->~DegreesOfFreedom();
+  }
+  last_chunk = std::move(grown_chunk);
+}
+
+}  // namespace internal_timeline
+}  // namespace physics
+}  // namespace principia
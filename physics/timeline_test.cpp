@@ -0,0 +1,161 @@
+﻿
+#include "physics/timeline.hpp"
+
+#include <iterator>
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "geometry/named_quantities.hpp"
+#include "gtest/gtest.h"
+#include "quantities/si.hpp"
+#include "serialization/geometry.pb.h"
+
+namespace principia {
+namespace physics {
+namespace internal_timeline {
+
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::Position;
+using geometry::Velocity;
+using quantities::si::Metre;
+using quantities::si::Second;
+
+class TimelineTest : public testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST, true>;
+
+  // The point at time |i| seconds.
+  static Instant t(int const i) {
+    return Instant() + i * Second;
+  }
+  static DegreesOfFreedom<World> dof(int const i) {
+    return {World::origin + Displacement<World>({i * Metre, 0 * Metre,
+                                                 0 * Metre}),
+            Velocity<World>()};
+  }
+
+  // Checks that |timeline| contains exactly the points [first, last[.
+  static void ExpectPoints(Timeline<World> const& timeline,
+                           int const first,
+                           int const last) {
+    EXPECT_EQ(last - first, timeline.size());
+    EXPECT_EQ(first == last, timeline.empty());
+    int i = first;
+    for (auto it = timeline.begin(); it != timeline.end(); ++it, ++i) {
+      EXPECT_EQ(t(i), it.time());
+      EXPECT_EQ(dof(i), it.degrees_of_freedom());
+    }
+    EXPECT_EQ(last, i);
+  }
+
+  Timeline<World> timeline_;
+};
+
+TEST_F(TimelineTest, Empty) {
+  ExpectPoints(timeline_, 0, 0);
+  EXPECT_TRUE(timeline_.begin() == timeline_.end());
+  EXPECT_TRUE(timeline_.find(t(0)) == timeline_.end());
+  EXPECT_TRUE(timeline_.lower_bound(t(0)) == timeline_.end());
+}
+
+TEST_F(TimelineTest, PushAndPop) {
+  for (int i = 0; i < 1000; ++i) {
+    timeline_.push_back(t(i), dof(i));
+  }
+  ExpectPoints(timeline_, 0, 1000);
+  for (int i = 0; i < 300; ++i) {
+    timeline_.pop_front();
+  }
+  ExpectPoints(timeline_, 300, 1000);
+  for (int i = 299; i >= -200; --i) {
+    timeline_.push_front(t(i), dof(i));
+  }
+  ExpectPoints(timeline_, -200, 1000);
+}
+
+TEST_F(TimelineTest, SmallTimelines) {
+  // The first chunk grows as points are appended.
+  for (int i = 0; i < 3; ++i) {
+    timeline_.push_back(t(i), dof(i));
+    ExpectPoints(timeline_, 0, i + 1);
+  }
+  auto const it = timeline_.find(t(1));
+  for (int i = 3; i < 70; ++i) {
+    timeline_.push_back(t(i), dof(i));
+  }
+  ExpectPoints(timeline_, 0, 70);
+  EXPECT_EQ(dof(1), it.degrees_of_freedom());
+
+  // Prepending to a small chunk.
+  Timeline<World> timeline;
+  timeline.push_back(t(0), dof(0));
+  timeline.push_front(t(-1), dof(-1));
+  for (int i = 1; i < 10; ++i) {
+    timeline.push_back(t(i), dof(i));
+  }
+  ExpectPoints(timeline, -1, 10);
+  timeline.erase(timeline.find(t(5)), timeline.end());
+  ExpectPoints(timeline, -1, 5);
+}
+
+TEST_F(TimelineTest, Search) {
+  for (int i = 0; i < 1000; i += 2) {
+    timeline_.push_back(t(i), dof(i));
+  }
+  EXPECT_TRUE(timeline_.find(t(501)) == timeline_.end());
+  EXPECT_TRUE(timeline_.find(t(1000)) == timeline_.end());
+  EXPECT_EQ(t(500), timeline_.find(t(500)).time());
+  EXPECT_EQ(t(0), timeline_.find(t(0)).time());
+  EXPECT_EQ(t(998), timeline_.find(t(998)).time());
+  EXPECT_EQ(t(500), timeline_.lower_bound(t(500)).time());
+  EXPECT_EQ(t(502), timeline_.lower_bound(t(501)).time());
+  EXPECT_EQ(t(0), timeline_.lower_bound(t(-1)).time());
+  EXPECT_TRUE(timeline_.lower_bound(t(999)) == timeline_.end());
+  EXPECT_EQ(t(502), timeline_.upper_bound(t(500)).time());
+  EXPECT_TRUE(timeline_.upper_bound(t(998)) == timeline_.end());
+}
+
+TEST_F(TimelineTest, Iterators) {
+  for (int i = 0; i < 200; ++i) {
+    timeline_.push_back(t(i), dof(i));
+  }
+  auto const end = timeline_.end();
+  auto const last = std::prev(end);
+  auto const it = timeline_.find(t(100));
+  EXPECT_EQ(t(199), last.time());
+  EXPECT_EQ(100, it - timeline_.begin());
+  EXPECT_EQ(100, end - it);
+  EXPECT_EQ(200, std::distance(timeline_.begin(), end));
+  EXPECT_EQ(t(150), (it + 50).time());
+  EXPECT_EQ(t(50), (it - 50).time());
+  EXPECT_TRUE(it + 100 == end);
+
+  // Appending doesn't invalidate the iterators and |end()| remains |end()|.
+  for (int i = 200; i < 1000; ++i) {
+    timeline_.push_back(t(i), dof(i));
+  }
+  EXPECT_TRUE(end == timeline_.end());
+  EXPECT_EQ(t(199), last.time());
+  EXPECT_EQ(t(100), it.time());
+  EXPECT_EQ(t(999), std::prev(end).time());
+
+  // Neither does removing points at either end.
+  timeline_.erase(timeline_.begin(), timeline_.find(t(90)));
+  timeline_.erase(timeline_.upper_bound(t(500)), timeline_.end());
+  ExpectPoints(timeline_, 90, 501);
+  EXPECT_TRUE(end == timeline_.end());
+  EXPECT_EQ(t(199), last.time());
+  EXPECT_EQ(t(100), it.time());
+  EXPECT_EQ(10, it - timeline_.begin());
+
+  timeline_.erase(timeline_.begin(), timeline_.end());
+  ExpectPoints(timeline_, 0, 0);
+  timeline_.push_back(t(3), dof(3));
+  ExpectPoints(timeline_, 3, 4);
+}
+
+}  // namespace internal_timeline
+}  // namespace physics
+}  // namespace principia
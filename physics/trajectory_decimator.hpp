@@ -0,0 +1,93 @@
+﻿
+#pragma once
+
+#include <experimental/optional>
+#include <vector>
+
+#include "geometry/named_quantities.hpp"
+#include "physics/degrees_of_freedom.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_trajectory_decimator {
+
+using geometry::Instant;
+using geometry::Position;
+using quantities::Angle;
+
+// Decimates a stream of points so that the polyline joining the retained
+// points approximates the polyline joining all the points.  A point is
+// discarded if, seen from the last retained point, it lies within |tolerance|
+// of the chord that replaces it and does not extend beyond that chord.  The
+// decimation is incremental: points are appended one at a time, and the
+// retained points never change once they have been retained, so that the
+// decimated trajectory can be extended as new points are appended.
+// Note that |tolerance| is an angle subtended at the last retained point, not
+// an error in screen space: the retained polyline is only as accurate on
+// screen as the angular tolerance is small compared to the angular size of
+// the trajectory as seen from the camera, and the error in distance grows with
+// the length of the chord.
+template<typename Frame>
+class TrajectoryDecimator final {
+ public:
+  explicit TrajectoryDecimator(Angle const& tolerance);
+
+  // Appends a point.  Its |time| must be after the time of the last point
+  // appended.
+  void Append(Instant const& time,
+              DegreesOfFreedom<Frame> const& degrees_of_freedom);
+
+  // Forgets the retained points before |time|.  If this leaves no retained
+  // point, the last point appended is retained if it is not before |time|, and
+  // forgotten otherwise.  The points retained after |time| are unaffected.
+  void ForgetBefore(Instant const& time);
+
+  // Returns true if no point was appended or if all of them were forgotten.
+  bool empty() const;
+
+  // The time of the last point appended.  Fails if no point was appended.
+  Instant const& last_time() const;
+
+  // The points that have been retained so far.  The last point appended is
+  // only retained once it is known to be needed, so it is usually not part of
+  // this trajectory.
+  DiscreteTrajectory<Frame> const& retained() const;
+
+  // Appends to |trajectory| the decimated points, i.e., the retained points
+  // followed by the last point appended, if it was not retained.
+  void WriteTo(DiscreteTrajectory<Frame>& trajectory) const;
+
+ private:
+  struct Point final {
+    Instant time;
+    DegreesOfFreedom<Frame> degrees_of_freedom;
+  };
+
+  // Returns true if all the points discarded since the last retained point,
+  // as well as |*last_|, are within tolerance of the chord from the last
+  // retained point to |position|.
+  bool IsWithinTolerance(Position<Frame> const& position) const;
+
+  // We cannot retain indefinitely many points in |discarded_| without making
+  // |Append| quadratic, so we retain a point after that many discarded ones.
+  static constexpr int max_discarded_points_ = 64;
+
+  double const tan²_tolerance_;
+  DiscreteTrajectory<Frame> retained_;
+  // The positions of the points discarded since the last retained point.
+  std::vector<Position<Frame>> discarded_;
+  // The last point appended, if it is not in |retained_|.
+  std::experimental::optional<Point> last_;
+};
+
+}  // namespace internal_trajectory_decimator
+
+using internal_trajectory_decimator::TrajectoryDecimator;
+
+}  // namespace physics
+}  // namespace principia
+
+#include "physics/trajectory_decimator_body.hpp"
@@ -0,0 +1,124 @@
+﻿
+#pragma once
+
+#include "physics/trajectory_decimator.hpp"
+
+#include "geometry/grassmann.hpp"
+#include "quantities/elementary_functions.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_trajectory_decimator {
+
+using geometry::Displacement;
+using geometry::InnerProduct;
+using geometry::Wedge;
+using quantities::Length;
+using quantities::Pow;
+using quantities::Square;
+using quantities::Tan;
+
+template<typename Frame>
+constexpr int TrajectoryDecimator<Frame>::max_discarded_points_;
+
+template<typename Frame>
+TrajectoryDecimator<Frame>::TrajectoryDecimator(Angle const& tolerance)
+    : tan²_tolerance_(Pow<2>(Tan(tolerance))) {}
+
+template<typename Frame>
+void TrajectoryDecimator<Frame>::Append(
+    Instant const& time,
+    DegreesOfFreedom<Frame> const& degrees_of_freedom) {
+  CHECK(retained_.Empty() || last_time() < time)
+      << "Append out of order at " << time << ", last time is "
+      << last_time();
+  if (retained_.Empty()) {
+    retained_.Append(time, degrees_of_freedom);
+    return;
+  }
+  if (last_) {
+    if (discarded_.size() < max_discarded_points_ &&
+        IsWithinTolerance(degrees_of_freedom.position())) {
+      discarded_.push_back(last_->degrees_of_freedom.position());
+    } else {
+      retained_.Append(last_->time, last_->degrees_of_freedom);
+      discarded_.clear();
+    }
+  }
+  last_ = Point{time, degrees_of_freedom};
+}
+
+template<typename Frame>
+void TrajectoryDecimator<Frame>::ForgetBefore(Instant const& time) {
+  retained_.ForgetBefore(time);
+  if (retained_.Empty()) {
+    if (last_ && last_->time >= time) {
+      retained_.Append(last_->time, last_->degrees_of_freedom);
+    }
+    last_ = std::experimental::nullopt;
+    discarded_.clear();
+  }
+}
+
+template<typename Frame>
+bool TrajectoryDecimator<Frame>::empty() const {
+  return retained_.Empty();
+}
+
+template<typename Frame>
+Instant const& TrajectoryDecimator<Frame>::last_time() const {
+  return last_ ? last_->time : retained_.last().time();
+}
+
+template<typename Frame>
+DiscreteTrajectory<Frame> const&
+TrajectoryDecimator<Frame>::retained() const {
+  return retained_;
+}
+
+template<typename Frame>
+void TrajectoryDecimator<Frame>::WriteTo(
+    DiscreteTrajectory<Frame>& trajectory) const {
+  for (auto it = retained_.Begin(); it != retained_.End(); ++it) {
+    trajectory.Append(it.time(), it.degrees_of_freedom());
+  }
+  if (last_) {
+    trajectory.Append(last_->time, last_->degrees_of_freedom);
+  }
+}
+
+template<typename Frame>
+bool TrajectoryDecimator<Frame>::IsWithinTolerance(
+    Position<Frame> const& position) const {
+  Position<Frame> const anchor =
+      retained_.last().degrees_of_freedom().position();
+  Displacement<Frame> const chord = position - anchor;
+  Square<Length> const chord² = InnerProduct(chord, chord);
+
+  auto const is_within_tolerance =
+      [this, &anchor, &chord, &chord²](Position<Frame> const& point) {
+        Displacement<Frame> const displacement = point - anchor;
+        Square<Length> const projection = InnerProduct(displacement, chord);
+        // The point must not be behind the anchor or beyond the chord.  This
+        // also rejects any point distinct from the anchor if the chord is null.
+        if (projection < Square<Length>() || projection > chord² ||
+            (chord² == Square<Length>() &&
+             displacement != Displacement<Frame>())) {
+          return false;
+        }
+        auto const wedge = Wedge(displacement, chord);
+        return InnerProduct(wedge, wedge) <=
+               tan²_tolerance_ * Pow<2>(projection);
+      };
+
+  for (Position<Frame> const& discarded : discarded_) {
+    if (!is_within_tolerance(discarded)) {
+      return false;
+    }
+  }
+  return is_within_tolerance(last_->degrees_of_freedom.position());
+}
+
+}  // namespace internal_trajectory_decimator
+}  // namespace physics
+}  // namespace principia
@@ -0,0 +1,198 @@
+﻿
+#include "physics/trajectory_decimator.hpp"
+
+#include <vector>
+
+#include "geometry/frame.hpp"
+#include "geometry/grassmann.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace physics {
+namespace internal_trajectory_decimator {
+
+using geometry::Displacement;
+using geometry::Frame;
+using geometry::InnerProduct;
+using geometry::Velocity;
+using geometry::Wedge;
+using quantities::Cos;
+using quantities::Length;
+using quantities::Sin;
+using quantities::Speed;
+using quantities::Tan;
+using quantities::si::Degree;
+using quantities::si::Metre;
+using quantities::si::Radian;
+using quantities::si::Second;
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::Lt;
+
+class TrajectoryDecimatorTest : public ::testing::Test {
+ protected:
+  using World = Frame<serialization::Frame::TestTag,
+                      serialization::Frame::TEST, true>;
+
+  TrajectoryDecimatorTest() {
+    // A circle of radius 1 m, sampled at 1000 points.
+    for (int i = 0; i < 1000; ++i) {
+      Angle const θ = i * 0.5 * Degree;
+      times_.push_back(t0_ + i * Second);
+      degrees_of_freedom_.emplace_back(
+          World::origin + Displacement<World>({Cos(θ) * Metre,
+                                               Sin(θ) * Metre,
+                                               0 * Metre}),
+          Velocity<World>());
+    }
+  }
+
+  // Checks that every point of |times_| in the range of |decimated| is close
+  // to the segment of |decimated| that covers it.
+  void CheckWithinTolerance(DiscreteTrajectory<World> const& decimated,
+                            Angle const& tolerance) {
+    auto it = decimated.Begin();
+    auto next = it;
+    ++next;
+    for (int i = 0; i < times_.size(); ++i) {
+      if (next == decimated.End()) {
+        break;
+      }
+      if (times_[i] >= next.time()) {
+        it = next;
+        ++next;
+        if (next == decimated.End()) {
+          break;
+        }
+      }
+      Displacement<World> const displacement =
+          degrees_of_freedom_[i].position() -
+          it.degrees_of_freedom().position();
+      Displacement<World> const chord = next.degrees_of_freedom().position() -
+                                        it.degrees_of_freedom().position();
+      auto const projection = InnerProduct(displacement, chord);
+      auto const wedge = Wedge(displacement, chord);
+      EXPECT_THAT(wedge.Norm(), Le(Tan(tolerance) * projection)) << i;
+    }
+  }
+
+  Instant const t0_;
+  std::vector<Instant> times_;
+  std::vector<DegreesOfFreedom<World>> degrees_of_freedom_;
+};
+
+TEST_F(TrajectoryDecimatorTest, StraightLine) {
+  TrajectoryDecimator<World> decimator(1 * Degree);
+  for (int i = 0; i < 10; ++i) {
+    decimator.Append(t0_ + i * Second,
+                     DegreesOfFreedom<World>(
+                         World::origin + Displacement<World>({i * Metre,
+                                                              2 * i * Metre,
+                                                              3 * i * Metre}),
+                         Velocity<World>()));
+  }
+  DiscreteTrajectory<World> decimated;
+  decimator.WriteTo(decimated);
+  EXPECT_EQ(2, decimated.Size());
+  EXPECT_EQ(t0_, decimated.Begin().time());
+  EXPECT_EQ(t0_ + 9 * Second, decimated.last().time());
+  EXPECT_EQ(1, decimator.retained().Size());
+}
+
+TEST_F(TrajectoryDecimatorTest, Backtracking) {
+  // A trajectory that goes back along the same line must not be decimated
+  // to a single segment.
+  TrajectoryDecimator<World> decimator(1 * Degree);
+  std::vector<Length> const abscissae = {0 * Metre, 2 * Metre, 1 * Metre};
+  for (int i = 0; i < abscissae.size(); ++i) {
+    decimator.Append(t0_ + i * Second,
+                     DegreesOfFreedom<World>(
+                         World::origin +
+                             Displacement<World>(
+                                 {abscissae[i], 0 * Metre, 0 * Metre}),
+                         Velocity<World>()));
+  }
+  DiscreteTrajectory<World> decimated;
+  decimator.WriteTo(decimated);
+  EXPECT_EQ(3, decimated.Size());
+}
+
+TEST_F(TrajectoryDecimatorTest, Circle) {
+  // The points are 0.5° apart, so they are seen 0.25° apart from the previous
+  // point.
+  for (Angle const tolerance : {0.6 * Degree, 1 * Degree, 5 * Degree}) {
+    TrajectoryDecimator<World> decimator(tolerance);
+    for (int i = 0; i < times_.size(); ++i) {
+      decimator.Append(times_[i], degrees_of_freedom_[i]);
+    }
+    DiscreteTrajectory<World> decimated;
+    decimator.WriteTo(decimated);
+    EXPECT_THAT(decimated.Size(), Lt(times_.size() / 2)) << tolerance;
+    EXPECT_EQ(times_.front(), decimated.Begin().time());
+    EXPECT_EQ(times_.back(), decimated.last().time());
+    CheckWithinTolerance(decimated, tolerance);
+  }
+}
+
+TEST_F(TrajectoryDecimatorTest, Incremental) {
+  TrajectoryDecimator<World> decimator(1 * Degree);
+  for (int i = 0; i < 500; ++i) {
+    decimator.Append(times_[i], degrees_of_freedom_[i]);
+  }
+  std::vector<Instant> prefix_times;
+  for (auto it = decimator.retained().Begin();
+       it != decimator.retained().End();
+       ++it) {
+    prefix_times.push_back(it.time());
+  }
+  for (int i = 500; i < times_.size(); ++i) {
+    decimator.Append(times_[i], degrees_of_freedom_[i]);
+  }
+
+  // The points retained from the prefix are unaffected by the points appended
+  // later.
+  auto it = decimator.retained().Begin();
+  for (Instant const& time : prefix_times) {
+    EXPECT_THAT(it.time(), Eq(time));
+    ++it;
+  }
+}
+
+TEST_F(TrajectoryDecimatorTest, ForgetBefore) {
+  TrajectoryDecimator<World> decimator(1 * Degree);
+  TrajectoryDecimator<World> reference_decimator(1 * Degree);
+  for (int i = 0; i < 500; ++i) {
+    decimator.Append(times_[i], degrees_of_freedom_[i]);
+    reference_decimator.Append(times_[i], degrees_of_freedom_[i]);
+  }
+  decimator.ForgetBefore(times_[300]);
+  EXPECT_FALSE(decimator.empty());
+  EXPECT_THAT(decimator.retained().Begin().time(), Ge(times_[300]));
+  for (int i = 500; i < times_.size(); ++i) {
+    decimator.Append(times_[i], degrees_of_freedom_[i]);
+    reference_decimator.Append(times_[i], degrees_of_freedom_[i]);
+  }
+
+  // The points retained after the forgotten ones are unaffected.
+  auto it = decimator.retained().Begin();
+  auto reference_it =
+      reference_decimator.retained().Find(decimator.retained().Begin().time());
+  ASSERT_TRUE(reference_it != reference_decimator.retained().End());
+  for (; it != decimator.retained().End(); ++it, ++reference_it) {
+    EXPECT_THAT(it.time(), Eq(reference_it.time()));
+  }
+  EXPECT_TRUE(reference_it == reference_decimator.retained().End());
+  EXPECT_EQ(times_.back(), decimator.last_time());
+
+  // Forgetting everything empties the decimator.
+  decimator.ForgetBefore(times_.back() + 1 * Second);
+  EXPECT_TRUE(decimator.empty());
+}
+
+}  // namespace internal_trajectory_decimator
+}  // namespace physics
+}  // namespace principia
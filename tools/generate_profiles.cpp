@@ -54,9 +54,9 @@ void GenerateProfiles() {
   std::ofstream player_generated_cc(journal / "player.generated.cc");
   CHECK(player_generated_cc.good());
   player_generated_cc << warning;
-  for (auto const& cxx_play_statement :
-           processor.GetCxxPlayStatements()) {
-    player_generated_cc << cxx_play_statement;
+  for (auto const& cxx_play_table_entry :
+           processor.GetCxxPlayTableEntries()) {
+    player_generated_cc << cxx_play_table_entry;
   }
 
   std::ofstream interface_generated_h(ksp_plugin / "interface.generated.h");
@@ -169,47 +169,104 @@ std::vector<std::string> JournalProtoProcessor::GetCxxMethodTypes() const {
   return result;
 }
 
-std::vector<std::string> JournalProtoProcessor::GetCxxPlayStatements() const {
+std::vector<std::string>
+JournalProtoProcessor::GetCxxPlayTableEntries() const {
   std::vector<std::string> result;
-  result.push_back("{\n  bool ran = false;\n");
-  for (auto const& pair : cxx_play_statement_) {
+  for (auto const& pair : cxx_play_table_entry_) {
     result.push_back(pair.second);
   }
-  result.push_back("  CHECK(ran) << method_in->DebugString() << \"\\n\"\n"
-                   "             << method_out_return->DebugString();\n}\n");
   return result;
 }
 
-void JournalProtoProcessor::ProcessRepeatedMessageField(
-    FieldDescriptor const* descriptor) {
-  std::string const& message_type_name = descriptor->message_type()->name();
-
+void JournalProtoProcessor::ProcessRepeatedNonStringField(
+    FieldDescriptor const* descriptor,
+    std::string const& cs_element_type,
+    std::string const& cxx_element_type) {
   FieldOptions const& options = descriptor->options();
   CHECK(options.HasExtension(journal::serialization::size))
       << descriptor->full_name() << " is missing a (size) option";
   size_member_name_[descriptor] =
       options.GetExtension(journal::serialization::size);
-  field_cs_type_[descriptor] = message_type_name + "[]";
-  field_cxx_type_[descriptor] = message_type_name + " const*";
+  field_cs_type_[descriptor] = cs_element_type + "[]";
+  field_cxx_element_type_[descriptor] = cxx_element_type;
+
+  // An array in an Out message is provided by the caller and filled by the
+  // interface, which returns the number of elements that it filled.  Only
+  // these elements are recorded, and when replaying we pass an array of the
+  // recorded size.
+  bool const is_out = Contains(out_, descriptor);
+  if (is_out) {
+    CHECK(!Contains(in_out_, descriptor))
+        << descriptor->full_name() << " cannot be in-out";
+    Descriptor const* const return_descriptor =
+        descriptor->containing_type()->containing_type()->FindNestedTypeByName(
+            return_message_name);
+    CHECK(return_descriptor != nullptr &&
+          return_descriptor->field_count() == 1 &&
+          return_descriptor->field(0)->type() == FieldDescriptor::TYPE_INT32)
+        << descriptor->full_name()
+        << " requires its method to return the number of filled elements";
+    field_cs_marshal_[descriptor] = "Out";
+    field_cxx_type_[descriptor] = cxx_element_type + "*";
+    field_cxx_arguments_fn_[descriptor] =
+        [](std::string const& identifier) -> std::vector<std::string> {
+          return {identifier + ".data()", identifier + ".size()"};
+        };
+  } else {
+    field_cxx_type_[descriptor] = cxx_element_type + " const*";
+    field_cxx_arguments_fn_[descriptor] =
+        [](std::string const& identifier) -> std::vector<std::string> {
+          return {"&" + identifier + "[0]", identifier + ".size()"};
+        };
+  }
 
-  field_cxx_arguments_fn_[descriptor] =
-      [](std::string const& identifier) -> std::vector<std::string> {
-        return {"&" + identifier + "[0]", identifier + ".size()"};
-      };
   field_cxx_assignment_fn_[descriptor] =
-      [this, descriptor, message_type_name](
+      [this, descriptor, cxx_element_type, is_out](
           std::string const& prefix, std::string const& expr) {
         std::string const& descriptor_name = descriptor->name();
         // The use of |substr| below is a bit of a cheat because we known the
-        // structure of |expr|.
-        return "  for (" + message_type_name + " const* " + descriptor_name +
+        // structure of |expr|.  For an Out array, the return message has
+        // already been filled when this code runs.
+        std::string const size =
+            is_out ? "message->return_().result()"
+                   : expr.substr(0, expr.find('.')) + "." +
+                         size_member_name_[descriptor];
+        return "  for (" + cxx_element_type + " const* " + descriptor_name +
                " = " + expr + "; " + descriptor_name + " < " + expr + " + " +
-               expr.substr(0, expr.find('.')) + "." +
-               size_member_name_[descriptor] + "; ++" + descriptor_name +
-               ") {\n    *" + prefix + "add_" + descriptor_name +
-               "() = " +
-               field_cxx_serializer_fn_[descriptor]("*"+ descriptor_name) +
-               ";\n  }\n";
+               size + "; ++" + descriptor_name + ") {\n  " +
+               field_cxx_element_assignment_fn_[descriptor](
+                   prefix, "*" + descriptor_name) +
+               "  }\n";
+      };
+}
+
+void JournalProtoProcessor::ProcessRepeatedDoubleField(
+    FieldDescriptor const* descriptor) {
+  ProcessRepeatedNonStringField(descriptor,
+                                /*cs_element_type=*/"double",
+                                /*cxx_element_type=*/"double");
+  field_cxx_element_assignment_fn_[descriptor] =
+      [descriptor](std::string const& prefix, std::string const& expr) {
+        return "  " + prefix + "add_" + descriptor->name() + "(" + expr +
+               ");\n";
+      };
+  field_cxx_deserializer_fn_[descriptor] =
+      [](std::string const& expr) {
+        return "std::vector<double>(" + expr + ".begin(), " + expr +
+               ".end())";
+      };
+}
+
+void JournalProtoProcessor::ProcessRepeatedMessageField(
+    FieldDescriptor const* descriptor) {
+  std::string const& message_type_name = descriptor->message_type()->name();
+  ProcessRepeatedNonStringField(descriptor,
+                                /*cs_element_type=*/message_type_name,
+                                /*cxx_element_type=*/message_type_name);
+  field_cxx_element_assignment_fn_[descriptor] =
+      [this, descriptor](std::string const& prefix, std::string const& expr) {
+        return "  *" + prefix + "add_" + descriptor->name() + "() = " +
+               field_cxx_serializer_fn_[descriptor](expr) + ";\n";
       };
   field_cxx_deserializer_fn_[descriptor] =
       [descriptor, message_type_name](std::string const& expr) {
@@ -233,6 +290,57 @@ void JournalProtoProcessor::ProcessRepeatedMessageField(
       };
 }
 
+void JournalProtoProcessor::ProcessRepeatedStringField(
+    FieldDescriptor const* descriptor) {
+  FieldOptions const& options = descriptor->options();
+  CHECK(options.HasExtension(journal::serialization::size))
+      << descriptor->full_name() << " is missing a (size) option";
+  CHECK_EQ(in_message_name, descriptor->containing_type()->name())
+      << descriptor->full_name() << " must be an in field";
+  size_member_name_[descriptor] =
+      options.GetExtension(journal::serialization::size);
+
+  // The strings are marshalled individually as null-terminated strings, which
+  // is adequate for identifiers.
+  field_cs_type_[descriptor] = "String[]";
+  field_cs_marshal_[descriptor] =
+      "MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)";
+  field_cxx_type_[descriptor] = "char const* const*";
+
+  field_cxx_arguments_fn_[descriptor] =
+      [](std::string const& identifier) -> std::vector<std::string> {
+        return {identifier + ".data()", identifier + ".size()"};
+      };
+  field_cxx_assignment_fn_[descriptor] =
+      [this, descriptor](std::string const& prefix, std::string const& expr) {
+        std::string const& descriptor_name = descriptor->name();
+        // The use of |substr| below is a bit of a cheat because we known the
+        // structure of |expr|.
+        return "  for (char const* const* " + descriptor_name + " = " + expr +
+               "; " + descriptor_name + " < " + expr + " + " +
+               expr.substr(0, expr.find('.')) + "." +
+               size_member_name_[descriptor] + "; ++" + descriptor_name +
+               ") {\n    " + prefix + "add_" + descriptor_name + "(*" +
+               descriptor_name + ");\n  }\n";
+      };
+  field_cxx_deserializer_fn_[descriptor] =
+      [descriptor](std::string const& expr) {
+        std::string const& descriptor_name = descriptor->name();
+        // The strings of the message outlive the call, so we only need to
+        // collect pointers to them.
+        return "[](::google::protobuf::RepeatedPtrField<std::string> const& "
+               "strings) -> std::vector<char const*> {\n"
+               "      std::vector<char const*> deserialized_" +
+               descriptor_name + ";\n" +
+               "      for (auto const& string : strings) {\n" +
+               "        deserialized_" + descriptor_name +
+               ".push_back(string.c_str());\n" +
+               "      }\n"
+               "      return deserialized_" + descriptor_name +
+               ";\n    }(" + expr + ")";
+      };
+}
+
 void JournalProtoProcessor::ProcessOptionalNonStringField(
     FieldDescriptor const* descriptor,
     std::string const& cs_boxed_type,
@@ -428,6 +536,39 @@ void JournalProtoProcessor::ProcessRequiredBoolField(
   field_cxx_type_[descriptor] = descriptor->cpp_type_name();
 }
 
+void JournalProtoProcessor::ProcessRequiredBytesField(
+    FieldDescriptor const* descriptor) {
+  FieldOptions const& options = descriptor->options();
+  CHECK(options.HasExtension(journal::serialization::size))
+      << descriptor->full_name() << " is missing a (size) option";
+  CHECK_EQ(in_message_name, descriptor->containing_type()->name())
+      << descriptor->full_name() << " must be an in field";
+  size_member_name_[descriptor] =
+      options.GetExtension(journal::serialization::size);
+
+  // Binary data is seen from the C# as an array of bytes, which is pinned
+  // rather than converted: it may contain NULs and has no terminator.
+  field_cs_type_[descriptor] = "byte[]";
+  field_cxx_type_[descriptor] = "std::uint8_t const*";
+
+  field_cxx_arguments_fn_[descriptor] =
+      [](std::string const& identifier) -> std::vector<std::string> {
+        return {"reinterpret_cast<std::uint8_t const*>(" + identifier +
+                    "->data())",
+                identifier + "->size()"};
+      };
+  field_cxx_deserializer_fn_[descriptor] =
+      [](std::string const& expr) {
+        return "&" + expr;
+      };
+  field_cxx_indirect_member_get_fn_[descriptor] =
+      [this, descriptor](std::string const& expr) {
+        return "std::string(reinterpret_cast<char const*>(" + expr + "), " +
+               expr.substr(0, expr.find('.')) + "." +
+               size_member_name_[descriptor] + ")";
+      };
+}
+
 void JournalProtoProcessor::ProcessRequiredDoubleField(
     FieldDescriptor const* descriptor) {
   field_cs_type_[descriptor] = "double";
@@ -529,9 +670,15 @@ void JournalProtoProcessor::ProcessOptionalField(
 void JournalProtoProcessor::ProcessRepeatedField(
     FieldDescriptor const* descriptor) {
   switch (descriptor->type()) {
-  case FieldDescriptor::TYPE_MESSAGE:
+    case FieldDescriptor::TYPE_DOUBLE:
+      ProcessRepeatedDoubleField(descriptor);
+      break;
+    case FieldDescriptor::TYPE_MESSAGE:
       ProcessRepeatedMessageField(descriptor);
       break;
+    case FieldDescriptor::TYPE_STRING:
+      ProcessRepeatedStringField(descriptor);
+      break;
     default:
       LOG(FATAL) << descriptor->full_name() << " has unexpected type "
                  << descriptor->type_name();
@@ -544,6 +691,9 @@ void JournalProtoProcessor::ProcessRequiredField(
     case FieldDescriptor::TYPE_BOOL:
       ProcessRequiredBoolField(descriptor);
       break;
+    case FieldDescriptor::TYPE_BYTES:
+      ProcessRequiredBytesField(descriptor);
+      break;
     case FieldDescriptor::TYPE_DOUBLE:
       ProcessRequiredDoubleField(descriptor);
       break;
@@ -719,7 +869,13 @@ void JournalProtoProcessor::ProcessInOut(
       std::copy(field_arguments.begin(), field_arguments.end(),
                 std::back_inserter(cxx_run_arguments_[descriptor]));
 
-      if (Contains(out_, field_descriptor)) {
+      if (Contains(out_, field_descriptor) &&
+          Contains(field_cxx_element_type_, field_descriptor)) {
+        cxx_run_body_prolog_[descriptor] +=
+            "  std::vector<" + field_cxx_element_type_[field_descriptor] +
+            "> " + run_local_variable + "(" + ToLower(name) + "." +
+            field_descriptor_name + "_size());\n";
+      } else if (Contains(out_, field_descriptor)) {
         cxx_run_body_prolog_[descriptor] +=
             "  " + field_cxx_type_[field_descriptor] + " " +
             run_local_variable + ";\n";
@@ -1053,9 +1209,9 @@ void JournalProtoProcessor::ProcessMethodExtension(
   }
   cxx_interface_method_declaration_[descriptor] += ");\n\n";
 
-  cxx_play_statement_[descriptor] =
-      "  ran |= RunIfAppropriate<" + name + ">(\n"
-      "             *method_in, *method_out_return);\n";
+  cxx_play_table_entry_[descriptor] =
+      "    {" + name + "::Message::extension.number(),\n"
+      "     &Player::RunIfAppropriate<" + name + ">},\n";
 }
 
 }  // namespace internal_journal_proto_processor
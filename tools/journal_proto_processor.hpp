@@ -36,10 +36,15 @@ class JournalProtoProcessor final {
   std::vector<std::string> GetCxxMethodTypes() const;
 
   // journal/player.cpp
-  std::vector<std::string> GetCxxPlayStatements() const;
+  std::vector<std::string> GetCxxPlayTableEntries() const;
 
  private:
+  void ProcessRepeatedNonStringField(FieldDescriptor const* descriptor,
+                                     std::string const& cs_element_type,
+                                     std::string const& cxx_element_type);
+  void ProcessRepeatedDoubleField(FieldDescriptor const* descriptor);
   void ProcessRepeatedMessageField(FieldDescriptor const* descriptor);
+  void ProcessRepeatedStringField(FieldDescriptor const* descriptor);
 
   void ProcessOptionalNonStringField(FieldDescriptor const* descriptor,
                                      std::string const& cs_boxed_type,
@@ -53,6 +58,7 @@ class JournalProtoProcessor final {
   void ProcessRequiredFixed64Field(FieldDescriptor const* descriptor);
   void ProcessRequiredMessageField(FieldDescriptor const* descriptor);
   void ProcessRequiredBoolField(FieldDescriptor const* descriptor);
+  void ProcessRequiredBytesField(FieldDescriptor const* descriptor);
   void ProcessRequiredDoubleField(FieldDescriptor const* descriptor);
   void ProcessRequiredInt32Field(FieldDescriptor const* descriptor);
   void ProcessRequiredInt64Field(FieldDescriptor const* descriptor);
@@ -125,6 +131,14 @@ class JournalProtoProcessor final {
                                      std::string const& expr)>>
       field_cxx_assignment_fn_;
 
+  // For repeated fields, a lambda producing a statement to append the element
+  // |expr| to the repeated field of the message, which is accessed through
+  // |prefix|.
+  std::map<FieldDescriptor const*,
+           std::function<std::string(std::string const& prefix,
+                                     std::string const& expr)>>
+      field_cxx_element_assignment_fn_;
+
   // For fields that have an (is_consumed) or (is_consumed_if) option, a lambda
   // producing a statement to call Delete() to remove the appropriate entry from
   // the pointer_map.  |expr| is a uint64 expression for the entry to be
@@ -206,6 +220,11 @@ class JournalProtoProcessor final {
   std::map<FieldDescriptor const*, std::string> field_cs_type_;
   std::map<FieldDescriptor const*, std::string> field_cxx_type_;
 
+  // For repeated fields, the C++ type of an element.  For repeated fields of
+  // an Out message the caller provides an array of such elements, which the
+  // interface fills.
+  std::map<FieldDescriptor const*, std::string> field_cxx_element_type_;
+
   // The C#/C++ declaration of an interface method corresponding to a method
   // message.  The key is a descriptor for a method message.
   std::map<Descriptor const*, std::string> cs_interface_method_declaration_;
@@ -238,8 +257,9 @@ class JournalProtoProcessor final {
   std::map<Descriptor const*, std::string> cxx_deserialize_definition_;
   std::map<Descriptor const*, std::string> cxx_serialize_definition_;
 
-  // The statements to be included in the body of the Play function.
-  std::map<Descriptor const*, std::string> cxx_play_statement_;
+  // The entries of the table used by the Play function to dispatch on the
+  // extension number.
+  std::map<Descriptor const*, std::string> cxx_play_table_entry_;
 
   // The entire sequence of statements for the body of a Fill function.  The key
   // is a descriptor for an In or Out message.